@@ -208,16 +208,19 @@ void USpatialGameInstance::Init()
 	checkf(!(GetDefault<USpatialGDKSettings>()->bEnableUnrealLoadBalancer && USpatialStatics::IsSpatialOffloadingEnabled()), TEXT("Offloading and the Unreal Load Balancer are enabled at the same time, this is currently not supported. Please change your project settings."));
 }
 
-void USpatialGameInstance::HandleOnConnected()
+void USpatialGameInstance::HandleOnConnected(const FString& WorkerId)
 {
 	UE_LOG(LogSpatialGameInstance, Log, TEXT("Successfully connected to SpatialOS"));
-	SpatialWorkerId = SpatialConnectionManager->GetWorkerConnection()->GetWorkerId();
+	SpatialWorkerId = WorkerId;
 #if TRACE_LIB_ACTIVE
 	SpatialLatencyTracer->SetWorkerId(SpatialWorkerId);
 
-	USpatialWorkerConnection* WorkerConnection = SpatialConnectionManager->GetWorkerConnection();
-	WorkerConnection->OnEnqueueMessage.AddUObject(SpatialLatencyTracer, &USpatialLatencyTracer::OnEnqueueMessage);
-	WorkerConnection->OnDequeueMessage.AddUObject(SpatialLatencyTracer, &USpatialLatencyTracer::OnDequeueMessage);
+	// Net drivers given a connection override don't connect through the connection manager.
+	if (USpatialWorkerConnection* WorkerConnection = SpatialConnectionManager != nullptr ? SpatialConnectionManager->GetWorkerConnection() : nullptr)
+	{
+		WorkerConnection->OnEnqueueMessage.AddUObject(SpatialLatencyTracer, &USpatialLatencyTracer::OnEnqueueMessage);
+		WorkerConnection->OnDequeueMessage.AddUObject(SpatialLatencyTracer, &USpatialLatencyTracer::OnDequeueMessage);
+	}
 #endif
 	OnConnected.Broadcast();
 }
@@ -188,7 +188,7 @@ void USpatialNetConnection::SetHeartbeatEventTimer()
 			Schema_Object* EventsObject = Schema_GetComponentUpdateEvents(ComponentUpdate.schema_type);
 			Schema_AddObject(EventsObject, SpatialConstants::HEARTBEAT_EVENT_ID);
 
-			USpatialWorkerConnection* WorkerConnection = Cast<USpatialNetDriver>(Connection->Driver)->Connection;
+			SpatialOSWorkerInterface* WorkerConnection = Cast<USpatialNetDriver>(Connection->Driver)->Connection;
 			if (WorkerConnection != nullptr)
 			{
 				WorkerConnection->SendComponentUpdate(Connection->PlayerControllerEntity, &ComponentUpdate);
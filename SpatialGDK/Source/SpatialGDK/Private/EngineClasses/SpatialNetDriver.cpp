@@ -52,8 +52,6 @@
 #endif
 
 using SpatialGDK::ComponentFactory;
-using SpatialGDK::FindFirstOpOfType;
-using SpatialGDK::FindFirstOpOfTypeForComponent;
 using SpatialGDK::InterestFactory;
 using SpatialGDK::RPCPayload;
 
@@ -70,8 +68,10 @@ DEFINE_STAT(STAT_SpatialActorsChanged);
 
 USpatialNetDriver::USpatialNetDriver(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, Connection(nullptr)
 	, LoadBalanceStrategy(nullptr)
 	, LoadBalanceEnforcer(nullptr)
+	, ConnectionOverride(nullptr)
 	, bAuthoritativeDestruction(true)
 	, bConnectAsClient(false)
 	, bPersistSpatialConnection(true)
@@ -219,6 +219,13 @@ void USpatialNetDriver::InitiateConnectionToSpatialOS(const FURL& URL)
 		return;
 	}
 
+	if (ConnectionOverride != nullptr)
+	{
+		// There is nothing to connect to, and the connection manager is left alone.
+		OnConnectionToSpatialOSSucceeded();
+		return;
+	}
+
 	if (bConnectAsClient)
 	{
 		bPersistSpatialConnection = URL.HasOption(*SpatialConstants::ClientsStayConnectedURLOption);
@@ -281,7 +288,7 @@ void USpatialNetDriver::InitiateConnectionToSpatialOS(const FURL& URL)
 
 void USpatialNetDriver::OnConnectionToSpatialOSSucceeded()
 {
-	Connection = ConnectionManager->GetWorkerConnection();
+	Connection = ConnectionOverride != nullptr ? ConnectionOverride : ConnectionManager->GetWorkerConnection();
 	check(Connection);
 
 	// If we're the server, we will spawn the special Spatial connection that will route all updates to SpatialOS.
@@ -305,7 +312,12 @@ void USpatialNetDriver::OnConnectionToSpatialOSSucceeded()
 
 	USpatialGameInstance* GameInstance = GetGameInstance();
 	check(GameInstance != nullptr);
-	GameInstance->HandleOnConnected();
+	GameInstance->HandleOnConnected(Connection->GetWorkerId());
+}
+
+USpatialWorkerConnection* USpatialNetDriver::GetWorkerConnection() const
+{
+	return ConnectionManager != nullptr ? ConnectionManager->GetWorkerConnection() : nullptr;
 }
 
 void USpatialNetDriver::OnConnectionToSpatialOSFailed(uint8_t ConnectionStatusCode, const FString& ErrorMessage)
@@ -350,6 +362,11 @@ void USpatialNetDriver::CreateAndInitializeCoreClasses()
 	InitializeSpatialOutputDevice();
 
 	Dispatcher = MakeUnique<SpatialDispatcher>();
+	OpQueue = MakeUnique<SpatialGDK::FTimeSlicedOpQueue>(
+		[this](Worker_OpList* OpList) { Dispatcher->DispatchOps(OpList); },
+		[this](const Worker_Op* Op) { Dispatcher->MarkOpToSkip(Op); },
+		[this]() { Dispatcher->FlushReceiverQueues(); },
+		[this](Worker_OpList* OpList) { DestroyOpList(OpList); });
 	Sender = NewObject<USpatialSender>();
 	Receiver = NewObject<USpatialReceiver>();
 
@@ -365,6 +382,10 @@ void USpatialNetDriver::CreateAndInitializeCoreClasses()
 
 	StaticComponentView = GameInstance->GetStaticComponentView();
 	check(StaticComponentView != nullptr);
+	if (GetDefault<USpatialGDKSettings>()->bPublishComponentViewSnapshots)
+	{
+		StaticComponentView->EnableSnapshots();
+	}
 
 	PlayerSpawner = NewObject<USpatialPlayerSpawner>();
 	SnapshotManager = MakeUnique<SpatialSnapshotManager>();
@@ -393,6 +414,16 @@ void USpatialNetDriver::CreateAndInitializeCoreClasses()
 		CreateAndInitializeLoadBalancingClasses();
 	}
 
+	if (!IsServer() && SpatialSettings->PooledActorClasses.Num() > 0)
+	{
+		ActorPool = MakeUnique<SpatialGDK::FActorPool>(SpatialSettings->PooledActorClasses);
+	}
+
+	if (SpatialSettings->bStageComponentUpdatesOnWorkerThreads)
+	{
+		ComponentUpdateStaging = MakeUnique<SpatialGDK::FComponentUpdateStaging>(this);
+	}
+
 	if (SpatialSettings->UseRPCRingBuffer())
 	{
 		RPCService = MakeUnique<SpatialGDK::SpatialRPCService>(ExtractRPCDelegate::CreateUObject(Receiver, &USpatialReceiver::OnExtractIncomingRPC), StaticComponentView);
@@ -404,7 +435,7 @@ void USpatialNetDriver::CreateAndInitializeCoreClasses()
 	GlobalStateManager->Init(this);
 	SnapshotManager->Init(Connection, GlobalStateManager, Receiver);
 	PlayerSpawner->Init(this, &TimerManager);
-	SpatialMetrics->Init(Connection, NetServerMaxTickRate, IsServer());
+	SpatialMetrics->Init(Connection, GetWorkerConnection(), NetServerMaxTickRate, IsServer());
 	SpatialMetrics->ControllerRefProvider.BindUObject(this, &USpatialNetDriver::GetCurrentPlayerControllerRef);
 
 	// PackageMap value has been set earlier in USpatialNetConnection::InitBase
@@ -830,7 +861,8 @@ void USpatialNetDriver::BeginDestroy()
 		}
 
 		// Destroy the connection to disconnect from SpatialOS if we aren't meant to persist it.
-		if (!bPersistSpatialConnection)
+		// A connection override belongs to whoever set it.
+		if (!bPersistSpatialConnection && ConnectionOverride == nullptr)
 		{
 			if (UWorld* LocalWorld = GetWorld())
 			{
@@ -963,6 +995,13 @@ void USpatialNetDriver::Shutdown()
 
 	SpatialOutputDevice = nullptr;
 
+	if (ActorPool.IsValid())
+	{
+		// Parked actors have no actor channel, so they would otherwise be left hidden in the world.
+		ActorPool->Empty();
+		ActorPool.Reset();
+	}
+
 	Super::Shutdown();
 
 	// This is done after Super::Shutdown so the NetDriver is given an opportunity to shutdown all open channels, and those
@@ -1041,6 +1080,17 @@ void USpatialNetDriver::OnOwnerUpdated(AActor* Actor, AActor* OldOwner)
 	Channel->ServerProcessOwnershipChange();
 }
 
+bool USpatialNetDriver::ShouldClientDestroyActor(AActor* Actor) const
+{
+	// Actors being parked in the actor pool outlive their actor channel.
+	if (ActorPool.IsValid() && ActorPool->IsParking(Actor))
+	{
+		return false;
+	}
+
+	return Super::ShouldClientDestroyActor(Actor);
+}
+
 //SpatialGDK: Functions in the ifdef block below are modified versions of the UNetDriver:: implementations.
 #if WITH_SERVER_CODE
 
@@ -1625,14 +1675,35 @@ void USpatialNetDriver::TickDispatch(float DeltaTime)
 			return;
 		}
 
+		if (ComponentUpdateStaging.IsValid())
 		{
-			SCOPE_CYCLE_COUNTER(STAT_SpatialProcessOps);
+			// Decoding overlaps with dispatching the ops received before, including those left over from previous frames.
 			for (Worker_OpList* OpList : OpLists)
 			{
-				Dispatcher->ProcessOps(OpList);
+				ComponentUpdateStaging->StageComponentUpdates(*OpList);
+			}
+		}
 
-				Worker_OpList_Destroy(OpList);
+		{
+			SCOPE_CYCLE_COUNTER(STAT_SpatialProcessOps);
+			const float OpProcessingBudgetMillis = IsServer() ? 0.0f : SpatialGDKSettings->ClientOpProcessingBudgetMillis;
+			if (OpProcessingBudgetMillis > 0.0f || !OpQueue->IsEmpty())
+			{
+				// Ops left over from previous frames have to be processed before the ones received since.
+				OpQueue->Enqueue(OpLists);
+				OpQueue->ProcessOps(OpProcessingBudgetMillis / 1000.0);
 			}
+			else
+			{
+				for (Worker_OpList* OpList : OpLists)
+				{
+					ProcessOps(OpList);
+
+					DestroyOpList(OpList);
+				}
+			}
+
+			StaticComponentView->PublishSnapshot();
 		}
 
 		if (SpatialMetrics != nullptr && SpatialGDKSettings->bEnableMetrics)
@@ -2166,6 +2237,11 @@ void USpatialNetDriver::AddActorChannel(Worker_EntityId EntityId, USpatialActorC
 	EntityToActorChannel.Add(EntityId, Channel);
 }
 
+void USpatialNetDriver::ReserveActorChannels(int32 NumChannels)
+{
+	EntityToActorChannel.Reserve(EntityToActorChannel.Num() + NumChannels);
+}
+
 void USpatialNetDriver::RemoveActorChannel(Worker_EntityId EntityId, USpatialActorChannel& Channel)
 {
 	for (auto& ChannelRefs : Channel.ObjectReferenceMap)
@@ -2364,9 +2440,14 @@ void USpatialNetDriver::HandleStartupOpQueueing(const TArray<Worker_OpList*>& In
 	}
 
 	QueuedStartupOpLists.Append(InOpLists);
+
+	// Only the op lists received this tick are searched, the startup ops of earlier ones have already been dispatched.
+	StartupOpIndex.Reset();
+	StartupOpIndex.AddOpLists(InOpLists);
+
 	if (IsServer())
 	{
-		bIsReadyToStart = FindAndDispatchStartupOpsServer(InOpLists);
+		bIsReadyToStart = FindAndDispatchStartupOpsServer(StartupOpIndex);
 
 		if (bIsReadyToStart)
 		{
@@ -2385,9 +2466,12 @@ void USpatialNetDriver::HandleStartupOpQueueing(const TArray<Worker_OpList*>& In
 	}
 	else
 	{
-		bIsReadyToStart = FindAndDispatchStartupOpsClient(InOpLists);
+		bIsReadyToStart = FindAndDispatchStartupOpsClient(StartupOpIndex);
 	}
 
+	// The index points into the op lists, which are destroyed once they have been processed.
+	StartupOpIndex.Reset();
+
 	if (!bIsReadyToStart)
 	{
 		return;
@@ -2396,7 +2480,7 @@ void USpatialNetDriver::HandleStartupOpQueueing(const TArray<Worker_OpList*>& In
 	for (Worker_OpList* OpList : QueuedStartupOpLists)
 	{
 		Dispatcher->ProcessOps(OpList);
-		Worker_OpList_Destroy(OpList);
+		DestroyOpList(OpList);
 	}
 
 	// Sanity check that the dispatcher encountered, skipped, and removed
@@ -2406,12 +2490,11 @@ void USpatialNetDriver::HandleStartupOpQueueing(const TArray<Worker_OpList*>& In
 	QueuedStartupOpLists.Empty();
 }
 
-bool USpatialNetDriver::FindAndDispatchStartupOpsServer(const TArray<Worker_OpList*>& InOpLists)
+bool USpatialNetDriver::FindAndDispatchStartupOpsServer(const SpatialGDK::FFirstOpIndex& OpIndex)
 {
 	TArray<Worker_Op*> FoundOps;
 
-	Worker_Op* EntityQueryResponseOp = nullptr;
-	FindFirstOpOfType(InOpLists, WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE, &EntityQueryResponseOp);
+	Worker_Op* EntityQueryResponseOp = OpIndex.FindFirstOpOfType(WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE);
 
 	if (EntityQueryResponseOp != nullptr)
 	{
@@ -2420,8 +2503,7 @@ bool USpatialNetDriver::FindAndDispatchStartupOpsServer(const TArray<Worker_OpLi
 
 	// CreateEntityResponseOps are needed for non-GSM-authoritative server workers sending an update
 	// to the Runtime indicating that the worker is ready to begin play.
-	Worker_Op* CreateEntityResponseOp = nullptr;
-	FindFirstOpOfType(InOpLists, WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE, &CreateEntityResponseOp);
+	Worker_Op* CreateEntityResponseOp = OpIndex.FindFirstOpOfType(WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE);
 
 	if (CreateEntityResponseOp != nullptr)
 	{
@@ -2433,8 +2515,7 @@ bool USpatialNetDriver::FindAndDispatchStartupOpsServer(const TArray<Worker_OpLi
 	// a new query will be sent, and we will process the new response here when it arrives.
 	if (!PackageMap->IsEntityPoolReady())
 	{
-		Worker_Op* EntityIdReservationResponseOp = nullptr;
-		FindFirstOpOfType(InOpLists, WORKER_OP_TYPE_RESERVE_ENTITY_IDS_RESPONSE, &EntityIdReservationResponseOp);
+		Worker_Op* EntityIdReservationResponseOp = OpIndex.FindFirstOpOfType(WORKER_OP_TYPE_RESERVE_ENTITY_IDS_RESPONSE);
 
 		if (EntityIdReservationResponseOp != nullptr)
 		{
@@ -2445,14 +2526,11 @@ bool USpatialNetDriver::FindAndDispatchStartupOpsServer(const TArray<Worker_OpLi
 	// Search for StartupActorManager ops we need and process them
 	if (!GlobalStateManager->IsReady())
 	{
-		Worker_Op* AddComponentOp = nullptr;
-		FindFirstOpOfTypeForComponent(InOpLists, WORKER_OP_TYPE_ADD_COMPONENT, SpatialConstants::STARTUP_ACTOR_MANAGER_COMPONENT_ID, &AddComponentOp);
+		Worker_Op* AddComponentOp = OpIndex.FindFirstOpOfTypeForComponent(WORKER_OP_TYPE_ADD_COMPONENT, SpatialConstants::STARTUP_ACTOR_MANAGER_COMPONENT_ID);
 
-		Worker_Op* AuthorityChangedOp = nullptr;
-		FindFirstOpOfTypeForComponent(InOpLists, WORKER_OP_TYPE_AUTHORITY_CHANGE, SpatialConstants::STARTUP_ACTOR_MANAGER_COMPONENT_ID, &AuthorityChangedOp);
+		Worker_Op* AuthorityChangedOp = OpIndex.FindFirstOpOfTypeForComponent(WORKER_OP_TYPE_AUTHORITY_CHANGE, SpatialConstants::STARTUP_ACTOR_MANAGER_COMPONENT_ID);
 
-		Worker_Op* ComponentUpdateOp = nullptr;
-		FindFirstOpOfTypeForComponent(InOpLists, WORKER_OP_TYPE_COMPONENT_UPDATE, SpatialConstants::STARTUP_ACTOR_MANAGER_COMPONENT_ID, &ComponentUpdateOp);
+		Worker_Op* ComponentUpdateOp = OpIndex.FindFirstOpOfTypeForComponent(WORKER_OP_TYPE_COMPONENT_UPDATE, SpatialConstants::STARTUP_ACTOR_MANAGER_COMPONENT_ID);
 
 		if (AddComponentOp != nullptr)
 		{
@@ -2472,14 +2550,11 @@ bool USpatialNetDriver::FindAndDispatchStartupOpsServer(const TArray<Worker_OpLi
 
 	if (VirtualWorkerTranslator.IsValid() && !VirtualWorkerTranslator->IsReady())
 	{
-		Worker_Op* AddComponentOp = nullptr;
-		FindFirstOpOfTypeForComponent(InOpLists, WORKER_OP_TYPE_ADD_COMPONENT, SpatialConstants::VIRTUAL_WORKER_TRANSLATION_COMPONENT_ID, &AddComponentOp);
+		Worker_Op* AddComponentOp = OpIndex.FindFirstOpOfTypeForComponent(WORKER_OP_TYPE_ADD_COMPONENT, SpatialConstants::VIRTUAL_WORKER_TRANSLATION_COMPONENT_ID);
 
-		Worker_Op* AuthorityChangedOp = nullptr;
-		FindFirstOpOfTypeForComponent(InOpLists, WORKER_OP_TYPE_AUTHORITY_CHANGE, SpatialConstants::VIRTUAL_WORKER_TRANSLATION_COMPONENT_ID, &AuthorityChangedOp);
+		Worker_Op* AuthorityChangedOp = OpIndex.FindFirstOpOfTypeForComponent(WORKER_OP_TYPE_AUTHORITY_CHANGE, SpatialConstants::VIRTUAL_WORKER_TRANSLATION_COMPONENT_ID);
 
-		Worker_Op* ComponentUpdateOp = nullptr;
-		FindFirstOpOfTypeForComponent(InOpLists, WORKER_OP_TYPE_COMPONENT_UPDATE, SpatialConstants::VIRTUAL_WORKER_TRANSLATION_COMPONENT_ID, &ComponentUpdateOp);
+		Worker_Op* ComponentUpdateOp = OpIndex.FindFirstOpOfTypeForComponent(WORKER_OP_TYPE_COMPONENT_UPDATE, SpatialConstants::VIRTUAL_WORKER_TRANSLATION_COMPONENT_ID);
 
 		if (AddComponentOp != nullptr)
 		{
@@ -2515,7 +2590,7 @@ bool USpatialNetDriver::FindAndDispatchStartupOpsServer(const TArray<Worker_OpLi
 	return false;
 }
 
-bool USpatialNetDriver::FindAndDispatchStartupOpsClient(const TArray<Worker_OpList*>& InOpLists)
+bool USpatialNetDriver::FindAndDispatchStartupOpsClient(const SpatialGDK::FFirstOpIndex& OpIndex)
 {
 	if (bMapLoaded)
 	{
@@ -2524,8 +2599,7 @@ bool USpatialNetDriver::FindAndDispatchStartupOpsClient(const TArray<Worker_OpLi
 	else
 	{
 		// Search for the entity query response for the GlobalStateManager
-		Worker_Op* Op = nullptr;
-		FindFirstOpOfType(InOpLists, WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE, &Op);
+		Worker_Op* Op = OpIndex.FindFirstOpOfType(WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE);
 
 		TArray<Worker_Op*> FoundOps;
 		if (Op != nullptr)
@@ -2556,6 +2630,31 @@ void USpatialNetDriver::SelectiveProcessOps(TArray<Worker_Op*> FoundOps)
 	}
 }
 
+void USpatialNetDriver::ProcessOps(Worker_OpList* OpList)
+{
+	Dispatcher->DispatchOps(OpList);
+	Dispatcher->FlushReceiverQueues();
+}
+
+void USpatialNetDriver::DestroyOpList(Worker_OpList* OpList)
+{
+	// Staged updates point into the op list, so they are dropped before it is destroyed.
+	if (ComponentUpdateStaging.IsValid())
+	{
+		ComponentUpdateStaging->Release(*OpList);
+	}
+
+	// Op lists left over once the connection is gone can only have come from the Worker SDK.
+	if (Connection != nullptr)
+	{
+		Connection->DestroyOpList(OpList);
+	}
+	else
+	{
+		Worker_OpList_Destroy(OpList);
+	}
+}
+
 // This should only be called once on each client, in the SpatialMetricsDisplay constructor after the class is replicated to each client.
 // This is enforced by the fact that the class is a Singleton spawned on servers by the SpatialNetDriver.
 void USpatialNetDriver::SetSpatialMetricsDisplay(ASpatialMetricsDisplay* InSpatialMetricsDisplay)
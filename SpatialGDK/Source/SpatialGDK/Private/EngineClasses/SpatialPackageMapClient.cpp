@@ -175,6 +175,12 @@ void USpatialPackageMapClient::ResolveSubobject(UObject* Object, const FUnrealOb
 	}
 }
 
+void USpatialPackageMapClient::ReserveEntityObjects(int32 NumObjects)
+{
+	FSpatialNetGUIDCache* SpatialGuidCache = static_cast<FSpatialNetGUIDCache*>(GuidCache.Get());
+	SpatialGuidCache->ReserveEntityObjects(NumObjects);
+}
+
 void USpatialPackageMapClient::RemoveEntityActor(Worker_EntityId EntityId)
 {
 	FSpatialNetGUIDCache* SpatialGuidCache = static_cast<FSpatialNetGUIDCache*>(GuidCache.Get());
@@ -441,6 +447,14 @@ void FSpatialNetGUIDCache::AssignNewSubobjectNetGUID(UObject* Subobject, const F
 	RegisterObjectRef(SubobjectNetGUID, SubobjectRef);
 }
 
+void FSpatialNetGUIDCache::ReserveEntityObjects(int32 NumObjects)
+{
+	ObjectLookup.Reserve(ObjectLookup.Num() + NumObjects);
+	NetGUIDLookup.Reserve(NetGUIDLookup.Num() + NumObjects);
+	NetGUIDToUnrealObjectRef.Reserve(NetGUIDToUnrealObjectRef.Num() + NumObjects);
+	UnrealObjectRefToNetGUID.Reserve(UnrealObjectRefToNetGUID.Num() + NumObjects);
+}
+
 // Recursively assign netguids to the outer chain of a UObject. Then associate them with their Spatial representation (FUnrealObjectRef)
 // This is required in order to be able to refer to a non-replicated stably named UObject.
 // Dynamically spawned actors and references to their subobjects do not go through this codepath.
@@ -0,0 +1,191 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/ActorPool.h"
+
+#include "Components/ActorComponent.h"
+#include "GameFramework/Actor.h"
+#include "Misc/OutputDevice.h"
+
+#include "Interop/SpatialPooledActor.h"
+
+DEFINE_LOG_CATEGORY(LogSpatialActorPool);
+
+namespace SpatialGDK
+{
+
+FActorPool::FActorPool(const TArray<FPooledActorClass>& PooledActorClasses)
+{
+	for (const FPooledActorClass& PooledActorClass : PooledActorClasses)
+	{
+		if (!PooledActorClass.ActorClass.IsNull() && PooledActorClass.MaxPooledActors > 0)
+		{
+			MaxPooledActorsByClassPath.Add(PooledActorClass.ActorClass.ToSoftObjectPath(), PooledActorClass.MaxPooledActors);
+		}
+	}
+}
+
+bool FActorPool::IsPooledClass(const UClass* Class)
+{
+	return FindClassPool(Class) != nullptr;
+}
+
+bool FActorPool::BeginParking(AActor* Actor)
+{
+	check(ActorBeingParked == nullptr);
+
+	FClassPool* Pool = FindClassPool(Actor->GetClass());
+	check(Pool != nullptr);
+
+	if (Pool->ParkedActors.Num() >= Pool->MaxPooledActors)
+	{
+		Pool->Stats.Overflows++;
+		return false;
+	}
+
+	ActorBeingParked = Actor;
+	return true;
+}
+
+void FActorPool::FinishParking()
+{
+	check(ActorBeingParked != nullptr);
+	AActor* Actor = ActorBeingParked;
+	ActorBeingParked = nullptr;
+
+	FClassPool& Pool = ClassPools.FindChecked(Actor->GetClass());
+	FParkedActor& ParkedActor = Pool.ParkedActors.AddDefaulted_GetRef();
+	ParkedActor.Actor = Actor;
+	ParkedActor.bWasHidden = Actor->bHidden;
+	ParkedActor.bHadCollision = Actor->GetActorEnableCollision();
+	ParkedActor.bWasTickEnabled = Actor->IsActorTickEnabled();
+
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (Component != nullptr && Component->IsComponentTickEnabled())
+		{
+			ParkedActor.TickingComponents.Add(Component);
+			Component->SetComponentTickEnabled(false);
+		}
+	}
+
+	Actor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+
+	CastChecked<ISpatialPooledActor>(Actor)->OnParkedInPool();
+
+	Pool.Stats.Parked++;
+}
+
+AActor* FActorPool::Take(const UClass* Class, const FTransform& Transform)
+{
+	FClassPool* Pool = FindClassPool(Class);
+	if (Pool == nullptr)
+	{
+		return nullptr;
+	}
+
+	while (Pool->ParkedActors.Num() > 0)
+	{
+		FParkedActor ParkedActor = Pool->ParkedActors.Pop(/* bAllowShrinking */ false);
+		AActor* Actor = ParkedActor.Actor.Get();
+		if (Actor == nullptr || Actor->IsPendingKillOrUnreachable())
+		{
+			// Destroyed while parked, e.g. by its level being unloaded.
+			continue;
+		}
+
+		Actor->SetActorTransform(Transform, /* bSweep */ false, nullptr, ETeleportType::ResetPhysics);
+		Actor->SetActorHiddenInGame(ParkedActor.bWasHidden);
+		Actor->SetActorEnableCollision(ParkedActor.bHadCollision);
+		Actor->SetActorTickEnabled(ParkedActor.bWasTickEnabled);
+		for (const TWeakObjectPtr<UActorComponent>& Component : ParkedActor.TickingComponents)
+		{
+			if (Component.IsValid())
+			{
+				Component->SetComponentTickEnabled(true);
+			}
+		}
+
+		CastChecked<ISpatialPooledActor>(Actor)->OnTakenFromPool();
+
+		Pool->Stats.Hits++;
+		return Actor;
+	}
+
+	Pool->Stats.Misses++;
+	return nullptr;
+}
+
+void FActorPool::Empty()
+{
+	for (auto& ClassPool : ClassPools)
+	{
+		for (const FParkedActor& ParkedActor : ClassPool.Value.ParkedActors)
+		{
+			if (AActor* Actor = ParkedActor.Actor.Get())
+			{
+				Actor->Destroy(true);
+			}
+		}
+		ClassPool.Value.ParkedActors.Empty();
+	}
+}
+
+int32 FActorPool::GetNumParkedActors(const UClass* Class) const
+{
+	const FClassPool* Pool = ClassPools.Find(Class);
+	return Pool != nullptr ? Pool->ParkedActors.Num() : 0;
+}
+
+const FActorPool::FClassStats* FActorPool::GetClassStats(const UClass* Class) const
+{
+	const FClassPool* Pool = ClassPools.Find(Class);
+	return Pool != nullptr && Pool->MaxPooledActors > 0 ? &Pool->Stats : nullptr;
+}
+
+void FActorPool::Dump(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Actor pool stats:"));
+
+	for (const auto& ClassPool : ClassPools)
+	{
+		const UClass* Class = ClassPool.Key.Get();
+		const FClassPool& Pool = ClassPool.Value;
+		if (Class == nullptr || Pool.MaxPooledActors == 0)
+		{
+			continue;
+		}
+
+		const uint64 Takes = Pool.Stats.Hits + Pool.Stats.Misses;
+		Ar.Logf(TEXT("  %-48s parked %4d/%-4d  hits %8llu  misses %8llu  hit rate %5.1f%%  overflows %8llu"),
+			*Class->GetName(),
+			Pool.ParkedActors.Num(), Pool.MaxPooledActors,
+			Pool.Stats.Hits,
+			Pool.Stats.Misses,
+			Takes > 0 ? 100.0 * Pool.Stats.Hits / Takes : 0.0,
+			Pool.Stats.Overflows);
+	}
+}
+
+FActorPool::FClassPool* FActorPool::FindClassPool(const UClass* Class)
+{
+	FClassPool* Pool = ClassPools.Find(Class);
+	if (Pool == nullptr)
+	{
+		// Classes that aren't pooled get an entry without room for actors, so they are only resolved once as well.
+		Pool = &ClassPools.Add(Class);
+		Pool->MaxPooledActors = MaxPooledActorsByClassPath.FindRef(FSoftObjectPath(Class));
+
+		if (Pool->MaxPooledActors > 0 && !Class->ImplementsInterface(USpatialPooledActor::StaticClass()))
+		{
+			UE_LOG(LogSpatialActorPool, Warning, TEXT("%s is configured to be pooled but doesn't implement ISpatialPooledActor, its actors won't be pooled."), *Class->GetName());
+			Pool->MaxPooledActors = 0;
+		}
+	}
+
+	return Pool->MaxPooledActors > 0 ? Pool : nullptr;
+}
+
+} // namespace SpatialGDK
@@ -0,0 +1,105 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/ComponentViewSnapshot.h"
+
+namespace SpatialGDK
+{
+
+FComponentViewSnapshotRef::FComponentViewSnapshotRef(const FComponentViewSnapshot* InSnapshot, TAtomic<int32>* InReaderCount)
+	: Snapshot(InSnapshot)
+	, ReaderCount(InReaderCount)
+{
+}
+
+FComponentViewSnapshotRef::FComponentViewSnapshotRef(FComponentViewSnapshotRef&& Other)
+	: Snapshot(Other.Snapshot)
+	, ReaderCount(Other.ReaderCount)
+{
+	Other.Snapshot = nullptr;
+	Other.ReaderCount = nullptr;
+}
+
+FComponentViewSnapshotRef& FComponentViewSnapshotRef::operator=(FComponentViewSnapshotRef&& Other)
+{
+	if (this != &Other)
+	{
+		Release();
+		Snapshot = Other.Snapshot;
+		ReaderCount = Other.ReaderCount;
+		Other.Snapshot = nullptr;
+		Other.ReaderCount = nullptr;
+	}
+	return *this;
+}
+
+FComponentViewSnapshotRef::~FComponentViewSnapshotRef()
+{
+	Release();
+}
+
+void FComponentViewSnapshotRef::Release()
+{
+	if (ReaderCount != nullptr)
+	{
+		--(*ReaderCount);
+	}
+	Snapshot = nullptr;
+	ReaderCount = nullptr;
+}
+
+FComponentViewSnapshots::FComponentViewSnapshots()
+	: CurrentIndex(0)
+	, PublishCount(0)
+{
+	Buffers[0].ReaderCount = 0;
+	Buffers[1].ReaderCount = 0;
+}
+
+void FComponentViewSnapshots::MarkChanged(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+{
+	// Each snapshot misses the changes since it was last published, so both have to catch up on them.
+	const EntityComponentId Key{ EntityId, ComponentId };
+	Buffers[0].PendingChanges.Add(Key);
+	Buffers[1].PendingChanges.Add(Key);
+}
+
+bool FComponentViewSnapshots::Publish(const FEntityComponentStore& Live)
+{
+	FBuffer& Back = Buffers[1 - CurrentIndex.Load()];
+
+	// Readers only add themselves to the back buffer when they lose a race with the last publish, and they let go again
+	// before reading, so once this is zero nothing reads the back buffer until it is made current below.
+	if (Back.ReaderCount.Load() != 0)
+	{
+		return false;
+	}
+
+	for (const EntityComponentId& Key : Back.PendingChanges)
+	{
+		Back.Snapshot.Store.CopyEntryFrom(Live, Key.EntityId, Key.ComponentId);
+	}
+	Back.PendingChanges.Reset();
+	Back.Snapshot.PublishCount = ++PublishCount;
+
+	CurrentIndex = 1 - CurrentIndex.Load();
+	return true;
+}
+
+FComponentViewSnapshotRef FComponentViewSnapshots::Acquire() const
+{
+	for (;;)
+	{
+		const int32 Index = CurrentIndex.Load();
+		const FBuffer& Buffer = Buffers[Index];
+		++Buffer.ReaderCount;
+
+		// If a publish swapped the buffers in between, the game thread may be writing to this one.
+		if (CurrentIndex.Load() == Index)
+		{
+			return FComponentViewSnapshotRef(&Buffer.Snapshot, &Buffer.ReaderCount);
+		}
+		--Buffer.ReaderCount;
+	}
+}
+
+} // namespace SpatialGDK
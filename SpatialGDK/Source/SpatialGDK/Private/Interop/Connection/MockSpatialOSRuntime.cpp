@@ -0,0 +1,1015 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/Connection/MockSpatialOSRuntime.h"
+
+#include "SpatialConstants.h"
+
+DEFINE_LOG_CATEGORY(LogMockSpatialOSRuntime);
+
+namespace SpatialGDK
+{
+
+namespace
+{
+
+// Matches the timeout the real connection uses when no timeout is given for a command.
+const uint32 DefaultCommandTimeoutMillis = 5000;
+
+Worker_ComponentData MakeComponentData(Worker_ComponentId ComponentId, Schema_ComponentData* SchemaData)
+{
+	Worker_ComponentData Data{};
+	Data.component_id = ComponentId;
+	Data.schema_type = SchemaData;
+	return Data;
+}
+
+bool IsWithinSphere(const Coordinates& Point, const Coordinates& Center, double Radius)
+{
+	const double DX = Point.X - Center.X;
+	const double DY = Point.Y - Center.Y;
+	const double DZ = Point.Z - Center.Z;
+	return DX * DX + DY * DY + DZ * DZ <= Radius * Radius;
+}
+
+// Cylinders are vertical and of infinite height, so only the X and Z axes are taken into account.
+bool IsWithinCylinder(const Coordinates& Point, const Coordinates& Center, double Radius)
+{
+	const double DX = Point.X - Center.X;
+	const double DZ = Point.Z - Center.Z;
+	return DX * DX + DZ * DZ <= Radius * Radius;
+}
+
+bool IsWithinBox(const Coordinates& Point, const Coordinates& Center, const EdgeLength& Edges)
+{
+	return FMath::Abs(Point.X - Center.X) <= Edges.X * 0.5
+		&& FMath::Abs(Point.Y - Center.Y) <= Edges.Y * 0.5
+		&& FMath::Abs(Point.Z - Center.Z) <= Edges.Z * 0.5;
+}
+
+} // anonymous namespace
+
+FMockSpatialOSRuntime::FMockSpatialOSRuntime()
+	: NextEntityId(1)
+	, NextCommandRequestId(1)
+	, bViewsDirty(false)
+{
+}
+
+FMockSpatialOSRuntime::~FMockSpatialOSRuntime()
+{
+	checkf(Workers.Num() == 0, TEXT("All mock worker connections must be destroyed before the mock runtime"));
+
+	for (auto& EntityPair : Entities)
+	{
+		for (auto& ComponentPair : EntityPair.Value.Components)
+		{
+			Schema_DestroyComponentData(ComponentPair.Value);
+		}
+	}
+}
+
+TUniquePtr<FMockSpatialOSWorkerConnection> FMockSpatialOSRuntime::ConnectWorker(const FString& WorkerId, const WorkerAttributeSet& Attributes)
+{
+	TUniquePtr<FMockSpatialOSWorkerConnection> Worker(new FMockSpatialOSWorkerConnection(*this, WorkerId, Attributes));
+	Workers.Add(Worker.Get());
+	bViewsDirty = true;
+
+	UE_LOG(LogMockSpatialOSRuntime, Log, TEXT("Worker %s connected to the mock runtime"), *WorkerId);
+	return Worker;
+}
+
+void FMockSpatialOSRuntime::DisconnectWorker(FMockSpatialOSWorkerConnection* Worker)
+{
+	Workers.Remove(Worker);
+
+	for (auto It = PendingCommands.CreateIterator(); It; ++It)
+	{
+		const FPendingCommand& Command = It.Value();
+		if (Command.Target == Worker && Command.Caller != Worker)
+		{
+			Command.Caller->QueueCommandResponse(Command.CallerRequestId, Command.EntityId, WORKER_STATUS_CODE_TIMEOUT,
+				TEXT("The worker handling the command disconnected"), Command.ComponentId, Command.CommandIndex, nullptr);
+		}
+
+		if (Command.Target == Worker || Command.Caller == Worker)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Authority is reassigned on the next refresh, but must not point at the worker in the meantime.
+	for (auto& EntityPair : Entities)
+	{
+		for (auto It = EntityPair.Value.Authority.CreateIterator(); It; ++It)
+		{
+			if (It.Value() == Worker)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+	bViewsDirty = true;
+
+	UE_LOG(LogMockSpatialOSRuntime, Log, TEXT("Worker %s disconnected from the mock runtime"), *Worker->GetWorkerId());
+}
+
+Worker_EntityId FMockSpatialOSRuntime::CreateEntity(TArray<FWorkerComponentData>&& Components)
+{
+	const Worker_EntityId EntityId = NextEntityId;
+	AddEntity(EntityId, Components);
+	return EntityId;
+}
+
+Schema_ComponentData* FMockSpatialOSRuntime::GetComponentData(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const
+{
+	const FMockEntity* Entity = Entities.Find(EntityId);
+	return Entity != nullptr ? Entity->Components.FindRef(ComponentId) : nullptr;
+}
+
+const FMockSpatialOSWorkerConnection* FMockSpatialOSRuntime::GetAuthoritativeWorker(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const
+{
+	const FMockEntity* Entity = Entities.Find(EntityId);
+	return Entity != nullptr ? Entity->Authority.FindRef(ComponentId) : nullptr;
+}
+
+bool FMockSpatialOSRuntime::AddEntity(Worker_EntityId EntityId, TArray<FWorkerComponentData>& Components)
+{
+	if (Entities.Contains(EntityId))
+	{
+		for (FWorkerComponentData& Data : Components)
+		{
+			Schema_DestroyComponentData(Data.schema_type);
+		}
+		return false;
+	}
+
+	FMockEntity& Entity = Entities.Add(EntityId);
+	for (FWorkerComponentData& Data : Components)
+	{
+		if (Entity.Components.Contains(Data.component_id))
+		{
+			UE_LOG(LogMockSpatialOSRuntime, Warning, TEXT("Entity %lld was created with component %u more than once"), EntityId, Data.component_id);
+			Schema_DestroyComponentData(Data.schema_type);
+			continue;
+		}
+
+		Entity.Components.Add(Data.component_id, Data.schema_type);
+		OnComponentChanged(Entity, Data.component_id);
+	}
+
+	NextEntityId = FMath::Max(NextEntityId, EntityId + 1);
+	bViewsDirty = true;
+	return true;
+}
+
+bool FMockSpatialOSRuntime::DeleteEntity(Worker_EntityId EntityId)
+{
+	FMockEntity* Entity = Entities.Find(EntityId);
+	if (Entity == nullptr)
+	{
+		return false;
+	}
+
+	for (auto& ComponentPair : Entity->Components)
+	{
+		Schema_DestroyComponentData(ComponentPair.Value);
+	}
+	Entities.Remove(EntityId);
+	bViewsDirty = true;
+	return true;
+}
+
+void FMockSpatialOSRuntime::AddComponent(FMockSpatialOSWorkerConnection* Sender, Worker_EntityId EntityId, const Worker_ComponentData& Data)
+{
+	// As in SpatialOS, adding and removing components requires authority over the EntityAcl.
+	FMockEntity* Entity = Entities.Find(EntityId);
+	if (Entity == nullptr || Entity->Authority.FindRef(SpatialConstants::ENTITY_ACL_COMPONENT_ID) != Sender || Entity->Components.Contains(Data.component_id))
+	{
+		UE_LOG(LogMockSpatialOSRuntime, Warning, TEXT("Worker %s failed to add component %u to entity %lld"), *Sender->GetWorkerId(), Data.component_id, EntityId);
+		Schema_DestroyComponentData(Data.schema_type);
+		return;
+	}
+
+	Entity->Components.Add(Data.component_id, Data.schema_type);
+	OnComponentChanged(*Entity, Data.component_id);
+	bViewsDirty = true;
+}
+
+void FMockSpatialOSRuntime::RemoveComponent(FMockSpatialOSWorkerConnection* Sender, Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+{
+	FMockEntity* Entity = Entities.Find(EntityId);
+	if (Entity == nullptr || Entity->Authority.FindRef(SpatialConstants::ENTITY_ACL_COMPONENT_ID) != Sender || !Entity->Components.Contains(ComponentId))
+	{
+		UE_LOG(LogMockSpatialOSRuntime, Warning, TEXT("Worker %s failed to remove component %u from entity %lld"), *Sender->GetWorkerId(), ComponentId, EntityId);
+		return;
+	}
+
+	Schema_DestroyComponentData(Entity->Components.FindAndRemoveChecked(ComponentId));
+	OnComponentChanged(*Entity, ComponentId);
+	bViewsDirty = true;
+}
+
+void FMockSpatialOSRuntime::ApplyComponentUpdate(FMockSpatialOSWorkerConnection* Sender, Worker_EntityId EntityId, const Worker_ComponentUpdate& Update)
+{
+	FMockEntity* Entity = Entities.Find(EntityId);
+	Schema_ComponentData* Data = Entity != nullptr ? Entity->Components.FindRef(Update.component_id) : nullptr;
+	if (Data == nullptr || Entity->Authority.FindRef(Update.component_id) != Sender)
+	{
+		// The runtime drops updates from workers that are not authoritative, which is expected around authority changes.
+		UE_LOG(LogMockSpatialOSRuntime, Verbose, TEXT("Dropped update to component %u on entity %lld from non-authoritative worker %s"), Update.component_id, EntityId, *Sender->GetWorkerId());
+		Schema_DestroyComponentUpdate(Update.schema_type);
+		return;
+	}
+
+	if (Schema_ApplyComponentUpdateToData(Update.schema_type, Data) == 0)
+	{
+		UE_LOG(LogMockSpatialOSRuntime, Warning, TEXT("Failed to apply update to component %u on entity %lld"), Update.component_id, EntityId);
+	}
+	OnComponentChanged(*Entity, Update.component_id);
+
+	TArray<FMockSpatialOSWorkerConnection*, TInlineAllocator<8>> Recipients;
+	for (FMockSpatialOSWorkerConnection* Worker : Workers)
+	{
+		const FMockSpatialOSWorkerConnection::FEntityView* EntityView = Worker->View.Find(EntityId);
+		if (Worker != Sender && EntityView != nullptr && EntityView->Components.Contains(Update.component_id))
+		{
+			Recipients.Add(Worker);
+		}
+	}
+
+	// The last recipient takes the update itself, every other one gets a copy.
+	for (int32 i = 0; i < Recipients.Num(); ++i)
+	{
+		const bool bLastRecipient = i == Recipients.Num() - 1;
+		Recipients[i]->QueueComponentUpdate(EntityId, Update.component_id, bLastRecipient ? Update.schema_type : Schema_CopyComponentUpdate(Update.schema_type));
+	}
+
+	if (Recipients.Num() == 0)
+	{
+		Schema_DestroyComponentUpdate(Update.schema_type);
+	}
+}
+
+void FMockSpatialOSRuntime::RouteCommandRequest(FMockSpatialOSWorkerConnection* Caller, Worker_RequestId CallerRequestId, Worker_EntityId EntityId, const Worker_CommandRequest& Request)
+{
+	const FMockEntity* Entity = Entities.Find(EntityId);
+	FMockSpatialOSWorkerConnection* Target = Entity != nullptr ? Entity->Authority.FindRef(Request.component_id) : nullptr;
+	if (Target == nullptr)
+	{
+		Schema_DestroyCommandRequest(Request.schema_type);
+		Caller->QueueCommandResponse(CallerRequestId, EntityId, Entity != nullptr ? WORKER_STATUS_CODE_TIMEOUT : WORKER_STATUS_CODE_NOT_FOUND,
+			Entity != nullptr ? TEXT("No worker is authoritative over the command component") : TEXT("Entity not found"),
+			Request.component_id, Request.command_index, nullptr);
+		return;
+	}
+
+	const Worker_RequestId RequestId = NextCommandRequestId++;
+	PendingCommands.Add(RequestId, FPendingCommand{ Caller, CallerRequestId, Target, EntityId, Request.component_id, Request.command_index });
+	Target->QueueCommandRequest(RequestId, EntityId, *Caller, Request);
+}
+
+void FMockSpatialOSRuntime::RouteCommandResponse(FMockSpatialOSWorkerConnection* Responder, Worker_RequestId RequestId, Schema_CommandResponse* Response, const FString& FailureMessage)
+{
+	const FPendingCommand* Command = PendingCommands.Find(RequestId);
+	if (Command == nullptr || Command->Target != Responder)
+	{
+		UE_LOG(LogMockSpatialOSRuntime, Warning, TEXT("Worker %s responded to unknown command request %lld"), *Responder->GetWorkerId(), RequestId);
+		if (Response != nullptr)
+		{
+			Schema_DestroyCommandResponse(Response);
+		}
+		return;
+	}
+
+	Command->Caller->QueueCommandResponse(Command->CallerRequestId, Command->EntityId,
+		Response != nullptr ? WORKER_STATUS_CODE_SUCCESS : WORKER_STATUS_CODE_APPLICATION_ERROR, FailureMessage,
+		Command->ComponentId, Command->CommandIndex, Response);
+	PendingCommands.Remove(RequestId);
+}
+
+void FMockSpatialOSRuntime::AnswerEntityQuery(FMockSpatialOSWorkerConnection* Caller, Worker_RequestId RequestId, const Worker_EntityQuery& Query)
+{
+	TArray<Worker_EntityId> Results;
+	for (const auto& EntityPair : Entities)
+	{
+		if (MatchesConstraint(Query.constraint, EntityPair.Key, EntityPair.Value))
+		{
+			Results.Add(EntityPair.Key);
+		}
+	}
+	Results.Sort();
+
+	FMockSpatialOSWorkerConnection::FOpBatch& Batch = Caller->QueuedOps;
+	Worker_EntityQueryResponseOp& Response = Caller->QueueEntityQueryResponse(RequestId);
+	Response.status_code = WORKER_STATUS_CODE_SUCCESS;
+	Response.result_count = Results.Num();
+
+	if (Query.result_type != WORKER_RESULT_TYPE_SNAPSHOT)
+	{
+		return;
+	}
+
+	TArray<Worker_Entity>& ResultEntities = Batch.Entities.AddDefaulted_GetRef();
+	ResultEntities.SetNumZeroed(Results.Num());
+	for (int32 i = 0; i < Results.Num(); ++i)
+	{
+		TArray<Worker_ComponentData>& Components = Batch.EntityComponents.AddDefaulted_GetRef();
+		for (const auto& ComponentPair : Entities[Results[i]].Components)
+		{
+			// A null list of result components means every component is included.
+			if (Query.snapshot_result_type_component_ids != nullptr
+				&& !MakeArrayView(Query.snapshot_result_type_component_ids, Query.snapshot_result_type_component_id_count).Contains(ComponentPair.Key))
+			{
+				continue;
+			}
+
+			Schema_ComponentData* Copy = Schema_CopyComponentData(ComponentPair.Value);
+			Batch.ComponentData.Add(Copy);
+			Components.Add(MakeComponentData(ComponentPair.Key, Copy));
+		}
+
+		ResultEntities[i].entity_id = Results[i];
+		ResultEntities[i].component_count = Components.Num();
+		ResultEntities[i].components = Components.GetData();
+	}
+	Response.results = ResultEntities.GetData();
+}
+
+void FMockSpatialOSRuntime::OnComponentChanged(FMockEntity& Entity, Worker_ComponentId ComponentId)
+{
+	Schema_ComponentData* Data = Entity.Components.FindRef(ComponentId);
+
+	switch (ComponentId)
+	{
+	case SpatialConstants::ENTITY_ACL_COMPONENT_ID:
+		Entity.Acl.Reset();
+		if (Data != nullptr)
+		{
+			Entity.Acl.Emplace(MakeComponentData(ComponentId, Data));
+		}
+		break;
+	case SpatialConstants::POSITION_COMPONENT_ID:
+		Entity.Coords.Reset();
+		if (Data != nullptr)
+		{
+			Entity.Coords = Position(MakeComponentData(ComponentId, Data)).Coords;
+		}
+		break;
+	case SpatialConstants::INTEREST_COMPONENT_ID:
+		Entity.EntityInterest.Reset();
+		if (Data != nullptr)
+		{
+			Entity.EntityInterest.Emplace(MakeComponentData(ComponentId, Data));
+		}
+		break;
+	default:
+		return;
+	}
+
+	// Any of these can change authority or interest. Position updates are the common case, and refresh every view.
+	bViewsDirty = true;
+}
+
+void FMockSpatialOSRuntime::RefreshViewsIfNeeded()
+{
+	if (!bViewsDirty)
+	{
+		return;
+	}
+	bViewsDirty = false;
+
+	UpdateAuthority();
+	for (FMockSpatialOSWorkerConnection* Worker : Workers)
+	{
+		RefreshView(*Worker);
+	}
+}
+
+void FMockSpatialOSRuntime::UpdateAuthority()
+{
+	for (auto& EntityPair : Entities)
+	{
+		FMockEntity& Entity = EntityPair.Value;
+		Entity.Authority.Reset();
+
+		if (!Entity.Acl.IsSet())
+		{
+			continue;
+		}
+
+		for (const auto& WriteAclPair : Entity.Acl->ComponentWriteAcl)
+		{
+			if (!Entity.Components.Contains(WriteAclPair.Key))
+			{
+				continue;
+			}
+
+			for (FMockSpatialOSWorkerConnection* Worker : Workers)
+			{
+				if (SatisfiesRequirementSet(WriteAclPair.Value, Worker->GetWorkerAttributes()))
+				{
+					Entity.Authority.Add(WriteAclPair.Key, Worker);
+					break;
+				}
+			}
+		}
+	}
+}
+
+void FMockSpatialOSRuntime::RefreshView(FMockSpatialOSWorkerConnection& Worker)
+{
+	struct FActiveQuery
+	{
+		const QueryConstraint* Constraint;
+		TOptional<Coordinates> Origin;
+	};
+
+	// Entities the worker is authoritative over are always in view, and bring in the interest of their authoritative components.
+	TSet<Worker_EntityId> Visible;
+	TArray<FActiveQuery> Queries;
+	for (const auto& EntityPair : Entities)
+	{
+		const FMockEntity& Entity = EntityPair.Value;
+		if (!IsAuthoritativeOverAny(Entity, Worker) || !SatisfiesRequirementSet(Entity.Acl->ReadAcl, Worker.GetWorkerAttributes()))
+		{
+			continue;
+		}
+
+		Visible.Add(EntityPair.Key);
+		if (Entity.EntityInterest.IsSet())
+		{
+			for (const auto& InterestPair : Entity.EntityInterest->ComponentInterestMap)
+			{
+				if (Entity.Authority.FindRef(InterestPair.Key) == &Worker)
+				{
+					for (const Query& InterestQuery : InterestPair.Value.Queries)
+					{
+						Queries.Add(FActiveQuery{ &InterestQuery.Constraint, Entity.Coords });
+					}
+				}
+			}
+		}
+	}
+
+	if (Queries.Num() > 0)
+	{
+		for (const auto& EntityPair : Entities)
+		{
+			const FMockEntity& Entity = EntityPair.Value;
+			if (Visible.Contains(EntityPair.Key) || !Entity.Acl.IsSet() || !SatisfiesRequirementSet(Entity.Acl->ReadAcl, Worker.GetWorkerAttributes()))
+			{
+				continue;
+			}
+
+			for (const FActiveQuery& ActiveQuery : Queries)
+			{
+				if (MatchesQueryConstraint(*ActiveQuery.Constraint, EntityPair.Key, Entity, ActiveQuery.Origin))
+				{
+					Visible.Add(EntityPair.Key);
+					break;
+				}
+			}
+		}
+	}
+
+	for (auto It = Worker.View.CreateIterator(); It; ++It)
+	{
+		if (Visible.Contains(It.Key()))
+		{
+			continue;
+		}
+
+		const Worker_EntityId EntityId = It.Key();
+		for (Worker_ComponentId ComponentId : It.Value().Authority)
+		{
+			Worker.QueueAuthorityChange(EntityId, ComponentId, false);
+		}
+		for (Worker_ComponentId ComponentId : It.Value().Components)
+		{
+			Worker.QueueRemoveComponent(EntityId, ComponentId);
+		}
+		Worker.QueueRemoveEntity(EntityId);
+		It.RemoveCurrent();
+	}
+
+	// Entities entering the view are added in a critical section, which is how the receiver expects to see new entities.
+	bool bInCriticalSection = false;
+	for (Worker_EntityId EntityId : Visible)
+	{
+		const FMockEntity& Entity = Entities[EntityId];
+		FMockSpatialOSWorkerConnection::FEntityView* EntityView = Worker.View.Find(EntityId);
+		if (EntityView == nullptr)
+		{
+			if (!bInCriticalSection)
+			{
+				Worker.QueueCriticalSection(true);
+				bInCriticalSection = true;
+			}
+			Worker.QueueAddEntity(EntityId);
+			EntityView = &Worker.View.Add(EntityId);
+		}
+
+		for (auto It = EntityView->Components.CreateIterator(); It; ++It)
+		{
+			if (!Entity.Components.Contains(*It))
+			{
+				if (EntityView->Authority.Remove(*It) > 0)
+				{
+					Worker.QueueAuthorityChange(EntityId, *It, false);
+				}
+				Worker.QueueRemoveComponent(EntityId, *It);
+				It.RemoveCurrent();
+			}
+		}
+
+		for (const auto& ComponentPair : Entity.Components)
+		{
+			if (!EntityView->Components.Contains(ComponentPair.Key))
+			{
+				Worker.QueueAddComponent(EntityId, ComponentPair.Key, ComponentPair.Value);
+				EntityView->Components.Add(ComponentPair.Key);
+			}
+		}
+
+		for (auto It = EntityView->Authority.CreateIterator(); It; ++It)
+		{
+			if (Entity.Authority.FindRef(*It) != &Worker)
+			{
+				Worker.QueueAuthorityChange(EntityId, *It, false);
+				It.RemoveCurrent();
+			}
+		}
+
+		for (const auto& AuthorityPair : Entity.Authority)
+		{
+			if (AuthorityPair.Value == &Worker && !EntityView->Authority.Contains(AuthorityPair.Key))
+			{
+				Worker.QueueAuthorityChange(EntityId, AuthorityPair.Key, true);
+				EntityView->Authority.Add(AuthorityPair.Key);
+			}
+		}
+	}
+
+	if (bInCriticalSection)
+	{
+		Worker.QueueCriticalSection(false);
+	}
+}
+
+bool FMockSpatialOSRuntime::IsAuthoritativeOverAny(const FMockEntity& Entity, const FMockSpatialOSWorkerConnection& Worker) const
+{
+	for (const auto& AuthorityPair : Entity.Authority)
+	{
+		if (AuthorityPair.Value == &Worker)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FMockSpatialOSRuntime::MatchesConstraint(const Worker_Constraint& Constraint, Worker_EntityId EntityId, const FMockEntity& Entity) const
+{
+	switch (Constraint.constraint_type)
+	{
+	case WORKER_CONSTRAINT_TYPE_ENTITY_ID:
+		return EntityId == Constraint.constraint.entity_id_constraint.entity_id;
+	case WORKER_CONSTRAINT_TYPE_COMPONENT:
+		return Entity.Components.Contains(Constraint.constraint.component_constraint.component_id);
+	case WORKER_CONSTRAINT_TYPE_SPHERE:
+	{
+		const Worker_SphereConstraint& Sphere = Constraint.constraint.sphere_constraint;
+		return Entity.Coords.IsSet() && IsWithinSphere(Entity.Coords.GetValue(), Coordinates{ Sphere.x, Sphere.y, Sphere.z }, Sphere.radius);
+	}
+	case WORKER_CONSTRAINT_TYPE_AND:
+		for (uint32 i = 0; i < Constraint.constraint.and_constraint.constraint_count; ++i)
+		{
+			if (!MatchesConstraint(Constraint.constraint.and_constraint.constraints[i], EntityId, Entity))
+			{
+				return false;
+			}
+		}
+		return true;
+	case WORKER_CONSTRAINT_TYPE_OR:
+		for (uint32 i = 0; i < Constraint.constraint.or_constraint.constraint_count; ++i)
+		{
+			if (MatchesConstraint(Constraint.constraint.or_constraint.constraints[i], EntityId, Entity))
+			{
+				return true;
+			}
+		}
+		return false;
+	case WORKER_CONSTRAINT_TYPE_NOT:
+		return !MatchesConstraint(*Constraint.constraint.not_constraint.constraint, EntityId, Entity);
+	default:
+		return false;
+	}
+}
+
+bool FMockSpatialOSRuntime::MatchesQueryConstraint(const QueryConstraint& Constraint, Worker_EntityId EntityId, const FMockEntity& Entity, const TOptional<Coordinates>& Origin)
+{
+	const bool bHasPosition = Entity.Coords.IsSet();
+	const bool bHasOrigin = Origin.IsSet();
+
+	if (Constraint.SphereConstraint.IsSet())
+	{
+		return bHasPosition && IsWithinSphere(Entity.Coords.GetValue(), Constraint.SphereConstraint->Center, Constraint.SphereConstraint->Radius);
+	}
+	if (Constraint.CylinderConstraint.IsSet())
+	{
+		return bHasPosition && IsWithinCylinder(Entity.Coords.GetValue(), Constraint.CylinderConstraint->Center, Constraint.CylinderConstraint->Radius);
+	}
+	if (Constraint.BoxConstraint.IsSet())
+	{
+		return bHasPosition && IsWithinBox(Entity.Coords.GetValue(), Constraint.BoxConstraint->Center, Constraint.BoxConstraint->EdgeLength);
+	}
+	if (Constraint.RelativeSphereConstraint.IsSet())
+	{
+		return bHasPosition && bHasOrigin && IsWithinSphere(Entity.Coords.GetValue(), Origin.GetValue(), Constraint.RelativeSphereConstraint->Radius);
+	}
+	if (Constraint.RelativeCylinderConstraint.IsSet())
+	{
+		return bHasPosition && bHasOrigin && IsWithinCylinder(Entity.Coords.GetValue(), Origin.GetValue(), Constraint.RelativeCylinderConstraint->Radius);
+	}
+	if (Constraint.RelativeBoxConstraint.IsSet())
+	{
+		return bHasPosition && bHasOrigin && IsWithinBox(Entity.Coords.GetValue(), Origin.GetValue(), Constraint.RelativeBoxConstraint->EdgeLength);
+	}
+	if (Constraint.EntityIdConstraint.IsSet())
+	{
+		return *Constraint.EntityIdConstraint == EntityId;
+	}
+	if (Constraint.ComponentConstraint.IsSet())
+	{
+		return Entity.Components.Contains(*Constraint.ComponentConstraint);
+	}
+	if (Constraint.AndConstraint.Num() > 0)
+	{
+		for (const QueryConstraint& Inner : Constraint.AndConstraint)
+		{
+			if (!MatchesQueryConstraint(Inner, EntityId, Entity, Origin))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	for (const QueryConstraint& Inner : Constraint.OrConstraint)
+	{
+		if (MatchesQueryConstraint(Inner, EntityId, Entity, Origin))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FMockSpatialOSRuntime::SatisfiesRequirementSet(const WorkerRequirementSet& RequirementSet, const WorkerAttributeSet& Attributes)
+{
+	for (const WorkerAttributeSet& RequiredAttributes : RequirementSet)
+	{
+		bool bSatisfied = true;
+		for (const FString& RequiredAttribute : RequiredAttributes)
+		{
+			if (!Attributes.Contains(RequiredAttribute))
+			{
+				bSatisfied = false;
+				break;
+			}
+		}
+
+		if (bSatisfied)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FMockSpatialOSWorkerConnection::FOpBatch::Reset()
+{
+	for (Schema_ComponentData* Data : ComponentData)
+	{
+		Schema_DestroyComponentData(Data);
+	}
+	for (Schema_ComponentUpdate* Update : ComponentUpdates)
+	{
+		Schema_DestroyComponentUpdate(Update);
+	}
+	for (Schema_CommandRequest* Request : CommandRequests)
+	{
+		Schema_DestroyCommandRequest(Request);
+	}
+	for (Schema_CommandResponse* Response : CommandResponses)
+	{
+		Schema_DestroyCommandResponse(Response);
+	}
+
+	Ops.Reset();
+	Strings.Reset();
+	AttributeLists.Reset();
+	Entities.Reset();
+	EntityComponents.Reset();
+	ComponentData.Reset();
+	ComponentUpdates.Reset();
+	CommandRequests.Reset();
+	CommandResponses.Reset();
+}
+
+FMockSpatialOSWorkerConnection::FMockSpatialOSWorkerConnection(FMockSpatialOSRuntime& InRuntime, const FString& InWorkerId, const WorkerAttributeSet& InAttributes)
+	: Runtime(&InRuntime)
+	, WorkerId(InWorkerId)
+	, Attributes(InAttributes)
+	, NextRequestId(1)
+{
+	Attributes.AddUnique(FString::Format(TEXT("workerId:{0}"), { *WorkerId }));
+}
+
+FMockSpatialOSWorkerConnection::~FMockSpatialOSWorkerConnection()
+{
+	Runtime->DisconnectWorker(this);
+	QueuedOps.Reset();
+	for (TUniquePtr<FDeliveredOpList>& Delivered : DeliveredOpLists)
+	{
+		Delivered->Batch.Reset();
+	}
+}
+
+bool FMockSpatialOSWorkerConnection::HasAuthority(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const
+{
+	const FEntityView* EntityView = View.Find(EntityId);
+	return EntityView != nullptr && EntityView->Authority.Contains(ComponentId);
+}
+
+TArray<Worker_OpList*> FMockSpatialOSWorkerConnection::GetOpList()
+{
+	Runtime->RefreshViewsIfNeeded();
+
+	if (QueuedOps.Ops.Num() == 0)
+	{
+		return {};
+	}
+
+	TUniquePtr<FDeliveredOpList>& Delivered = DeliveredOpLists.Add_GetRef(MakeUnique<FDeliveredOpList>());
+	Swap(Delivered->Batch, QueuedOps);
+
+	Delivered->OpList.ops = Delivered->Batch.Ops.GetData();
+	Delivered->OpList.op_count = Delivered->Batch.Ops.Num();
+	return { &Delivered->OpList };
+}
+
+void FMockSpatialOSWorkerConnection::DestroyOpList(Worker_OpList* OpList)
+{
+	const int32 Index = DeliveredOpLists.IndexOfByPredicate([OpList](const TUniquePtr<FDeliveredOpList>& Delivered)
+	{
+		return &Delivered->OpList == OpList;
+	});
+
+	if (!ensureMsgf(Index != INDEX_NONE, TEXT("Op list was not handed out by worker %s"), *WorkerId))
+	{
+		return;
+	}
+
+	DeliveredOpLists[Index]->Batch.Reset();
+	DeliveredOpLists.RemoveAtSwap(Index);
+}
+
+Worker_RequestId FMockSpatialOSWorkerConnection::SendReserveEntityIdsRequest(uint32_t NumOfEntities)
+{
+	const Worker_RequestId RequestId = NextRequestId++;
+	QueueReserveEntityIdsResponse(RequestId, Runtime->NextEntityId, NumOfEntities);
+	Runtime->NextEntityId += NumOfEntities;
+	return RequestId;
+}
+
+Worker_RequestId FMockSpatialOSWorkerConnection::SendCreateEntityRequest(TArray<FWorkerComponentData>&& Components, const Worker_EntityId* EntityId)
+{
+	const Worker_RequestId RequestId = NextRequestId++;
+	const Worker_EntityId NewEntityId = EntityId != nullptr ? *EntityId : Runtime->NextEntityId;
+	if (Runtime->AddEntity(NewEntityId, Components))
+	{
+		QueueCreateEntityResponse(RequestId, WORKER_STATUS_CODE_SUCCESS, FString(), NewEntityId);
+	}
+	else
+	{
+		QueueCreateEntityResponse(RequestId, WORKER_STATUS_CODE_APPLICATION_ERROR, TEXT("Entity id is already in use"), NewEntityId);
+	}
+	return RequestId;
+}
+
+Worker_RequestId FMockSpatialOSWorkerConnection::SendDeleteEntityRequest(Worker_EntityId EntityId)
+{
+	const Worker_RequestId RequestId = NextRequestId++;
+	if (Runtime->DeleteEntity(EntityId))
+	{
+		QueueDeleteEntityResponse(RequestId, WORKER_STATUS_CODE_SUCCESS, FString(), EntityId);
+	}
+	else
+	{
+		QueueDeleteEntityResponse(RequestId, WORKER_STATUS_CODE_APPLICATION_ERROR, TEXT("Entity not found"), EntityId);
+	}
+	return RequestId;
+}
+
+void FMockSpatialOSWorkerConnection::SendAddComponent(Worker_EntityId EntityId, FWorkerComponentData* ComponentData)
+{
+	Runtime->AddComponent(this, EntityId, *ComponentData);
+}
+
+void FMockSpatialOSWorkerConnection::SendRemoveComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+{
+	Runtime->RemoveComponent(this, EntityId, ComponentId);
+}
+
+void FMockSpatialOSWorkerConnection::SendComponentUpdate(Worker_EntityId EntityId, const FWorkerComponentUpdate* ComponentUpdate)
+{
+	Runtime->ApplyComponentUpdate(this, EntityId, *ComponentUpdate);
+}
+
+Worker_RequestId FMockSpatialOSWorkerConnection::SendCommandRequest(Worker_EntityId EntityId, const Worker_CommandRequest* Request, uint32_t CommandId)
+{
+	const Worker_RequestId RequestId = NextRequestId++;
+	Runtime->RouteCommandRequest(this, RequestId, EntityId, *Request);
+	return RequestId;
+}
+
+void FMockSpatialOSWorkerConnection::SendCommandResponse(Worker_RequestId RequestId, const Worker_CommandResponse* Response)
+{
+	Runtime->RouteCommandResponse(this, RequestId, Response->schema_type, FString());
+}
+
+void FMockSpatialOSWorkerConnection::SendCommandFailure(Worker_RequestId RequestId, const FString& Message)
+{
+	Runtime->RouteCommandResponse(this, RequestId, nullptr, Message);
+}
+
+void FMockSpatialOSWorkerConnection::SendLogMessage(uint8_t Level, const FName& LoggerName, const TCHAR* Message)
+{
+}
+
+void FMockSpatialOSWorkerConnection::SendComponentInterest(Worker_EntityId EntityId, TArray<Worker_InterestOverride>&& ComponentInterest)
+{
+}
+
+Worker_RequestId FMockSpatialOSWorkerConnection::SendEntityQueryRequest(const Worker_EntityQuery* EntityQuery)
+{
+	const Worker_RequestId RequestId = NextRequestId++;
+	Runtime->AnswerEntityQuery(this, RequestId, *EntityQuery);
+	return RequestId;
+}
+
+void FMockSpatialOSWorkerConnection::SendMetrics(const SpatialMetrics& Metrics)
+{
+}
+
+Worker_Op& FMockSpatialOSWorkerConnection::QueueOp(uint8 OpType)
+{
+	Worker_Op& Op = QueuedOps.Ops.AddZeroed_GetRef();
+	Op.op_type = OpType;
+	return Op;
+}
+
+const char* FMockSpatialOSWorkerConnection::StoreString(const FString& String)
+{
+	FTCHARToUTF8 Converter(*String);
+	TArray<ANSICHAR>& Stored = QueuedOps.Strings.AddDefaulted_GetRef();
+	Stored.Reserve(Converter.Length() + 1);
+	Stored.Append(Converter.Get(), Converter.Length());
+	Stored.Add('\0');
+	return Stored.GetData();
+}
+
+void FMockSpatialOSWorkerConnection::QueueCriticalSection(bool bInCriticalSection)
+{
+	QueueOp(WORKER_OP_TYPE_CRITICAL_SECTION).op.critical_section.in_critical_section = bInCriticalSection ? 1 : 0;
+}
+
+void FMockSpatialOSWorkerConnection::QueueAddEntity(Worker_EntityId EntityId)
+{
+	QueueOp(WORKER_OP_TYPE_ADD_ENTITY).op.add_entity.entity_id = EntityId;
+}
+
+void FMockSpatialOSWorkerConnection::QueueRemoveEntity(Worker_EntityId EntityId)
+{
+	QueueOp(WORKER_OP_TYPE_REMOVE_ENTITY).op.remove_entity.entity_id = EntityId;
+}
+
+void FMockSpatialOSWorkerConnection::QueueAddComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId, const Schema_ComponentData* Data)
+{
+	Schema_ComponentData* Copy = Schema_CopyComponentData(Data);
+	QueuedOps.ComponentData.Add(Copy);
+
+	Worker_AddComponentOp& Op = QueueOp(WORKER_OP_TYPE_ADD_COMPONENT).op.add_component;
+	Op.entity_id = EntityId;
+	Op.data = MakeComponentData(ComponentId, Copy);
+}
+
+void FMockSpatialOSWorkerConnection::QueueRemoveComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+{
+	Worker_RemoveComponentOp& Op = QueueOp(WORKER_OP_TYPE_REMOVE_COMPONENT).op.remove_component;
+	Op.entity_id = EntityId;
+	Op.component_id = ComponentId;
+}
+
+void FMockSpatialOSWorkerConnection::QueueAuthorityChange(Worker_EntityId EntityId, Worker_ComponentId ComponentId, bool bAuthoritative)
+{
+	Worker_AuthorityChangeOp& Op = QueueOp(WORKER_OP_TYPE_AUTHORITY_CHANGE).op.authority_change;
+	Op.entity_id = EntityId;
+	Op.component_id = ComponentId;
+	Op.authority = bAuthoritative ? WORKER_AUTHORITY_AUTHORITATIVE : WORKER_AUTHORITY_NOT_AUTHORITATIVE;
+}
+
+void FMockSpatialOSWorkerConnection::QueueComponentUpdate(Worker_EntityId EntityId, Worker_ComponentId ComponentId, Schema_ComponentUpdate* Update)
+{
+	QueuedOps.ComponentUpdates.Add(Update);
+
+	Worker_ComponentUpdateOp& Op = QueueOp(WORKER_OP_TYPE_COMPONENT_UPDATE).op.component_update;
+	Op.entity_id = EntityId;
+	Op.update.component_id = ComponentId;
+	Op.update.schema_type = Update;
+}
+
+void FMockSpatialOSWorkerConnection::QueueReserveEntityIdsResponse(Worker_RequestId RequestId, Worker_EntityId FirstEntityId, uint32 NumberOfEntityIds)
+{
+	const char* Message = StoreString(FString());
+
+	Worker_ReserveEntityIdsResponseOp& Op = QueueOp(WORKER_OP_TYPE_RESERVE_ENTITY_IDS_RESPONSE).op.reserve_entity_ids_response;
+	Op.request_id = RequestId;
+	Op.status_code = WORKER_STATUS_CODE_SUCCESS;
+	Op.message = Message;
+	Op.first_entity_id = FirstEntityId;
+	Op.number_of_entity_ids = NumberOfEntityIds;
+}
+
+void FMockSpatialOSWorkerConnection::QueueCreateEntityResponse(Worker_RequestId RequestId, uint8 StatusCode, const FString& Message, Worker_EntityId EntityId)
+{
+	const char* StoredMessage = StoreString(Message);
+
+	Worker_CreateEntityResponseOp& Op = QueueOp(WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE).op.create_entity_response;
+	Op.request_id = RequestId;
+	Op.status_code = StatusCode;
+	Op.message = StoredMessage;
+	Op.entity_id = EntityId;
+}
+
+void FMockSpatialOSWorkerConnection::QueueDeleteEntityResponse(Worker_RequestId RequestId, uint8 StatusCode, const FString& Message, Worker_EntityId EntityId)
+{
+	const char* StoredMessage = StoreString(Message);
+
+	Worker_DeleteEntityResponseOp& Op = QueueOp(WORKER_OP_TYPE_DELETE_ENTITY_RESPONSE).op.delete_entity_response;
+	Op.request_id = RequestId;
+	Op.entity_id = EntityId;
+	Op.status_code = StatusCode;
+	Op.message = StoredMessage;
+}
+
+Worker_EntityQueryResponseOp& FMockSpatialOSWorkerConnection::QueueEntityQueryResponse(Worker_RequestId RequestId)
+{
+	const char* Message = StoreString(FString());
+
+	Worker_EntityQueryResponseOp& Op = QueueOp(WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE).op.entity_query_response;
+	Op.request_id = RequestId;
+	Op.message = Message;
+	return Op;
+}
+
+void FMockSpatialOSWorkerConnection::QueueCommandRequest(Worker_RequestId RequestId, Worker_EntityId EntityId, const FMockSpatialOSWorkerConnection& Caller, const Worker_CommandRequest& Request)
+{
+	const char* CallerWorkerId = StoreString(Caller.GetWorkerId());
+	TArray<const char*>& CallerAttributes = QueuedOps.AttributeLists.AddDefaulted_GetRef();
+	for (const FString& Attribute : Caller.GetWorkerAttributes())
+	{
+		CallerAttributes.Add(StoreString(Attribute));
+	}
+	QueuedOps.CommandRequests.Add(Request.schema_type);
+
+	Worker_CommandRequestOp& Op = QueueOp(WORKER_OP_TYPE_COMMAND_REQUEST).op.command_request;
+	Op.request_id = RequestId;
+	Op.entity_id = EntityId;
+	Op.timeout_millis = DefaultCommandTimeoutMillis;
+	Op.caller_worker_id = CallerWorkerId;
+	Op.caller_attribute_set.attribute_count = CallerAttributes.Num();
+	Op.caller_attribute_set.attributes = CallerAttributes.GetData();
+	Op.request = Request;
+}
+
+void FMockSpatialOSWorkerConnection::QueueCommandResponse(Worker_RequestId RequestId, Worker_EntityId EntityId, uint8 StatusCode, const FString& Message, Worker_ComponentId ComponentId, uint32 CommandIndex, Schema_CommandResponse* Response)
+{
+	const char* StoredMessage = StoreString(Message);
+	if (Response != nullptr)
+	{
+		QueuedOps.CommandResponses.Add(Response);
+	}
+
+	Worker_CommandResponseOp& Op = QueueOp(WORKER_OP_TYPE_COMMAND_RESPONSE).op.command_response;
+	Op.request_id = RequestId;
+	Op.entity_id = EntityId;
+	Op.status_code = StatusCode;
+	Op.message = StoredMessage;
+	Op.response.component_id = ComponentId;
+	Op.response.command_index = CommandIndex;
+	Op.response.schema_type = Response;
+	Op.command_id = CommandIndex;
+}
+
+} // namespace SpatialGDK
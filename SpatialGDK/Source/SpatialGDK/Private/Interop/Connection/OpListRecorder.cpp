@@ -0,0 +1,256 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/Connection/OpListRecorder.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Serialization/Archive.h"
+
+DEFINE_LOG_CATEGORY(LogSpatialOpListRecording);
+
+namespace SpatialGDK
+{
+
+FOpListRecorder::FOpListRecorder(const FString& InFilename, TUniquePtr<FArchive> InFileWriter)
+	: Filename(InFilename)
+	, FileWriter(MoveTemp(InFileWriter))
+	, StartTime(FPlatformTime::Seconds())
+	, NumRecordedFrames(0)
+{
+	uint32 Magic = OpListRecording::Magic;
+	uint32 Version = OpListRecording::Version;
+	FileWriter->Serialize(&Magic, sizeof(Magic));
+	FileWriter->Serialize(&Version, sizeof(Version));
+}
+
+FOpListRecorder::~FOpListRecorder()
+{
+	FileWriter->Close();
+	UE_LOG(LogSpatialOpListRecording, Log, TEXT("Finished recording %u frames of ops to %s"), NumRecordedFrames, *Filename);
+}
+
+TUniquePtr<FOpListRecorder> FOpListRecorder::Create(const FString& Filename)
+{
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!FileWriter.IsValid())
+	{
+		UE_LOG(LogSpatialOpListRecording, Error, TEXT("Failed to open %s for recording ops"), *Filename);
+		return nullptr;
+	}
+
+	UE_LOG(LogSpatialOpListRecording, Log, TEXT("Recording ops to %s"), *Filename);
+	return TUniquePtr<FOpListRecorder>(new FOpListRecorder(Filename, MoveTemp(FileWriter)));
+}
+
+void FOpListRecorder::RecordFrame(const TArray<Worker_OpList*>& OpLists)
+{
+	FrameBuffer.Reset();
+
+	Write<double>(FPlatformTime::Seconds() - StartTime);
+	Write<uint32>(OpLists.Num());
+	for (const Worker_OpList* OpList : OpLists)
+	{
+		Write<uint32>(OpList->op_count);
+		for (uint32 i = 0; i < OpList->op_count; ++i)
+		{
+			WriteOp(OpList->ops[i]);
+		}
+	}
+
+	uint32 FrameSize = FrameBuffer.Num();
+	FileWriter->Serialize(&FrameSize, sizeof(FrameSize));
+	FileWriter->Serialize(FrameBuffer.GetData(), FrameBuffer.Num());
+
+	NumRecordedFrames++;
+}
+
+void FOpListRecorder::WriteOp(const Worker_Op& Op)
+{
+	Write<uint8>(Op.op_type);
+
+	switch (static_cast<Worker_OpType>(Op.op_type))
+	{
+	case WORKER_OP_TYPE_DISCONNECT:
+		Write<uint8>(Op.op.disconnect.connection_status_code);
+		WriteString(Op.op.disconnect.reason);
+		break;
+	case WORKER_OP_TYPE_FLAG_UPDATE:
+		WriteString(Op.op.flag_update.name);
+		WriteString(Op.op.flag_update.value);
+		break;
+	case WORKER_OP_TYPE_LOG_MESSAGE:
+		Write<uint8>(Op.op.log_message.level);
+		WriteString(Op.op.log_message.message);
+		break;
+	case WORKER_OP_TYPE_METRICS:
+		// Metrics ops only carry runtime metrics about the worker itself, which are not part of the receive path.
+		break;
+	case WORKER_OP_TYPE_CRITICAL_SECTION:
+		Write<uint8>(Op.op.critical_section.in_critical_section);
+		break;
+	case WORKER_OP_TYPE_ADD_ENTITY:
+		Write<int64>(Op.op.add_entity.entity_id);
+		break;
+	case WORKER_OP_TYPE_REMOVE_ENTITY:
+		Write<int64>(Op.op.remove_entity.entity_id);
+		break;
+	case WORKER_OP_TYPE_RESERVE_ENTITY_IDS_RESPONSE:
+		Write<int64>(Op.op.reserve_entity_ids_response.request_id);
+		Write<uint8>(Op.op.reserve_entity_ids_response.status_code);
+		WriteString(Op.op.reserve_entity_ids_response.message);
+		Write<int64>(Op.op.reserve_entity_ids_response.first_entity_id);
+		Write<uint32>(Op.op.reserve_entity_ids_response.number_of_entity_ids);
+		break;
+	case WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE:
+		Write<int64>(Op.op.create_entity_response.request_id);
+		Write<uint8>(Op.op.create_entity_response.status_code);
+		WriteString(Op.op.create_entity_response.message);
+		Write<int64>(Op.op.create_entity_response.entity_id);
+		break;
+	case WORKER_OP_TYPE_DELETE_ENTITY_RESPONSE:
+		Write<int64>(Op.op.delete_entity_response.request_id);
+		Write<int64>(Op.op.delete_entity_response.entity_id);
+		Write<uint8>(Op.op.delete_entity_response.status_code);
+		WriteString(Op.op.delete_entity_response.message);
+		break;
+	case WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE:
+	{
+		const Worker_EntityQueryResponseOp& Response = Op.op.entity_query_response;
+		Write<int64>(Response.request_id);
+		Write<uint8>(Response.status_code);
+		WriteString(Response.message);
+		Write<uint32>(Response.result_count);
+		// Count-only queries report a result count without any results.
+		Write<uint8>(Response.results != nullptr ? 1 : 0);
+		if (Response.results != nullptr)
+		{
+			for (uint32 i = 0; i < Response.result_count; ++i)
+			{
+				const Worker_Entity& Entity = Response.results[i];
+				Write<int64>(Entity.entity_id);
+				Write<uint32>(Entity.component_count);
+				for (uint32 j = 0; j < Entity.component_count; ++j)
+				{
+					WriteComponentData(Entity.components[j]);
+				}
+			}
+		}
+		break;
+	}
+	case WORKER_OP_TYPE_ADD_COMPONENT:
+		Write<int64>(Op.op.add_component.entity_id);
+		WriteComponentData(Op.op.add_component.data);
+		break;
+	case WORKER_OP_TYPE_REMOVE_COMPONENT:
+		Write<int64>(Op.op.remove_component.entity_id);
+		Write<uint32>(Op.op.remove_component.component_id);
+		break;
+	case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+		Write<int64>(Op.op.authority_change.entity_id);
+		Write<uint32>(Op.op.authority_change.component_id);
+		Write<uint8>(Op.op.authority_change.authority);
+		break;
+	case WORKER_OP_TYPE_COMPONENT_UPDATE:
+		Write<int64>(Op.op.component_update.entity_id);
+		WriteComponentUpdate(Op.op.component_update.update);
+		break;
+	case WORKER_OP_TYPE_COMMAND_REQUEST:
+	{
+		const Worker_CommandRequestOp& Request = Op.op.command_request;
+		Write<int64>(Request.request_id);
+		Write<int64>(Request.entity_id);
+		Write<uint32>(Request.timeout_millis);
+		WriteString(Request.caller_worker_id);
+		Write<uint32>(Request.caller_attribute_set.attribute_count);
+		for (uint32 i = 0; i < Request.caller_attribute_set.attribute_count; ++i)
+		{
+			WriteString(Request.caller_attribute_set.attributes[i]);
+		}
+		Write<uint32>(Request.request.component_id);
+		Write<uint32>(Request.request.command_index);
+		WriteSchemaObject(Request.request.schema_type != nullptr ? Schema_GetCommandRequestObject(Request.request.schema_type) : nullptr);
+		break;
+	}
+	case WORKER_OP_TYPE_COMMAND_RESPONSE:
+	{
+		const Worker_CommandResponseOp& Response = Op.op.command_response;
+		Write<int64>(Response.request_id);
+		Write<int64>(Response.entity_id);
+		Write<uint8>(Response.status_code);
+		WriteString(Response.message);
+		Write<uint32>(Response.command_id);
+		Write<uint32>(Response.response.component_id);
+		Write<uint32>(Response.response.command_index);
+		WriteSchemaObject(Response.response.schema_type != nullptr ? Schema_GetCommandResponseObject(Response.response.schema_type) : nullptr);
+		break;
+	}
+	default:
+		UE_LOG(LogSpatialOpListRecording, Warning, TEXT("Recorded op of unknown type %d without its contents"), Op.op_type);
+		break;
+	}
+}
+
+void FOpListRecorder::WriteComponentData(const Worker_ComponentData& Data)
+{
+	Write<uint32>(Data.component_id);
+	WriteSchemaObject(Data.schema_type != nullptr ? Schema_GetComponentDataFields(Data.schema_type) : nullptr);
+}
+
+void FOpListRecorder::WriteComponentUpdate(const Worker_ComponentUpdate& Update)
+{
+	Write<uint32>(Update.component_id);
+	if (Update.schema_type == nullptr)
+	{
+		WriteSchemaObject(nullptr);
+		return;
+	}
+
+	WriteSchemaObject(Schema_GetComponentUpdateFields(Update.schema_type));
+	WriteSchemaObject(Schema_GetComponentUpdateEvents(Update.schema_type));
+
+	const uint32 ClearedFieldCount = Schema_GetComponentUpdateClearedFieldCount(Update.schema_type);
+	Write<uint32>(ClearedFieldCount);
+	if (ClearedFieldCount > 0)
+	{
+		TArray<Schema_FieldId> ClearedFields;
+		ClearedFields.SetNumUninitialized(ClearedFieldCount);
+		Schema_GetComponentUpdateClearedFieldList(Update.schema_type, ClearedFields.GetData());
+		WriteBytes(ClearedFields.GetData(), ClearedFieldCount * sizeof(Schema_FieldId));
+	}
+}
+
+void FOpListRecorder::WriteSchemaObject(Schema_Object* Object)
+{
+	if (Object == nullptr)
+	{
+		Write<uint32>(OpListRecording::NullLength);
+		return;
+	}
+
+	const uint32 Length = Schema_GetWriteBufferLength(Object);
+	SchemaBuffer.SetNumUninitialized(Length, /*bAllowShrinking*/ false);
+	Schema_SerializeToBuffer(Object, SchemaBuffer.GetData(), Length);
+
+	Write<uint32>(Length);
+	WriteBytes(SchemaBuffer.GetData(), Length);
+}
+
+void FOpListRecorder::WriteString(const char* String)
+{
+	if (String == nullptr)
+	{
+		Write<uint32>(OpListRecording::NullLength);
+		return;
+	}
+
+	const uint32 Length = FCStringAnsi::Strlen(String);
+	Write<uint32>(Length);
+	WriteBytes(String, Length);
+}
+
+void FOpListRecorder::WriteBytes(const void* Data, uint32 Length)
+{
+	FrameBuffer.Append(static_cast<const uint8*>(Data), Length);
+}
+
+} // namespace SpatialGDK
@@ -0,0 +1,524 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/Connection/OpListReplayer.h"
+
+#include "Interop/Connection/OpListRecorder.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+
+namespace SpatialGDK
+{
+
+namespace
+{
+
+// Bounds checked cursor over a recording.
+class FRecordingReader
+{
+public:
+	FRecordingReader(const uint8* InData, int64 InSize)
+		: Data(InData)
+		, Size(InSize)
+		, Offset(0)
+		, bError(false)
+	{
+	}
+
+	template <typename T>
+	T Read()
+	{
+		T Value{};
+		ReadBytes(&Value, sizeof(T));
+		return Value;
+	}
+
+	void ReadBytes(void* Out, int64 Length)
+	{
+		if (const uint8* Bytes = Consume(Length))
+		{
+			FMemory::Memcpy(Out, Bytes, Length);
+		}
+	}
+
+	// Returns a pointer to the next Length bytes and skips past them, or nullptr if there aren't enough left.
+	const uint8* Consume(int64 Length)
+	{
+		if (bError || Length < 0 || Offset + Length > Size)
+		{
+			bError = true;
+			return nullptr;
+		}
+
+		const uint8* Bytes = Data + Offset;
+		Offset += Length;
+		return Bytes;
+	}
+
+	bool HasError() const { return bError; }
+	bool IsAtEnd() const { return Offset >= Size; }
+	int64 GetOffset() const { return Offset; }
+
+private:
+	const uint8* Data;
+	int64 Size;
+	int64 Offset;
+	bool bError;
+};
+
+} // anonymous namespace
+
+FOpListReplayer::FOpListReplayer()
+	: ReplaySpeed(EOpListReplaySpeed::Recorded)
+	, ReplayStartTime(0.0)
+	, NextFrame(0)
+	, NumOps(0)
+	, NextRequestId(0)
+{
+}
+
+FOpListReplayer::~FOpListReplayer()
+{
+	Unload();
+}
+
+bool FOpListReplayer::LoadRecording(const FString& InFilename)
+{
+	Unload();
+	Filename = InFilename;
+
+	// Prefer mapping the recording, the decoder reads it in place either way.
+	TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile.IsValid() ? MappedFile->MapRegion() : nullptr);
+
+	bool bDecoded = false;
+	if (MappedRegion.IsValid())
+	{
+		bDecoded = DecodeRecording(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize());
+	}
+	else
+	{
+		TArray<uint8> FileContents;
+		if (!FFileHelper::LoadFileToArray(FileContents, *Filename))
+		{
+			UE_LOG(LogSpatialOpListRecording, Error, TEXT("Failed to open op recording %s"), *Filename);
+			return false;
+		}
+		bDecoded = DecodeRecording(FileContents.GetData(), FileContents.Num());
+	}
+
+	if (!bDecoded)
+	{
+		Unload();
+		return false;
+	}
+
+	UE_LOG(LogSpatialOpListRecording, Log, TEXT("Loaded op recording %s: %d frames, %d op lists, %d ops"), *Filename, Frames.Num(), OpLists.Num(), NumOps);
+	Restart();
+	return true;
+}
+
+void FOpListReplayer::Restart()
+{
+	NextFrame = 0;
+	ReplayStartTime = FPlatformTime::Seconds();
+}
+
+TArray<Worker_OpList*> FOpListReplayer::GetOpList()
+{
+	TArray<Worker_OpList*> Result;
+
+	const double Elapsed = FPlatformTime::Seconds() - ReplayStartTime;
+	while (NextFrame < Frames.Num())
+	{
+		const FReplayFrame& Frame = Frames[NextFrame];
+		if (ReplaySpeed == EOpListReplaySpeed::Recorded && Frame.Timestamp > Elapsed)
+		{
+			break;
+		}
+
+		for (int32 i = 0; i < Frame.NumOpLists; ++i)
+		{
+			Result.Add(&OpLists[Frame.FirstOpList + i]);
+		}
+		NextFrame++;
+
+		if (ReplaySpeed == EOpListReplaySpeed::Maximum)
+		{
+			break;
+		}
+	}
+
+	return Result;
+}
+
+bool FOpListReplayer::DecodeRecording(const uint8* Data, int64 Size)
+{
+	FRecordingReader Reader(Data, Size);
+
+	if (Reader.Read<uint32>() != OpListRecording::Magic)
+	{
+		UE_LOG(LogSpatialOpListRecording, Error, TEXT("%s is not an op recording"), *Filename);
+		return false;
+	}
+
+	const uint32 Version = Reader.Read<uint32>();
+	if (Version != OpListRecording::Version)
+	{
+		UE_LOG(LogSpatialOpListRecording, Error, TEXT("Op recording %s has version %u, expected %u"), *Filename, Version, OpListRecording::Version);
+		return false;
+	}
+
+	const auto ReadString = [this, &Reader]() -> const char*
+	{
+		const uint32 Length = Reader.Read<uint32>();
+		if (Length == OpListRecording::NullLength)
+		{
+			return nullptr;
+		}
+
+		const uint8* Bytes = Reader.Consume(Length);
+		if (Bytes == nullptr)
+		{
+			return nullptr;
+		}
+
+		TArray<ANSICHAR>& String = StringStorage.AddDefaulted_GetRef();
+		String.SetNumUninitialized(Length + 1);
+		FMemory::Memcpy(String.GetData(), Bytes, Length);
+		String[Length] = '\0';
+		return String.GetData();
+	};
+
+	// Returns false if the object was recorded as missing, or could not be decoded.
+	const auto ReadSchemaObject = [this, &Reader](Schema_Object* Object) -> bool
+	{
+		const uint32 Length = Reader.Read<uint32>();
+		if (Length == OpListRecording::NullLength)
+		{
+			return false;
+		}
+
+		const uint8* Bytes = Reader.Consume(Length);
+		if (Bytes == nullptr || Schema_MergeFromBuffer(Object, Bytes, Length) == 0)
+		{
+			UE_LOG(LogSpatialOpListRecording, Error, TEXT("Failed to decode schema object in op recording %s"), *Filename);
+			return false;
+		}
+		return true;
+	};
+
+	const auto ReadComponentData = [this, &Reader, &ReadSchemaObject](Worker_ComponentData& OutData)
+	{
+		OutData = Worker_ComponentData{};
+		OutData.component_id = Reader.Read<uint32>();
+		Schema_ComponentData* SchemaData = Schema_CreateComponentData();
+		OwnedComponentData.Add(SchemaData);
+		OutData.schema_type = ReadSchemaObject(Schema_GetComponentDataFields(SchemaData)) ? SchemaData : nullptr;
+	};
+
+	const auto ReadComponentUpdate = [this, &Reader, &ReadSchemaObject](Worker_ComponentUpdate& OutUpdate)
+	{
+		OutUpdate = Worker_ComponentUpdate{};
+		OutUpdate.component_id = Reader.Read<uint32>();
+		Schema_ComponentUpdate* SchemaUpdate = Schema_CreateComponentUpdate();
+		OwnedComponentUpdates.Add(SchemaUpdate);
+
+		if (!ReadSchemaObject(Schema_GetComponentUpdateFields(SchemaUpdate)))
+		{
+			return;
+		}
+		ReadSchemaObject(Schema_GetComponentUpdateEvents(SchemaUpdate));
+
+		const uint32 ClearedFieldCount = Reader.Read<uint32>();
+		for (uint32 i = 0; i < ClearedFieldCount && !Reader.HasError(); ++i)
+		{
+			Schema_AddComponentUpdateClearedField(SchemaUpdate, Reader.Read<Schema_FieldId>());
+		}
+		OutUpdate.schema_type = SchemaUpdate;
+	};
+
+	while (!Reader.IsAtEnd() && !Reader.HasError())
+	{
+		const uint32 FrameSize = Reader.Read<uint32>();
+		const int64 FrameEnd = Reader.GetOffset() + FrameSize;
+
+		FReplayFrame& Frame = Frames.AddDefaulted_GetRef();
+		Frame.Timestamp = Reader.Read<double>();
+		Frame.FirstOpList = OpLists.Num();
+		Frame.NumOpLists = Reader.Read<uint32>();
+
+		for (int32 ListIndex = 0; ListIndex < Frame.NumOpLists && !Reader.HasError(); ++ListIndex)
+		{
+			const uint32 OpCount = Reader.Read<uint32>();
+			TArray<Worker_Op>& Ops = OpStorage.AddDefaulted_GetRef();
+			Ops.SetNumZeroed(OpCount);
+
+			for (Worker_Op& Op : Ops)
+			{
+				Op.op_type = Reader.Read<uint8>();
+
+				switch (static_cast<Worker_OpType>(Op.op_type))
+				{
+				case WORKER_OP_TYPE_DISCONNECT:
+					Op.op.disconnect.connection_status_code = Reader.Read<uint8>();
+					Op.op.disconnect.reason = ReadString();
+					break;
+				case WORKER_OP_TYPE_FLAG_UPDATE:
+					Op.op.flag_update.name = ReadString();
+					Op.op.flag_update.value = ReadString();
+					break;
+				case WORKER_OP_TYPE_LOG_MESSAGE:
+					Op.op.log_message.level = Reader.Read<uint8>();
+					Op.op.log_message.message = ReadString();
+					break;
+				case WORKER_OP_TYPE_METRICS:
+					break;
+				case WORKER_OP_TYPE_CRITICAL_SECTION:
+					Op.op.critical_section.in_critical_section = Reader.Read<uint8>();
+					break;
+				case WORKER_OP_TYPE_ADD_ENTITY:
+					Op.op.add_entity.entity_id = Reader.Read<int64>();
+					break;
+				case WORKER_OP_TYPE_REMOVE_ENTITY:
+					Op.op.remove_entity.entity_id = Reader.Read<int64>();
+					break;
+				case WORKER_OP_TYPE_RESERVE_ENTITY_IDS_RESPONSE:
+					Op.op.reserve_entity_ids_response.request_id = Reader.Read<int64>();
+					Op.op.reserve_entity_ids_response.status_code = Reader.Read<uint8>();
+					Op.op.reserve_entity_ids_response.message = ReadString();
+					Op.op.reserve_entity_ids_response.first_entity_id = Reader.Read<int64>();
+					Op.op.reserve_entity_ids_response.number_of_entity_ids = Reader.Read<uint32>();
+					break;
+				case WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE:
+					Op.op.create_entity_response.request_id = Reader.Read<int64>();
+					Op.op.create_entity_response.status_code = Reader.Read<uint8>();
+					Op.op.create_entity_response.message = ReadString();
+					Op.op.create_entity_response.entity_id = Reader.Read<int64>();
+					break;
+				case WORKER_OP_TYPE_DELETE_ENTITY_RESPONSE:
+					Op.op.delete_entity_response.request_id = Reader.Read<int64>();
+					Op.op.delete_entity_response.entity_id = Reader.Read<int64>();
+					Op.op.delete_entity_response.status_code = Reader.Read<uint8>();
+					Op.op.delete_entity_response.message = ReadString();
+					break;
+				case WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE:
+				{
+					Worker_EntityQueryResponseOp& Response = Op.op.entity_query_response;
+					Response.request_id = Reader.Read<int64>();
+					Response.status_code = Reader.Read<uint8>();
+					Response.message = ReadString();
+					Response.result_count = Reader.Read<uint32>();
+					if (Reader.Read<uint8>() == 0)
+					{
+						break;
+					}
+
+					TArray<Worker_Entity>& Entities = EntityStorage.AddDefaulted_GetRef();
+					Entities.SetNumZeroed(Response.result_count);
+					for (Worker_Entity& Entity : Entities)
+					{
+						Entity.entity_id = Reader.Read<int64>();
+						Entity.component_count = Reader.Read<uint32>();
+						TArray<Worker_ComponentData>& Components = ComponentDataStorage.AddDefaulted_GetRef();
+						Components.SetNumZeroed(Entity.component_count);
+						for (Worker_ComponentData& Component : Components)
+						{
+							ReadComponentData(Component);
+						}
+						Entity.components = Components.GetData();
+					}
+					Response.results = Entities.GetData();
+					break;
+				}
+				case WORKER_OP_TYPE_ADD_COMPONENT:
+					Op.op.add_component.entity_id = Reader.Read<int64>();
+					ReadComponentData(Op.op.add_component.data);
+					break;
+				case WORKER_OP_TYPE_REMOVE_COMPONENT:
+					Op.op.remove_component.entity_id = Reader.Read<int64>();
+					Op.op.remove_component.component_id = Reader.Read<uint32>();
+					break;
+				case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+					Op.op.authority_change.entity_id = Reader.Read<int64>();
+					Op.op.authority_change.component_id = Reader.Read<uint32>();
+					Op.op.authority_change.authority = Reader.Read<uint8>();
+					break;
+				case WORKER_OP_TYPE_COMPONENT_UPDATE:
+					Op.op.component_update.entity_id = Reader.Read<int64>();
+					ReadComponentUpdate(Op.op.component_update.update);
+					break;
+				case WORKER_OP_TYPE_COMMAND_REQUEST:
+				{
+					Worker_CommandRequestOp& Request = Op.op.command_request;
+					Request.request_id = Reader.Read<int64>();
+					Request.entity_id = Reader.Read<int64>();
+					Request.timeout_millis = Reader.Read<uint32>();
+					Request.caller_worker_id = ReadString();
+
+					TArray<const char*>& Attributes = AttributeStorage.AddDefaulted_GetRef();
+					Attributes.SetNumZeroed(Reader.Read<uint32>());
+					for (const char*& Attribute : Attributes)
+					{
+						Attribute = ReadString();
+					}
+					Request.caller_attribute_set.attribute_count = Attributes.Num();
+					Request.caller_attribute_set.attributes = Attributes.GetData();
+
+					Request.request.component_id = Reader.Read<uint32>();
+					Request.request.command_index = Reader.Read<uint32>();
+					Schema_CommandRequest* SchemaRequest = Schema_CreateCommandRequest();
+					OwnedCommandRequests.Add(SchemaRequest);
+					Request.request.schema_type = ReadSchemaObject(Schema_GetCommandRequestObject(SchemaRequest)) ? SchemaRequest : nullptr;
+					break;
+				}
+				case WORKER_OP_TYPE_COMMAND_RESPONSE:
+				{
+					Worker_CommandResponseOp& Response = Op.op.command_response;
+					Response.request_id = Reader.Read<int64>();
+					Response.entity_id = Reader.Read<int64>();
+					Response.status_code = Reader.Read<uint8>();
+					Response.message = ReadString();
+					Response.command_id = Reader.Read<uint32>();
+					Response.response.component_id = Reader.Read<uint32>();
+					Response.response.command_index = Reader.Read<uint32>();
+					Schema_CommandResponse* SchemaResponse = Schema_CreateCommandResponse();
+					OwnedCommandResponses.Add(SchemaResponse);
+					Response.response.schema_type = ReadSchemaObject(Schema_GetCommandResponseObject(SchemaResponse)) ? SchemaResponse : nullptr;
+					break;
+				}
+				default:
+					break;
+				}
+			}
+
+			Worker_OpList& OpList = OpLists.AddDefaulted_GetRef();
+			OpList.ops = Ops.GetData();
+			OpList.op_count = Ops.Num();
+			NumOps += Ops.Num();
+		}
+
+		if (Reader.HasError() || Reader.GetOffset() != FrameEnd)
+		{
+			UE_LOG(LogSpatialOpListRecording, Error, TEXT("Op recording %s is malformed at frame %d"), *Filename, Frames.Num() - 1);
+			return false;
+		}
+	}
+
+	return !Reader.HasError();
+}
+
+void FOpListReplayer::Unload()
+{
+	for (Schema_ComponentData* Data : OwnedComponentData)
+	{
+		Schema_DestroyComponentData(Data);
+	}
+	for (Schema_ComponentUpdate* Update : OwnedComponentUpdates)
+	{
+		Schema_DestroyComponentUpdate(Update);
+	}
+	for (Schema_CommandRequest* Request : OwnedCommandRequests)
+	{
+		Schema_DestroyCommandRequest(Request);
+	}
+	for (Schema_CommandResponse* Response : OwnedCommandResponses)
+	{
+		Schema_DestroyCommandResponse(Response);
+	}
+
+	OwnedComponentData.Empty();
+	OwnedComponentUpdates.Empty();
+	OwnedCommandRequests.Empty();
+	OwnedCommandResponses.Empty();
+	Frames.Empty();
+	OpLists.Empty();
+	OpStorage.Empty();
+	StringStorage.Empty();
+	AttributeStorage.Empty();
+	EntityStorage.Empty();
+	ComponentDataStorage.Empty();
+	NextFrame = 0;
+	NumOps = 0;
+}
+
+Worker_RequestId FOpListReplayer::SendReserveEntityIdsRequest(uint32_t NumOfEntities)
+{
+	return NextRequestId++;
+}
+
+Worker_RequestId FOpListReplayer::SendCreateEntityRequest(TArray<FWorkerComponentData>&& Components, const Worker_EntityId* EntityId)
+{
+	// Sent messages are dropped, but the schema objects they own still have to be destroyed as the worker SDK would.
+	for (FWorkerComponentData& Component : Components)
+	{
+		Schema_DestroyComponentData(Component.schema_type);
+	}
+	return NextRequestId++;
+}
+
+Worker_RequestId FOpListReplayer::SendDeleteEntityRequest(Worker_EntityId EntityId)
+{
+	return NextRequestId++;
+}
+
+void FOpListReplayer::SendAddComponent(Worker_EntityId EntityId, FWorkerComponentData* ComponentData)
+{
+	Schema_DestroyComponentData(ComponentData->schema_type);
+}
+
+void FOpListReplayer::SendRemoveComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+{
+}
+
+void FOpListReplayer::SendComponentUpdate(Worker_EntityId EntityId, const FWorkerComponentUpdate* ComponentUpdate)
+{
+	Schema_DestroyComponentUpdate(ComponentUpdate->schema_type);
+}
+
+Worker_RequestId FOpListReplayer::SendCommandRequest(Worker_EntityId EntityId, const Worker_CommandRequest* Request, uint32_t CommandId)
+{
+	Schema_DestroyCommandRequest(Request->schema_type);
+	return NextRequestId++;
+}
+
+void FOpListReplayer::SendCommandResponse(Worker_RequestId RequestId, const Worker_CommandResponse* Response)
+{
+	Schema_DestroyCommandResponse(Response->schema_type);
+}
+
+void FOpListReplayer::SendCommandFailure(Worker_RequestId RequestId, const FString& Message)
+{
+}
+
+void FOpListReplayer::SendLogMessage(uint8_t Level, const FName& LoggerName, const TCHAR* Message)
+{
+}
+
+void FOpListReplayer::SendComponentInterest(Worker_EntityId EntityId, TArray<Worker_InterestOverride>&& ComponentInterest)
+{
+}
+
+Worker_RequestId FOpListReplayer::SendEntityQueryRequest(const Worker_EntityQuery* EntityQuery)
+{
+	return NextRequestId++;
+}
+
+void FOpListReplayer::SendMetrics(const SpatialMetrics& Metrics)
+{
+}
+
+PhysicalWorkerName FOpListReplayer::GetWorkerId() const
+{
+	return PhysicalWorkerName(TEXT("OpListReplayer"));
+}
+
+const TArray<FString>& FOpListReplayer::GetWorkerAttributes() const
+{
+	static const TArray<FString> NoAttributes;
+	return NoAttributes;
+}
+
+} // namespace SpatialGDK
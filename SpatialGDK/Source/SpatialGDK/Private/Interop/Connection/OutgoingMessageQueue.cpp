@@ -0,0 +1,133 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/Connection/OutgoingMessageQueue.h"
+
+#include "Math/UnrealMathUtility.h"
+
+namespace SpatialGDK
+{
+
+FOutgoingMessageQueue::FOutgoingMessageQueue(uint32 InCapacity)
+	: Capacity(FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(InCapacity, 2)))
+	, IndexMask(Capacity - 1)
+	, EnqueuePosition(0)
+	, DequeuePosition(0)
+{
+	Slots = MakeUnique<FSlot[]>(Capacity);
+	for (uint32 i = 0; i < Capacity; i++)
+	{
+		Slots[i].Sequence = i;
+	}
+}
+
+FOutgoingMessageQueue::~FOutgoingMessageQueue()
+{
+	while (Peek() != nullptr)
+	{
+		Pop();
+	}
+}
+
+FOutgoingMessageQueue::FSlot* FOutgoingMessageQueue::ClaimSlot(uint64& OutPosition)
+{
+	uint64 Position = EnqueuePosition.Load(EMemoryOrder::Relaxed);
+	for (;;)
+	{
+		FSlot* Slot = &Slots[Position & IndexMask];
+		const int64 Difference = static_cast<int64>(Slot->Sequence.Load()) - static_cast<int64>(Position);
+
+		if (Difference == 0)
+		{
+			// The slot is free for this position, try to take ownership of it.
+			if (EnqueuePosition.CompareExchange(Position, Position + 1))
+			{
+				OutPosition = Position;
+				return Slot;
+			}
+			// CompareExchange updated Position with the current enqueue position, retry with it.
+		}
+		else if (Difference < 0)
+		{
+			// The consumer has not released this slot yet, the queue is full.
+			return nullptr;
+		}
+		else
+		{
+			// Another producer claimed this position first.
+			Position = EnqueuePosition.Load(EMemoryOrder::Relaxed);
+		}
+	}
+}
+
+void FOutgoingMessageQueue::PublishSlot(FSlot* Slot, uint64 Position)
+{
+	Slot->Sequence = Position + 1;
+}
+
+FOutgoingMessage* FOutgoingMessageQueue::Peek()
+{
+	const uint64 Position = DequeuePosition.Load(EMemoryOrder::Relaxed);
+	FSlot& Slot = Slots[Position & IndexMask];
+
+	if (Slot.Sequence.Load() != Position + 1)
+	{
+		return nullptr;
+	}
+
+	return reinterpret_cast<FOutgoingMessage*>(Slot.Storage.Data);
+}
+
+void FOutgoingMessageQueue::Pop()
+{
+	const uint64 Position = DequeuePosition.Load(EMemoryOrder::Relaxed);
+	FSlot& Slot = Slots[Position & IndexMask];
+	check(Slot.Sequence.Load() == Position + 1);
+
+	reinterpret_cast<FOutgoingMessage*>(Slot.Storage.Data)->~FOutgoingMessage();
+
+	// Hand the slot back to producers for the next lap around the ring.
+	Slot.Sequence = Position + Capacity;
+	// Sequentially consistent so that a producer publishing the next message either sees this position and reports
+	// the queue as having been empty, or publishes before the consumer's next Peek and is picked up by it.
+	DequeuePosition.Store(Position + 1);
+}
+
+void FOutgoingMessageQueue::Grow()
+{
+	const uint64 Dequeued = DequeuePosition.Load();
+	const uint64 Enqueued = EnqueuePosition.Load();
+	const uint32 NewCapacity = Capacity * 2;
+
+	TUniquePtr<FSlot[]> NewSlots = MakeUnique<FSlot[]>(NewCapacity);
+	for (uint64 Position = Dequeued; Position < Enqueued; Position++)
+	{
+		const uint32 NewIndex = static_cast<uint32>(Position - Dequeued);
+		FMemory::Memcpy(&NewSlots[NewIndex].Storage, &Slots[Position & IndexMask].Storage, sizeof(FSlot::Storage));
+		NewSlots[NewIndex].Sequence = NewIndex + 1;
+	}
+	for (uint32 NewIndex = static_cast<uint32>(Enqueued - Dequeued); NewIndex < NewCapacity; NewIndex++)
+	{
+		NewSlots[NewIndex].Sequence = NewIndex;
+	}
+
+	Slots = MoveTemp(NewSlots);
+	Capacity = NewCapacity;
+	IndexMask = NewCapacity - 1;
+	EnqueuePosition = Enqueued - Dequeued;
+	DequeuePosition = 0;
+}
+
+bool FOutgoingMessageQueue::IsEmpty() const
+{
+	const uint64 Position = DequeuePosition.Load(EMemoryOrder::Relaxed);
+	return Slots[Position & IndexMask].Sequence.Load() != Position + 1;
+}
+
+uint32 FOutgoingMessageQueue::Num() const
+{
+	const uint64 Dequeued = DequeuePosition.Load();
+	const uint64 Enqueued = EnqueuePosition.Load();
+	return Enqueued > Dequeued ? static_cast<uint32>(Enqueued - Dequeued) : 0;
+}
+
+} // namespace SpatialGDK
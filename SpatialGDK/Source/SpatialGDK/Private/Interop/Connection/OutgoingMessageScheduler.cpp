@@ -0,0 +1,352 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/Connection/OutgoingMessageScheduler.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+
+namespace SpatialGDK
+{
+
+namespace
+{
+
+// Rough per message cost of framing, ids and the message header.
+const uint32 MessageOverheadBytes = 16;
+
+uint32 GetSchemaObjectSize(Schema_Object* Object)
+{
+	return Object != nullptr ? Schema_GetWriteBufferLength(Object) : 0;
+}
+
+uint32 GetComponentDataSize(const Worker_ComponentData& Data)
+{
+	return Data.schema_type != nullptr ? GetSchemaObjectSize(Schema_GetComponentDataFields(Data.schema_type)) : 0;
+}
+
+TOptional<Worker_EntityId> GetMessageEntityId(const FOutgoingMessage& Message)
+{
+	switch (Message.Type)
+	{
+	case EOutgoingMessageType::CreateEntityRequest:
+		return static_cast<const FCreateEntityRequest&>(Message).EntityId;
+	case EOutgoingMessageType::DeleteEntityRequest:
+		return static_cast<const FDeleteEntityRequest&>(Message).EntityId;
+	case EOutgoingMessageType::AddComponent:
+		return static_cast<const FAddComponent&>(Message).EntityId;
+	case EOutgoingMessageType::RemoveComponent:
+		return static_cast<const FRemoveComponent&>(Message).EntityId;
+	case EOutgoingMessageType::ComponentUpdate:
+		return static_cast<const FComponentUpdate&>(Message).EntityId;
+	case EOutgoingMessageType::CommandRequest:
+		return static_cast<const FCommandRequest&>(Message).EntityId;
+	case EOutgoingMessageType::ComponentInterest:
+		return static_cast<const FComponentInterest&>(Message).EntityId;
+	default:
+		return TOptional<Worker_EntityId>();
+	}
+}
+
+// Deferred messages outlive the queue slot they were constructed in, so they are moved to the heap.
+TUniquePtr<FOutgoingMessage> MoveToHeap(FOutgoingMessage& Message)
+{
+	switch (Message.Type)
+	{
+	case EOutgoingMessageType::ReserveEntityIdsRequest:
+		return MakeUnique<FReserveEntityIdsRequest>(MoveTemp(static_cast<FReserveEntityIdsRequest&>(Message)));
+	case EOutgoingMessageType::CreateEntityRequest:
+		return MakeUnique<FCreateEntityRequest>(MoveTemp(static_cast<FCreateEntityRequest&>(Message)));
+	case EOutgoingMessageType::DeleteEntityRequest:
+		return MakeUnique<FDeleteEntityRequest>(MoveTemp(static_cast<FDeleteEntityRequest&>(Message)));
+	case EOutgoingMessageType::AddComponent:
+		return MakeUnique<FAddComponent>(MoveTemp(static_cast<FAddComponent&>(Message)));
+	case EOutgoingMessageType::RemoveComponent:
+		return MakeUnique<FRemoveComponent>(MoveTemp(static_cast<FRemoveComponent&>(Message)));
+	case EOutgoingMessageType::ComponentUpdate:
+		return MakeUnique<FComponentUpdate>(MoveTemp(static_cast<FComponentUpdate&>(Message)));
+	case EOutgoingMessageType::CommandRequest:
+		return MakeUnique<FCommandRequest>(MoveTemp(static_cast<FCommandRequest&>(Message)));
+	case EOutgoingMessageType::CommandResponse:
+		return MakeUnique<FCommandResponse>(MoveTemp(static_cast<FCommandResponse&>(Message)));
+	case EOutgoingMessageType::CommandFailure:
+		return MakeUnique<FCommandFailure>(MoveTemp(static_cast<FCommandFailure&>(Message)));
+	case EOutgoingMessageType::LogMessage:
+		return MakeUnique<FLogMessage>(MoveTemp(static_cast<FLogMessage&>(Message)));
+	case EOutgoingMessageType::ComponentInterest:
+		return MakeUnique<FComponentInterest>(MoveTemp(static_cast<FComponentInterest&>(Message)));
+	case EOutgoingMessageType::EntityQueryRequest:
+		// The query's constraints point into ConstraintStorage, whose allocations move along with it.
+		return MakeUnique<FEntityQueryRequest>(MoveTemp(static_cast<FEntityQueryRequest&>(Message)));
+	case EOutgoingMessageType::Metrics:
+		return MakeUnique<FMetrics>(MoveTemp(static_cast<FMetrics&>(Message)));
+	default:
+		checkNoEntry();
+		return nullptr;
+	}
+}
+
+} // anonymous namespace
+
+EOutgoingMessagePriority GetOutgoingMessagePriority(EOutgoingMessageType Type)
+{
+	switch (Type)
+	{
+	case EOutgoingMessageType::ComponentUpdate:
+	case EOutgoingMessageType::CommandRequest:
+	case EOutgoingMessageType::CommandResponse:
+	case EOutgoingMessageType::CommandFailure:
+		return EOutgoingMessagePriority::Critical;
+	case EOutgoingMessageType::LogMessage:
+	case EOutgoingMessageType::ComponentInterest:
+	case EOutgoingMessageType::Metrics:
+		return EOutgoingMessagePriority::Low;
+	default:
+		return EOutgoingMessagePriority::Normal;
+	}
+}
+
+bool IsOutgoingRequest(EOutgoingMessageType Type)
+{
+	switch (Type)
+	{
+	case EOutgoingMessageType::ReserveEntityIdsRequest:
+	case EOutgoingMessageType::CreateEntityRequest:
+	case EOutgoingMessageType::DeleteEntityRequest:
+	case EOutgoingMessageType::CommandRequest:
+	case EOutgoingMessageType::EntityQueryRequest:
+		return true;
+	default:
+		return false;
+	}
+}
+
+uint32 GetComponentUpdateSize(const Worker_ComponentUpdate& Update)
+{
+	uint32 PayloadSize = 0;
+	if (Update.schema_type != nullptr)
+	{
+		PayloadSize = GetSchemaObjectSize(Schema_GetComponentUpdateFields(Update.schema_type))
+			+ GetSchemaObjectSize(Schema_GetComponentUpdateEvents(Update.schema_type));
+	}
+	return MessageOverheadBytes + PayloadSize;
+}
+
+uint32 GetOutgoingMessageSize(const FOutgoingMessage& Message)
+{
+	uint32 PayloadSize = 0;
+
+	switch (Message.Type)
+	{
+	case EOutgoingMessageType::CreateEntityRequest:
+		for (const FWorkerComponentData& Data : static_cast<const FCreateEntityRequest&>(Message).Components)
+		{
+			PayloadSize += GetComponentDataSize(Data);
+		}
+		break;
+	case EOutgoingMessageType::AddComponent:
+		PayloadSize = GetComponentDataSize(static_cast<const FAddComponent&>(Message).Data);
+		break;
+	case EOutgoingMessageType::ComponentUpdate:
+		return GetComponentUpdateSize(static_cast<const FComponentUpdate&>(Message).Update);
+	case EOutgoingMessageType::CommandRequest:
+	{
+		const Worker_CommandRequest& Request = static_cast<const FCommandRequest&>(Message).Request;
+		PayloadSize = Request.schema_type != nullptr ? GetSchemaObjectSize(Schema_GetCommandRequestObject(Request.schema_type)) : 0;
+		break;
+	}
+	case EOutgoingMessageType::CommandResponse:
+	{
+		const Worker_CommandResponse& Response = static_cast<const FCommandResponse&>(Message).Response;
+		PayloadSize = Response.schema_type != nullptr ? GetSchemaObjectSize(Schema_GetCommandResponseObject(Response.schema_type)) : 0;
+		break;
+	}
+	case EOutgoingMessageType::CommandFailure:
+		PayloadSize = static_cast<const FCommandFailure&>(Message).Message.Len();
+		break;
+	case EOutgoingMessageType::LogMessage:
+		PayloadSize = static_cast<const FLogMessage&>(Message).Message.Len();
+		break;
+	case EOutgoingMessageType::ComponentInterest:
+		PayloadSize = static_cast<const FComponentInterest&>(Message).Interests.Num() * sizeof(Worker_InterestOverride);
+		break;
+	case EOutgoingMessageType::EntityQueryRequest:
+		PayloadSize = (static_cast<const FEntityQueryRequest&>(Message).ConstraintStorage.Num() + 1) * sizeof(Worker_Constraint);
+		break;
+	case EOutgoingMessageType::Metrics:
+	{
+		const SpatialMetrics& Metrics = static_cast<const FMetrics&>(Message).Metrics;
+		for (const GaugeMetric& Gauge : Metrics.GaugeMetrics)
+		{
+			PayloadSize += Gauge.Key.size() + sizeof(double);
+		}
+		for (const HistogramMetric& Histogram : Metrics.HistogramMetrics)
+		{
+			PayloadSize += Histogram.Key.size() + sizeof(double) + Histogram.Buckets.Num() * sizeof(HistogramMetricBucket);
+		}
+		break;
+	}
+	default:
+		break;
+	}
+
+	return MessageOverheadBytes + PayloadSize;
+}
+
+FOutgoingMessageScheduler::FOutgoingMessageScheduler(const FOutgoingMessageBudget& InBudget)
+	: Budget(InBudget)
+	, NumDeferredRequests(0)
+	, FlushCount(0)
+	, MessagesSent(0)
+	, BytesSent(0)
+{
+}
+
+void FOutgoingMessageScheduler::BeginFlush(FSendFunction Send)
+{
+	FlushCount++;
+	MessagesSent = 0;
+	BytesSent = 0;
+
+	// Normal messages go first so that starved low priority messages don't overtake older normal ones.
+	DrainLane(NormalLane, /*bRespectBudget*/ true, Send);
+	DrainLane(LowLane, /*bRespectBudget*/ false, Send);
+}
+
+void FOutgoingMessageScheduler::Schedule(FOutgoingMessage& Message, FSendFunction Send)
+{
+	if (!Budget.IsLimited())
+	{
+		SendMessage(Message, Send);
+		return;
+	}
+
+	const TOptional<Worker_EntityId> EntityId = GetMessageEntityId(Message);
+
+	switch (GetOutgoingMessagePriority(Message.Type))
+	{
+	case EOutgoingMessagePriority::Critical:
+		if ((EntityId.IsSet() && EntitiesWithDeferredMessages.Contains(EntityId.GetValue()))
+			|| (NumDeferredRequests > 0 && IsOutgoingRequest(Message.Type)))
+		{
+			Defer(NormalLane, Message, EntityId);
+			return;
+		}
+		break;
+	case EOutgoingMessagePriority::Normal:
+		if (NormalLane.Num() > 0 || !HasBudget())
+		{
+			Defer(NormalLane, Message, EntityId);
+			return;
+		}
+		break;
+	case EOutgoingMessagePriority::Low:
+		if (NormalLane.Num() > 0 || LowLane.Num() > 0 || !HasBudget())
+		{
+			Defer(LowLane, Message, EntityId);
+			return;
+		}
+		break;
+	}
+
+	SendMessage(Message, Send);
+}
+
+void FOutgoingMessageScheduler::DropDeferredMessages()
+{
+	for (TArray<FDeferredMessage>* Lane : { &NormalLane, &LowLane })
+	{
+		for (FDeferredMessage& Deferred : *Lane)
+		{
+			DestroyOutgoingMessageSchemaObjects(*Deferred.Message);
+		}
+		Lane->Empty();
+	}
+
+	EntitiesWithDeferredMessages.Empty();
+	NumDeferredRequests = 0;
+}
+
+void FOutgoingMessageScheduler::EndFlush(FSendFunction Send)
+{
+	if (NormalLane.Num() == 0)
+	{
+		DrainLane(LowLane, /*bRespectBudget*/ true, Send);
+	}
+}
+
+bool FOutgoingMessageScheduler::HasBudget() const
+{
+	return (Budget.MaxMessagesPerFlush == 0 || MessagesSent < Budget.MaxMessagesPerFlush)
+		&& (Budget.MaxBytesPerFlush == 0 || BytesSent < Budget.MaxBytesPerFlush);
+}
+
+void FOutgoingMessageScheduler::SendMessage(FOutgoingMessage& Message, FSendFunction Send)
+{
+	// Sending hands the message's schema data over to the Worker SDK, so it has to be measured first.
+	const uint32 MessageBytes = IsBudgetingBytes() ? GetOutgoingMessageSize(Message) : 0;
+
+	if (Send(Message))
+	{
+		ChargeSentMessage(MessageBytes);
+	}
+}
+
+void FOutgoingMessageScheduler::ChargeSentMessage(uint32 MessageBytes)
+{
+	BytesSent += MessageBytes;
+	MessagesSent++;
+}
+
+void FOutgoingMessageScheduler::Defer(TArray<FDeferredMessage>& Lane, FOutgoingMessage& Message, const TOptional<Worker_EntityId>& EntityId)
+{
+	if (&Lane == &NormalLane)
+	{
+		if (EntityId.IsSet())
+		{
+			EntitiesWithDeferredMessages.FindOrAdd(EntityId.GetValue())++;
+		}
+		if (IsOutgoingRequest(Message.Type))
+		{
+			NumDeferredRequests++;
+		}
+	}
+
+	Lane.Add(FDeferredMessage{ MoveToHeap(Message), EntityId, FlushCount });
+}
+
+void FOutgoingMessageScheduler::DrainLane(TArray<FDeferredMessage>& Lane, bool bRespectBudget, FSendFunction Send)
+{
+	int32 NumSent = 0;
+	for (; NumSent < Lane.Num(); ++NumSent)
+	{
+		FDeferredMessage& Deferred = Lane[NumSent];
+
+		// Lanes are in the order messages were deferred in, so starved messages are always at the front.
+		const bool bStarved = Budget.MaxDeferredFlushes > 0 && FlushCount - Deferred.DeferredAtFlush >= Budget.MaxDeferredFlushes;
+		if (!bStarved && !(bRespectBudget && HasBudget()))
+		{
+			break;
+		}
+
+		SendMessage(*Deferred.Message, Send);
+
+		if (&Lane == &NormalLane)
+		{
+			if (Deferred.EntityId.IsSet())
+			{
+				int32& Count = EntitiesWithDeferredMessages.FindChecked(Deferred.EntityId.GetValue());
+				if (--Count == 0)
+				{
+					EntitiesWithDeferredMessages.Remove(Deferred.EntityId.GetValue());
+				}
+			}
+			if (IsOutgoingRequest(Deferred.Message->Type))
+			{
+				NumDeferredRequests--;
+			}
+		}
+	}
+
+	Lane.RemoveAt(0, NumSent, /*bAllowShrinking*/ false);
+}
+
+} // namespace SpatialGDK
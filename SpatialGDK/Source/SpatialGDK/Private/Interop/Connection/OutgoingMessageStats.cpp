@@ -0,0 +1,324 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/Connection/OutgoingMessageStats.h"
+
+#include "HAL/PlatformTime.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/OutputDevice.h"
+
+#include <limits>
+
+namespace SpatialGDK
+{
+
+namespace
+{
+
+// Exported latency buckets go up to 2^24us (~17s), size buckets up to 2^24 bytes (16MB).
+const uint32 MaxMetricExponent = 24;
+
+uint64 CyclesToMicros(uint64 Cycles)
+{
+	return static_cast<uint64>(FPlatformTime::ToSeconds64(Cycles) * 1000000.0);
+}
+
+// Queue latency is skipped for messages queued while stats were disabled, which have no EnqueueCycles.
+void RecordSample(FOutgoingMessageStats::FMessageHistograms& Histograms, uint64 EnqueueCycles, uint64 SentCycles, uint64 SendDurationCycles, uint32 PayloadBytes)
+{
+	if (EnqueueCycles != 0 && SentCycles >= EnqueueCycles)
+	{
+		Histograms.QueueLatencyMicros.Record(CyclesToMicros(SentCycles - EnqueueCycles));
+	}
+	Histograms.SendDurationMicros.Record(CyclesToMicros(SendDurationCycles));
+	Histograms.PayloadBytes.Record(PayloadBytes);
+}
+
+void SubtractHistograms(FOutgoingMessageStats::FMessageHistograms& Histograms, const FOutgoingMessageStats::FMessageHistograms& Earlier)
+{
+	Histograms.QueueLatencyMicros.Subtract(Earlier.QueueLatencyMicros);
+	Histograms.SendDurationMicros.Subtract(Earlier.SendDurationMicros);
+	Histograms.PayloadBytes.Subtract(Earlier.PayloadBytes);
+}
+
+void AppendMetrics(TArray<HistogramMetric>& OutMetrics, const FString& Prefix, const FOutgoingMessageStats::FMessageHistograms& Histograms)
+{
+	const auto Append = [&OutMetrics, &Prefix](const TCHAR* Name, const FOutgoingMessageHistogram& Histogram)
+	{
+		if (Histogram.GetCount() > 0)
+		{
+			OutMetrics.Add(Histogram.ToMetric(TCHAR_TO_UTF8(*FString::Printf(TEXT("%s.%s"), *Prefix, Name)), MaxMetricExponent));
+		}
+	};
+
+	Append(TEXT("QueueLatencyMicros"), Histograms.QueueLatencyMicros);
+	Append(TEXT("SendDurationMicros"), Histograms.SendDurationMicros);
+	Append(TEXT("PayloadBytes"), Histograms.PayloadBytes);
+}
+
+void DumpHistogram(FOutputDevice& Ar, const FString& Name, const TCHAR* Unit, const FOutgoingMessageHistogram& Histogram)
+{
+	if (Histogram.GetCount() == 0)
+	{
+		return;
+	}
+
+	Ar.Logf(TEXT("  %-36s %-6s count %8llu  mean %8llu  p50 %8llu  p90 %8llu  p99 %8llu  p99.9 %8llu  max %8llu"),
+		*Name, Unit,
+		Histogram.GetCount(),
+		Histogram.GetSum() / Histogram.GetCount(),
+		Histogram.GetValueAtPercentile(50.0),
+		Histogram.GetValueAtPercentile(90.0),
+		Histogram.GetValueAtPercentile(99.0),
+		Histogram.GetValueAtPercentile(99.9),
+		Histogram.GetMax());
+}
+
+void DumpHistograms(FOutputDevice& Ar, const FString& Name, const FOutgoingMessageStats::FMessageHistograms& Histograms)
+{
+	DumpHistogram(Ar, Name, TEXT("queue"), Histograms.QueueLatencyMicros);
+	DumpHistogram(Ar, Name, TEXT("send"), Histograms.SendDurationMicros);
+	DumpHistogram(Ar, Name, TEXT("bytes"), Histograms.PayloadBytes);
+}
+
+} // anonymous namespace
+
+const TCHAR* GetOutgoingMessageTypeName(EOutgoingMessageType Type)
+{
+	switch (Type)
+	{
+	case EOutgoingMessageType::ReserveEntityIdsRequest:
+		return TEXT("ReserveEntityIdsRequest");
+	case EOutgoingMessageType::CreateEntityRequest:
+		return TEXT("CreateEntityRequest");
+	case EOutgoingMessageType::DeleteEntityRequest:
+		return TEXT("DeleteEntityRequest");
+	case EOutgoingMessageType::AddComponent:
+		return TEXT("AddComponent");
+	case EOutgoingMessageType::RemoveComponent:
+		return TEXT("RemoveComponent");
+	case EOutgoingMessageType::ComponentUpdate:
+		return TEXT("ComponentUpdate");
+	case EOutgoingMessageType::CommandRequest:
+		return TEXT("CommandRequest");
+	case EOutgoingMessageType::CommandResponse:
+		return TEXT("CommandResponse");
+	case EOutgoingMessageType::CommandFailure:
+		return TEXT("CommandFailure");
+	case EOutgoingMessageType::LogMessage:
+		return TEXT("LogMessage");
+	case EOutgoingMessageType::ComponentInterest:
+		return TEXT("ComponentInterest");
+	case EOutgoingMessageType::EntityQueryRequest:
+		return TEXT("EntityQueryRequest");
+	case EOutgoingMessageType::Metrics:
+		return TEXT("Metrics");
+	default:
+		checkNoEntry();
+		return TEXT("Unknown");
+	}
+}
+
+uint32 FOutgoingMessageHistogram::GetBucketIndex(uint64 Value)
+{
+	if (Value < SubBucketCount)
+	{
+		return static_cast<uint32>(Value);
+	}
+
+	// The leading bit selects the group, the SubBucketBits bits after it the bucket within the group.
+	const uint32 Exponent = static_cast<uint32>(FMath::FloorLog2_64(Value));
+	const uint32 Shift = Exponent - SubBucketBits;
+	const uint32 SubBucket = static_cast<uint32>(Value >> Shift) & (SubBucketCount - 1);
+	return (Shift + 1) * SubBucketCount + SubBucket;
+}
+
+uint64 FOutgoingMessageHistogram::GetBucketLowerBound(uint32 BucketIndex)
+{
+	const uint32 Group = BucketIndex / SubBucketCount;
+	if (Group == 0)
+	{
+		return BucketIndex;
+	}
+
+	const uint64 SubBucket = BucketIndex % SubBucketCount;
+	return (SubBucketCount + SubBucket) << (Group - 1);
+}
+
+void FOutgoingMessageHistogram::Record(uint64 Value)
+{
+	const uint32 BucketIndex = GetBucketIndex(Value);
+	if (BucketIndex >= static_cast<uint32>(Buckets.Num()))
+	{
+		Buckets.SetNumZeroed(BucketIndex + 1);
+	}
+
+	Buckets[BucketIndex]++;
+	Count++;
+	Sum += Value;
+	Max = FMath::Max(Max, Value);
+}
+
+void FOutgoingMessageHistogram::Subtract(const FOutgoingMessageHistogram& Earlier)
+{
+	// A histogram that was reset in the meantime has nothing in common with the earlier copy.
+	if (Earlier.Count > Count)
+	{
+		return;
+	}
+
+	for (int32 i = 0; i < Earlier.Buckets.Num() && i < Buckets.Num(); ++i)
+	{
+		Buckets[i] -= FMath::Min(Buckets[i], Earlier.Buckets[i]);
+	}
+
+	Count -= Earlier.Count;
+	Sum -= FMath::Min(Sum, Earlier.Sum);
+	// The maximum can't be recovered, so it stays the maximum over the lifetime of the histogram.
+}
+
+void FOutgoingMessageHistogram::Reset()
+{
+	Buckets.Reset();
+	Count = 0;
+	Sum = 0;
+	Max = 0;
+}
+
+uint64 FOutgoingMessageHistogram::GetValueAtPercentile(double Percentile) const
+{
+	if (Count == 0)
+	{
+		return 0;
+	}
+
+	const uint64 TargetCount = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(Percentile / 100.0 * Count)));
+
+	uint64 SeenCount = 0;
+	for (int32 i = 0; i < Buckets.Num(); ++i)
+	{
+		SeenCount += Buckets[i];
+		if (SeenCount >= TargetCount)
+		{
+			// The highest value in the bucket, but never more than the highest value recorded.
+			return FMath::Min(GetBucketLowerBound(i + 1) - 1, Max);
+		}
+	}
+
+	return Max;
+}
+
+HistogramMetric FOutgoingMessageHistogram::ToMetric(const std::string& Key, uint32 MaxExponent) const
+{
+	HistogramMetric Metric;
+	Metric.Key = Key;
+	Metric.Sum = static_cast<double>(Sum);
+
+	// Bucket boundaries line up with powers of two, so the buckets below 2^Exponent hold exactly the values below it.
+	uint64 CumulativeCount = 0;
+	int32 BucketIndex = 0;
+	for (uint32 Exponent = 0; Exponent <= MaxExponent; ++Exponent)
+	{
+		const uint64 UpperBound = uint64(1) << Exponent;
+		for (; BucketIndex < Buckets.Num() && GetBucketLowerBound(BucketIndex) < UpperBound; ++BucketIndex)
+		{
+			CumulativeCount += Buckets[BucketIndex];
+		}
+
+		Metric.Buckets.Add(HistogramMetricBucket{ static_cast<double>(UpperBound - 1), static_cast<uint32>(CumulativeCount) });
+	}
+
+	Metric.Buckets.Add(HistogramMetricBucket{ std::numeric_limits<double>::infinity(), static_cast<uint32>(Count) });
+
+	return Metric;
+}
+
+FOutgoingMessageStats::FOutgoingMessageStats()
+{
+	MessageHistograms.SetNum(NumMessageTypes);
+}
+
+void FOutgoingMessageStats::RecordSentMessage(const FOutgoingMessage& Message, uint64 SentCycles, uint64 SendDurationCycles, uint32 PayloadBytes)
+{
+	if (Message.Type == EOutgoingMessageType::ComponentUpdate)
+	{
+		RecordSentComponentUpdate(static_cast<const FComponentUpdate&>(Message).Update.component_id, Message.EnqueueCycles, SentCycles, SendDurationCycles, PayloadBytes);
+		return;
+	}
+
+	RecordSample(MessageHistograms[static_cast<int32>(Message.Type)], Message.EnqueueCycles, SentCycles, SendDurationCycles, PayloadBytes);
+}
+
+void FOutgoingMessageStats::RecordSentComponentUpdate(Worker_ComponentId ComponentId, uint64 EnqueueCycles, uint64 SentCycles, uint64 SendDurationCycles, uint32 PayloadBytes)
+{
+	RecordSample(MessageHistograms[static_cast<int32>(EOutgoingMessageType::ComponentUpdate)], EnqueueCycles, SentCycles, SendDurationCycles, PayloadBytes);
+	RecordSample(ComponentUpdateHistograms.FindOrAdd(ComponentId), EnqueueCycles, SentCycles, SendDurationCycles, PayloadBytes);
+}
+
+void FOutgoingMessageStats::Subtract(const FOutgoingMessageStats& Earlier)
+{
+	for (int32 i = 0; i < NumMessageTypes; ++i)
+	{
+		SubtractHistograms(MessageHistograms[i], Earlier.MessageHistograms[i]);
+	}
+
+	for (auto& ComponentHistograms : ComponentUpdateHistograms)
+	{
+		if (const FMessageHistograms* EarlierHistograms = Earlier.ComponentUpdateHistograms.Find(ComponentHistograms.Key))
+		{
+			SubtractHistograms(ComponentHistograms.Value, *EarlierHistograms);
+		}
+	}
+}
+
+void FOutgoingMessageStats::Reset()
+{
+	MessageHistograms.Reset();
+	MessageHistograms.SetNum(NumMessageTypes);
+	ComponentUpdateHistograms.Reset();
+}
+
+void FOutgoingMessageStats::AppendHistogramMetrics(TArray<HistogramMetric>& OutMetrics) const
+{
+	for (int32 i = 0; i < NumMessageTypes; ++i)
+	{
+		const FString Prefix = FString::Printf(TEXT("OutgoingMessages.%s"), GetOutgoingMessageTypeName(static_cast<EOutgoingMessageType>(i)));
+		AppendMetrics(OutMetrics, Prefix, MessageHistograms[i]);
+	}
+
+	for (const auto& ComponentHistograms : ComponentUpdateHistograms)
+	{
+		const FString Prefix = FString::Printf(TEXT("OutgoingMessages.ComponentUpdate.%u"), ComponentHistograms.Key);
+		AppendMetrics(OutMetrics, Prefix, ComponentHistograms.Value);
+	}
+}
+
+void FOutgoingMessageStats::Dump(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Outgoing message stats (queue and send in microseconds, bytes estimated):"));
+
+	for (int32 i = 0; i < NumMessageTypes; ++i)
+	{
+		DumpHistograms(Ar, GetOutgoingMessageTypeName(static_cast<EOutgoingMessageType>(i)), MessageHistograms[i]);
+	}
+
+	if (ComponentUpdateHistograms.Num() == 0)
+	{
+		return;
+	}
+
+	// Busiest components first.
+	TArray<Worker_ComponentId> ComponentIds;
+	ComponentUpdateHistograms.GetKeys(ComponentIds);
+	ComponentIds.Sort([this](Worker_ComponentId Lhs, Worker_ComponentId Rhs)
+	{
+		return ComponentUpdateHistograms[Lhs].PayloadBytes.GetCount() > ComponentUpdateHistograms[Rhs].PayloadBytes.GetCount();
+	});
+
+	Ar.Logf(TEXT("Component updates by component:"));
+	for (Worker_ComponentId ComponentId : ComponentIds)
+	{
+		DumpHistograms(Ar, FString::Printf(TEXT("ComponentUpdate %u"), ComponentId), ComponentUpdateHistograms[ComponentId]);
+	}
+}
+
+} // namespace SpatialGDK
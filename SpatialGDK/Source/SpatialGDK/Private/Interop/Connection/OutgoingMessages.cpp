@@ -2,9 +2,38 @@
 
 #include "Interop/Connection/OutgoingMessages.h"
 
+#include <WorkerSDK/improbable/c_schema.h>
+
 namespace SpatialGDK
 {
 
+void DestroyOutgoingMessageSchemaObjects(FOutgoingMessage& Message)
+{
+	switch (Message.Type)
+	{
+	case EOutgoingMessageType::CreateEntityRequest:
+		for (FWorkerComponentData& Component : static_cast<FCreateEntityRequest&>(Message).Components)
+		{
+			Schema_DestroyComponentData(Component.schema_type);
+		}
+		break;
+	case EOutgoingMessageType::AddComponent:
+		Schema_DestroyComponentData(static_cast<FAddComponent&>(Message).Data.schema_type);
+		break;
+	case EOutgoingMessageType::ComponentUpdate:
+		Schema_DestroyComponentUpdate(static_cast<FComponentUpdate&>(Message).Update.schema_type);
+		break;
+	case EOutgoingMessageType::CommandRequest:
+		Schema_DestroyCommandRequest(static_cast<FCommandRequest&>(Message).Request.schema_type);
+		break;
+	case EOutgoingMessageType::CommandResponse:
+		Schema_DestroyCommandResponse(static_cast<FCommandResponse&>(Message).Response.schema_type);
+		break;
+	default:
+		break;
+	}
+}
+
 void FEntityQueryRequest::TraverseConstraint(Worker_Constraint* Constraint)
 {
 	switch (Constraint->constraint_type)
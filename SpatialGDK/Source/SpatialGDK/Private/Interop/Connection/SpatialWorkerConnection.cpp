@@ -3,19 +3,60 @@
 #include "Interop/Connection/SpatialWorkerConnection.h"
 
 #include "Async/Async.h"
+#include "Misc/CommandLine.h"
+#include "SpatialConstants.h"
 #include "SpatialGDKSettings.h"
 
 DEFINE_LOG_CATEGORY(LogSpatialWorkerConnection);
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Outgoing Message Queue Depth"), STAT_SpatialOutgoingMessageQueueDepth, STATGROUP_SpatialNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Outgoing Message Queue Stalls"), STAT_SpatialOutgoingMessageQueueStalls, STATGROUP_SpatialNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Coalesced Component Updates"), STAT_SpatialCoalescedComponentUpdates, STATGROUP_SpatialNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Deferred Outgoing Messages"), STAT_SpatialDeferredOutgoingMessages, STATGROUP_SpatialNet);
+
 using namespace SpatialGDK;
 
+void USpatialWorkerConnection::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return;
+	}
+
+	// Created up front rather than in SetConnection, so that messages sent before the connection is set are queued.
+	const USpatialGDKSettings* SpatialGDKSettings = GetDefault<USpatialGDKSettings>();
+	OutgoingMessagesQueue = MakeUnique<FOutgoingMessageQueue>(SpatialGDKSettings->OutgoingMessageQueueCapacity);
+
+	FOutgoingMessageBudget Budget;
+	Budget.MaxMessagesPerFlush = SpatialGDKSettings->MaxOutgoingMessagesPerFlush;
+	Budget.MaxBytesPerFlush = SpatialGDKSettings->MaxOutgoingBytesPerFlush;
+	Budget.MaxDeferredFlushes = SpatialGDKSettings->MaxDeferredOutgoingMessageFlushes;
+	OutgoingMessageScheduler = MakeUnique<FOutgoingMessageScheduler>(Budget);
+
+	if (SpatialGDKSettings->bWakeSpatialWorkerConnectionOnSend && !SpatialGDKSettings->bRunSpatialWorkerConnectionOnGameThread)
+	{
+		OutgoingMessageQueuedEvent = FPlatformProcess::GetSynchEventFromPool();
+	}
+}
+
 void USpatialWorkerConnection::SetConnection(Worker_Connection* WorkerConnectionIn)
 {
 	WorkerConnection = WorkerConnectionIn;
 
 	CacheWorkerAttributes();
 
-	const USpatialGDKSettings* SpatialGDKSettings = GetDefault<USpatialGDKSettings>();    
+	const USpatialGDKSettings* SpatialGDKSettings = GetDefault<USpatialGDKSettings>();
+	bCoalesceComponentUpdates = SpatialGDKSettings->bCoalesceOutgoingComponentUpdates;
+	bTrackOutgoingMessageStats = SpatialGDKSettings->bTrackOutgoingMessageStats;
+
+	FString OpRecordingFilename;
+	if (FParse::Value(FCommandLine::Get(), TEXT("SpatialOpRecording="), OpRecordingFilename))
+	{
+		StartRecordingOpLists(OpRecordingFilename);
+	}
+
 	if (!SpatialGDKSettings->bRunSpatialWorkerConnectionOnGameThread)  
 	{
 		if (OpsProcessingThread == nullptr)
@@ -31,6 +72,12 @@ void USpatialWorkerConnection::FinishDestroy()
 
 	DestroyConnection();
 
+	if (OutgoingMessageQueuedEvent != nullptr)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(OutgoingMessageQueuedEvent);
+		OutgoingMessageQueuedEvent = nullptr;
+	}
+
 	Super::FinishDestroy();
 }
 
@@ -43,6 +90,9 @@ void USpatialWorkerConnection::DestroyConnection()
 		OpsProcessingThread = nullptr;
 	}
 
+	// Nothing sends them once the ops thread has stopped, and the Worker SDK never took ownership of their schema objects.
+	DropOutgoingMessages();
+
 	if (WorkerConnection)
 	{
 		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WorkerConnection = WorkerConnection]
@@ -53,6 +103,8 @@ void USpatialWorkerConnection::DestroyConnection()
 		WorkerConnection = nullptr;
 	}
 
+	StopRecordingOpLists();
+
 	NextRequestId = 0;
 	KeepRunning.AtomicSet(true);
 }
@@ -67,9 +119,25 @@ TArray<Worker_OpList*> USpatialWorkerConnection::GetOpList()
 		OpLists.Add(OutOpList);
 	}
 
+	if (OpListRecorder.IsValid() && OpLists.Num() > 0)
+	{
+		OpListRecorder->RecordFrame(OpLists);
+	}
+
 	return OpLists;
 }
 
+bool USpatialWorkerConnection::StartRecordingOpLists(const FString& Filename)
+{
+	OpListRecorder = FOpListRecorder::Create(Filename);
+	return OpListRecorder.IsValid();
+}
+
+void USpatialWorkerConnection::StopRecordingOpLists()
+{
+	OpListRecorder.Reset();
+}
+
 Worker_RequestId USpatialWorkerConnection::SendReserveEntityIdsRequest(uint32_t NumOfEntities)
 {
 	QueueOutgoingMessage<FReserveEntityIdsRequest>(NumOfEntities);
@@ -150,6 +218,33 @@ const TArray<FString>& USpatialWorkerConnection::GetWorkerAttributes() const
 	return CachedWorkerAttributes;
 }
 
+uint32 USpatialWorkerConnection::GetOutgoingMessageQueueDepth() const
+{
+	return OutgoingMessagesQueue.IsValid() ? OutgoingMessagesQueue->Num() : 0;
+}
+
+uint32 USpatialWorkerConnection::GetOutgoingMessageQueueStallCount() const
+{
+	return OutgoingMessageQueueStalls.Load();
+}
+
+void USpatialWorkerConnection::SetTrackOutgoingMessageStats(bool bTrack)
+{
+	bTrackOutgoingMessageStats = bTrack;
+}
+
+FOutgoingMessageStats USpatialWorkerConnection::GetOutgoingMessageStats() const
+{
+	FScopeLock Lock(&OutgoingMessageStatsMutex);
+	return OutgoingMessageStats;
+}
+
+void USpatialWorkerConnection::ResetOutgoingMessageStats()
+{
+	FScopeLock Lock(&OutgoingMessageStatsMutex);
+	OutgoingMessageStats.Reset();
+}
+
 void USpatialWorkerConnection::CacheWorkerAttributes()
 {
 	const Worker_WorkerAttributes* Attributes = Worker_Connection_GetWorkerAttributes(WorkerConnection);
@@ -169,7 +264,11 @@ void USpatialWorkerConnection::CacheWorkerAttributes()
 
 bool USpatialWorkerConnection::Init()
 {
-	OpsUpdateInterval = 1.0f / GetDefault<USpatialGDKSettings>()->OpsUpdateRate;
+	const USpatialGDKSettings* SpatialGDKSettings = GetDefault<USpatialGDKSettings>();
+	OpsUpdateInterval = 1.0f / SpatialGDKSettings->OpsUpdateRate;
+	bWakeOnOutgoingMessage = OutgoingMessageQueuedEvent != nullptr;
+	// A zero timeout would turn the wait for outgoing messages into a busy loop.
+	OpsPollIntervalMillis = FMath::Max(SpatialGDKSettings->OpsPollIntervalMillis, 1u);
 
 	return true;
 }
@@ -181,9 +280,22 @@ uint32 USpatialWorkerConnection::Run()
 
 	while (KeepRunning)
 	{
-		FPlatformProcess::Sleep(OpsUpdateInterval);
-		QueueLatestOpList();
-		ProcessOutgoingMessages();
+		if (bWakeOnOutgoingMessage)
+		{
+			ProcessOutgoingMessages();
+			QueueLatestOpList();
+
+			// Ops are polled for, so this wait is what bounds their latency: it ends after OpsPollIntervalMillis, or earlier if the
+			// game thread queues a message. The event resets when it wakes this thread, and the next flush drains every message
+			// queued since, so a busy game thread can't make it spin.
+			OutgoingMessageQueuedEvent->Wait(OpsPollIntervalMillis);
+		}
+		else
+		{
+			FPlatformProcess::Sleep(OpsUpdateInterval);
+			QueueLatestOpList();
+			ProcessOutgoingMessages();
+		}
 	}
 
 	return 0;
@@ -192,6 +304,11 @@ uint32 USpatialWorkerConnection::Run()
 void USpatialWorkerConnection::Stop()
 {
 	KeepRunning.AtomicSet(false);
+
+	if (OutgoingMessageQueuedEvent != nullptr)
+	{
+		OutgoingMessageQueuedEvent->Trigger();
+	}
 }
 
 void USpatialWorkerConnection::InitializeOpsProcessingThread()
@@ -217,214 +334,397 @@ void USpatialWorkerConnection::QueueLatestOpList()
 
 void USpatialWorkerConnection::ProcessOutgoingMessages()
 {
-	while (!OutgoingMessagesQueue.IsEmpty())
-	{
-		TUniquePtr<FOutgoingMessage> OutgoingMessage;
-		OutgoingMessagesQueue.Dequeue(OutgoingMessage);
+	SET_DWORD_STAT(STAT_SpatialOutgoingMessageQueueDepth, OutgoingMessagesQueue->Num());
 
-		OnDequeueMessage.Broadcast(OutgoingMessage.Get());
-
-		static const Worker_UpdateParameters DisableLoopback{ /*loopback*/ WORKER_COMPONENT_UPDATE_LOOPBACK_NONE };
-
-		switch (OutgoingMessage->Type)
+	const auto Send = [this](FOutgoingMessage& OutgoingMessage)
+	{
+		// Anything other than a component update must not overtake the updates held back before it.
+		// They are flushed before timing the message, so that its send duration is its own.
+		if (OutgoingMessage.Type != EOutgoingMessageType::ComponentUpdate)
 		{
-		case EOutgoingMessageType::ReserveEntityIdsRequest:
+			SendCoalescedComponentUpdates();
+		}
+
+		// Coalesced updates are only charged and recorded once SendCoalescedComponentUpdates actually sends them.
+		if (bCoalesceComponentUpdates && OutgoingMessage.Type == EOutgoingMessageType::ComponentUpdate)
 		{
-			FReserveEntityIdsRequest* Message = static_cast<FReserveEntityIdsRequest*>(OutgoingMessage.Get());
+			SendOutgoingMessage(&OutgoingMessage);
+			return false;
+		}
 
-			Worker_Connection_SendReserveEntityIdsRequest(WorkerConnection,
-				Message->NumOfEntities,
-				nullptr);
-			break;
+		if (!bTrackOutgoingMessageStats)
+		{
+			SendOutgoingMessage(&OutgoingMessage);
+			return true;
 		}
-		case EOutgoingMessageType::CreateEntityRequest:
+
+		// The Worker SDK takes ownership of the payload, so measure it before sending.
+		const uint32 PayloadBytes = GetOutgoingMessageSize(OutgoingMessage);
+		const uint64 SendStartCycles = FPlatformTime::Cycles64();
+		SendOutgoingMessage(&OutgoingMessage);
+		const uint64 SendDurationCycles = FPlatformTime::Cycles64() - SendStartCycles;
+
+		FScopeLock Lock(&OutgoingMessageStatsMutex);
+		OutgoingMessageStats.RecordSentMessage(OutgoingMessage, SendStartCycles, SendDurationCycles, PayloadBytes);
+		return true;
+	};
+
+	OutgoingMessageScheduler->BeginFlush(Send);
+
+	while (FOutgoingMessage* OutgoingMessage = OutgoingMessagesQueue->Peek())
+	{
+		OnDequeueMessage.Broadcast(OutgoingMessage);
+
+		// Held back updates are charged as they are sent, so they are sent before anything the budget applies to is scheduled.
+		if (OutgoingMessage->Type != EOutgoingMessageType::ComponentUpdate)
 		{
-			FCreateEntityRequest* Message = static_cast<FCreateEntityRequest*>(OutgoingMessage.Get());
+			SendCoalescedComponentUpdates();
+		}
+
+		// Either sends the message or moves it out of the queue, to be sent in a later flush.
+		OutgoingMessageScheduler->Schedule(*OutgoingMessage, Send);
+
+		OutgoingMessagesQueue->Pop();
+	}
+
+	// Before ending the flush, so that they count towards its budget.
+	SendCoalescedComponentUpdates();
+
+	OutgoingMessageScheduler->EndFlush(Send);
+
+	SET_DWORD_STAT(STAT_SpatialDeferredOutgoingMessages, OutgoingMessageScheduler->GetNumDeferredMessages());
+}
+
+void USpatialWorkerConnection::SendOutgoingMessage(FOutgoingMessage* OutgoingMessage)
+{
+	static const Worker_UpdateParameters DisableLoopback{ /*loopback*/ WORKER_COMPONENT_UPDATE_LOOPBACK_NONE };
+
+	switch (OutgoingMessage->Type)
+	{
+	case EOutgoingMessageType::ReserveEntityIdsRequest:
+	{
+		FReserveEntityIdsRequest* Message = static_cast<FReserveEntityIdsRequest*>(OutgoingMessage);
+
+		Worker_Connection_SendReserveEntityIdsRequest(WorkerConnection,
+			Message->NumOfEntities,
+			nullptr);
+		break;
+	}
+	case EOutgoingMessageType::CreateEntityRequest:
+	{
+		FCreateEntityRequest* Message = static_cast<FCreateEntityRequest*>(OutgoingMessage);
 
 #if TRACE_LIB_ACTIVE
-			// We have to unpack these as Worker_ComponentData is not the same as FWorkerComponentData
-			TArray<Worker_ComponentData> UnpackedComponentData;
-			UnpackedComponentData.SetNum(Message->Components.Num());
-			for (int i = 0, Num = Message->Components.Num(); i < Num; i++)
-			{
-				UnpackedComponentData[i] = Message->Components[i];
-			}
-			Worker_ComponentData* ComponentData = UnpackedComponentData.GetData();
-			uint32 ComponentCount = UnpackedComponentData.Num();
-#else
-			Worker_ComponentData* ComponentData = Message->Components.GetData();
-			uint32 ComponentCount = Message->Components.Num();
-#endif
-			Worker_Connection_SendCreateEntityRequest(WorkerConnection,
-				ComponentCount,
-				ComponentData,
-				Message->EntityId.IsSet() ? &(Message->EntityId.GetValue()) : nullptr,
-				nullptr);
-			break;
-		}
-		case EOutgoingMessageType::DeleteEntityRequest:
+		// We have to unpack these as Worker_ComponentData is not the same as FWorkerComponentData
+		TArray<Worker_ComponentData> UnpackedComponentData;
+		UnpackedComponentData.SetNum(Message->Components.Num());
+		for (int i = 0, Num = Message->Components.Num(); i < Num; i++)
 		{
-			FDeleteEntityRequest* Message = static_cast<FDeleteEntityRequest*>(OutgoingMessage.Get());
-
-			Worker_Connection_SendDeleteEntityRequest(WorkerConnection,
-				Message->EntityId,
-				nullptr);
-			break;
+			UnpackedComponentData[i] = Message->Components[i];
 		}
-		case EOutgoingMessageType::AddComponent:
-		{
-			FAddComponent* Message = static_cast<FAddComponent*>(OutgoingMessage.Get());
+		Worker_ComponentData* ComponentData = UnpackedComponentData.GetData();
+		uint32 ComponentCount = UnpackedComponentData.Num();
+#else
+		Worker_ComponentData* ComponentData = Message->Components.GetData();
+		uint32 ComponentCount = Message->Components.Num();
+#endif
+		Worker_Connection_SendCreateEntityRequest(WorkerConnection,
+			ComponentCount,
+			ComponentData,
+			Message->EntityId.IsSet() ? &(Message->EntityId.GetValue()) : nullptr,
+			nullptr);
+		break;
+	}
+	case EOutgoingMessageType::DeleteEntityRequest:
+	{
+		FDeleteEntityRequest* Message = static_cast<FDeleteEntityRequest*>(OutgoingMessage);
 
-			Worker_Connection_SendAddComponent(WorkerConnection,
-				Message->EntityId,
-				&Message->Data,
-				&DisableLoopback);
-			break;
-		}
-		case EOutgoingMessageType::RemoveComponent:
-		{
-			FRemoveComponent* Message = static_cast<FRemoveComponent*>(OutgoingMessage.Get());
+		Worker_Connection_SendDeleteEntityRequest(WorkerConnection,
+			Message->EntityId,
+			nullptr);
+		break;
+	}
+	case EOutgoingMessageType::AddComponent:
+	{
+		FAddComponent* Message = static_cast<FAddComponent*>(OutgoingMessage);
 
-			Worker_Connection_SendRemoveComponent(WorkerConnection,
-				Message->EntityId,
-				Message->ComponentId,
-				&DisableLoopback);
-			break;
-		}
-		case EOutgoingMessageType::ComponentUpdate:
-		{
-			FComponentUpdate* Message = static_cast<FComponentUpdate*>(OutgoingMessage.Get());
+		Worker_Connection_SendAddComponent(WorkerConnection,
+			Message->EntityId,
+			&Message->Data,
+			&DisableLoopback);
+		break;
+	}
+	case EOutgoingMessageType::RemoveComponent:
+	{
+		FRemoveComponent* Message = static_cast<FRemoveComponent*>(OutgoingMessage);
 
-			Worker_Connection_SendComponentUpdate(WorkerConnection,
-				Message->EntityId,
-				&Message->Update,
-				&DisableLoopback);
+		Worker_Connection_SendRemoveComponent(WorkerConnection,
+			Message->EntityId,
+			Message->ComponentId,
+			&DisableLoopback);
+		break;
+	}
+	case EOutgoingMessageType::ComponentUpdate:
+	{
+		FComponentUpdate* Message = static_cast<FComponentUpdate*>(OutgoingMessage);
 
-			break;
-		}
-		case EOutgoingMessageType::CommandRequest:
+		if (bCoalesceComponentUpdates)
 		{
-			FCommandRequest* Message = static_cast<FCommandRequest*>(OutgoingMessage.Get());
-
-			static const Worker_CommandParameters DefaultCommandParams{};
-			Worker_Connection_SendCommandRequest(WorkerConnection,
-				Message->EntityId,
-				&Message->Request,
-				nullptr,
-				&DefaultCommandParams);
+			CoalesceComponentUpdate(Message->EntityId, Message->Update, Message->EnqueueCycles);
 			break;
 		}
-		case EOutgoingMessageType::CommandResponse:
-		{
-			FCommandResponse* Message = static_cast<FCommandResponse*>(OutgoingMessage.Get());
 
-			Worker_Connection_SendCommandResponse(WorkerConnection,
-				Message->RequestId,
-				&Message->Response);
-			break;
-		}
-		case EOutgoingMessageType::CommandFailure:
-		{
-			FCommandFailure* Message = static_cast<FCommandFailure*>(OutgoingMessage.Get());
+		Worker_Connection_SendComponentUpdate(WorkerConnection,
+			Message->EntityId,
+			&Message->Update,
+			&DisableLoopback);
 
-			Worker_Connection_SendCommandFailure(WorkerConnection,
-				Message->RequestId,
-				TCHAR_TO_UTF8(*Message->Message));
-			break;
-		}
-		case EOutgoingMessageType::LogMessage:
-		{
-			FLogMessage* Message = static_cast<FLogMessage*>(OutgoingMessage.Get());
+		break;
+	}
+	case EOutgoingMessageType::CommandRequest:
+	{
+		FCommandRequest* Message = static_cast<FCommandRequest*>(OutgoingMessage);
+
+		static const Worker_CommandParameters DefaultCommandParams{};
+		Worker_Connection_SendCommandRequest(WorkerConnection,
+			Message->EntityId,
+			&Message->Request,
+			nullptr,
+			&DefaultCommandParams);
+		break;
+	}
+	case EOutgoingMessageType::CommandResponse:
+	{
+		FCommandResponse* Message = static_cast<FCommandResponse*>(OutgoingMessage);
 
-			FTCHARToUTF8 LoggerName(*Message->LoggerName.ToString());
-			FTCHARToUTF8 LogString(*Message->Message);
+		Worker_Connection_SendCommandResponse(WorkerConnection,
+			Message->RequestId,
+			&Message->Response);
+		break;
+	}
+	case EOutgoingMessageType::CommandFailure:
+	{
+		FCommandFailure* Message = static_cast<FCommandFailure*>(OutgoingMessage);
 
-			Worker_LogMessage LogMessage{};
-			LogMessage.level = Message->Level;
-			LogMessage.logger_name = LoggerName.Get();
-			LogMessage.message = LogString.Get();
-			Worker_Connection_SendLogMessage(WorkerConnection, &LogMessage);
-			break;
-		}
-		case EOutgoingMessageType::ComponentInterest:
-		{
-			FComponentInterest* Message = static_cast<FComponentInterest*>(OutgoingMessage.Get());
+		Worker_Connection_SendCommandFailure(WorkerConnection,
+			Message->RequestId,
+			TCHAR_TO_UTF8(*Message->Message));
+		break;
+	}
+	case EOutgoingMessageType::LogMessage:
+	{
+		FLogMessage* Message = static_cast<FLogMessage*>(OutgoingMessage);
 
-			Worker_Connection_SendComponentInterest(WorkerConnection,
-				Message->EntityId,
-				Message->Interests.GetData(),
-				Message->Interests.Num());
-			break;
-		}
-		case EOutgoingMessageType::EntityQueryRequest:
-		{
-			FEntityQueryRequest* Message = static_cast<FEntityQueryRequest*>(OutgoingMessage.Get());
+		FTCHARToUTF8 LoggerName(*Message->LoggerName.ToString());
+		FTCHARToUTF8 LogString(*Message->Message);
 
-			Worker_Connection_SendEntityQueryRequest(WorkerConnection,
-				&Message->EntityQuery,
-				nullptr);
-			break;
-		}
-		case EOutgoingMessageType::Metrics:
+		Worker_LogMessage LogMessage{};
+		LogMessage.level = Message->Level;
+		LogMessage.logger_name = LoggerName.Get();
+		LogMessage.message = LogString.Get();
+		Worker_Connection_SendLogMessage(WorkerConnection, &LogMessage);
+		break;
+	}
+	case EOutgoingMessageType::ComponentInterest:
+	{
+		FComponentInterest* Message = static_cast<FComponentInterest*>(OutgoingMessage);
+
+		Worker_Connection_SendComponentInterest(WorkerConnection,
+			Message->EntityId,
+			Message->Interests.GetData(),
+			Message->Interests.Num());
+		break;
+	}
+	case EOutgoingMessageType::EntityQueryRequest:
+	{
+		FEntityQueryRequest* Message = static_cast<FEntityQueryRequest*>(OutgoingMessage);
+
+		Worker_Connection_SendEntityQueryRequest(WorkerConnection,
+			&Message->EntityQuery,
+			nullptr);
+		break;
+	}
+	case EOutgoingMessageType::Metrics:
+	{
+		FMetrics* Message = static_cast<FMetrics*>(OutgoingMessage);
+
+		// Do the conversion here so we can store everything on the stack.
+		Worker_Metrics WorkerMetrics;
+
+		WorkerMetrics.load = Message->Metrics.Load.IsSet() ? &Message->Metrics.Load.GetValue() : nullptr;
+
+		TArray<Worker_GaugeMetric> WorkerGaugeMetrics;
+		WorkerGaugeMetrics.SetNum(Message->Metrics.GaugeMetrics.Num());
+		for (int i = 0; i < Message->Metrics.GaugeMetrics.Num(); i++)
 		{
-			FMetrics* Message = static_cast<FMetrics*>(OutgoingMessage.Get());
+			WorkerGaugeMetrics[i].key = Message->Metrics.GaugeMetrics[i].Key.c_str();
+			WorkerGaugeMetrics[i].value = Message->Metrics.GaugeMetrics[i].Value;
+		}
 
-			// Do the conversion here so we can store everything on the stack.
-			Worker_Metrics WorkerMetrics;
+		WorkerMetrics.gauge_metric_count = static_cast<uint32_t>(WorkerGaugeMetrics.Num());
+		WorkerMetrics.gauge_metrics = WorkerGaugeMetrics.GetData();
 
-			WorkerMetrics.load = Message->Metrics.Load.IsSet() ? &Message->Metrics.Load.GetValue() : nullptr;
+		TArray<Worker_HistogramMetric> WorkerHistogramMetrics;
+		TArray<TArray<Worker_HistogramMetricBucket>> WorkerHistogramMetricBuckets;
+		WorkerHistogramMetrics.SetNum(Message->Metrics.HistogramMetrics.Num());
+		WorkerHistogramMetricBuckets.SetNum(Message->Metrics.HistogramMetrics.Num());
+		for (int i = 0; i < Message->Metrics.HistogramMetrics.Num(); i++)
+		{
+			WorkerHistogramMetrics[i].key = Message->Metrics.HistogramMetrics[i].Key.c_str();
+			WorkerHistogramMetrics[i].sum = Message->Metrics.HistogramMetrics[i].Sum;
 
-			TArray<Worker_GaugeMetric> WorkerGaugeMetrics;
-			WorkerGaugeMetrics.SetNum(Message->Metrics.GaugeMetrics.Num());
-			for (int i = 0; i < Message->Metrics.GaugeMetrics.Num(); i++)
+			WorkerHistogramMetricBuckets[i].SetNum(Message->Metrics.HistogramMetrics[i].Buckets.Num());
+			for (int j = 0; j < Message->Metrics.HistogramMetrics[i].Buckets.Num(); j++)
 			{
-				WorkerGaugeMetrics[i].key = Message->Metrics.GaugeMetrics[i].Key.c_str();
-				WorkerGaugeMetrics[i].value = Message->Metrics.GaugeMetrics[i].Value;
+				WorkerHistogramMetricBuckets[i][j].upper_bound = Message->Metrics.HistogramMetrics[i].Buckets[j].UpperBound;
+				WorkerHistogramMetricBuckets[i][j].samples = Message->Metrics.HistogramMetrics[i].Buckets[j].Samples;
 			}
 
-			WorkerMetrics.gauge_metric_count = static_cast<uint32_t>(WorkerGaugeMetrics.Num());
-			WorkerMetrics.gauge_metrics = WorkerGaugeMetrics.GetData();
+			WorkerHistogramMetrics[i].bucket_count = static_cast<uint32_t>(WorkerHistogramMetricBuckets[i].Num());
+			WorkerHistogramMetrics[i].buckets = WorkerHistogramMetricBuckets[i].GetData();
+		}
 
-			TArray<Worker_HistogramMetric> WorkerHistogramMetrics;
-			TArray<TArray<Worker_HistogramMetricBucket>> WorkerHistogramMetricBuckets;
-			WorkerHistogramMetrics.SetNum(Message->Metrics.HistogramMetrics.Num());
-			for (int i = 0; i < Message->Metrics.HistogramMetrics.Num(); i++)
-			{
-				WorkerHistogramMetrics[i].key = Message->Metrics.HistogramMetrics[i].Key.c_str();
-				WorkerHistogramMetrics[i].sum = Message->Metrics.HistogramMetrics[i].Sum;
-
-				WorkerHistogramMetricBuckets[i].SetNum(Message->Metrics.HistogramMetrics[i].Buckets.Num());
-				for (int j = 0; j < Message->Metrics.HistogramMetrics[i].Buckets.Num(); j++)
-				{
-					WorkerHistogramMetricBuckets[i][j].upper_bound = Message->Metrics.HistogramMetrics[i].Buckets[j].UpperBound;
-					WorkerHistogramMetricBuckets[i][j].samples = Message->Metrics.HistogramMetrics[i].Buckets[j].Samples;
-				}
-
-				WorkerHistogramMetrics[i].bucket_count = static_cast<uint32_t>(WorkerHistogramMetricBuckets[i].Num());
-				WorkerHistogramMetrics[i].buckets = WorkerHistogramMetricBuckets[i].GetData();
-			}
+		WorkerMetrics.histogram_metric_count = static_cast<uint32_t>(WorkerHistogramMetrics.Num());
+		WorkerMetrics.histogram_metrics = WorkerHistogramMetrics.GetData();
 
-			WorkerMetrics.histogram_metric_count = static_cast<uint32_t>(WorkerHistogramMetrics.Num());
-			WorkerMetrics.histogram_metrics = WorkerHistogramMetrics.GetData();
+		Worker_Connection_SendMetrics(WorkerConnection, &WorkerMetrics);
+		break;
+	}
+	default:
+	{
+		checkNoEntry();
+		break;
+	}
+	}
+}
 
-			Worker_Connection_SendMetrics(WorkerConnection, &WorkerMetrics);
-			break;
+void USpatialWorkerConnection::CoalesceComponentUpdate(Worker_EntityId EntityId, const FWorkerComponentUpdate& Update, uint64 EnqueueCycles)
+{
+	const EntityComponentId Id = { EntityId, Update.component_id };
+
+	if (const int32* Index = CoalescedComponentUpdateIndices.Find(Id))
+	{
+		// Merges fields, cleared fields and events of the newer update into the held back one.
+		Schema_ComponentUpdate* Target = CoalescedComponentUpdates[*Index].Update.schema_type;
+		if (Schema_MergeComponentUpdateIntoComponentUpdate(Update.schema_type, Target) != 0)
+		{
+			Schema_DestroyComponentUpdate(Update.schema_type);
+			INC_DWORD_STAT(STAT_SpatialCoalescedComponentUpdates);
+			return;
 		}
-		default:
+
+		// Fall back to sending both updates, in order.
+		UE_LOG(LogSpatialWorkerConnection, Warning, TEXT("Failed to merge component update for entity %lld component %d, sending it separately."), EntityId, Update.component_id);
+		SendCoalescedComponentUpdates();
+	}
+
+	CoalescedComponentUpdateIndices.Add(Id, CoalescedComponentUpdates.Num());
+	CoalescedComponentUpdates.Add(FCoalescedComponentUpdate{ EntityId, Update, EnqueueCycles });
+}
+
+void USpatialWorkerConnection::SendCoalescedComponentUpdates()
+{
+	if (CoalescedComponentUpdates.Num() == 0)
+	{
+		return;
+	}
+
+	static const Worker_UpdateParameters DisableLoopback{ /*loopback*/ WORKER_COMPONENT_UPDATE_LOOPBACK_NONE };
+
+	for (const FCoalescedComponentUpdate& CoalescedUpdate : CoalescedComponentUpdates)
+	{
+		// The Worker SDK takes ownership of the update, so measure it before sending.
+		const bool bMeasure = bTrackOutgoingMessageStats || OutgoingMessageScheduler->IsBudgetingBytes();
+		const uint32 PayloadBytes = bMeasure ? GetComponentUpdateSize(CoalescedUpdate.Update) : 0;
+		OutgoingMessageScheduler->ChargeSentMessage(PayloadBytes);
+
+		if (!bTrackOutgoingMessageStats)
 		{
-			checkNoEntry();
-			break;
+			Worker_Connection_SendComponentUpdate(WorkerConnection,
+				CoalescedUpdate.EntityId,
+				&CoalescedUpdate.Update,
+				&DisableLoopback);
+			continue;
 		}
+
+		const uint64 SendStartCycles = FPlatformTime::Cycles64();
+		Worker_Connection_SendComponentUpdate(WorkerConnection,
+			CoalescedUpdate.EntityId,
+			&CoalescedUpdate.Update,
+			&DisableLoopback);
+		const uint64 SendDurationCycles = FPlatformTime::Cycles64() - SendStartCycles;
+
+		FScopeLock Lock(&OutgoingMessageStatsMutex);
+		OutgoingMessageStats.RecordSentComponentUpdate(CoalescedUpdate.Update.component_id, CoalescedUpdate.EnqueueCycles, SendStartCycles, SendDurationCycles, PayloadBytes);
+	}
+
+	// Keep the allocations around, they will be needed again on the next flush.
+	CoalescedComponentUpdates.Reset();
+	CoalescedComponentUpdateIndices.Reset();
+}
+
+void USpatialWorkerConnection::DropOutgoingMessages()
+{
+	if (OutgoingMessagesQueue.IsValid())
+	{
+		while (FOutgoingMessage* OutgoingMessage = OutgoingMessagesQueue->Peek())
+		{
+			DestroyOutgoingMessageSchemaObjects(*OutgoingMessage);
+			OutgoingMessagesQueue->Pop();
 		}
 	}
+
+	if (OutgoingMessageScheduler.IsValid())
+	{
+		OutgoingMessageScheduler->DropDeferredMessages();
+	}
+
+	for (const FCoalescedComponentUpdate& CoalescedUpdate : CoalescedComponentUpdates)
+	{
+		Schema_DestroyComponentUpdate(CoalescedUpdate.Update.schema_type);
+	}
+	CoalescedComponentUpdates.Reset();
+	CoalescedComponentUpdateIndices.Reset();
 }
 
 template <typename T, typename... ArgsType>
 void USpatialWorkerConnection::QueueOutgoingMessage(ArgsType&&... Args)
 {
-	// TODO UNR-1271: As later optimization, we can change the queue to hold a union
-	// of all outgoing message types, rather than having a pointer.
-	auto Message = MakeUnique<T>(Forward<ArgsType>(Args)...);
-	OnEnqueueMessage.Broadcast(Message.Get());
-	OutgoingMessagesQueue.Enqueue(MoveTemp(Message));
+	const auto OnEnqueue = [this](FOutgoingMessage* Message)
+	{
+		if (bTrackOutgoingMessageStats)
+		{
+			Message->EnqueueCycles = FPlatformTime::Cycles64();
+		}
+		OnEnqueueMessage.Broadcast(Message);
+	};
+
+	// Arguments are only consumed once a slot has been claimed, so they are safe to forward again on retry.
+	bool bQueueWasEmpty = false;
+	while (!OutgoingMessagesQueue->TryEnqueue<T>(bQueueWasEmpty, OnEnqueue, Forward<ArgsType>(Args)...))
+	{
+		// The queue is full. Drain it here when there is no ops thread, otherwise give the ops thread a chance to catch up.
+		// Before the connection is set there is nothing to drain it into, so grow it and keep the messages until then.
+		INC_DWORD_STAT(STAT_SpatialOutgoingMessageQueueStalls);
+		OutgoingMessageQueueStalls++;
+
+		if (OpsProcessingThread == nullptr && WorkerConnection == nullptr)
+		{
+			OutgoingMessagesQueue->Grow();
+		}
+		else if (OpsProcessingThread == nullptr)
+		{
+			ProcessOutgoingMessages();
+		}
+		else
+		{
+			FPlatformProcess::Yield();
+		}
+	}
+
+	// The ops thread only goes back to sleep once it has drained the queue, so it only needs waking for the first message after that.
+	if (bQueueWasEmpty && OutgoingMessageQueuedEvent != nullptr)
+	{
+		OutgoingMessageQueuedEvent->Trigger();
+	}
 }
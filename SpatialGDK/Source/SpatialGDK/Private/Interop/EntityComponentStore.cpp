@@ -0,0 +1,274 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/EntityComponentStore.h"
+
+#include "HAL/UnrealMemory.h"
+#include "Templates/AlignmentTemplates.h"
+
+namespace SpatialGDK
+{
+
+FComponentSlabPool::FComponentSlabPool(uint32 InSlotSize, uint32 InSlotAlignment)
+	: SlotAlignment(FMath::Max<uint32>(InSlotAlignment, alignof(void*)))
+	, FreeList(nullptr)
+	, NumAllocated(0)
+{
+	SlotSize = Align(FMath::Max<uint32>(InSlotSize, sizeof(void*)), SlotAlignment);
+}
+
+FComponentSlabPool::~FComponentSlabPool()
+{
+	checkf(NumAllocated == 0, TEXT("Component pool destroyed with %d components still allocated."), NumAllocated);
+	for (void* Slab : Slabs)
+	{
+		FMemory::Free(Slab);
+	}
+}
+
+void* FComponentSlabPool::Allocate()
+{
+	if (FreeList == nullptr)
+	{
+		AddSlab();
+	}
+
+	void* Slot = FreeList;
+	FreeList = *static_cast<void**>(Slot);
+	++NumAllocated;
+	return Slot;
+}
+
+void FComponentSlabPool::Free(void* Slot)
+{
+	check(Slot != nullptr);
+	*static_cast<void**>(Slot) = FreeList;
+	FreeList = Slot;
+	--NumAllocated;
+}
+
+void FComponentSlabPool::AddSlab()
+{
+	uint8* Slab = static_cast<uint8*>(FMemory::Malloc(SlotSize * SlotsPerSlab, SlotAlignment));
+	Slabs.Add(Slab);
+
+	// Linked back to front, so slots are handed out in address order.
+	for (int32 i = SlotsPerSlab - 1; i >= 0; --i)
+	{
+		void* Slot = Slab + i * SlotSize;
+		*static_cast<void**>(Slot) = FreeList;
+		FreeList = Slot;
+	}
+}
+
+FEntityComponentStore::FEntityComponentStore()
+	: NumEntries(0)
+{
+}
+
+FEntityComponentStore::~FEntityComponentStore()
+{
+	for (FEntry& Entry : Entries)
+	{
+		if (Entry.EntityId != SpatialConstants::INVALID_ENTITY_ID)
+		{
+			DestroyComponentData(Entry);
+		}
+	}
+}
+
+void FEntityComponentStore::AddComponentWithoutData(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+{
+	SetComponent(EntityId, ComponentId, nullptr);
+}
+
+void FEntityComponentStore::RemoveComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+{
+	const int32 Index = FindIndex(EntityId, ComponentId);
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	FEntry& Entry = Entries[Index];
+	DestroyComponentData(Entry);
+	Entry.bHasComponent = false;
+
+	if (Entry.Authority == WORKER_AUTHORITY_NOT_AUTHORITATIVE)
+	{
+		RemoveEntry(Index);
+	}
+}
+
+void FEntityComponentStore::SetAuthority(Worker_EntityId EntityId, Worker_ComponentId ComponentId, Worker_Authority Authority)
+{
+	Entries[FindOrAddIndex(EntityId, ComponentId)].Authority = static_cast<uint8>(Authority);
+}
+
+void FEntityComponentStore::RemoveEntity(Worker_EntityId EntityId)
+{
+	TArray<Worker_ComponentId> ComponentIds;
+	if (!EntityComponentIds.RemoveAndCopyValue(EntityId, ComponentIds))
+	{
+		return;
+	}
+
+	for (const Worker_ComponentId ComponentId : ComponentIds)
+	{
+		// Removing shifts other entries, so each one is looked up again.
+		const int32 Index = FindIndex(EntityId, ComponentId);
+		check(Index != INDEX_NONE);
+		DestroyComponentData(Entries[Index]);
+		RemoveAt(Index);
+	}
+}
+
+void FEntityComponentStore::CopyEntryFrom(const FEntityComponentStore& Source, Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+{
+	const int32 SourceIndex = Source.FindIndex(EntityId, ComponentId);
+	if (SourceIndex == INDEX_NONE)
+	{
+		const int32 Index = FindIndex(EntityId, ComponentId);
+		if (Index != INDEX_NONE)
+		{
+			RemoveEntry(Index);
+		}
+
+		// The entity leaves once its last entry is gone, as it did in Source.
+		const TArray<Worker_ComponentId>* ComponentIds = EntityComponentIds.Find(EntityId);
+		if (ComponentIds != nullptr && ComponentIds->Num() == 0 && Source.GetEntityComponentIds(EntityId) == nullptr)
+		{
+			EntityComponentIds.Remove(EntityId);
+		}
+		return;
+	}
+
+	const FEntry& SourceEntry = Source.Entries[SourceIndex];
+	FEntry& Entry = Entries[FindOrAddIndex(EntityId, ComponentId)];
+	DestroyComponentData(Entry);
+	Entry.Authority = SourceEntry.Authority;
+	Entry.bHasComponent = SourceEntry.bHasComponent;
+
+	if (SourceEntry.Data != nullptr)
+	{
+		const FComponentType& SourceType = Source.ComponentTypes.FindChecked(ComponentId);
+		FComponentType& Type = FindOrAddComponentType(ComponentId, SourceType.Size, SourceType.Alignment, SourceType.CopyConstruct);
+		Entry.Data = Type.CopyConstruct(Type.Pool->Allocate(), *SourceEntry.Data);
+	}
+}
+
+int32 FEntityComponentStore::FindOrAddIndex(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+{
+	check(EntityId != SpatialConstants::INVALID_ENTITY_ID);
+
+	const int32 ExistingIndex = FindIndex(EntityId, ComponentId);
+	if (ExistingIndex != INDEX_NONE)
+	{
+		return ExistingIndex;
+	}
+
+	if ((NumEntries + 1) * 2 > Entries.Num())
+	{
+		Grow();
+	}
+
+	const uint32 Mask = Entries.Num() - 1;
+	uint32 Index = HashKey(EntityId, ComponentId) & Mask;
+	while (Entries[Index].EntityId != SpatialConstants::INVALID_ENTITY_ID)
+	{
+		Index = (Index + 1) & Mask;
+	}
+
+	Entries[Index] = FEntry{ EntityId, ComponentId, static_cast<uint8>(WORKER_AUTHORITY_NOT_AUTHORITATIVE), false, nullptr };
+	++NumEntries;
+	EntityComponentIds.FindOrAdd(EntityId).Add(ComponentId);
+	return Index;
+}
+
+void FEntityComponentStore::RemoveEntry(int32 Index)
+{
+	FEntry& Entry = Entries[Index];
+	DestroyComponentData(Entry);
+	if (TArray<Worker_ComponentId>* ComponentIds = EntityComponentIds.Find(Entry.EntityId))
+	{
+		ComponentIds->RemoveSingleSwap(Entry.ComponentId);
+	}
+	RemoveAt(Index);
+}
+
+void FEntityComponentStore::RemoveAt(int32 Index)
+{
+	const uint32 Mask = Entries.Num() - 1;
+	uint32 Hole = Index;
+	for (uint32 Next = (Hole + 1) & Mask; Entries[Next].EntityId != SpatialConstants::INVALID_ENTITY_ID; Next = (Next + 1) & Mask)
+	{
+		// An entry can only move back into the hole if the hole is not before its home slot in its probe sequence.
+		const uint32 Home = HashKey(Entries[Next].EntityId, Entries[Next].ComponentId) & Mask;
+		const bool bHomeBetweenHoleAndNext = Hole <= Next ? (Hole < Home && Home <= Next) : (Hole < Home || Home <= Next);
+		if (!bHomeBetweenHoleAndNext)
+		{
+			Entries[Hole] = Entries[Next];
+			Hole = Next;
+		}
+	}
+
+	Entries[Hole] = FEntry{ SpatialConstants::INVALID_ENTITY_ID, 0, 0, false, nullptr };
+	--NumEntries;
+}
+
+void FEntityComponentStore::Grow()
+{
+	TArray<FEntry> OldEntries = MoveTemp(Entries);
+	Entries.Init(FEntry{ SpatialConstants::INVALID_ENTITY_ID, 0, 0, false, nullptr }, FMath::Max(MinCapacity, OldEntries.Num() * 2));
+
+	const uint32 Mask = Entries.Num() - 1;
+	for (const FEntry& Entry : OldEntries)
+	{
+		if (Entry.EntityId == SpatialConstants::INVALID_ENTITY_ID)
+		{
+			continue;
+		}
+
+		uint32 Index = HashKey(Entry.EntityId, Entry.ComponentId) & Mask;
+		while (Entries[Index].EntityId != SpatialConstants::INVALID_ENTITY_ID)
+		{
+			Index = (Index + 1) & Mask;
+		}
+		Entries[Index] = Entry;
+	}
+}
+
+FEntityComponentStore::FComponentType& FEntityComponentStore::FindOrAddComponentType(Worker_ComponentId ComponentId, uint32 Size, uint32 Alignment, FCopyConstructFunction CopyConstruct)
+{
+	FComponentType& Type = ComponentTypes.FindOrAdd(ComponentId);
+	if (!Type.Pool.IsValid())
+	{
+		Type.Pool = MakeUnique<FComponentSlabPool>(Size, Alignment);
+		Type.CopyConstruct = CopyConstruct;
+		Type.Size = Size;
+		Type.Alignment = Alignment;
+	}
+	return Type;
+}
+
+void FEntityComponentStore::SetComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId, Component* Data)
+{
+	FEntry& Entry = Entries[FindOrAddIndex(EntityId, ComponentId)];
+	DestroyComponentData(Entry);
+	Entry.bHasComponent = true;
+	Entry.Data = Data;
+}
+
+void FEntityComponentStore::DestroyComponentData(FEntry& Entry)
+{
+	if (Entry.Data == nullptr)
+	{
+		return;
+	}
+
+	// Component types only derive from Component, so the component starts at the beginning of its slot.
+	Entry.Data->~Component();
+	ComponentTypes.FindChecked(Entry.ComponentId).Pool->Free(Entry.Data);
+	Entry.Data = nullptr;
+}
+
+} // namespace SpatialGDK
@@ -0,0 +1,133 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/LingeringActors.h"
+
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+
+namespace SpatialGDK
+{
+
+FLingeringActors::FLingeringActors()
+	: Clock([] { return FPlatformTime::Seconds(); })
+{
+}
+
+void FLingeringActors::Init(const TMap<TSoftClassPtr<AActor>, float>& LingerSecondsByClass, TFunction<double()> InClock /* = nullptr */)
+{
+	if (InClock)
+	{
+		Clock = MoveTemp(InClock);
+	}
+
+	for (const auto& LingerSeconds : LingerSecondsByClass)
+	{
+		if (!LingerSeconds.Key.IsNull() && LingerSeconds.Value > 0.0f)
+		{
+			LingerSecondsByClassPath.Add(LingerSeconds.Key.ToSoftObjectPath(), LingerSeconds.Value);
+		}
+	}
+}
+
+float FLingeringActors::GetLingerSeconds(UClass* Class)
+{
+	if (LingerSecondsByClassPath.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	if (const float* CachedLingerSeconds = LingerSecondsByClass.Find(Class))
+	{
+		return *CachedLingerSeconds;
+	}
+
+	float LingerSeconds = 0.0f;
+	for (UClass* ConfiguredClass = Class; ConfiguredClass != nullptr; ConfiguredClass = ConfiguredClass->GetSuperClass())
+	{
+		if (const float* ConfiguredLingerSeconds = LingerSecondsByClassPath.Find(FSoftObjectPath(ConfiguredClass)))
+		{
+			LingerSeconds = *ConfiguredLingerSeconds;
+			break;
+		}
+	}
+
+	LingerSecondsByClass.Add(Class, LingerSeconds);
+	return LingerSeconds;
+}
+
+bool FLingeringActors::StartLingering(Worker_EntityId EntityId, AActor* Actor)
+{
+	const float LingerSeconds = GetLingerSeconds(Actor->GetClass());
+	if (LingerSeconds <= 0.0f)
+	{
+		return false;
+	}
+
+	const double ExpiryTime = Clock() + LingerSeconds;
+	LingeringActors.Add(EntityId, FLingeringActor{ Actor, ExpiryTime });
+	ExpiryHeap.HeapPush(FExpiry{ EntityId, ExpiryTime });
+	DiscardStaleExpiries();
+	return true;
+}
+
+AActor* FLingeringActors::StopLingering(Worker_EntityId EntityId)
+{
+	FLingeringActor LingeringActor;
+	if (!LingeringActors.RemoveAndCopyValue(EntityId, LingeringActor))
+	{
+		return nullptr;
+	}
+
+	DiscardStaleExpiries();
+
+	AActor* Actor = LingeringActor.Actor.Get();
+	return Actor != nullptr && !Actor->IsPendingKill() ? Actor : nullptr;
+}
+
+TArray<Worker_EntityId> FLingeringActors::TakeExpired()
+{
+	TArray<Worker_EntityId> ExpiredEntityIds;
+
+	const double Now = Clock();
+	while (ExpiryHeap.Num() > 0 && ExpiryHeap.HeapTop().ExpiryTime <= Now)
+	{
+		FExpiry Expiry;
+		ExpiryHeap.HeapPop(Expiry, /* bAllowShrinking */ false);
+		if (!IsStale(Expiry))
+		{
+			LingeringActors.Remove(Expiry.EntityId);
+			ExpiredEntityIds.Add(Expiry.EntityId);
+		}
+	}
+
+	DiscardStaleExpiries();
+
+	return ExpiredEntityIds;
+}
+
+TOptional<double> FLingeringActors::GetSecondsUntilNextExpiry() const
+{
+	if (ExpiryHeap.Num() == 0)
+	{
+		return TOptional<double>();
+	}
+
+	return FMath::Max(ExpiryHeap.HeapTop().ExpiryTime - Clock(), 0.0);
+}
+
+bool FLingeringActors::IsStale(const FExpiry& Expiry) const
+{
+	// An entity that stopped lingering and started again has a newer expiry in the heap.
+	const FLingeringActor* LingeringActor = LingeringActors.Find(Expiry.EntityId);
+	return LingeringActor == nullptr || LingeringActor->ExpiryTime != Expiry.ExpiryTime;
+}
+
+void FLingeringActors::DiscardStaleExpiries()
+{
+	while (ExpiryHeap.Num() > 0 && IsStale(ExpiryHeap.HeapTop()))
+	{
+		ExpiryHeap.HeapPopDiscard(/* bAllowShrinking */ false);
+	}
+}
+
+} // namespace SpatialGDK
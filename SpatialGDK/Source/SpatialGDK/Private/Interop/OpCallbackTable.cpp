@@ -0,0 +1,102 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/OpCallbackTable.h"
+
+namespace SpatialGDK
+{
+
+FOpCallbackTable::FOpCallbackTable()
+	: NextCallbackId(1)
+{
+	ComponentBlockIndices.Init(INDEX_NONE, NumComponents);
+}
+
+bool FOpCallbackTable::IsSupportedComponent(Worker_ComponentId ComponentId)
+{
+	return SpatialConstants::MIN_EXTERNAL_SCHEMA_ID <= ComponentId && ComponentId <= SpatialConstants::MAX_EXTERNAL_SCHEMA_ID;
+}
+
+bool FOpCallbackTable::IsSupportedOpType(Worker_OpType OpType)
+{
+	return GetOpTypeIndex(OpType) != INDEX_NONE;
+}
+
+FOpCallbackTable::FCallbackId FOpCallbackTable::Add(Worker_ComponentId ComponentId, Worker_OpType OpType, FOpCallback Callback)
+{
+	check(IsSupportedComponent(ComponentId));
+	const int32 OpTypeIndex = GetOpTypeIndex(OpType);
+	check(OpTypeIndex != INDEX_NONE);
+
+	int32& BlockIndex = ComponentBlockIndices[ComponentId - SpatialConstants::MIN_EXTERNAL_SCHEMA_ID];
+	if (BlockIndex == INDEX_NONE)
+	{
+		BlockIndex = ComponentBlocks.AddDefaulted();
+	}
+
+	const FCallbackId NewCallbackId = NextCallbackId++;
+	ComponentBlocks[BlockIndex].ByOpType[OpTypeIndex].Add(FCallbackData{ NewCallbackId, MoveTemp(Callback) });
+	CallbackLocations.Add(NewCallbackId, FCallbackLocation{ BlockIndex, OpTypeIndex });
+	return NewCallbackId;
+}
+
+bool FOpCallbackTable::Remove(FCallbackId Id)
+{
+	FCallbackLocation Location;
+	if (!CallbackLocations.RemoveAndCopyValue(Id, Location))
+	{
+		return false;
+	}
+
+	// Blocks stay allocated, a component that had callbacks is likely to get them again.
+	TArray<FCallbackData>& Callbacks = ComponentBlocks[Location.BlockIndex].ByOpType[Location.OpTypeIndex];
+	const int32 CallbackIndex = Callbacks.IndexOfByPredicate([Id](const FCallbackData& Data)
+	{
+		return Data.Id == Id;
+	});
+	check(CallbackIndex != INDEX_NONE);
+	Callbacks.RemoveAt(CallbackIndex);
+	return true;
+}
+
+void FOpCallbackTable::Invoke(Worker_ComponentId ComponentId, const Worker_Op* Op) const
+{
+	if (!IsSupportedComponent(ComponentId))
+	{
+		return;
+	}
+
+	const int32 BlockIndex = ComponentBlockIndices[ComponentId - SpatialConstants::MIN_EXTERNAL_SCHEMA_ID];
+	const int32 OpTypeIndex = GetOpTypeIndex(static_cast<Worker_OpType>(Op->op_type));
+	if (BlockIndex == INDEX_NONE || OpTypeIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	for (const FCallbackData& CallbackData : ComponentBlocks[BlockIndex].ByOpType[OpTypeIndex])
+	{
+		CallbackData.Callback(Op);
+	}
+}
+
+int32 FOpCallbackTable::GetOpTypeIndex(Worker_OpType OpType)
+{
+	switch (OpType)
+	{
+	case WORKER_OP_TYPE_ADD_COMPONENT:
+		return 0;
+	case WORKER_OP_TYPE_REMOVE_COMPONENT:
+		return 1;
+	case WORKER_OP_TYPE_COMPONENT_UPDATE:
+		return 2;
+	case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+		return 3;
+	case WORKER_OP_TYPE_COMMAND_REQUEST:
+		return 4;
+	case WORKER_OP_TYPE_COMMAND_RESPONSE:
+		return 5;
+	default:
+		return INDEX_NONE;
+	}
+}
+
+} // namespace SpatialGDK
@@ -17,6 +17,8 @@
 
 #include "EngineClasses/SpatialNetDriver.h"
 #include "EngineClasses/SpatialPackageMapClient.h"
+#include "Utils/PropertyApplyPlan.h"
+#include "Utils/PropertySerializationPlan.h"
 #include "Utils/SpatialActorGroupManager.h"
 #include "Utils/RepLayoutUtils.h"
 
@@ -334,6 +336,48 @@ const FClassInfo& USpatialClassInfoManager::GetClassInfoByComponentId(Worker_Com
 	return Info.Get();
 }
 
+const SpatialGDK::FPropertySerializationPlan* USpatialClassInfoManager::GetOrCreateSerializationPlan(const FClassInfo& Info)
+{
+	if (!Info.Class.IsValid())
+	{
+		return nullptr;
+	}
+
+	if (const TSharedRef<const SpatialGDK::FPropertySerializationPlan>* Plan = SerializationPlanMap.Find(Info.Class))
+	{
+		return &Plan->Get();
+	}
+
+	// Built on first use rather than with the class info, so classes whose objects are never written get no rep layout built for them.
+	return &SerializationPlanMap.Add(Info.Class, MakeShared<const SpatialGDK::FPropertySerializationPlan>(NetDriver, Info)).Get();
+}
+
+const SpatialGDK::FPropertyApplyPlan* USpatialClassInfoManager::GetOrCreateApplyPlan(Worker_ComponentId ComponentId)
+{
+	if (const TSharedRef<const SpatialGDK::FPropertyApplyPlan>* Plan = ComponentToApplyPlanMap.Find(ComponentId))
+	{
+		return &Plan->Get();
+	}
+
+	const ESchemaComponentType Category = GetCategoryByComponentId(ComponentId);
+	if (Category != SCHEMA_Data && Category != SCHEMA_OwnerOnly && Category != SCHEMA_Handover)
+	{
+		return nullptr;
+	}
+
+	const FClassInfo& Info = GetClassInfoByComponentId(ComponentId);
+	if (!Info.Class.IsValid())
+	{
+		return nullptr;
+	}
+
+	TSharedRef<const SpatialGDK::FPropertyApplyPlan> Plan = Category == SCHEMA_Handover
+		? SpatialGDK::FPropertyApplyPlan::CreateForHandover(NetDriver, Info)
+		: SpatialGDK::FPropertyApplyPlan::CreateForRepLayout(NetDriver, Info);
+
+	return &ComponentToApplyPlanMap.Add(ComponentId, Plan).Get();
+}
+
 UClass* USpatialClassInfoManager::GetClassByComponentId(Worker_ComponentId ComponentId)
 {
 	TSharedRef<FClassInfo> Info = ComponentToClassInfoMap.FindChecked(ComponentId);
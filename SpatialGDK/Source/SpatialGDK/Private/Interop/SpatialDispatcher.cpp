@@ -27,6 +27,12 @@ void SpatialDispatcher::Init(USpatialReceiver* InReceiver, USpatialStaticCompone
 }
 
 void SpatialDispatcher::ProcessOps(Worker_OpList* OpList)
+{
+	DispatchOps(OpList);
+	FlushReceiverQueues();
+}
+
+void SpatialDispatcher::DispatchOps(Worker_OpList* OpList)
 {
 	check(Receiver.IsValid());
 	check(StaticComponentView.IsValid());
@@ -36,15 +42,15 @@ void SpatialDispatcher::ProcessOps(Worker_OpList* OpList)
 		Worker_Op* Op = &OpList->ops[i];
 
 		if (OpsToSkip.Num() != 0 &&
-			OpsToSkip.Contains(Op))
+			OpsToSkip.Remove(Op) != 0)
 		{
-			OpsToSkip.Remove(Op);
 			continue;
 		}
 
-		if (IsExternalSchemaOp(Op))
+		const Worker_ComponentId ComponentId = SpatialGDK::GetComponentId(Op);
+		if (SpatialGDK::FOpCallbackTable::IsSupportedComponent(ComponentId))
 		{
-			ProcessExternalSchemaOp(Op);
+			ProcessExternalSchemaOp(ComponentId, Op);
 			continue;
 		}
 
@@ -124,20 +130,18 @@ void SpatialDispatcher::ProcessOps(Worker_OpList* OpList)
 			break;
 		}
 	}
-
-	Receiver->FlushRemoveComponentOps();
-	Receiver->FlushRetryRPCs();
 }
 
-bool SpatialDispatcher::IsExternalSchemaOp(Worker_Op* Op) const
+void SpatialDispatcher::FlushReceiverQueues()
 {
-	Worker_ComponentId ComponentId = SpatialGDK::GetComponentId(Op);
-	return SpatialConstants::MIN_EXTERNAL_SCHEMA_ID <= ComponentId && ComponentId <= SpatialConstants::MAX_EXTERNAL_SCHEMA_ID;
+	check(Receiver.IsValid());
+
+	Receiver->FlushRemoveComponentOps();
+	Receiver->FlushRetryRPCs();
 }
 
-void SpatialDispatcher::ProcessExternalSchemaOp(Worker_Op* Op)
+void SpatialDispatcher::ProcessExternalSchemaOp(Worker_ComponentId ComponentId, Worker_Op* Op)
 {
-	Worker_ComponentId ComponentId = SpatialGDK::GetComponentId(Op);
 	check(ComponentId != SpatialConstants::INVALID_COMPONENT_ID);
 	check(StaticComponentView.IsValid());
 
@@ -151,7 +155,7 @@ void SpatialDispatcher::ProcessExternalSchemaOp(Worker_Op* Op)
 	case WORKER_OP_TYPE_COMPONENT_UPDATE:
 	case WORKER_OP_TYPE_COMMAND_REQUEST:
 	case WORKER_OP_TYPE_COMMAND_RESPONSE:
-		RunCallbacks(ComponentId, Op);
+		Callbacks.Invoke(ComponentId, Op);
 		break;
 	default:
 		// This should never happen providing the GetComponentId function has
@@ -211,76 +215,12 @@ SpatialDispatcher::FCallbackId SpatialDispatcher::OnCommandResponse(Worker_Compo
 
 SpatialDispatcher::FCallbackId SpatialDispatcher::AddGenericOpCallback(Worker_ComponentId ComponentId, Worker_OpType OpType, const TFunction<void(const Worker_Op*)>& Callback)
 {
-	check(SpatialConstants::MIN_EXTERNAL_SCHEMA_ID <= ComponentId && ComponentId <= SpatialConstants::MAX_EXTERNAL_SCHEMA_ID);
-	const FCallbackId NewCallbackId = NextCallbackId++;
-	ComponentOpTypeToCallbacksMap.FindOrAdd(ComponentId).FindOrAdd(OpType).Add(UserOpCallbackData{ NewCallbackId, Callback });
-	CallbackIdToDataMap.Add(NewCallbackId, CallbackIdData{ ComponentId, OpType });
-	return NewCallbackId;
+	return Callbacks.Add(ComponentId, OpType, Callback);
 }
 
 bool SpatialDispatcher::RemoveOpCallback(FCallbackId CallbackId)
 {
-	CallbackIdData* CallbackData = CallbackIdToDataMap.Find(CallbackId);
-	if (CallbackData == nullptr)
-	{
-		return false;
-	}
-
-	OpTypeToCallbacksMap* OpTypesToCallbacks = ComponentOpTypeToCallbacksMap.Find(CallbackData->ComponentId);
-	if (OpTypesToCallbacks == nullptr)
-	{
-		return false;
-	}
-
-	TArray<UserOpCallbackData>* ComponentCallbacks = OpTypesToCallbacks->Find(CallbackData->OpType);
-	if (ComponentCallbacks == nullptr)
-	{
-		return false;
-	}
-
-	int32 CallbackIndex = ComponentCallbacks->IndexOfByPredicate([CallbackId](const UserOpCallbackData& Data)
-	{
-		return Data.Id == CallbackId;
-	});
-	if (CallbackIndex == INDEX_NONE)
-	{
-		return false;
-	}
-
-	// If removing the only callback for a component ID / op type, delete map entries as applicable
-	if (ComponentCallbacks->Num() == 1)
-	{
-		if (OpTypesToCallbacks->Num() == 1)
-		{
-			ComponentOpTypeToCallbacksMap.Remove(CallbackData->ComponentId);
-			return true;
-		}
-		OpTypesToCallbacks->Remove(CallbackData->OpType);
-		return true;
-	}
-
-	ComponentCallbacks->RemoveAt(CallbackIndex);
-	return true;
-}
-
-void SpatialDispatcher::RunCallbacks(Worker_ComponentId ComponentId, const Worker_Op* Op)
-{
-	OpTypeToCallbacksMap* OpTypeCallbacks = ComponentOpTypeToCallbacksMap.Find(ComponentId);
-	if (OpTypeCallbacks == nullptr)
-	{
-		return;
-	}
-
-	TArray<UserOpCallbackData>* ComponentCallbacks = OpTypeCallbacks->Find(static_cast<Worker_OpType>(Op->op_type));
-	if (ComponentCallbacks == nullptr)
-	{
-		return;
-	}
-
-	for (UserOpCallbackData CallbackData : *ComponentCallbacks)
-	{
-		CallbackData.Callback(Op);
-	}
+	return Callbacks.Remove(CallbackId);
 }
 
 void SpatialDispatcher::MarkOpToSkip(const Worker_Op* Op)
@@ -27,6 +27,7 @@
 #include "Schema/UnrealMetadata.h"
 #include "SpatialConstants.h"
 #include "Utils/ComponentReader.h"
+#include "Utils/ComponentUpdateStaging.h"
 #include "Utils/ErrorCodeRemapping.h"
 #include "Utils/RepLayoutUtils.h"
 #include "Utils/SpatialDebugger.h"
@@ -51,6 +52,7 @@ DECLARE_CYCLE_STAT(TEXT("Receiver ReserveEntityIds"), STAT_ReceiverReserveEntity
 DECLARE_CYCLE_STAT(TEXT("Receiver CreateEntityResponse"), STAT_ReceiverCreateEntityResponse, STATGROUP_SpatialNet);
 DECLARE_CYCLE_STAT(TEXT("Receiver EntityQueryResponse"), STAT_ReceiverEntityQueryResponse, STATGROUP_SpatialNet);
 DECLARE_CYCLE_STAT(TEXT("Receiver FlushRemoveComponents"), STAT_ReceiverFlushRemoveComponents, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("Receiver ReceiveActors"), STAT_ReceiverReceiveActors, STATGROUP_SpatialNet);
 DECLARE_CYCLE_STAT(TEXT("Receiver ReceiveActor"), STAT_ReceiverReceiveActor, STATGROUP_SpatialNet);
 DECLARE_CYCLE_STAT(TEXT("Receiver RemoveActor"), STAT_ReceiverRemoveActor, STATGROUP_SpatialNet);
 DECLARE_CYCLE_STAT(TEXT("Receiver ApplyRPC"), STAT_ReceiverApplyRPC, STATGROUP_SpatialNet);
@@ -68,8 +70,10 @@ void USpatialReceiver::Init(USpatialNetDriver* InNetDriver, FTimerManager* InTim
 	TimerManager = InTimerManager;
 	RPCService = InRPCService;
 
-	IncomingRPCs.BindProcessingFunction(FProcessRPCDelegate::CreateUObject(this, &USpatialReceiver::ApplyRPC));
+	IncomingRPCs.Init(FProcessIncomingRPCDelegate::CreateUObject(this, &USpatialReceiver::ApplyRPC), GetDefault<USpatialGDKSettings>()->QueuedIncomingRPCWaitTime);
 	PeriodicallyProcessIncomingRPCs();
+
+	LingeringActors.Init(GetDefault<USpatialGDKSettings>()->ActorRemovalLingerSeconds);
 }
 
 void USpatialReceiver::OnCriticalSection(bool InCriticalSection)
@@ -98,9 +102,13 @@ void USpatialReceiver::LeaveCriticalSection()
 	UE_LOG(LogSpatialReceiver, Verbose, TEXT("Leaving critical section."));
 	check(bInCriticalSection);
 
+	if (PendingAddActors.Num() > 0)
+	{
+		ReceiveActors(PendingAddActors);
+	}
+
 	for (Worker_EntityId& PendingAddEntity : PendingAddActors)
 	{
-		ReceiveActor(PendingAddEntity);
 		if (!IsEntityWaitingForAsyncLoad(PendingAddEntity))
 		{
 			OnEntityAddedDelegate.Broadcast(PendingAddEntity);
@@ -294,7 +302,7 @@ void USpatialReceiver::OnRemoveComponent(const Worker_RemoveComponentOp& Op)
 			// Pretend we never saw this actor.
 			EntitiesWaitingForAsyncLoad.Remove(Op.entity_id);
 		}
-		else
+		else if (!TryLingerActor(Op.entity_id))
 		{
 			RemoveActor(Op.entity_id);
 		}
@@ -689,24 +697,23 @@ void USpatialReceiver::HandleActorAuthority(const Worker_AuthorityChangeOp& Op)
 	}
 }
 
-bool USpatialReceiver::IsReceivedEntityTornOff(Worker_EntityId EntityId)
+bool USpatialReceiver::IsReceivedEntityTornOff(const TArray<PendingAddComponentWrapper*>& EntityPendingAddComponents)
 {
 	// Check the pending add components, to find the root component for the received entity.
-	for (PendingAddComponentWrapper& PendingAddComponent : PendingAddComponents)
+	for (const PendingAddComponentWrapper* PendingAddComponent : EntityPendingAddComponents)
 	{
-		if (PendingAddComponent.EntityId != EntityId
-			|| ClassInfoManager->GetCategoryByComponentId(PendingAddComponent.ComponentId) != SCHEMA_Data)
+		if (ClassInfoManager->GetCategoryByComponentId(PendingAddComponent->ComponentId) != SCHEMA_Data)
 		{
 			continue;
 		}
 
-		UClass* Class = ClassInfoManager->GetClassByComponentId(PendingAddComponent.ComponentId);
+		UClass* Class = ClassInfoManager->GetClassByComponentId(PendingAddComponent->ComponentId);
 		if (!Class->IsChildOf<AActor>())
 		{
 			continue;
 		}
 
-		Worker_ComponentData* ComponentData = PendingAddComponent.Data->ComponentData;
+		Worker_ComponentData* ComponentData = PendingAddComponent->Data->ComponentData;
 		Schema_Object* ComponentObject = Schema_GetComponentDataFields(ComponentData->schema_type);
 		return GetBoolFromSchema(ComponentObject, SpatialConstants::ACTOR_TEAROFF_ID);
 	}
@@ -714,76 +721,180 @@ bool USpatialReceiver::IsReceivedEntityTornOff(Worker_EntityId EntityId)
 	return false;
 }
 
-void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId)
+void USpatialReceiver::ReceiveActors(const TArray<Worker_EntityId>& EntityIds)
 {
-	SCOPE_CYCLE_COUNTER(STAT_ReceiverReceiveActor);
+	SCOPE_CYCLE_COUNTER(STAT_ReceiverReceiveActors);
 
 	checkf(NetDriver, TEXT("We should have a NetDriver whilst processing ops."));
 	checkf(NetDriver->GetWorld(), TEXT("We should have a World whilst processing ops."));
 
-	SpawnData* SpawnDataComp = StaticComponentView->GetComponentData<SpawnData>(EntityId);
-	UnrealMetadata* UnrealMetadataComp = StaticComponentView->GetComponentData<UnrealMetadata>(EntityId);
-	NetOwningClientWorker* NetOwningClientWorkerComp = StaticComponentView->GetComponentData<NetOwningClientWorker>(EntityId);
+	const USpatialGDKSettings* SpatialGDKSettings = GetDefault<USpatialGDKSettings>();
 
-	// This function should only ever be called if we have received an unreal metadata component.
-	check(UnrealMetadataComp != nullptr);
+	// Group the entities by class, so each class is found, loaded and has its info looked up once.
+	TArray<FReceivedActorGroup> Groups;
+	TMap<FString, int32> GroupIndexByClassPath;
+	TArray<TPair<Worker_EntityId, AActor*>> LingeringActorsToRestore;
+	for (Worker_EntityId EntityId : EntityIds)
+	{
+		if (LingeringActors.IsLingering(EntityId))
+		{
+			if (AActor* LingeringActor = StopLingering(EntityId))
+			{
+				LingeringActorsToRestore.Emplace(EntityId, LingeringActor);
+				continue;
+			}
+		}
 
-	const USpatialGDKSettings* SpatialGDKSettings = GetDefault<USpatialGDKSettings>();
+		UnrealMetadata* UnrealMetadataComp = StaticComponentView->GetComponentData<UnrealMetadata>(EntityId);
+
+		// This function should only ever be called if we have received an unreal metadata component.
+		check(UnrealMetadataComp != nullptr);
+
+		int32& GroupIndex = GroupIndexByClassPath.FindOrAdd(UnrealMetadataComp->ClassPath, INDEX_NONE);
+		if (GroupIndex == INDEX_NONE)
+		{
+			GroupIndex = Groups.AddDefaulted();
+			Groups[GroupIndex].ClassPath = UnrealMetadataComp->ClassPath;
+		}
+		Groups[GroupIndex].EntityIds.Add(EntityId);
+	}
 
-	// Check if actor's class is loaded. If not, start async loading it and extract all data and
-	// authority ops into a separate entry that will get processed once the loading is finished.
-	const FString& ClassPath = UnrealMetadataComp->ClassPath;
-	if (SpatialGDKSettings->bAsyncLoadNewClassesOnEntityCheckout && NeedToLoadClass(ClassPath))
+	int32 NumActorsToCreate = 0;
+	int32 NumObjectsToCreate = 0;
+	for (FReceivedActorGroup& Group : Groups)
 	{
-		StartAsyncLoadingClass(ClassPath, EntityId);
-		return;
+		// Check if actor's class is loaded. If not, start async loading it and extract all data and
+		// authority ops into a separate entry that will get processed once the loading is finished.
+		const FString& ClassPath = Group.ClassPath;
+		if (SpatialGDKSettings->bAsyncLoadNewClassesOnEntityCheckout && NeedToLoadClass(ClassPath))
+		{
+			for (Worker_EntityId EntityId : Group.EntityIds)
+			{
+				StartAsyncLoadingClass(ClassPath, EntityId);
+			}
+			Group.EntityIds.Reset();
+			continue;
+		}
+
+		Group.EntityIds.RemoveAll([this](Worker_EntityId EntityId)
+		{
+			return ReceiveExistingActor(EntityId);
+		});
+
+		for (Worker_EntityId EntityId : Group.EntityIds)
+		{
+			UnrealMetadata* UnrealMetadataComp = StaticComponentView->GetComponentData<UnrealMetadata>(EntityId);
+			if (Group.Class != nullptr)
+			{
+				UnrealMetadataComp->NativeClass = Group.Class;
+			}
+			else if (UClass* Class = UnrealMetadataComp->GetNativeEntityClass())
+			{
+				// Make sure ClassInfo exists
+				Group.Class = Class;
+				Group.ClassInfo = &ClassInfoManager->GetOrCreateClassInfoByClass(Class);
+			}
+		}
+
+		if (Group.Class != nullptr)
+		{
+			NumActorsToCreate += Group.EntityIds.Num();
+			NumObjectsToCreate += Group.EntityIds.Num() * (1 + Group.ClassInfo->SubobjectInfo.Num());
+		}
 	}
 
-	AActor* EntityActor = Cast<AActor>(PackageMap->GetObjectFromEntityId(EntityId));
-	if (EntityActor != nullptr)
+	NetDriver->ReserveActorChannels(NumActorsToCreate);
+	PackageMap->ReserveEntityObjects(NumObjectsToCreate);
+
+	// Pending add components can only be taken out for async loading above, so the index stays valid from here on.
+	TMap<Worker_EntityId_Key, TArray<PendingAddComponentWrapper*>> PendingAddComponentsByEntity;
+	PendingAddComponentsByEntity.Reserve(NumActorsToCreate);
+	for (PendingAddComponentWrapper& PendingAddComponent : PendingAddComponents)
 	{
-		UE_LOG(LogSpatialReceiver, Verbose, TEXT("%s: Entity for actor %s has been checked out on the worker which spawned it or is a singleton linked on this worker. "
-			"Entity ID: %lld"), *NetDriver->Connection->GetWorkerId(), *EntityActor->GetName(), EntityId);
+		PendingAddComponentsByEntity.FindOrAdd(PendingAddComponent.EntityId).Add(&PendingAddComponent);
+	}
+
+	const TArray<PendingAddComponentWrapper*> NoPendingAddComponents;
+	for (const TPair<Worker_EntityId, AActor*>& LingeringActor : LingeringActorsToRestore)
+	{
+		const TArray<PendingAddComponentWrapper*>* EntityPendingAddComponents = PendingAddComponentsByEntity.Find(LingeringActor.Key);
+		RestoreLingeringActor(LingeringActor.Key, *LingeringActor.Value, EntityPendingAddComponents != nullptr ? *EntityPendingAddComponents : NoPendingAddComponents);
+	}
 
-		// Assume SimulatedProxy until we've been delegated Authority
-		bool bAuthority = StaticComponentView->HasAuthority(EntityId, Position::ComponentId);
-		EntityActor->Role = bAuthority ? ROLE_Authority : ROLE_SimulatedProxy;
-		EntityActor->RemoteRole = bAuthority ? ROLE_SimulatedProxy : ROLE_Authority;
-		if (bAuthority)
+	TArray<FReceivedActor> ReceivedActors;
+	ReceivedActors.Reserve(NumActorsToCreate);
+	for (const FReceivedActorGroup& Group : Groups)
+	{
+		for (Worker_EntityId EntityId : Group.EntityIds)
 		{
-			if (EntityActor->GetNetConnection() != nullptr || EntityActor->IsA<APawn>())
+			if (Group.Class == nullptr)
 			{
-				EntityActor->RemoteRole = ROLE_AutonomousProxy;
+				UE_LOG(LogSpatialReceiver, Warning, TEXT("The received actor with entity ID %lld couldn't be loaded. The actor (%s) will not be spawned."),
+					EntityId, *Group.ClassPath);
+				continue;
 			}
+
+			const TArray<PendingAddComponentWrapper*>* EntityPendingAddComponents = PendingAddComponentsByEntity.Find(EntityId);
+			ReceiveActor(EntityId, *Group.ClassInfo, EntityPendingAddComponents != nullptr ? *EntityPendingAddComponents : NoPendingAddComponents, ReceivedActors);
 		}
+	}
 
-		// If we're a singleton, apply the data, regardless of authority - JIRA: 736
-		return;
+	// BeginPlay is deferred until all actors of the batch have been set up, so they can see each other from it.
+	for (const FReceivedActor& ReceivedActor : ReceivedActors)
+	{
+		FinishReceivingActor(ReceivedActor);
+	}
+}
+
+bool USpatialReceiver::ReceiveExistingActor(Worker_EntityId EntityId)
+{
+	AActor* EntityActor = Cast<AActor>(PackageMap->GetObjectFromEntityId(EntityId));
+	if (EntityActor == nullptr)
+	{
+		return false;
 	}
 
-	UE_LOG(LogSpatialReceiver, Verbose, TEXT("%s: Entity has been checked out on a worker which didn't spawn it. "
-		"Entity ID: %lld"), *NetDriver->Connection->GetWorkerId(), EntityId);
+	UE_LOG(LogSpatialReceiver, Verbose, TEXT("%s: Entity for actor %s has been checked out on the worker which spawned it or is a singleton linked on this worker. "
+		"Entity ID: %lld"), *NetDriver->Connection->GetWorkerId(), *EntityActor->GetName(), EntityId);
 
-	UClass* Class = UnrealMetadataComp->GetNativeEntityClass();
-	if (Class == nullptr)
+	// Assume SimulatedProxy until we've been delegated Authority
+	bool bAuthority = StaticComponentView->HasAuthority(EntityId, Position::ComponentId);
+	EntityActor->Role = bAuthority ? ROLE_Authority : ROLE_SimulatedProxy;
+	EntityActor->RemoteRole = bAuthority ? ROLE_SimulatedProxy : ROLE_Authority;
+	if (bAuthority)
 	{
-		UE_LOG(LogSpatialReceiver, Warning, TEXT("The received actor with entity ID %lld couldn't be loaded. The actor (%s) will not be spawned."),
-			EntityId, *UnrealMetadataComp->ClassPath);
-		return;
+		if (EntityActor->GetNetConnection() != nullptr || EntityActor->IsA<APawn>())
+		{
+			EntityActor->RemoteRole = ROLE_AutonomousProxy;
+		}
 	}
 
-	// Make sure ClassInfo exists
-	const FClassInfo& ActorClassInfo = ClassInfoManager->GetOrCreateClassInfoByClass(Class);
+	// If we're a singleton, apply the data, regardless of authority - JIRA: 736
+	return true;
+}
+
+void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId, const FClassInfo& ActorClassInfo, const TArray<PendingAddComponentWrapper*>& EntityPendingAddComponents, TArray<FReceivedActor>& OutReceivedActors)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ReceiverReceiveActor);
+
+	SpawnData* SpawnDataComp = StaticComponentView->GetComponentData<SpawnData>(EntityId);
+	UnrealMetadata* UnrealMetadataComp = StaticComponentView->GetComponentData<UnrealMetadata>(EntityId);
+	NetOwningClientWorker* NetOwningClientWorkerComp = StaticComponentView->GetComponentData<NetOwningClientWorker>(EntityId);
+
+	const USpatialGDKSettings* SpatialGDKSettings = GetDefault<USpatialGDKSettings>();
+
+	UE_LOG(LogSpatialReceiver, Verbose, TEXT("%s: Entity has been checked out on a worker which didn't spawn it. "
+		"Entity ID: %lld"), *NetDriver->Connection->GetWorkerId(), EntityId);
 
 	// If the received actor is torn off, don't bother spawning it.
 	// (This is only needed due to the delay between tearoff and deleting the entity. See https://improbableio.atlassian.net/browse/UNR-841)
-	if (IsReceivedEntityTornOff(EntityId))
+	if (IsReceivedEntityTornOff(EntityPendingAddComponents))
 	{
 		UE_LOG(LogSpatialReceiver, Verbose, TEXT("The received actor with entity ID %lld was already torn off. The actor will not be spawned."), EntityId);
 		return;
 	}
 
-	EntityActor = TryGetOrCreateActor(UnrealMetadataComp, SpawnDataComp, NetOwningClientWorkerComp);
+	AActor* EntityActor = TryGetOrCreateActor(UnrealMetadataComp, SpawnDataComp, NetOwningClientWorkerComp);
 
 	if (EntityActor == nullptr)
 	{
@@ -856,17 +967,14 @@ void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId)
 	// Apply initial replicated properties.
 	// This was moved to after FinishingSpawning because components existing only in blueprints aren't added until spawning is complete
 	// Potentially we could split out the initial actor state and the initial component state
-	for (PendingAddComponentWrapper& PendingAddComponent : PendingAddComponents)
+	for (PendingAddComponentWrapper* PendingAddComponent : EntityPendingAddComponents)
 	{
-		if (ClassInfoManager->IsGeneratedQBIMarkerComponent(PendingAddComponent.ComponentId))
+		if (ClassInfoManager->IsGeneratedQBIMarkerComponent(PendingAddComponent->ComponentId))
 		{
 			continue;
 		}
 
-		if (PendingAddComponent.EntityId == EntityId)
-		{
-			ApplyComponentDataOnActorCreation(EntityId, *PendingAddComponent.Data->ComponentData, *Channel, ActorClassInfo, ObjectsToResolvePendingOpsFor);
-		}
+		ApplyComponentDataOnActorCreation(EntityId, *PendingAddComponent->Data->ComponentData, *Channel, ActorClassInfo, ObjectsToResolvePendingOpsFor);
 	}
 
 	// Resolve things like RepNotify or RPCs after applying component data.
@@ -900,7 +1008,19 @@ void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId)
 		}
 	}
 
-	// Taken from PostNetInit
+	OutReceivedActors.Add(FReceivedActor{ EntityId, EntityActor, Channel });
+}
+
+void USpatialReceiver::FinishReceivingActor(const FReceivedActor& ReceivedActor)
+{
+	AActor* EntityActor = ReceivedActor.Actor;
+	if (EntityActor->IsPendingKillOrUnreachable())
+	{
+		// Destroyed by one of the actors received before it.
+		return;
+	}
+
+	// Taken from PostNetInit. Actors reused from the actor pool have already begun play, ISpatialPooledActor::OnTakenFromPool stands in for it.
 	if (NetDriver->GetWorld()->HasBegunPlay() && !EntityActor->HasActorBegunPlay())
 	{
 		// The Actor role can be authority here if a PendingAddComponent processed above set the role.
@@ -917,15 +1037,128 @@ void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId)
 
 	if (EntityActor->GetClass()->HasAnySpatialClassFlags(SPATIALCLASS_Singleton))
 	{
-		GlobalStateManager->RegisterSingletonChannel(EntityActor, Channel);
+		GlobalStateManager->RegisterSingletonChannel(EntityActor, ReceivedActor.Channel);
 	}
 
 	EntityActor->UpdateOverlaps();
 
+	if (StaticComponentView->HasComponent(ReceivedActor.EntityId, SpatialConstants::DORMANT_COMPONENT_ID))
+	{
+		NetDriver->AddPendingDormantChannel(ReceivedActor.Channel);
+	}
+}
+
+bool USpatialReceiver::TryLingerActor(Worker_EntityId EntityId)
+{
+	if (NetDriver->IsServer() || !LingeringActors.HasLingeringClasses())
+	{
+		return false;
+	}
+
+	AActor* Actor = Cast<AActor>(PackageMap->GetObjectFromEntityId(EntityId).Get());
+	if (Actor == nullptr || Actor->IsPendingKill() || Actor->GetTearOff() || Actor->Role != ROLE_SimulatedProxy
+		|| Actor->IsFullNameStableForNetworking() || NetDriver->GetActorChannelByEntityId(EntityId) == nullptr)
+	{
+		return false;
+	}
+
+	if (!LingeringActors.StartLingering(EntityId, Actor))
+	{
+		return false;
+	}
+
+	UE_LOG(LogSpatialReceiver, Verbose, TEXT("Keeping actor %s for %.2fs after entity %lld left the view."), *Actor->GetName(), LingeringActors.GetLingerSeconds(Actor->GetClass()), EntityId);
+
+	ScheduleLingeringActorExpiry();
+	return true;
+}
+
+void USpatialReceiver::ScheduleLingeringActorExpiry()
+{
+	const TOptional<double> SecondsUntilNextExpiry = LingeringActors.GetSecondsUntilNextExpiry();
+	if (!SecondsUntilNextExpiry.IsSet())
+	{
+		TimerManager->ClearTimer(LingeringActorsTimerHandle);
+		return;
+	}
+
+	// A rate of 0 would clear the timer rather than fire it on the next tick.
+	const float Rate = FMath::Max(static_cast<float>(SecondsUntilNextExpiry.GetValue()), KINDA_SMALL_NUMBER);
+	TimerManager->SetTimer(LingeringActorsTimerHandle, [WeakThis = TWeakObjectPtr<USpatialReceiver>(this)]()
+	{
+		if (USpatialReceiver* SpatialReceiver = WeakThis.Get())
+		{
+			SpatialReceiver->OnLingeringActorsExpired();
+		}
+	}, Rate, false);
+}
+
+void USpatialReceiver::OnLingeringActorsExpired()
+{
+	for (Worker_EntityId EntityId : LingeringActors.TakeExpired())
+	{
+		UE_LOG(LogSpatialReceiver, Verbose, TEXT("Entity %lld did not come back into view, removing its actor."), EntityId);
+		RemoveActor(EntityId);
+	}
+
+	ScheduleLingeringActorExpiry();
+}
+
+AActor* USpatialReceiver::StopLingering(Worker_EntityId EntityId)
+{
+	AActor* Actor = LingeringActors.StopLingering(EntityId);
+	ScheduleLingeringActorExpiry();
+
+	if (Actor == nullptr || NetDriver->GetActorChannelByEntityId(EntityId) == nullptr)
+	{
+		UE_LOG(LogSpatialReceiver, Verbose, TEXT("Actor for entity %lld was destroyed while out of view, it will be spawned again."), EntityId);
+		RemoveActor(EntityId);
+		return nullptr;
+	}
+
+	return Actor;
+}
+
+void USpatialReceiver::RestoreLingeringActor(Worker_EntityId EntityId, AActor& Actor, const TArray<PendingAddComponentWrapper*>& EntityPendingAddComponents)
+{
+	USpatialActorChannel* Channel = NetDriver->GetActorChannelByEntityId(EntityId);
+
+	UE_LOG(LogSpatialReceiver, Verbose, TEXT("Entity %lld came back into view, updating its lingering actor %s."), EntityId, *Actor.GetName());
+
+	ReceiveExistingActor(EntityId);
+
+	const FClassInfo& ActorClassInfo = ClassInfoManager->GetOrCreateClassInfoByClass(Actor.GetClass());
+	TArray<ObjectPtrRefPair> ObjectsToResolvePendingOpsFor;
+	for (PendingAddComponentWrapper* PendingAddComponent : EntityPendingAddComponents)
+	{
+		if (ClassInfoManager->IsGeneratedQBIMarkerComponent(PendingAddComponent->ComponentId))
+		{
+			continue;
+		}
+
+		ApplyComponentDataOnActorCreation(EntityId, *PendingAddComponent->Data->ComponentData, *Channel, ActorClassInfo, ObjectsToResolvePendingOpsFor);
+	}
+
+	for (const ObjectPtrRefPair& ObjectToResolve : ObjectsToResolvePendingOpsFor)
+	{
+		ResolvePendingOperations(ObjectToResolve.Key, ObjectToResolve.Value);
+	}
+
+	if (!GetDefault<USpatialGDKSettings>()->bEnableResultTypes)
+	{
+		Sender->SendComponentInterestForActor(Channel, EntityId, Channel->IsAuthoritativeClient());
+	}
+
+	// As for newly received actors, see FinishReceivingActor. The channel may also still be pending dormancy from before
+	// the entity left the view, which no longer applies if it came back awake.
 	if (StaticComponentView->HasComponent(EntityId, SpatialConstants::DORMANT_COMPONENT_ID))
 	{
 		NetDriver->AddPendingDormantChannel(Channel);
 	}
+	else
+	{
+		NetDriver->RemovePendingDormantChannel(Channel);
+	}
 }
 
 void USpatialReceiver::RemoveActor(Worker_EntityId EntityId)
@@ -1060,10 +1293,16 @@ void USpatialReceiver::DestroyActor(AActor* Actor, Worker_EntityId EntityId)
 	// TODO: fix this with working sets (UNR-411)
 	NetDriver->StartIgnoringAuthoritativeDestruction();
 
-	// Clean up the actor channel. For clients, this will also call destroy on the actor.
+	// Clean up the actor channel. For clients, this will also call destroy on the actor, unless it is parked in the actor pool.
+	bool bParkedActor = false;
 	if (USpatialActorChannel* ActorChannel = NetDriver->GetActorChannelByEntityId(EntityId))
 	{
+		bParkedActor = CanParkActor(Actor, *ActorChannel) && NetDriver->ActorPool->BeginParking(Actor);
 		ActorChannel->ConditionalCleanUp(false, EChannelCloseReason::Destroyed);
+		if (bParkedActor)
+		{
+			NetDriver->ActorPool->FinishParking();
+		}
 	}
 	else
 	{
@@ -1078,7 +1317,7 @@ void USpatialReceiver::DestroyActor(AActor* Actor, Worker_EntityId EntityId)
 	}
 
 	// It is safe to call AActor::Destroy even if the destruction has already started.
-	if (Actor != nullptr && !Actor->Destroy(true))
+	if (Actor != nullptr && !bParkedActor && !Actor->Destroy(true))
 	{
 		UE_LOG(LogSpatialReceiver, Error, TEXT("Failed to destroy actor in RemoveActor %s %lld"), *Actor->GetName(), EntityId);
 	}
@@ -1087,6 +1326,17 @@ void USpatialReceiver::DestroyActor(AActor* Actor, Worker_EntityId EntityId)
 	check(PackageMap->GetObjectFromEntityId(EntityId) == nullptr);
 }
 
+bool USpatialReceiver::CanParkActor(AActor* Actor, const USpatialActorChannel& Channel) const
+{
+	// Dynamically attached subobjects would be created again when the actor is reused, so actors with any are destroyed.
+	return NetDriver->ActorPool.IsValid()
+		&& Actor != nullptr
+		&& !Actor->IsPendingKillOrUnreachable()
+		&& !Actor->IsA<APlayerController>()
+		&& Channel.CreateSubObjects.Num() == 0
+		&& NetDriver->ActorPool->IsPooledClass(Actor->GetClass());
+}
+
 AActor* USpatialReceiver::TryGetOrCreateActor(UnrealMetadata* UnrealMetadataComp, SpawnData* SpawnDataComp, NetOwningClientWorker* NetOwningClientWorkerComp)
 {
 	if (UnrealMetadataComp->StablyNamedRef.IsSet())
@@ -1139,7 +1389,16 @@ AActor* USpatialReceiver::CreateActor(UnrealMetadata* UnrealMetadataComp, SpawnD
 
 	FVector SpawnLocation = FRepMovement::RebaseOntoLocalOrigin(SpawnDataComp->Location, NetDriver->GetWorld()->OriginLocation);
 
-	AActor* NewActor = NetDriver->GetWorld()->SpawnActorAbsolute(ActorClass, FTransform(SpawnDataComp->Rotation, SpawnLocation), SpawnInfo);
+	AActor* NewActor = nullptr;
+	if (NetDriver->ActorPool.IsValid())
+	{
+		NewActor = NetDriver->ActorPool->Take(ActorClass, FTransform(SpawnDataComp->Rotation, SpawnLocation, SpawnDataComp->Scale));
+	}
+
+	if (NewActor == nullptr)
+	{
+		NewActor = NetDriver->GetWorld()->SpawnActorAbsolute(ActorClass, FTransform(SpawnDataComp->Rotation, SpawnLocation), SpawnInfo);
+	}
 	check(NewActor);
 
 	if (bIsServer && bCreatingPlayerController)
@@ -1850,9 +2109,11 @@ void USpatialReceiver::ApplyComponentUpdate(const Worker_ComponentUpdate& Compon
 {
 	RepStateUpdateHelper RepStateHelper(Channel, TargetObject);
 
+	const FStagedComponentUpdate* StagedUpdate = NetDriver->ComponentUpdateStaging.IsValid() ? NetDriver->ComponentUpdateStaging->Find(ComponentUpdate) : nullptr;
+
 	ComponentReader Reader(NetDriver, RepStateHelper.GetRefMap());
 	bool bOutReferencesChanged = false;
-	Reader.ApplyComponentUpdate(ComponentUpdate, TargetObject, Channel, bIsHandover, bOutReferencesChanged);
+	Reader.ApplyComponentUpdate(ComponentUpdate, TargetObject, Channel, bIsHandover, bOutReferencesChanged, StagedUpdate);
 	RepStateHelper.Update(*this, Channel, TargetObject, bOutReferencesChanged);
 
 	// This is a temporary workaround, see UNR-841:
@@ -1869,7 +2130,7 @@ void USpatialReceiver::ApplyComponentUpdate(const Worker_ComponentUpdate& Compon
 	}
 }
 
-ERPCResult USpatialReceiver::ApplyRPCInternal(UObject* TargetObject, UFunction* Function, const RPCPayload& Payload, const FString& SenderWorkerId, bool bApplyWithUnresolvedRefs /* = false */)
+ERPCResult USpatialReceiver::ApplyRPCInternal(UObject* TargetObject, UFunction* Function, const RPCPayload& Payload, const FString& SenderWorkerId, bool bApplyWithUnresolvedRefs /* = false */, TSet<FUnrealObjectRef>* OutUnresolvedRefs /* = nullptr */)
 {
 	ERPCResult Result = ERPCResult::Unknown;
 
@@ -1892,6 +2153,10 @@ ERPCResult USpatialReceiver::ApplyRPCInternal(UObject* TargetObject, UFunction*
 	else
 	{
 		Result = ERPCResult::UnresolvedParameters;
+		if (OutUnresolvedRefs != nullptr)
+		{
+			*OutUnresolvedRefs = MoveTemp(UnresolvedRefs);
+		}
 	}
 
 	// Destroy the parameters.
@@ -1903,7 +2168,7 @@ ERPCResult USpatialReceiver::ApplyRPCInternal(UObject* TargetObject, UFunction*
 	return Result;
 }
 
-FRPCErrorInfo USpatialReceiver::ApplyRPC(const FPendingRPCParams& Params)
+FRPCErrorInfo USpatialReceiver::ApplyRPC(const FPendingRPCParams& Params, TSet<FUnrealObjectRef>& OutUnresolvedRefs)
 {
 	SCOPE_CYCLE_COUNTER(STAT_ReceiverApplyRPC);
 
@@ -1932,7 +2197,7 @@ FRPCErrorInfo USpatialReceiver::ApplyRPC(const FPendingRPCParams& Params)
 		bApplyWithUnresolvedRefs = true;
 	}
 
-	ERPCResult Result = ApplyRPCInternal(TargetObject, Function, Params.Payload, FString{}, bApplyWithUnresolvedRefs);
+	ERPCResult Result = ApplyRPCInternal(TargetObject, Function, Params.Payload, FString{}, bApplyWithUnresolvedRefs, &OutUnresolvedRefs);
 
 	return FRPCErrorInfo{ TargetObject, Function, Result };
 }
@@ -2153,18 +2418,24 @@ void USpatialReceiver::ResolvePendingOperations(UObject* Object, const FUnrealOb
 	UE_LOG(LogSpatialReceiver, Verbose, TEXT("Resolving pending object refs and RPCs which depend on object: %s %s."), *Object->GetName(), *ObjectRef.ToString());
 
 	ResolveIncomingOperations(Object, ObjectRef);
+	FUnrealObjectRef ClassObjectRef = FUnrealObjectRef::NULL_OBJECT_REF;
 	if (Object->GetClass()->HasAnySpatialClassFlags(SPATIALCLASS_Singleton) && !Object->IsFullNameStableForNetworking())
 	{
 		// When resolving a singleton, also resolve using class path (in case any properties
 		// were set from a server that hasn't resolved the singleton yet)
-		FUnrealObjectRef ClassObjectRef = FUnrealObjectRef::GetSingletonClassRef(Object, PackageMap);
+		ClassObjectRef = FUnrealObjectRef::GetSingletonClassRef(Object, PackageMap);
 		if (ClassObjectRef.IsValid())
 		{
 			ResolveIncomingOperations(Object, ClassObjectRef);
 		}
 	}
-	// TODO: UNR-1650 We're trying to resolve all queues, which introduces more overhead.
-	IncomingRPCs.ProcessRPCs();
+
+	// Only the RPCs waiting on the resolved refs are retried.
+	IncomingRPCs.OnObjectRefResolved(ObjectRef);
+	if (ClassObjectRef.IsValid())
+	{
+		IncomingRPCs.OnObjectRefResolved(ClassObjectRef);
+	}
 }
 
 void USpatialReceiver::ResolveIncomingOperations(UObject* Object, const FUnrealObjectRef& ObjectRef)
@@ -2433,14 +2704,15 @@ void USpatialReceiver::CloseClientConnection(USpatialNetConnection* ClientConnec
 
 void USpatialReceiver::PeriodicallyProcessIncomingRPCs()
 {
+	// Only retries the queued RPCs whose deadline has passed, RPCs waiting on references are retried when those are resolved.
 	FTimerHandle IncomingRPCsPeriodicProcessTimer;
 	TimerManager->SetTimer(IncomingRPCsPeriodicProcessTimer, [WeakThis = TWeakObjectPtr<USpatialReceiver>(this)]()
 	{
 		if (USpatialReceiver* SpatialReceiver = WeakThis.Get())
 		{
-			SpatialReceiver->IncomingRPCs.ProcessRPCs();
+			SpatialReceiver->IncomingRPCs.Tick();
 		}
-	}, GetDefault<USpatialGDKSettings>()->QueuedIncomingRPCWaitTime, true);
+	}, IncomingRPCs.GetTickSeconds(), true);
 }
 
 bool USpatialReceiver::NeedToLoadClass(const FString& ClassPath)
@@ -2,7 +2,7 @@
 
 #include "Interop/SpatialSnapshotManager.h"
 
-#include "Interop/Connection/SpatialWorkerConnection.h"
+#include "Interop/Connection/SpatialOSWorkerInterface.h"
 #include "Interop/GlobalStateManager.h"
 #include "Interop/SpatialReceiver.h"
 #include "SpatialConstants.h"
@@ -18,7 +18,7 @@ SpatialSnapshotManager::SpatialSnapshotManager()
 	, Receiver(nullptr)
 {}
 
-void SpatialSnapshotManager::Init(USpatialWorkerConnection* InConnection, UGlobalStateManager* InGlobalStateManager, USpatialReceiver* InReceiver)
+void SpatialSnapshotManager::Init(SpatialOSWorkerInterface* InConnection, UGlobalStateManager* InGlobalStateManager, USpatialReceiver* InReceiver)
 {
 	check(InConnection != nullptr);
 	Connection = InConnection;
@@ -47,7 +47,7 @@ void SpatialSnapshotManager::WorldWipe(const PostWorldWipeDelegate& PostWorldWip
 	WorldQuery.result_type = WORKER_RESULT_TYPE_SNAPSHOT;
 
 	Worker_RequestId RequestID;
-	check(Connection.IsValid());
+	check(Connection != nullptr);
 	RequestID = Connection->SendEntityQueryRequest(&WorldQuery);
 
 	EntityQueryDelegate WorldQueryDelegate;
@@ -75,14 +75,14 @@ void SpatialSnapshotManager::WorldWipe(const PostWorldWipeDelegate& PostWorldWip
 	Receiver->AddEntityQueryDelegate(RequestID, WorldQueryDelegate);
 }
 
-void SpatialSnapshotManager::DeleteEntities(const Worker_EntityQueryResponseOp& Op, TWeakObjectPtr<USpatialWorkerConnection> Connection)
+void SpatialSnapshotManager::DeleteEntities(const Worker_EntityQueryResponseOp& Op, SpatialOSWorkerInterface* Connection)
 {
 	UE_LOG(LogSnapshotManager, Log, TEXT("Deleting %u entities."), Op.result_count);
 
 	for (uint32_t i = 0; i < Op.result_count; i++)
 	{
 		UE_LOG(LogSnapshotManager, Verbose, TEXT("Sending delete request for: %i"), Op.results[i].entity_id);
-		check(Connection.IsValid());
+		check(Connection != nullptr);
 		Connection->SendDeleteEntityRequest(Op.results[i].entity_id);
 	}
 }
@@ -172,7 +172,7 @@ void SpatialSnapshotManager::LoadSnapshot(const FString& SnapshotName)
 		// Ensure we have the same number of reserved IDs as we have entities to spawn
 		check(EntitiesToSpawn.Num() == Op.number_of_entity_ids);
 		check(GlobalStateManager.IsValid());
-		check(Connection.IsValid());
+		check(Connection != nullptr);
 
 		for (uint32_t i = 0; i < Op.number_of_entity_ids; i++)
 		{
@@ -199,7 +199,7 @@ void SpatialSnapshotManager::LoadSnapshot(const FString& SnapshotName)
 	});
 
 	// Reserve the Entity IDs
-	check(Connection.IsValid());
+	check(Connection != nullptr);
 	Worker_RequestId ReserveRequestID = Connection->SendReserveEntityIdsRequest(EntitiesToSpawn.Num());
 
 	// TODO: UNR-654
@@ -19,118 +19,108 @@
 #include "Schema/SpawnData.h"
 #include "Schema/UnrealMetadata.h"
 
-Worker_Authority USpatialStaticComponentView::GetAuthority(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const
-{
-	if (const TMap<Worker_ComponentId, Worker_Authority>* ComponentAuthorityMap = EntityComponentAuthorityMap.Find(EntityId))
-	{
-		if (const Worker_Authority* Authority = ComponentAuthorityMap->Find(ComponentId))
-		{
-			return *Authority;
-		}
-	}
-
-	return WORKER_AUTHORITY_NOT_AUTHORITATIVE;
-}
-
 bool USpatialStaticComponentView::HasAuthority(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const
 {
-	return GetAuthority(EntityId, ComponentId) == WORKER_AUTHORITY_AUTHORITATIVE;
+	return Store.GetAuthority(EntityId, ComponentId) == WORKER_AUTHORITY_AUTHORITATIVE;
 }
 
 bool USpatialStaticComponentView::HasComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const
 {
-	if (auto* EntityComponentStorage = EntityComponentMap.Find(EntityId))
-	{
-		return EntityComponentStorage->Contains(ComponentId);
-	}
-
-	return false;
+	return Store.HasComponent(EntityId, ComponentId);
 }
 
 void USpatialStaticComponentView::OnAddComponent(const Worker_AddComponentOp& Op)
 {
-	TUniquePtr<SpatialGDK::Component> Data;
+	MarkChanged(Op.entity_id, Op.data.component_id);
+
 	switch (Op.data.component_id)
 	{
 	case SpatialConstants::ENTITY_ACL_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::EntityAcl>(Op.data);
+		Store.AddComponent<SpatialGDK::EntityAcl>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::METADATA_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::Metadata>(Op.data);
+		Store.AddComponent<SpatialGDK::Metadata>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::POSITION_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::Position>(Op.data);
+		Store.AddComponent<SpatialGDK::Position>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::PERSISTENCE_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::Persistence>(Op.data);
+		Store.AddComponent<SpatialGDK::Persistence>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::WORKER_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::Worker>(Op.data);
+		Store.AddComponent<SpatialGDK::Worker>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::SPAWN_DATA_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::SpawnData>(Op.data);
+		Store.AddComponent<SpatialGDK::SpawnData>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::SINGLETON_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::Singleton>(Op.data);
+		Store.AddComponent<SpatialGDK::Singleton>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::UNREAL_METADATA_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::UnrealMetadata>(Op.data);
+		Store.AddComponent<SpatialGDK::UnrealMetadata>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::INTEREST_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::Interest>(Op.data);
+		Store.AddComponent<SpatialGDK::Interest>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::HEARTBEAT_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::Heartbeat>(Op.data);
+		Store.AddComponent<SpatialGDK::Heartbeat>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::RPCS_ON_ENTITY_CREATION_ID:
-		Data = MakeUnique<SpatialGDK::RPCsOnEntityCreation>(Op.data);
+		Store.AddComponent<SpatialGDK::RPCsOnEntityCreation>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID_LEGACY:
-		Data = MakeUnique<SpatialGDK::ClientRPCEndpointLegacy>(Op.data);
+		Store.AddComponent<SpatialGDK::ClientRPCEndpointLegacy>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID_LEGACY:
-		Data = MakeUnique<SpatialGDK::ServerRPCEndpointLegacy>(Op.data);
+		Store.AddComponent<SpatialGDK::ServerRPCEndpointLegacy>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::AUTHORITY_INTENT_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::AuthorityIntent>(Op.data);
+		Store.AddComponent<SpatialGDK::AuthorityIntent>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::CLIENT_ENDPOINT_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::ClientEndpoint>(Op.data);
+		Store.AddComponent<SpatialGDK::ClientEndpoint>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::SERVER_ENDPOINT_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::ServerEndpoint>(Op.data);
+		Store.AddComponent<SpatialGDK::ServerEndpoint>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::MULTICAST_RPCS_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::MulticastRPCs>(Op.data);
+		Store.AddComponent<SpatialGDK::MulticastRPCs>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::SPATIAL_DEBUGGING_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::SpatialDebugging>(Op.data);
+		Store.AddComponent<SpatialGDK::SpatialDebugging>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::COMPONENT_PRESENCE_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::ComponentPresence>(Op.data);
+		Store.AddComponent<SpatialGDK::ComponentPresence>(Op.entity_id, Op.data);
 		break;
 	case SpatialConstants::NET_OWNING_CLIENT_WORKER_COMPONENT_ID:
-		Data = MakeUnique<SpatialGDK::NetOwningClientWorker>(Op.data);
+		Store.AddComponent<SpatialGDK::NetOwningClientWorker>(Op.entity_id, Op.data);
 		break;
 	default:
 		// Component is not hand written, but we still want to know the existence of it on this entity.
-		Data = nullptr;
+		Store.AddComponentWithoutData(Op.entity_id, Op.data.component_id);
 	}
-	EntityComponentMap.FindOrAdd(Op.entity_id).FindOrAdd(Op.data.component_id) = MoveTemp(Data);
 }
 
 void USpatialStaticComponentView::OnRemoveComponent(const Worker_RemoveComponentOp& Op)
 {
-	if (auto* ComponentMap = EntityComponentMap.Find(Op.entity_id))
-	{
-		ComponentMap->Remove(Op.component_id);
-	}
+	MarkChanged(Op.entity_id, Op.component_id);
+	Store.RemoveComponent(Op.entity_id, Op.component_id);
 }
 
 void USpatialStaticComponentView::OnRemoveEntity(Worker_EntityId EntityId)
 {
-	EntityComponentMap.Remove(EntityId);
-	EntityComponentAuthorityMap.Remove(EntityId);
+	if (Snapshots.IsValid())
+	{
+		if (const TArray<Worker_ComponentId>* ComponentIds = Store.GetEntityComponentIds(EntityId))
+		{
+			for (const Worker_ComponentId ComponentId : *ComponentIds)
+			{
+				Snapshots->MarkChanged(EntityId, ComponentId);
+			}
+		}
+	}
+
+	Store.RemoveEntity(EntityId);
 }
 
 void USpatialStaticComponentView::OnComponentUpdate(const Worker_ComponentUpdateOp& Op)
@@ -179,10 +169,49 @@ void USpatialStaticComponentView::OnComponentUpdate(const Worker_ComponentUpdate
 	if (Component)
 	{
 		Component->ApplyComponentUpdate(Op.update);
+		MarkChanged(Op.entity_id, Op.update.component_id);
 	}
 }
 
 void USpatialStaticComponentView::OnAuthorityChange(const Worker_AuthorityChangeOp& Op)
 {
-	EntityComponentAuthorityMap.FindOrAdd(Op.entity_id).FindOrAdd(Op.component_id) = (Worker_Authority)Op.authority;
+	Store.SetAuthority(Op.entity_id, Op.component_id, (Worker_Authority)Op.authority);
+	MarkChanged(Op.entity_id, Op.component_id);
+}
+
+void USpatialStaticComponentView::EnableSnapshots()
+{
+	if (Snapshots.IsValid())
+	{
+		return;
+	}
+
+	Snapshots = MakeShared<SpatialGDK::FComponentViewSnapshots, ESPMode::ThreadSafe>();
+
+	// Everything already in view is new to the snapshots.
+	TArray<Worker_EntityId_Key> EntityIds;
+	Store.GetEntityIds(EntityIds);
+	for (const Worker_EntityId_Key EntityId : EntityIds)
+	{
+		for (const Worker_ComponentId ComponentId : *Store.GetEntityComponentIds(EntityId))
+		{
+			Snapshots->MarkChanged(EntityId, ComponentId);
+		}
+	}
+}
+
+void USpatialStaticComponentView::PublishSnapshot()
+{
+	if (Snapshots.IsValid())
+	{
+		Snapshots->Publish(Store);
+	}
+}
+
+void USpatialStaticComponentView::MarkChanged(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+{
+	if (Snapshots.IsValid())
+	{
+		Snapshots->MarkChanged(EntityId, ComponentId);
+	}
 }
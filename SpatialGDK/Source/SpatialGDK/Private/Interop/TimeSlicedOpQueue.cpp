@@ -0,0 +1,223 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/TimeSlicedOpQueue.h"
+
+#include "SpatialConstants.h"
+#include "Utils/OpUtils.h"
+
+namespace SpatialGDK
+{
+
+FTimeSlicedOpQueue::FTimeSlicedOpQueue(FProcessOpsFunction InProcessOps, FSkipOpFunction InSkipOp, FFlushFunction InFlush, FDestroyOpListFunction InDestroyOpList, FGetTimeFunction InGetTime)
+	: ProcessOpsFunction(MoveTemp(InProcessOps))
+	, SkipOp(MoveTemp(InSkipOp))
+	, Flush(MoveTemp(InFlush))
+	, DestroyOpList(MoveTemp(InDestroyOpList))
+	, GetTime(MoveTemp(InGetTime))
+	, NextOpIndex(0)
+	, bInCriticalSection(false)
+	, NumEnqueuedOps(0)
+	, bEnqueuedInCriticalSection(false)
+{
+}
+
+FTimeSlicedOpQueue::~FTimeSlicedOpQueue()
+{
+	for (const FQueuedOpList& QueuedOpList : OpLists)
+	{
+		DestroyOpList(QueuedOpList.OpList);
+	}
+}
+
+void FTimeSlicedOpQueue::Enqueue(const TArray<Worker_OpList*>& InOpLists)
+{
+	for (Worker_OpList* OpList : InOpLists)
+	{
+		OpLists.Add(FQueuedOpList{ OpList, NumEnqueuedOps });
+
+		for (uint32 OpIndex = 0; OpIndex < OpList->op_count; ++OpIndex, ++NumEnqueuedOps)
+		{
+			Worker_Op* Op = &OpList->ops[OpIndex];
+			if (Op->op_type == WORKER_OP_TYPE_CRITICAL_SECTION)
+			{
+				bEnqueuedInCriticalSection = Op->op.critical_section.in_critical_section != 0;
+				continue;
+			}
+
+			const Worker_EntityId EntityId = GetEntityId(Op);
+			if (EntityId == SpatialConstants::INVALID_ENTITY_ID)
+			{
+				continue;
+			}
+
+			if (IsUrgentOp(*Op))
+			{
+				const TPair<const Worker_Op*, uint64>* LastOp = LastEnqueuedOpByEntity.Find(EntityId);
+				PendingUrgentOps.Add(FUrgentOp{ Op, NumEnqueuedOps, LastOp != nullptr ? LastOp->Key : nullptr, LastOp != nullptr ? LastOp->Value : 0, bEnqueuedInCriticalSection });
+			}
+			LastEnqueuedOpByEntity.Add(EntityId, TPair<const Worker_Op*, uint64>(Op, NumEnqueuedOps));
+		}
+	}
+}
+
+void FTimeSlicedOpQueue::ProcessOps(double BudgetSeconds)
+{
+	if (OpLists.Num() == 0)
+	{
+		return;
+	}
+
+	const double StartTime = GetTime();
+
+	while (OpLists.Num() > 0)
+	{
+		ProcessNextChunk();
+
+		// Critical sections spread over several op lists are finished even if that goes over budget.
+		if (BudgetSeconds > 0.0 && !bInCriticalSection && GetTime() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	if (OpLists.Num() > 0)
+	{
+		ProcessUrgentOps();
+	}
+	else
+	{
+		// Every op enqueued so far has been processed, none of them can block later ones.
+		LastEnqueuedOpByEntity.Reset();
+		PendingUrgentOps.Reset();
+	}
+
+	// What the ops queued to be done once per frame is done once, rather than after every chunk.
+	Flush();
+}
+
+uint32 FTimeSlicedOpQueue::GetNumQueuedOps() const
+{
+	return static_cast<uint32>(NumEnqueuedOps - GetNextOpPosition());
+}
+
+bool FTimeSlicedOpQueue::IsProcessed(const Worker_Op* Op, uint64 Position) const
+{
+	return Position < GetNextOpPosition() || ProcessedAhead.Contains(Op);
+}
+
+uint64 FTimeSlicedOpQueue::GetNextOpPosition() const
+{
+	return OpLists.Num() > 0 ? OpLists[0].FirstOpPosition + NextOpIndex : NumEnqueuedOps;
+}
+
+bool FTimeSlicedOpQueue::IsUrgentOp(const Worker_Op& Op)
+{
+	switch (Op.op_type)
+	{
+	case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+	case WORKER_OP_TYPE_COMMAND_REQUEST:
+	case WORKER_OP_TYPE_COMMAND_RESPONSE:
+		return true;
+	case WORKER_OP_TYPE_COMPONENT_UPDATE:
+		switch (Op.op.component_update.update.component_id)
+		{
+		case SpatialConstants::CLIENT_ENDPOINT_COMPONENT_ID:
+		case SpatialConstants::SERVER_ENDPOINT_COMPONENT_ID:
+		case SpatialConstants::MULTICAST_RPCS_COMPONENT_ID:
+		case SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID_LEGACY:
+		case SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID_LEGACY:
+		case SpatialConstants::NETMULTICAST_RPCS_COMPONENT_ID_LEGACY:
+			return true;
+		default:
+			return false;
+		}
+	default:
+		return false;
+	}
+}
+
+bool FTimeSlicedOpQueue::ContinuesEntityRemoval(const Worker_OpList& OpList, uint32 OpIndex)
+{
+	if (OpIndex == 0 || OpList.ops[OpIndex - 1].op_type != WORKER_OP_TYPE_REMOVE_COMPONENT)
+	{
+		return false;
+	}
+
+	const Worker_Op& Op = OpList.ops[OpIndex];
+	return (Op.op_type == WORKER_OP_TYPE_REMOVE_COMPONENT || Op.op_type == WORKER_OP_TYPE_REMOVE_ENTITY)
+		&& GetEntityId(&Op) == GetEntityId(&OpList.ops[OpIndex - 1]);
+}
+
+void FTimeSlicedOpQueue::ProcessNextChunk()
+{
+	Worker_OpList* OpList = OpLists[0].OpList;
+
+	// A chunk ends after MaxOpsPerChunk ops, but not before the end of a critical section it contains, nor in the middle
+	// of an entity being removed.
+	uint32 EndIndex = NextOpIndex;
+	while (EndIndex < OpList->op_count && (bInCriticalSection || EndIndex - NextOpIndex < MaxOpsPerChunk || ContinuesEntityRemoval(*OpList, EndIndex)))
+	{
+		const Worker_Op& Op = OpList->ops[EndIndex];
+		if (Op.op_type == WORKER_OP_TYPE_CRITICAL_SECTION)
+		{
+			bInCriticalSection = Op.op.critical_section.in_critical_section != 0;
+		}
+
+		if (ProcessedAhead.Num() > 0)
+		{
+			ProcessedAhead.Remove(&Op);
+		}
+		++EndIndex;
+	}
+
+	// The chunk is processed in place, the ops stay owned by their op list.
+	Worker_OpList Chunk;
+	Chunk.op_count = EndIndex - NextOpIndex;
+	Chunk.ops = OpList->ops + NextOpIndex;
+	ProcessOpsFunction(&Chunk);
+
+	NextOpIndex = EndIndex;
+	if (NextOpIndex == OpList->op_count)
+	{
+		DestroyOpList(OpList);
+		OpLists.RemoveAt(0);
+		NextOpIndex = 0;
+	}
+}
+
+void FTimeSlicedOpQueue::ProcessUrgentOps()
+{
+	// Only the urgent ops found on enqueue are looked at, rather than every op left over.
+	const uint64 NextOpPosition = GetNextOpPosition();
+	int32 NumRemaining = 0;
+	for (int32 i = 0; i < PendingUrgentOps.Num(); ++i)
+	{
+		const FUrgentOp UrgentOp = PendingUrgentOps[i];
+		if (UrgentOp.Position < NextOpPosition)
+		{
+			// Processed by a chunk.
+			continue;
+		}
+
+		// An op can go ahead once every op before it that refers to the same entity has been processed. Ops in a
+		// critical section never go ahead, as the receiver expects to see the critical section in full.
+		const bool bCanGoAhead = !UrgentOp.bInCriticalSection
+			&& (UrgentOp.Blocker == nullptr || IsProcessed(UrgentOp.Blocker, UrgentOp.BlockerPosition));
+		if (!bCanGoAhead)
+		{
+			PendingUrgentOps[NumRemaining++] = UrgentOp;
+			continue;
+		}
+
+		Worker_OpList SingleOpList;
+		SingleOpList.op_count = 1;
+		SingleOpList.ops = UrgentOp.Op;
+		ProcessOpsFunction(&SingleOpList);
+
+		SkipOp(UrgentOp.Op);
+		ProcessedAhead.Add(UrgentOp.Op);
+	}
+	PendingUrgentOps.SetNum(NumRemaining, /*bAllowShrinking*/ false);
+}
+
+} // namespace SpatialGDK
@@ -2,6 +2,8 @@
 
 #include "SpatialGDKConsoleCommands.h"
 
+#include "EngineClasses/SpatialNetDriver.h"
+#include "Interop/Connection/SpatialWorkerConnection.h"
 #include "SpatialConstants.h"
 #include "Engine/Engine.h"
 
@@ -34,4 +36,117 @@ namespace SpatialGDKConsoleCommands
 		TEXT("Usage: ConnectToLocator <login> <playerToken>"),
 		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ConsoleCommand_ConnectToLocator)
 	);
+
+	USpatialWorkerConnection* GetWorkerConnection(UWorld* World)
+	{
+		USpatialNetDriver* NetDriver = World != nullptr ? Cast<USpatialNetDriver>(World->GetNetDriver()) : nullptr;
+		return NetDriver != nullptr ? NetDriver->GetWorkerConnection() : nullptr;
+	}
+
+	void ConsoleCommand_StartOpRecording(const TArray<FString>& Args, UWorld* World)
+	{
+		if (Args.Num() != 1)
+		{
+			UE_LOG(LogSpatialGDKConsoleCommands, Log, TEXT("ConsoleCommand_StartOpRecording takes 1 argument (filename). %d given."), Args.Num());
+			return;
+		}
+
+		USpatialWorkerConnection* Connection = GetWorkerConnection(World);
+		if (Connection == nullptr)
+		{
+			UE_LOG(LogSpatialGDKConsoleCommands, Warning, TEXT("Cannot record ops, there is no SpatialOS connection."));
+			return;
+		}
+
+		Connection->StartRecordingOpLists(Args[0]);
+	}
+
+	void ConsoleCommand_StopOpRecording(const TArray<FString>& Args, UWorld* World)
+	{
+		if (USpatialWorkerConnection* Connection = GetWorkerConnection(World))
+		{
+			Connection->StopRecordingOpLists();
+		}
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs StartOpRecordingCommand = FAutoConsoleCommandWithWorldAndArgs(
+		TEXT("SpatialStartOpRecording"),
+		TEXT("Usage: SpatialStartOpRecording <filename>. Records all ops received from SpatialOS for offline replay."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ConsoleCommand_StartOpRecording)
+	);
+
+	FAutoConsoleCommandWithWorldAndArgs StopOpRecordingCommand = FAutoConsoleCommandWithWorldAndArgs(
+		TEXT("SpatialStopOpRecording"),
+		TEXT("Usage: SpatialStopOpRecording. Stops a recording started with SpatialStartOpRecording."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ConsoleCommand_StopOpRecording)
+	);
+
+	void ConsoleCommand_StartOutgoingMessageStats(const TArray<FString>& Args, UWorld* World)
+	{
+		USpatialWorkerConnection* Connection = GetWorkerConnection(World);
+		if (Connection == nullptr)
+		{
+			UE_LOG(LogSpatialGDKConsoleCommands, Warning, TEXT("Cannot track outgoing messages, there is no SpatialOS connection."));
+			return;
+		}
+
+		Connection->ResetOutgoingMessageStats();
+		Connection->SetTrackOutgoingMessageStats(true);
+	}
+
+	void ConsoleCommand_StopOutgoingMessageStats(const TArray<FString>& Args, UWorld* World)
+	{
+		if (USpatialWorkerConnection* Connection = GetWorkerConnection(World))
+		{
+			Connection->SetTrackOutgoingMessageStats(false);
+		}
+	}
+
+	void ConsoleCommand_DumpOutgoingMessageStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		USpatialWorkerConnection* Connection = GetWorkerConnection(World);
+		if (Connection == nullptr)
+		{
+			Ar.Logf(TEXT("There is no SpatialOS connection."));
+			return;
+		}
+
+		Connection->GetOutgoingMessageStats().Dump(Ar);
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs StartOutgoingMessageStatsCommand = FAutoConsoleCommandWithWorldAndArgs(
+		TEXT("SpatialStartOutgoingMessageStats"),
+		TEXT("Usage: SpatialStartOutgoingMessageStats. Clears and starts recording latency and size histograms of outgoing messages."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ConsoleCommand_StartOutgoingMessageStats)
+	);
+
+	FAutoConsoleCommandWithWorldAndArgs StopOutgoingMessageStatsCommand = FAutoConsoleCommandWithWorldAndArgs(
+		TEXT("SpatialStopOutgoingMessageStats"),
+		TEXT("Usage: SpatialStopOutgoingMessageStats. Stops recording outgoing message histograms, keeping what has been recorded."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ConsoleCommand_StopOutgoingMessageStats)
+	);
+
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpOutgoingMessageStatsCommand = FAutoConsoleCommandWithWorldArgsAndOutputDevice(
+		TEXT("SpatialDumpOutgoingMessageStats"),
+		TEXT("Usage: SpatialDumpOutgoingMessageStats. Prints latency and size percentiles of outgoing messages, per message type and component."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&ConsoleCommand_DumpOutgoingMessageStats)
+	);
+
+	void ConsoleCommand_DumpActorPoolStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		USpatialNetDriver* NetDriver = World != nullptr ? Cast<USpatialNetDriver>(World->GetNetDriver()) : nullptr;
+		if (NetDriver == nullptr || !NetDriver->ActorPool.IsValid())
+		{
+			Ar.Logf(TEXT("There is no actor pool. Actors are only pooled on clients with PooledActorClasses set."));
+			return;
+		}
+
+		NetDriver->ActorPool->Dump(Ar);
+	}
+
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpActorPoolStatsCommand = FAutoConsoleCommandWithWorldArgsAndOutputDevice(
+		TEXT("SpatialDumpActorPoolStats"),
+		TEXT("Usage: SpatialDumpActorPoolStats. Prints the hit rate and number of parked actors of each pooled actor class."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&ConsoleCommand_DumpActorPoolStats)
+	);
 }
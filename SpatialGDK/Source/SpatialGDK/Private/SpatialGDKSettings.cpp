@@ -64,6 +64,17 @@ USpatialGDKSettings::USpatialGDKSettings(const FObjectInitializer& ObjectInitial
 	, WorkerLogLevel(ESettingsWorkerLogVerbosity::Warning)
 	, bEnableUnrealLoadBalancer(false)
 	, bRunSpatialWorkerConnectionOnGameThread(false)
+	, bWakeSpatialWorkerConnectionOnSend(false)
+	, OpsPollIntervalMillis(1)
+	, bCoalesceOutgoingComponentUpdates(false)
+	, OutgoingMessageQueueCapacity(8192)
+	, MaxOutgoingMessagesPerFlush(0)
+	, MaxOutgoingBytesPerFlush(0)
+	, MaxDeferredOutgoingMessageFlushes(10)
+	, bTrackOutgoingMessageStats(false)
+	, bPublishComponentViewSnapshots(false)
+	, ClientOpProcessingBudgetMillis(0.0f)
+	, bStageComponentUpdatesOnWorkerThreads(false)
 	, bUseRPCRingBuffers(true)
 	, DefaultRPCRingBufferSize(32)
 	, MaxRPCRingBufferSize(32)
@@ -99,6 +110,7 @@ void USpatialGDKSettings::PostInitProperties()
 	CheckCmdLineOverrideBool(CommandLine, TEXT("OverrideLoadBalancer"), TEXT("Load balancer"), bEnableUnrealLoadBalancer);
 	CheckCmdLineOverrideBool(CommandLine, TEXT("OverrideRPCRingBuffers"), TEXT("RPC ring buffers"), bUseRPCRingBuffers);
 	CheckCmdLineOverrideBool(CommandLine, TEXT("OverrideSpatialWorkerConnectionOnGameThread"), TEXT("Spatial worker connection on game thread"), bRunSpatialWorkerConnectionOnGameThread);
+	CheckCmdLineOverrideBool(CommandLine, TEXT("OverrideWakeSpatialWorkerConnectionOnSend"), TEXT("Wake spatial worker connection on send"), bWakeSpatialWorkerConnectionOnSend);
 	CheckCmdLineOverrideBool(CommandLine, TEXT("OverrideResultTypes"), TEXT("Result types"), bEnableResultTypes);
 	CheckCmdLineOverrideBool(CommandLine, TEXT("OverrideNetCullDistanceInterest"), TEXT("Net cull distance interest"), bEnableNetCullDistanceInterest);
 	CheckCmdLineOverrideBool(CommandLine, TEXT("OverrideNetCullDistanceInterestFrequency"), TEXT("Net cull distance interest frequency"), bEnableNetCullDistanceFrequency);
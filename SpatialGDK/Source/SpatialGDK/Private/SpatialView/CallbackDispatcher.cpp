@@ -0,0 +1,242 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "SpatialView/CallbackDispatcher.h"
+
+#include "Algo/BinarySearch.h"
+
+namespace SpatialGDK
+{
+
+namespace
+{
+
+template <typename CallbackType>
+bool RemoveCallbackFrom(TArray<CallbackType>& Callbacks, CallbackId Id)
+{
+	return Callbacks.RemoveAll([Id](const CallbackType& Registered) { return Registered.Id == Id; }) > 0;
+}
+
+} // anonymous namespace
+
+void CallbackDispatcher::ComponentSubscription::ResetChanges()
+{
+	Added.Reset();
+	Removed.Reset();
+	Updated.Reset();
+	Refreshed.Reset();
+	AuthorityGained.Reset();
+	AuthorityLost.Reset();
+	AuthorityLostTemporarily.Reset();
+}
+
+bool CallbackDispatcher::ComponentSubscription::RemoveCallback(CallbackId Id)
+{
+	return RemoveCallbackFrom(AddedCallbacks, Id)
+		|| RemoveCallbackFrom(RemovedCallbacks, Id)
+		|| RemoveCallbackFrom(UpdateCallbacks, Id)
+		|| RemoveCallbackFrom(RefreshCallbacks, Id)
+		|| RemoveCallbackFrom(AuthorityGainedCallbacks, Id)
+		|| RemoveCallbackFrom(AuthorityLostCallbacks, Id)
+		|| RemoveCallbackFrom(AuthorityLostTemporarilyCallbacks, Id);
+}
+
+CallbackDispatcher::CallbackDispatcher()
+: NextCallbackId(1)
+, bInvokingCallbacks(false)
+{
+}
+
+CallbackId CallbackDispatcher::RegisterComponentAddedCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback)
+{
+	return AddCallback(FindOrAddSubscription(ComponentId).AddedCallbacks, MoveTemp(Callback));
+}
+
+CallbackId CallbackDispatcher::RegisterComponentRemovedCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback)
+{
+	return AddCallback(FindOrAddSubscription(ComponentId).RemovedCallbacks, MoveTemp(Callback));
+}
+
+CallbackId CallbackDispatcher::RegisterComponentUpdateCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback)
+{
+	return AddCallback(FindOrAddSubscription(ComponentId).UpdateCallbacks, MoveTemp(Callback));
+}
+
+CallbackId CallbackDispatcher::RegisterComponentRefreshCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback)
+{
+	return AddCallback(FindOrAddSubscription(ComponentId).RefreshCallbacks, MoveTemp(Callback));
+}
+
+CallbackId CallbackDispatcher::RegisterAuthorityGainedCallback(Worker_ComponentId ComponentId, AuthorityChangeCallback Callback)
+{
+	return AddCallback(FindOrAddSubscription(ComponentId).AuthorityGainedCallbacks, MoveTemp(Callback));
+}
+
+CallbackId CallbackDispatcher::RegisterAuthorityLostCallback(Worker_ComponentId ComponentId, AuthorityChangeCallback Callback)
+{
+	return AddCallback(FindOrAddSubscription(ComponentId).AuthorityLostCallbacks, MoveTemp(Callback));
+}
+
+CallbackId CallbackDispatcher::RegisterAuthorityLostTemporarilyCallback(Worker_ComponentId ComponentId, AuthorityChangeCallback Callback)
+{
+	return AddCallback(FindOrAddSubscription(ComponentId).AuthorityLostTemporarilyCallbacks, MoveTemp(Callback));
+}
+
+void CallbackDispatcher::RemoveCallback(CallbackId Id)
+{
+	checkf(!bInvokingCallbacks, TEXT("Callbacks must not be removed while callbacks are being invoked."));
+
+	// Subscriptions are kept when their last callback is removed, the component is likely to be subscribed to again.
+	for (ComponentSubscription& Subscription : Subscriptions)
+	{
+		if (Subscription.RemoveCallback(Id))
+		{
+			return;
+		}
+	}
+}
+
+void CallbackDispatcher::InvokeCallbacks(const ViewDelta& Delta)
+{
+	SliceDelta(Delta);
+
+	bInvokingCallbacks = true;
+
+	const auto InvokeComponentCallbacks = [](const TArray<RegisteredCallback<ComponentChangeCallback>>& Callbacks, const TArray<EntityComponentChange>& Changes)
+	{
+		for (const RegisteredCallback<ComponentChangeCallback>& Registered : Callbacks)
+		{
+			for (const EntityComponentChange& Change : Changes)
+			{
+				Registered.Callback(Change.EntityId, *Change.Change);
+			}
+		}
+	};
+
+	const auto InvokeAuthorityCallbacks = [](const TArray<RegisteredCallback<AuthorityChangeCallback>>& Callbacks, const TArray<Worker_EntityId>& EntityIds)
+	{
+		for (const RegisteredCallback<AuthorityChangeCallback>& Registered : Callbacks)
+		{
+			for (const Worker_EntityId EntityId : EntityIds)
+			{
+				Registered.Callback(EntityId);
+			}
+		}
+	};
+
+	for (const ComponentSubscription& Subscription : Subscriptions)
+	{
+		InvokeComponentCallbacks(Subscription.AddedCallbacks, Subscription.Added);
+	}
+	for (const ComponentSubscription& Subscription : Subscriptions)
+	{
+		InvokeComponentCallbacks(Subscription.RefreshCallbacks, Subscription.Refreshed);
+	}
+	for (const ComponentSubscription& Subscription : Subscriptions)
+	{
+		InvokeComponentCallbacks(Subscription.UpdateCallbacks, Subscription.Updated);
+	}
+	for (const ComponentSubscription& Subscription : Subscriptions)
+	{
+		InvokeAuthorityCallbacks(Subscription.AuthorityGainedCallbacks, Subscription.AuthorityGained);
+	}
+	for (const ComponentSubscription& Subscription : Subscriptions)
+	{
+		InvokeAuthorityCallbacks(Subscription.AuthorityLostTemporarilyCallbacks, Subscription.AuthorityLostTemporarily);
+	}
+	for (const ComponentSubscription& Subscription : Subscriptions)
+	{
+		InvokeAuthorityCallbacks(Subscription.AuthorityLostCallbacks, Subscription.AuthorityLost);
+	}
+	for (const ComponentSubscription& Subscription : Subscriptions)
+	{
+		InvokeComponentCallbacks(Subscription.RemovedCallbacks, Subscription.Removed);
+	}
+
+	bInvokingCallbacks = false;
+}
+
+CallbackDispatcher::ComponentSubscription& CallbackDispatcher::FindOrAddSubscription(Worker_ComponentId ComponentId)
+{
+	checkf(!bInvokingCallbacks, TEXT("Callbacks must not be registered while callbacks are being invoked."));
+
+	if (ComponentSubscription* Subscription = FindSubscription(ComponentId))
+	{
+		return *Subscription;
+	}
+
+	const int32 Index = Algo::LowerBoundBy(Subscriptions, ComponentId, [](const ComponentSubscription& Subscription) { return Subscription.ComponentId; });
+	Subscriptions.Insert(ComponentSubscription{ ComponentId }, Index);
+
+	// Registering a new component is rare, so the indices are rebuilt rather than shifted.
+	SubscriptionIndices.Reset();
+	for (int32 i = 0; i < Subscriptions.Num(); ++i)
+	{
+		SubscriptionIndices.Add(Subscriptions[i].ComponentId, i);
+	}
+
+	return Subscriptions[Index];
+}
+
+CallbackDispatcher::ComponentSubscription* CallbackDispatcher::FindSubscription(Worker_ComponentId ComponentId)
+{
+	const int32* Index = SubscriptionIndices.Find(ComponentId);
+	return Index != nullptr ? &Subscriptions[*Index] : nullptr;
+}
+
+template <typename CallbackType>
+CallbackId CallbackDispatcher::AddCallback(TArray<RegisteredCallback<CallbackType>>& Callbacks, CallbackType Callback)
+{
+	const CallbackId Id = NextCallbackId++;
+	Callbacks.Add(RegisteredCallback<CallbackType>{ Id, MoveTemp(Callback) });
+	return Id;
+}
+
+void CallbackDispatcher::SliceDelta(const ViewDelta& Delta)
+{
+	for (ComponentSubscription& Subscription : Subscriptions)
+	{
+		Subscription.ResetChanges();
+	}
+
+	if (Subscriptions.Num() == 0)
+	{
+		return;
+	}
+
+	// Entity deltas are in entity order, so every slice ends up in entity order too.
+	const auto SliceComponentChanges = [this](Worker_EntityId EntityId, TArrayView<const ComponentChange> Changes, TArray<EntityComponentChange> ComponentSubscription::* Slice)
+	{
+		for (const ComponentChange& Change : Changes)
+		{
+			if (ComponentSubscription* Subscription = FindSubscription(Change.ComponentId))
+			{
+				(Subscription->*Slice).Add(EntityComponentChange{ EntityId, &Change });
+			}
+		}
+	};
+
+	const auto SliceAuthorityChanges = [this](TArrayView<const EntityComponentId> Changes, TArray<Worker_EntityId> ComponentSubscription::* Slice)
+	{
+		for (const EntityComponentId& Change : Changes)
+		{
+			if (ComponentSubscription* Subscription = FindSubscription(Change.ComponentId))
+			{
+				(Subscription->*Slice).Add(Change.EntityId);
+			}
+		}
+	};
+
+	for (const EntityDelta& Entity : Delta.GetEntityDeltas())
+	{
+		SliceComponentChanges(Entity.EntityId, Entity.ComponentsAdded, &ComponentSubscription::Added);
+		SliceComponentChanges(Entity.EntityId, Entity.ComponentsRemoved, &ComponentSubscription::Removed);
+		SliceComponentChanges(Entity.EntityId, Entity.ComponentUpdates, &ComponentSubscription::Updated);
+		SliceComponentChanges(Entity.EntityId, Entity.ComponentsRefreshed, &ComponentSubscription::Refreshed);
+	}
+
+	SliceAuthorityChanges(Delta.GetAuthorityGained(), &ComponentSubscription::AuthorityGained);
+	SliceAuthorityChanges(Delta.GetAuthorityLost(), &ComponentSubscription::AuthorityLost);
+	SliceAuthorityChanges(Delta.GetAuthorityLostTemporarily(), &ComponentSubscription::AuthorityLostTemporarily);
+}
+
+}  // namespace SpatialGDK
@@ -0,0 +1,59 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "SpatialView/CommandRequest.h"
+
+namespace SpatialGDK
+{
+
+CommandRequest::CommandRequest(Worker_ComponentId ComponentId, Schema_FieldId CommandIndex)
+: CommandRequest(OwningCommandRequestPtr(Schema_CreateCommandRequest()), ComponentId, CommandIndex)
+{
+}
+
+CommandRequest::CommandRequest(OwningCommandRequestPtr Request, Worker_ComponentId ComponentId, Schema_FieldId CommandIndex)
+: ComponentId(ComponentId)
+, CommandIndex(CommandIndex)
+, Request(MoveTemp(Request))
+{
+}
+
+CommandRequest CommandRequest::CreateCopy(const Schema_CommandRequest* Request, Worker_ComponentId ComponentId, Schema_FieldId CommandIndex)
+{
+	return CommandRequest(OwningCommandRequestPtr(Schema_CopyCommandRequest(Request)), ComponentId, CommandIndex);
+}
+
+CommandRequest CommandRequest::DeepCopy() const
+{
+	check(Request.IsValid());
+	return CreateCopy(Request.Get(), ComponentId, CommandIndex);
+}
+
+Schema_CommandRequest* CommandRequest::Release() &&
+{
+	check(Request.IsValid());
+	return Request.Release();
+}
+
+Schema_Object* CommandRequest::GetRequestObject() const
+{
+	check(Request.IsValid());
+	return Schema_GetCommandRequestObject(Request.Get());
+}
+
+Schema_CommandRequest* CommandRequest::GetUnderlying() const
+{
+	check(Request.IsValid());
+	return Request.Get();
+}
+
+Worker_ComponentId CommandRequest::GetComponentId() const
+{
+	return ComponentId;
+}
+
+Schema_FieldId CommandRequest::GetCommandIndex() const
+{
+	return CommandIndex;
+}
+
+}  // namespace SpatialGDK
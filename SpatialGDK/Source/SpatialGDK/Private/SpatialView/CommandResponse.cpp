@@ -0,0 +1,59 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "SpatialView/CommandResponse.h"
+
+namespace SpatialGDK
+{
+
+CommandResponse::CommandResponse(Worker_ComponentId ComponentId, Schema_FieldId CommandIndex)
+: CommandResponse(OwningCommandResponsePtr(Schema_CreateCommandResponse()), ComponentId, CommandIndex)
+{
+}
+
+CommandResponse::CommandResponse(OwningCommandResponsePtr Response, Worker_ComponentId ComponentId, Schema_FieldId CommandIndex)
+: ComponentId(ComponentId)
+, CommandIndex(CommandIndex)
+, Response(MoveTemp(Response))
+{
+}
+
+CommandResponse CommandResponse::CreateCopy(const Schema_CommandResponse* Response, Worker_ComponentId ComponentId, Schema_FieldId CommandIndex)
+{
+	return CommandResponse(OwningCommandResponsePtr(Schema_CopyCommandResponse(Response)), ComponentId, CommandIndex);
+}
+
+CommandResponse CommandResponse::DeepCopy() const
+{
+	check(Response.IsValid());
+	return CreateCopy(Response.Get(), ComponentId, CommandIndex);
+}
+
+Schema_CommandResponse* CommandResponse::Release() &&
+{
+	check(Response.IsValid());
+	return Response.Release();
+}
+
+Schema_Object* CommandResponse::GetResponseObject() const
+{
+	check(Response.IsValid());
+	return Schema_GetCommandResponseObject(Response.Get());
+}
+
+Schema_CommandResponse* CommandResponse::GetUnderlying() const
+{
+	check(Response.IsValid());
+	return Response.Get();
+}
+
+Worker_ComponentId CommandResponse::GetComponentId() const
+{
+	return ComponentId;
+}
+
+Schema_FieldId CommandResponse::GetCommandIndex() const
+{
+	return CommandIndex;
+}
+
+}  // namespace SpatialGDK
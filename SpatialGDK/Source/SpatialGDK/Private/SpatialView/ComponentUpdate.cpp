@@ -0,0 +1,76 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "SpatialView/ComponentUpdate.h"
+
+namespace SpatialGDK
+{
+
+ComponentUpdate::ComponentUpdate(Worker_ComponentId Id)
+: ComponentUpdate(OwningComponentUpdatePtr(Schema_CreateComponentUpdate()), Id)
+{
+}
+
+ComponentUpdate::ComponentUpdate(OwningComponentUpdatePtr Update, Worker_ComponentId Id)
+: ComponentId(Id)
+, Update(MoveTemp(Update))
+{
+}
+
+ComponentUpdate ComponentUpdate::CreateCopy(const Schema_ComponentUpdate* Update, Worker_ComponentId Id)
+{
+	return ComponentUpdate(OwningComponentUpdatePtr(Schema_CopyComponentUpdate(Update)), Id);
+}
+
+ComponentUpdate ComponentUpdate::DeepCopy() const
+{
+	check(Update.IsValid());
+	return CreateCopy(Update.Get(), ComponentId);
+}
+
+Schema_ComponentUpdate* ComponentUpdate::Release() &&
+{
+	check(Update.IsValid());
+	return Update.Release();
+}
+
+bool ComponentUpdate::Merge(const ComponentUpdate& Other)
+{
+	check(Update.IsValid());
+	check(Other.Update.IsValid());
+	check(Other.ComponentId == ComponentId);
+
+	return Merge(Other.Update.Get());
+}
+
+bool ComponentUpdate::Merge(const Schema_ComponentUpdate* Other)
+{
+	check(Update.IsValid());
+	check(Other != nullptr);
+
+	return Schema_MergeComponentUpdateIntoComponentUpdate(Other, Update.Get()) != 0;
+}
+
+Schema_Object* ComponentUpdate::GetFields() const
+{
+	check(Update.IsValid());
+	return Schema_GetComponentUpdateFields(Update.Get());
+}
+
+Schema_Object* ComponentUpdate::GetEvents() const
+{
+	check(Update.IsValid());
+	return Schema_GetComponentUpdateEvents(Update.Get());
+}
+
+Schema_ComponentUpdate* ComponentUpdate::GetUnderlying() const
+{
+	check(Update.IsValid());
+	return Update.Get();
+}
+
+Worker_ComponentId ComponentUpdate::GetComponentId() const
+{
+	return ComponentId;
+}
+
+}  // namespace SpatialGDK
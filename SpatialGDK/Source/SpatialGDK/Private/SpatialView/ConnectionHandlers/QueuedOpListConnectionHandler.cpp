@@ -0,0 +1,228 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "SpatialView/ConnectionHandlers/QueuedOpListConnectionHandler.h"
+
+namespace SpatialGDK
+{
+
+namespace
+{
+
+template <typename T>
+const T* GetOptionalPtr(const TOptional<T>& Optional)
+{
+	return Optional.IsSet() ? &Optional.GetValue() : nullptr;
+}
+
+void SendComponentMessage(Worker_Connection* Connection, OutgoingComponentMessage& Message)
+{
+	// Loopback is left at its default, so local changes come back as ops and keep the view up to date.
+	switch (Message.Type)
+	{
+	case OutgoingComponentMessage::ADD:
+	{
+		Worker_ComponentData Data{};
+		Data.component_id = Message.ComponentId;
+		Data.schema_type = Message.Data.Release();
+		Worker_Connection_SendAddComponent(Connection, Message.EntityId, &Data, nullptr);
+		break;
+	}
+	case OutgoingComponentMessage::UPDATE:
+	{
+		Worker_ComponentUpdate Update{};
+		Update.component_id = Message.ComponentId;
+		Update.schema_type = Message.Update.Release();
+		Worker_Connection_SendComponentUpdate(Connection, Message.EntityId, &Update, nullptr);
+		break;
+	}
+	case OutgoingComponentMessage::REMOVE:
+		Worker_Connection_SendRemoveComponent(Connection, Message.EntityId, Message.ComponentId, nullptr);
+		break;
+	}
+}
+
+void SendMetrics(Worker_Connection* Connection, SpatialMetrics& Metrics)
+{
+	TArray<Worker_GaugeMetric> WorkerGaugeMetrics;
+	WorkerGaugeMetrics.SetNum(Metrics.GaugeMetrics.Num());
+	for (int32 i = 0; i < Metrics.GaugeMetrics.Num(); ++i)
+	{
+		WorkerGaugeMetrics[i].key = Metrics.GaugeMetrics[i].Key.c_str();
+		WorkerGaugeMetrics[i].value = Metrics.GaugeMetrics[i].Value;
+	}
+
+	// One allocation for the buckets of all histograms.
+	int32 BucketCount = 0;
+	for (const HistogramMetric& Histogram : Metrics.HistogramMetrics)
+	{
+		BucketCount += Histogram.Buckets.Num();
+	}
+
+	TArray<Worker_HistogramMetric> WorkerHistogramMetrics;
+	TArray<Worker_HistogramMetricBucket> WorkerHistogramMetricBuckets;
+	WorkerHistogramMetrics.SetNum(Metrics.HistogramMetrics.Num());
+	WorkerHistogramMetricBuckets.Reserve(BucketCount);
+	for (int32 i = 0; i < Metrics.HistogramMetrics.Num(); ++i)
+	{
+		const HistogramMetric& Histogram = Metrics.HistogramMetrics[i];
+		WorkerHistogramMetrics[i].key = Histogram.Key.c_str();
+		WorkerHistogramMetrics[i].sum = Histogram.Sum;
+		WorkerHistogramMetrics[i].bucket_count = static_cast<uint32_t>(Histogram.Buckets.Num());
+		WorkerHistogramMetrics[i].buckets = WorkerHistogramMetricBuckets.GetData() + WorkerHistogramMetricBuckets.Num();
+		for (const HistogramMetricBucket& Bucket : Histogram.Buckets)
+		{
+			WorkerHistogramMetricBuckets.Add(Worker_HistogramMetricBucket{ Bucket.UpperBound, Bucket.Samples });
+		}
+	}
+
+	Worker_Metrics WorkerMetrics{};
+	WorkerMetrics.load = Metrics.Load.IsSet() ? &Metrics.Load.GetValue() : nullptr;
+	WorkerMetrics.gauge_metric_count = static_cast<uint32_t>(WorkerGaugeMetrics.Num());
+	WorkerMetrics.gauge_metrics = WorkerGaugeMetrics.GetData();
+	WorkerMetrics.histogram_metric_count = static_cast<uint32_t>(WorkerHistogramMetrics.Num());
+	WorkerMetrics.histogram_metrics = WorkerHistogramMetrics.GetData();
+
+	Worker_Connection_SendMetrics(Connection, &WorkerMetrics);
+}
+
+Worker_RequestId* GetResponseRequestId(Worker_Op& Op)
+{
+	switch (Op.op_type)
+	{
+	case WORKER_OP_TYPE_RESERVE_ENTITY_IDS_RESPONSE:
+		return &Op.op.reserve_entity_ids_response.request_id;
+	case WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE:
+		return &Op.op.create_entity_response.request_id;
+	case WORKER_OP_TYPE_DELETE_ENTITY_RESPONSE:
+		return &Op.op.delete_entity_response.request_id;
+	case WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE:
+		return &Op.op.entity_query_response.request_id;
+	case WORKER_OP_TYPE_COMMAND_RESPONSE:
+		return &Op.op.command_response.request_id;
+	default:
+		return nullptr;
+	}
+}
+
+} // anonymous namespace
+
+TUniquePtr<AbstractOpList> QueuedOpListConnectionHandler::GetNextOpList()
+{
+	TUniquePtr<AbstractOpList> NextOpList = MoveTemp(OpLists[0]);
+	OpLists.RemoveAt(0);
+
+	// Give responses the request ids the messages were sent with.
+	if (SdkToMessageRequestIds.Num() > 0)
+	{
+		AbstractOpList& Ops = *NextOpList;
+		for (uint32 i = 0; i < Ops.GetCount(); ++i)
+		{
+			Worker_RequestId* RequestId = GetResponseRequestId(Ops[i]);
+			Worker_RequestId MessageRequestId;
+			if (RequestId != nullptr && SdkToMessageRequestIds.RemoveAndCopyValue(*RequestId, MessageRequestId))
+			{
+				*RequestId = MessageRequestId;
+			}
+		}
+	}
+
+	return NextOpList;
+}
+
+void QueuedOpListConnectionHandler::SendMessages(MessagesToSend& Messages)
+{
+	static const Worker_CommandParameters DefaultCommandParams{};
+
+	// Messages are sent in the order they were added, whatever their type. The Worker SDK assigns its own request ids,
+	// which can differ from the ids in the messages, so responses are mapped back to the ids in the messages.
+	for (const MessagesToSend::MessageRef& Ref : Messages.Order)
+	{
+		switch (Ref.Type)
+		{
+		case MessagesToSend::RESERVE_ENTITY_IDS_REQUEST:
+		{
+			const ReserveEntityIdsRequest& Request = Messages.ReserveEntityIdsRequests[Ref.Index];
+			const Worker_RequestId SdkRequestId = Worker_Connection_SendReserveEntityIdsRequest(Connection, Request.NumberOfEntityIds, GetOptionalPtr(Request.TimeoutMillis));
+			SdkToMessageRequestIds.Add(SdkRequestId, Request.RequestId);
+			break;
+		}
+		case MessagesToSend::CREATE_ENTITY_REQUEST:
+		{
+			CreateEntityRequest& Request = Messages.CreateEntityRequests[Ref.Index];
+			Worker_EntityId* EntityId = Request.EntityId.IsSet() ? &Request.EntityId.GetValue() : nullptr;
+			uint32* TimeoutMillis = Request.TimeoutMillis.IsSet() ? &Request.TimeoutMillis.GetValue() : nullptr;
+			const Worker_RequestId SdkRequestId = Worker_Connection_SendCreateEntityRequest(Connection, Request.ComponentCount, Request.EntityComponents, EntityId, TimeoutMillis);
+			SdkToMessageRequestIds.Add(SdkRequestId, Request.RequestId);
+			break;
+		}
+		case MessagesToSend::COMPONENT_MESSAGE:
+			SendComponentMessage(Connection, Messages.ComponentMessages[Ref.Index]);
+			break;
+		case MessagesToSend::COMPONENT_INTEREST:
+		{
+			ComponentInterestMessage& Message = Messages.ComponentInterests[Ref.Index];
+			Worker_Connection_SendComponentInterest(Connection, Message.EntityId, Message.Interests.GetData(), Message.Interests.Num());
+			break;
+		}
+		case MessagesToSend::ENTITY_COMMAND_REQUEST:
+		{
+			EntityCommandRequest& Request = Messages.EntityCommandRequests[Ref.Index];
+			Worker_CommandRequest WorkerRequest{};
+			WorkerRequest.component_id = Request.Request.GetComponentId();
+			WorkerRequest.command_index = Request.Request.GetCommandIndex();
+			WorkerRequest.schema_type = MoveTemp(Request.Request).Release();
+			const Worker_RequestId SdkRequestId = Worker_Connection_SendCommandRequest(Connection, Request.EntityId, &WorkerRequest, GetOptionalPtr(Request.TimeoutMillis), &DefaultCommandParams);
+			SdkToMessageRequestIds.Add(SdkRequestId, Request.RequestId);
+			break;
+		}
+		case MessagesToSend::ENTITY_COMMAND_RESPONSE:
+		{
+			EntityCommandResponse& Response = Messages.EntityCommandResponses[Ref.Index];
+			Worker_CommandResponse WorkerResponse{};
+			WorkerResponse.component_id = Response.Response.GetComponentId();
+			WorkerResponse.command_index = Response.Response.GetCommandIndex();
+			WorkerResponse.schema_type = MoveTemp(Response.Response).Release();
+			Worker_Connection_SendCommandResponse(Connection, Response.RequestId, &WorkerResponse);
+			break;
+		}
+		case MessagesToSend::ENTITY_COMMAND_FAILURE:
+		{
+			const EntityCommandFailure& Failure = Messages.EntityCommandFailures[Ref.Index];
+			Worker_Connection_SendCommandFailure(Connection, Failure.RequestId, TCHAR_TO_UTF8(*Failure.Message));
+			break;
+		}
+		case MessagesToSend::ENTITY_QUERY_REQUEST:
+		{
+			const EntityQueryRequest& Request = Messages.EntityQueryRequests[Ref.Index];
+			const Worker_RequestId SdkRequestId = Worker_Connection_SendEntityQueryRequest(Connection, Request.Query.GetWorkerQuery(), GetOptionalPtr(Request.TimeoutMillis));
+			SdkToMessageRequestIds.Add(SdkRequestId, Request.RequestId);
+			break;
+		}
+		case MessagesToSend::DELETE_ENTITY_REQUEST:
+		{
+			const DeleteEntityRequest& Request = Messages.DeleteEntityRequests[Ref.Index];
+			const Worker_RequestId SdkRequestId = Worker_Connection_SendDeleteEntityRequest(Connection, Request.EntityId, GetOptionalPtr(Request.TimeoutMillis));
+			SdkToMessageRequestIds.Add(SdkRequestId, Request.RequestId);
+			break;
+		}
+		case MessagesToSend::LOG:
+		{
+			const LogMessage& Log = Messages.Logs[Ref.Index];
+			FTCHARToUTF8 LoggerName(*Log.LoggerName.ToString());
+			FTCHARToUTF8 LogString(*Log.Message);
+
+			Worker_LogMessage WorkerLog{};
+			WorkerLog.level = Log.Level;
+			WorkerLog.logger_name = LoggerName.Get();
+			WorkerLog.message = LogString.Get();
+			Worker_Connection_SendLogMessage(Connection, &WorkerLog);
+			break;
+		}
+		case MessagesToSend::METRICS:
+			SendMetrics(Connection, Messages.Metrics[Ref.Index]);
+			break;
+		}
+	}
+}
+
+}  // namespace SpatialGDK
@@ -0,0 +1,73 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "SpatialView/EntityQuery.h"
+
+namespace SpatialGDK
+{
+
+EntityQuery::EntityQuery(const Worker_EntityQuery& Query)
+: Query(Query)
+{
+	if (Query.snapshot_result_type_component_ids != nullptr)
+	{
+		SnapshotComponentIds.Append(Query.snapshot_result_type_component_ids, static_cast<int32>(Query.snapshot_result_type_component_id_count));
+		this->Query.snapshot_result_type_component_ids = SnapshotComponentIds.GetData();
+	}
+
+	CopyConstraint(this->Query.constraint);
+}
+
+const Worker_EntityQuery* EntityQuery::GetWorkerQuery() const
+{
+	return &Query;
+}
+
+void EntityQuery::CopyConstraint(Worker_Constraint& Constraint)
+{
+	// Child constraints live in heap arrays, so moving the query keeps them valid.
+	switch (Constraint.constraint_type)
+	{
+	case WORKER_CONSTRAINT_TYPE_AND:
+	{
+		Worker_AndConstraint& And = Constraint.constraint.and_constraint;
+		TUniquePtr<Worker_Constraint[]> NewConstraints = MakeUnique<Worker_Constraint[]>(And.constraint_count);
+		for (uint32 i = 0; i < And.constraint_count; ++i)
+		{
+			NewConstraints[i] = And.constraints[i];
+			CopyConstraint(NewConstraints[i]);
+		}
+		And.constraints = NewConstraints.Get();
+
+		ConstraintStorage.Add(MoveTemp(NewConstraints));
+		break;
+	}
+	case WORKER_CONSTRAINT_TYPE_OR:
+	{
+		Worker_OrConstraint& Or = Constraint.constraint.or_constraint;
+		TUniquePtr<Worker_Constraint[]> NewConstraints = MakeUnique<Worker_Constraint[]>(Or.constraint_count);
+		for (uint32 i = 0; i < Or.constraint_count; ++i)
+		{
+			NewConstraints[i] = Or.constraints[i];
+			CopyConstraint(NewConstraints[i]);
+		}
+		Or.constraints = NewConstraints.Get();
+
+		ConstraintStorage.Add(MoveTemp(NewConstraints));
+		break;
+	}
+	case WORKER_CONSTRAINT_TYPE_NOT:
+	{
+		TUniquePtr<Worker_Constraint[]> NewConstraint = MakeUnique<Worker_Constraint[]>(1);
+		NewConstraint[0] = *Constraint.constraint.not_constraint.constraint;
+		CopyConstraint(NewConstraint[0]);
+		Constraint.constraint.not_constraint.constraint = NewConstraint.Get();
+
+		ConstraintStorage.Add(MoveTemp(NewConstraint));
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+}  // namespace SpatialGDK
@@ -0,0 +1,92 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "SpatialView/FrameArena.h"
+
+#include "HAL/UnrealMemory.h"
+#include "Templates/AlignmentTemplates.h"
+
+namespace SpatialGDK
+{
+
+namespace
+{
+
+const uint32 BlockAlignment = 16;
+
+} // anonymous namespace
+
+FrameArena::FrameArena(SIZE_T MinBlockSize)
+: MinBlockSize(MinBlockSize)
+, Offset(0)
+, BytesUsed(0)
+{
+}
+
+FrameArena::~FrameArena()
+{
+	for (const Block& CurrentBlock : Blocks)
+	{
+		FMemory::Free(CurrentBlock.Memory);
+	}
+}
+
+void* FrameArena::Allocate(SIZE_T Size, SIZE_T Alignment)
+{
+	if (Blocks.Num() > 0)
+	{
+		const Block& CurrentBlock = Blocks.Last();
+		const SIZE_T AlignedOffset = Align(reinterpret_cast<UPTRINT>(CurrentBlock.Memory) + Offset, Alignment) - reinterpret_cast<UPTRINT>(CurrentBlock.Memory);
+		if (AlignedOffset + Size <= CurrentBlock.Size)
+		{
+			Offset = AlignedOffset + Size;
+			BytesUsed += Size;
+			return CurrentBlock.Memory + AlignedOffset;
+		}
+	}
+
+	// New blocks start at BlockAlignment, which covers every type stored in the arena.
+	check(Alignment <= BlockAlignment);
+	Blocks.Add(AllocateBlock(FMath::Max(MinBlockSize, Size)));
+	Offset = Size;
+	BytesUsed += Size;
+	return Blocks.Last().Memory;
+}
+
+void FrameArena::Reset()
+{
+	if (Blocks.Num() > 1)
+	{
+		const SIZE_T TotalSize = GetBytesReserved();
+		for (const Block& CurrentBlock : Blocks)
+		{
+			FMemory::Free(CurrentBlock.Memory);
+		}
+		Blocks.Reset();
+		Blocks.Add(AllocateBlock(TotalSize));
+	}
+
+	Offset = 0;
+	BytesUsed = 0;
+}
+
+SIZE_T FrameArena::GetBytesUsed() const
+{
+	return BytesUsed;
+}
+
+SIZE_T FrameArena::GetBytesReserved() const
+{
+	SIZE_T TotalSize = 0;
+	for (const Block& CurrentBlock : Blocks)
+	{
+		TotalSize += CurrentBlock.Size;
+	}
+	return TotalSize;
+}
+
+FrameArena::Block FrameArena::AllocateBlock(SIZE_T Size)
+{
+	return Block{ static_cast<uint8*>(FMemory::Malloc(Size, BlockAlignment)), Size };
+}
+
+}  // namespace SpatialGDK
@@ -22,16 +22,91 @@ void ViewCoordinator::Advance()
 	Delta = View.GenerateViewDelta();
 }
 
+void ViewCoordinator::InvokeCallbacks()
+{
+	Dispatcher.InvokeCallbacks(*Delta);
+}
+
 void ViewCoordinator::FlushMessagesToSend()
 {
 	ConnectionHandler->SendMessages(View.FlushLocalChanges());
 }
 
+void ViewCoordinator::SendReserveEntityIdsRequest(ReserveEntityIdsRequest Request)
+{
+	View.SendReserveEntityIdsRequest(MoveTemp(Request));
+}
+
+void ViewCoordinator::SendCreateEntityRequest(CreateEntityRequest Request)
+{
+	View.SendCreateEntityRequest(MoveTemp(Request));
+}
+
+void ViewCoordinator::SendDeleteEntityRequest(DeleteEntityRequest Request)
+{
+	View.SendDeleteEntityRequest(MoveTemp(Request));
+}
+
+void ViewCoordinator::SendAddComponent(Worker_EntityId EntityId, ComponentData Data)
+{
+	View.SendAddComponent(EntityId, MoveTemp(Data));
+}
+
+void ViewCoordinator::SendComponentUpdate(Worker_EntityId EntityId, ComponentUpdate Update)
+{
+	View.SendComponentUpdate(EntityId, MoveTemp(Update));
+}
+
+void ViewCoordinator::SendRemoveComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+{
+	View.SendRemoveComponent(EntityId, ComponentId);
+}
+
+void ViewCoordinator::SendComponentInterest(Worker_EntityId EntityId, TArray<Worker_InterestOverride> Interests)
+{
+	View.SendComponentInterest(EntityId, MoveTemp(Interests));
+}
+
+void ViewCoordinator::SendEntityCommandRequest(EntityCommandRequest Request)
+{
+	View.SendEntityCommandRequest(MoveTemp(Request));
+}
+
+void ViewCoordinator::SendEntityCommandResponse(EntityCommandResponse Response)
+{
+	View.SendEntityCommandResponse(MoveTemp(Response));
+}
+
+void ViewCoordinator::SendEntityCommandFailure(EntityCommandFailure Failure)
+{
+	View.SendEntityCommandFailure(MoveTemp(Failure));
+}
+
+void ViewCoordinator::SendEntityQueryRequest(EntityQueryRequest Request)
+{
+	View.SendEntityQueryRequest(MoveTemp(Request));
+}
+
+void ViewCoordinator::SendLogMessage(LogMessage Log)
+{
+	View.SendLogMessage(MoveTemp(Log));
+}
+
+void ViewCoordinator::SendMetrics(SpatialMetrics Metrics)
+{
+	View.SendMetrics(MoveTemp(Metrics));
+}
+
 const TArray<CreateEntityResponse>& ViewCoordinator::GetCreateEntityResponses() const
 {
 	return Delta->GetCreateEntityResponses();
 }
 
+const TArray<EntityDelta>& ViewCoordinator::GetEntityDeltas() const
+{
+	return Delta->GetEntityDeltas();
+}
+
 const TArray<EntityComponentId>& ViewCoordinator::GetAuthorityGained() const
 {
 	return Delta->GetAuthorityGained();
@@ -47,9 +122,49 @@ const TArray<EntityComponentId>& ViewCoordinator::GetAuthorityLostTemporarily()
 	return Delta->GetAuthorityLostTemporarily();
 }
 
-TUniquePtr<AbstractOpList> ViewCoordinator::GenerateLegacyOpList() const
+const EntityView& ViewCoordinator::GetView() const
+{
+	return View.GetView();
+}
+
+CallbackId ViewCoordinator::RegisterComponentAddedCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback)
+{
+	return Dispatcher.RegisterComponentAddedCallback(ComponentId, MoveTemp(Callback));
+}
+
+CallbackId ViewCoordinator::RegisterComponentRemovedCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback)
+{
+	return Dispatcher.RegisterComponentRemovedCallback(ComponentId, MoveTemp(Callback));
+}
+
+CallbackId ViewCoordinator::RegisterComponentUpdateCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback)
+{
+	return Dispatcher.RegisterComponentUpdateCallback(ComponentId, MoveTemp(Callback));
+}
+
+CallbackId ViewCoordinator::RegisterComponentRefreshCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback)
+{
+	return Dispatcher.RegisterComponentRefreshCallback(ComponentId, MoveTemp(Callback));
+}
+
+CallbackId ViewCoordinator::RegisterAuthorityGainedCallback(Worker_ComponentId ComponentId, AuthorityChangeCallback Callback)
+{
+	return Dispatcher.RegisterAuthorityGainedCallback(ComponentId, MoveTemp(Callback));
+}
+
+CallbackId ViewCoordinator::RegisterAuthorityLostCallback(Worker_ComponentId ComponentId, AuthorityChangeCallback Callback)
+{
+	return Dispatcher.RegisterAuthorityLostCallback(ComponentId, MoveTemp(Callback));
+}
+
+CallbackId ViewCoordinator::RegisterAuthorityLostTemporarilyCallback(Worker_ComponentId ComponentId, AuthorityChangeCallback Callback)
+{
+	return Dispatcher.RegisterAuthorityLostTemporarilyCallback(ComponentId, MoveTemp(Callback));
+}
+
+void ViewCoordinator::RemoveCallback(CallbackId Id)
 {
-	return Delta->GenerateLegacyOpList();
+	Dispatcher.RemoveCallback(Id);
 }
 
 }  // SpatialView
@@ -1,20 +1,141 @@
 // Copyright (c) Improbable Worlds Ltd, All Rights Reserved
 
 #include "SpatialView/ViewDelta.h"
-#include "SpatialView/OpList/ViewDeltaLegacyOpList.h"
-#include "Containers/StringConv.h"
+
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
 
 namespace SpatialGDK
 {
 
+namespace
+{
+
+// Below this many ops per shard, distributing the work costs more than it saves.
+const uint32 MinOpsPerShard = 1024;
+
+template <typename T>
+bool EntityComponentLess(const T& Lhs, const T& Rhs)
+{
+	return Lhs.EntityId != Rhs.EntityId ? Lhs.EntityId < Rhs.EntityId : Lhs.ComponentId < Rhs.ComponentId;
+}
+
+// Returns the end of the run of elements starting at Begin that match Predicate.
+template <typename T, typename PredicateType>
+int32 FindRunEnd(const ArenaArray<T>& Elements, int32 Begin, PredicateType Predicate)
+{
+	int32 End = Begin;
+	while (End < Elements.Num() && Predicate(Elements[End]))
+	{
+		++End;
+	}
+	return End;
+}
+
+template <typename T>
+TArrayView<const T> MakeRunView(const ArenaArray<T>& Elements, int32 Begin, int32 End)
+{
+	return TArrayView<const T>(Elements.GetData() + Begin, End - Begin);
+}
+
+template <typename T>
+TArrayView<const T> MakeTailView(const ArenaArray<T>& Elements, int32 Begin)
+{
+	return MakeRunView(Elements, Begin, Elements.Num());
+}
+
+// Returns the entity an op changes, or 0 for ops that don't change an entity.
+Worker_EntityId GetChangedEntityId(const Worker_Op& Op)
+{
+	switch (static_cast<Worker_OpType>(Op.op_type))
+	{
+	case WORKER_OP_TYPE_ADD_ENTITY:
+		return Op.op.add_entity.entity_id;
+	case WORKER_OP_TYPE_REMOVE_ENTITY:
+		return Op.op.remove_entity.entity_id;
+	case WORKER_OP_TYPE_ADD_COMPONENT:
+		return Op.op.add_component.entity_id;
+	case WORKER_OP_TYPE_COMPONENT_UPDATE:
+		return Op.op.component_update.entity_id;
+	case WORKER_OP_TYPE_REMOVE_COMPONENT:
+		return Op.op.remove_component.entity_id;
+	case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+		return Op.op.authority_change.entity_id;
+	default:
+		return 0;
+	}
+}
+
+} // anonymous namespace
+
+void ViewDelta::SetFromOpLists(TArray<TUniquePtr<AbstractOpList>>& InOpLists, EntityView& View)
+{
+	Clear();
+
+	uint32 TotalOpCount = 0;
+	for (const TUniquePtr<AbstractOpList>& OpList : InOpLists)
+	{
+		TotalOpCount += OpList->GetCount();
+	}
+
+	const int32 MaxShards = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	const int32 ShardCount = FMath::Clamp(static_cast<int32>(TotalOpCount / MinOpsPerShard), 1, MaxShards);
+	Shards.SetNum(ShardCount, /*bAllowShrinking*/ false);
+	const bool bSingleThreaded = ShardCount == 1;
+
+	// Counting first lets every shard get exactly the space it needs from the arena.
+	for (const TUniquePtr<AbstractOpList>& OpList : InOpLists)
+	{
+		const uint32 OpCount = OpList->GetCount();
+		for (uint32 i = 0; i < OpCount; ++i)
+		{
+			CountOp((*OpList)[i]);
+		}
+	}
+
+	for (Shard& CurrentShard : Shards)
+	{
+		CurrentShard.Init(Arena);
+	}
+
+	for (const TUniquePtr<AbstractOpList>& OpList : InOpLists)
+	{
+		const uint32 OpCount = OpList->GetCount();
+		for (uint32 i = 0; i < OpCount; ++i)
+		{
+			GatherOp((*OpList)[i]);
+		}
+	}
+
+	// OpLists was emptied by Clear, so this hands its allocation back to the caller.
+	Swap(OpLists, InOpLists);
+
+	ParallelFor(ShardCount, [this](int32 Index) { Shards[Index].SortReceivedChanges(); }, bSingleThreaded);
+
+	// Adding and removing entities changes the layout of the view, so it happens outside of the parallel section.
+	for (Shard& CurrentShard : Shards)
+	{
+		CurrentShard.AddEntitiesEnteringView(View);
+	}
+
+	ParallelFor(ShardCount, [this, &View](int32 Index) { Shards[Index].Process(View); }, bSingleThreaded);
+
+	for (Shard& CurrentShard : Shards)
+	{
+		CurrentShard.RemoveEntitiesLeavingView(View);
+	}
+
+	MergeShards();
+}
+
 void ViewDelta::AddCreateEntityResponse(CreateEntityResponse Response)
 {
 	CreateEntityResponses.Push(MoveTemp(Response));
 }
 
-void ViewDelta::SetAuthority(Worker_EntityId EntityId, Worker_ComponentId ComponentId, Worker_Authority Authority)
+const TArray<EntityDelta>& ViewDelta::GetEntityDeltas() const
 {
-	AuthorityChanges.SetAuthority(EntityId, ComponentId, Authority);
+	return EntityDeltas;
 }
 
 const TArray<CreateEntityResponse>& ViewDelta::GetCreateEntityResponses() const
@@ -24,96 +145,449 @@ const TArray<CreateEntityResponse>& ViewDelta::GetCreateEntityResponses() const
 
 const TArray<EntityComponentId>& ViewDelta::GetAuthorityGained() const
 {
-	return AuthorityChanges.GetAuthorityGained();
+	return AuthorityGained;
 }
 
 const TArray<EntityComponentId>& ViewDelta::GetAuthorityLost() const
 {
-	return AuthorityChanges.GetAuthorityLost();
+	return AuthorityLost;
 }
 
 const TArray<EntityComponentId>& ViewDelta::GetAuthorityLostTemporarily() const
 {
-	return AuthorityChanges.GetAuthorityLostTemporarily();
+	return AuthorityLostTemporarily;
+}
+
+void ViewDelta::Clear()
+{
+	for (Shard& CurrentShard : Shards)
+	{
+		CurrentShard.Reset();
+	}
+
+	// Shards have to forget their arena memory before it is reset.
+	Arena.Reset();
+
+	EntityDeltas.Reset();
+	AuthorityGained.Reset();
+	AuthorityLost.Reset();
+	AuthorityLostTemporarily.Reset();
+
+	CreateEntityResponses.Reset();
+	OpLists.Reset();
+}
+
+void ViewDelta::CountOp(const Worker_Op& Op)
+{
+	switch (static_cast<Worker_OpType>(Op.op_type))
+	{
+	case WORKER_OP_TYPE_ADD_ENTITY:
+	case WORKER_OP_TYPE_REMOVE_ENTITY:
+		GetShard(GetChangedEntityId(Op)).EntityChangeCount++;
+		break;
+	case WORKER_OP_TYPE_ADD_COMPONENT:
+	case WORKER_OP_TYPE_COMPONENT_UPDATE:
+	case WORKER_OP_TYPE_REMOVE_COMPONENT:
+		GetShard(GetChangedEntityId(Op)).ComponentChangeCount++;
+		break;
+	case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+		GetShard(GetChangedEntityId(Op)).AuthorityChangeCount++;
+		break;
+	default:
+		break;
+	}
+}
+
+void ViewDelta::GatherOp(const Worker_Op& Op)
+{
+	switch (static_cast<Worker_OpType>(Op.op_type))
+	{
+	case WORKER_OP_TYPE_ADD_ENTITY:
+		GetShard(Op.op.add_entity.entity_id).ReceivedEntityChanges.Push(ReceivedEntityChange{ Op.op.add_entity.entity_id, true });
+		break;
+	case WORKER_OP_TYPE_REMOVE_ENTITY:
+		GetShard(Op.op.remove_entity.entity_id).ReceivedEntityChanges.Push(ReceivedEntityChange{ Op.op.remove_entity.entity_id, false });
+		break;
+	case WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE:
+	{
+		const Worker_CreateEntityResponseOp& Response = Op.op.create_entity_response;
+		AddCreateEntityResponse(CreateEntityResponse{
+			Response.request_id,
+			static_cast<Worker_StatusCode>(Response.status_code),
+			FString{Response.message},
+			Response.entity_id
+		});
+		break;
+	}
+	case WORKER_OP_TYPE_ADD_COMPONENT:
+		GetShard(Op.op.add_component.entity_id).ReceivedComponentChanges.Push(ReceivedComponentChange{ Op.op.add_component.entity_id, Op.op.add_component.data.component_id,
+			ComponentChange::ADD, Op.op.add_component.data.schema_type, nullptr });
+		break;
+	case WORKER_OP_TYPE_COMPONENT_UPDATE:
+		GetShard(Op.op.component_update.entity_id).ReceivedComponentChanges.Push(ReceivedComponentChange{ Op.op.component_update.entity_id, Op.op.component_update.update.component_id,
+			ComponentChange::UPDATE, nullptr, Op.op.component_update.update.schema_type });
+		break;
+	case WORKER_OP_TYPE_REMOVE_COMPONENT:
+		GetShard(Op.op.remove_component.entity_id).ReceivedComponentChanges.Push(ReceivedComponentChange{ Op.op.remove_component.entity_id, Op.op.remove_component.component_id,
+			ComponentChange::REMOVE, nullptr, nullptr });
+		break;
+	case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+		GetShard(Op.op.authority_change.entity_id).ReceivedAuthorityChanges.Push(ReceivedAuthorityChange{ Op.op.authority_change.entity_id, Op.op.authority_change.component_id,
+			static_cast<Worker_Authority>(Op.op.authority_change.authority) });
+		break;
+	default:
+		break;
+	}
+}
+
+ViewDelta::Shard& ViewDelta::GetShard(Worker_EntityId EntityId)
+{
+	return Shards[static_cast<uint64>(EntityId) % Shards.Num()];
+}
+
+void ViewDelta::MergeShards()
+{
+	for (const Shard& CurrentShard : Shards)
+	{
+		EntityDeltas.Append(CurrentShard.EntityDeltas.GetData(), CurrentShard.EntityDeltas.Num());
+		AuthorityGained.Append(CurrentShard.AuthorityGained.GetData(), CurrentShard.AuthorityGained.Num());
+		AuthorityLost.Append(CurrentShard.AuthorityLost.GetData(), CurrentShard.AuthorityLost.Num());
+		AuthorityLostTemporarily.Append(CurrentShard.AuthorityLostTemporarily.GetData(), CurrentShard.AuthorityLostTemporarily.Num());
+	}
+
+	// Each shard is already sorted, and every key appears in only one of them.
+	if (Shards.Num() > 1)
+	{
+		EntityDeltas.Sort([](const EntityDelta& Lhs, const EntityDelta& Rhs) { return Lhs.EntityId < Rhs.EntityId; });
+		AuthorityGained.Sort(EntityComponentLess<EntityComponentId>);
+		AuthorityLost.Sort(EntityComponentLess<EntityComponentId>);
+		AuthorityLostTemporarily.Sort(EntityComponentLess<EntityComponentId>);
+	}
+}
+
+void ViewDelta::Shard::Reset()
+{
+	EntityChangeCount = 0;
+	ComponentChangeCount = 0;
+	AuthorityChangeCount = 0;
+
+	ReceivedEntityChanges.Reset();
+	ReceivedComponentChanges.Reset();
+	ReceivedAuthorityChanges.Reset();
+	EntitiesEnteringView.Reset();
+	EntitiesLeavingView.Reset();
+
+	EntityDeltas.Reset();
+	ComponentsAdded.Reset();
+	ComponentsRemoved.Reset();
+	ComponentUpdates.Reset();
+	ComponentsRefreshed.Reset();
+	AuthorityGained.Reset();
+	AuthorityLost.Reset();
+	AuthorityLostTemporarily.Reset();
+
+	// Reset rather than Empty, the next delta is likely to need a similar amount of space.
+	OwnedData.Reset();
+	OwnedUpdates.Reset();
+}
+
+void ViewDelta::Shard::Init(FrameArena& Arena)
+{
+	ReceivedEntityChanges.Init(Arena, EntityChangeCount);
+	ReceivedComponentChanges.Init(Arena, ComponentChangeCount);
+	ReceivedAuthorityChanges.Init(Arena, AuthorityChangeCount);
+
+	EntitiesEnteringView.Init(Arena, EntityChangeCount);
+	EntitiesLeavingView.Init(Arena, EntityChangeCount);
+
+	EntityDeltas.Init(Arena, EntityChangeCount + ComponentChangeCount + AuthorityChangeCount);
+	ComponentsAdded.Init(Arena, ComponentChangeCount);
+	ComponentsRemoved.Init(Arena, ComponentChangeCount);
+	ComponentUpdates.Init(Arena, ComponentChangeCount);
+	ComponentsRefreshed.Init(Arena, ComponentChangeCount);
+	AuthorityGained.Init(Arena, AuthorityChangeCount);
+	AuthorityLost.Init(Arena, AuthorityChangeCount);
+	AuthorityLostTemporarily.Init(Arena, AuthorityChangeCount);
+}
+
+void ViewDelta::Shard::SortReceivedChanges()
+{
+	// Stable sorts keep the changes to each entity and component in the order they were received.
+	ReceivedEntityChanges.StableSort([](const ReceivedEntityChange& Lhs, const ReceivedEntityChange& Rhs)
+	{
+		return Lhs.EntityId < Rhs.EntityId;
+	});
+	ReceivedComponentChanges.StableSort(EntityComponentLess<ReceivedComponentChange>);
+	ReceivedAuthorityChanges.StableSort(EntityComponentLess<ReceivedAuthorityChange>);
+}
+
+void ViewDelta::Shard::AddEntitiesEnteringView(EntityView& View)
+{
+	for (int32 Begin = 0; Begin < ReceivedEntityChanges.Num();)
+	{
+		const Worker_EntityId EntityId = ReceivedEntityChanges[Begin].EntityId;
+		const int32 End = FindRunEnd(ReceivedEntityChanges, Begin, [EntityId](const ReceivedEntityChange& Change) { return Change.EntityId == EntityId; });
+
+		if (ReceivedEntityChanges[End - 1].bAdded && !View.Contains(EntityId))
+		{
+			View.Add(EntityId);
+			EntitiesEnteringView.Push(EntityId);
+		}
+		Begin = End;
+	}
+}
+
+void ViewDelta::Shard::Process(EntityView& View)
+{
+	int32 EntityIndex = 0;
+	int32 ComponentIndex = 0;
+	int32 AuthorityIndex = 0;
+	while (EntityIndex < ReceivedEntityChanges.Num() || ComponentIndex < ReceivedComponentChanges.Num() || AuthorityIndex < ReceivedAuthorityChanges.Num())
+	{
+		Worker_EntityId EntityId = MAX_int64;
+		if (EntityIndex < ReceivedEntityChanges.Num())
+		{
+			EntityId = FMath::Min(EntityId, ReceivedEntityChanges[EntityIndex].EntityId);
+		}
+		if (ComponentIndex < ReceivedComponentChanges.Num())
+		{
+			EntityId = FMath::Min(EntityId, ReceivedComponentChanges[ComponentIndex].EntityId);
+		}
+		if (AuthorityIndex < ReceivedAuthorityChanges.Num())
+		{
+			EntityId = FMath::Min(EntityId, ReceivedAuthorityChanges[AuthorityIndex].EntityId);
+		}
+
+		const auto IsEntity = [EntityId](const auto& Change) { return Change.EntityId == EntityId; };
+		const int32 EntityEnd = FindRunEnd(ReceivedEntityChanges, EntityIndex, IsEntity);
+		const int32 ComponentEnd = FindRunEnd(ReceivedComponentChanges, ComponentIndex, IsEntity);
+		const int32 AuthorityEnd = FindRunEnd(ReceivedAuthorityChanges, AuthorityIndex, IsEntity);
+
+		ProcessEntity(View, EntityId,
+			MakeRunView(ReceivedEntityChanges, EntityIndex, EntityEnd),
+			MakeRunView(ReceivedComponentChanges, ComponentIndex, ComponentEnd),
+			MakeRunView(ReceivedAuthorityChanges, AuthorityIndex, AuthorityEnd));
+
+		EntityIndex = EntityEnd;
+		ComponentIndex = ComponentEnd;
+		AuthorityIndex = AuthorityEnd;
+	}
+}
+
+void ViewDelta::Shard::RemoveEntitiesLeavingView(EntityView& View)
+{
+	// Components are always removed before their entity, so nothing in the delta points into the element.
+	for (const Worker_EntityId EntityId : EntitiesLeavingView)
+	{
+		View.Remove(EntityId);
+	}
 }
 
-TUniquePtr<AbstractOpList> ViewDelta::GenerateLegacyOpList() const
+void ViewDelta::Shard::ProcessEntity(EntityView& View, Worker_EntityId EntityId, TArrayView<const ReceivedEntityChange> EntityChanges,
+	TArrayView<const ReceivedComponentChange> ComponentChanges, TArrayView<const ReceivedAuthorityChange> AuthorityChanges)
 {
-	// Todo - refactor individual op creation to an oplist type.
-	TArray<Worker_Op> OpList;
-	OpList.Reserve(CreateEntityResponses.Num());
+	const TArrayView<const Worker_EntityId> EnteringView = EntitiesEnteringView.GetView();
+	EntityViewElement* Element = View.Find(EntityId);
+	const bool bInitiallyInView = Element != nullptr && Algo::BinarySearch(EnteringView, EntityId) == INDEX_NONE;
+	const bool bFinallyInView = EntityChanges.Num() > 0 ? EntityChanges.Last().bAdded : bInitiallyInView;
+
+	if (Element == nullptr)
+	{
+		// Added and removed again, everything that happened to the entity in between cancels out.
+		checkf(EntityChanges.Num() > 0, TEXT("Received changes to entity %lld which is not in view."), EntityId);
+		return;
+	}
 
-	// todo Entity added ops get created here.
+	const int32 AddedBegin = ComponentsAdded.Num();
+	const int32 RemovedBegin = ComponentsRemoved.Num();
+	const int32 UpdatesBegin = ComponentUpdates.Num();
+	const int32 RefreshedBegin = ComponentsRefreshed.Num();
+	const int32 GainedBegin = AuthorityGained.Num();
+	const int32 LostBegin = AuthorityLost.Num();
+	const int32 LostTemporarilyBegin = AuthorityLostTemporarily.Num();
 
-	// todo Component Added ops get created here.
+	for (int32 Begin = 0; Begin < ComponentChanges.Num();)
+	{
+		int32 End = Begin + 1;
+		while (End < ComponentChanges.Num() && ComponentChanges[End].ComponentId == ComponentChanges[Begin].ComponentId)
+		{
+			++End;
+		}
+		ProcessComponent(*Element, ComponentChanges.Slice(Begin, End - Begin));
+		Begin = End;
+	}
 
-	for (const EntityComponentId& Id : AuthorityChanges.GetAuthorityLost())
+	for (int32 Begin = 0; Begin < AuthorityChanges.Num();)
 	{
-		Worker_Op Op = {};
-		Op.op_type = WORKER_OP_TYPE_AUTHORITY_CHANGE;
-		Op.op.authority_change.entity_id = Id.EntityId;
-		Op.op.authority_change.component_id = Id.ComponentId;
-		Op.op.authority_change.authority = WORKER_AUTHORITY_NOT_AUTHORITATIVE;
-		OpList.Push(Op);
+		int32 End = Begin + 1;
+		while (End < AuthorityChanges.Num() && AuthorityChanges[End].ComponentId == AuthorityChanges[Begin].ComponentId)
+		{
+			++End;
+		}
+		ProcessAuthority(*Element, AuthorityChanges.Slice(Begin, End - Begin));
+		Begin = End;
 	}
 
-	for (const EntityComponentId& Id : AuthorityChanges.GetAuthorityLostTemporarily())
+	if (!bFinallyInView)
 	{
-		Worker_Op Op = {};
-		Op.op_type = WORKER_OP_TYPE_AUTHORITY_CHANGE;
-		Op.op.authority_change.entity_id = Id.EntityId;
-		Op.op.authority_change.component_id = Id.ComponentId;
-		Op.op.authority_change.authority = WORKER_AUTHORITY_NOT_AUTHORITATIVE;
-		OpList.Push(Op);
+		EntitiesLeavingView.Push(EntityId);
 	}
 
-	// todo Component update and remove ops get created here.
+	EntityDelta Delta;
+	Delta.EntityId = EntityId;
+	Delta.bAdded = !bInitiallyInView && bFinallyInView;
+	Delta.bRemoved = bInitiallyInView && !bFinallyInView;
+	Delta.ComponentsAdded = MakeTailView(ComponentsAdded, AddedBegin);
+	Delta.ComponentsRemoved = MakeTailView(ComponentsRemoved, RemovedBegin);
+	Delta.ComponentUpdates = MakeTailView(ComponentUpdates, UpdatesBegin);
+	Delta.ComponentsRefreshed = MakeTailView(ComponentsRefreshed, RefreshedBegin);
+	Delta.AuthorityGained = MakeTailView(AuthorityGained, GainedBegin);
+	Delta.AuthorityLost = MakeTailView(AuthorityLost, LostBegin);
+	Delta.AuthorityLostTemporarily = MakeTailView(AuthorityLostTemporarily, LostTemporarilyBegin);
 
-	// todo Entity removed ops get created here or below.
+	const bool bHasChanges = Delta.bAdded || Delta.bRemoved
+		|| Delta.ComponentsAdded.Num() > 0 || Delta.ComponentsRemoved.Num() > 0
+		|| Delta.ComponentUpdates.Num() > 0 || Delta.ComponentsRefreshed.Num() > 0
+		|| Delta.AuthorityGained.Num() > 0 || Delta.AuthorityLost.Num() > 0 || Delta.AuthorityLostTemporarily.Num() > 0;
+	if (bHasChanges)
+	{
+		EntityDeltas.Push(Delta);
+	}
+}
+
+void ViewDelta::Shard::ProcessComponent(EntityViewElement& Element, TArrayView<const ReceivedComponentChange> Changes)
+{
+	const Worker_EntityId EntityId = Changes[0].EntityId;
+	const Worker_ComponentId ComponentId = Changes[0].ComponentId;
+
+	const int32 ExistingIndex = Element.Components.IndexOfByPredicate(ComponentIdEquality{ComponentId});
+	const bool bInitiallyPresent = ExistingIndex != INDEX_NONE;
+
+	// Updates before the last addition or removal only matter for their events.
+	int32 LastPresenceChange = INDEX_NONE;
+	for (int32 i = 0; i < Changes.Num(); ++i)
+	{
+		if (Changes[i].Type != ComponentChange::UPDATE)
+		{
+			LastPresenceChange = i;
+		}
+	}
+
+	const bool bFinallyPresent = LastPresenceChange != INDEX_NONE ? Changes[LastPresenceChange].Type == ComponentChange::ADD : bInitiallyPresent;
+
+	if (!bFinallyPresent)
+	{
+		if (bInitiallyPresent)
+		{
+			Element.Components.RemoveAtSwap(ExistingIndex);
+			ComponentsRemoved.Push(ComponentChange{ ComponentId, ComponentChange::REMOVE, nullptr, nullptr });
+		}
+		return;
+	}
 
-	for (const EntityComponentId& Id : AuthorityChanges.GetAuthorityLostTemporarily())
+	if (LastPresenceChange == INDEX_NONE)
 	{
-		Worker_Op Op = {};
-		Op.op_type = WORKER_OP_TYPE_AUTHORITY_CHANGE;
-		Op.op.authority_change.entity_id = Id.EntityId;
-		Op.op.authority_change.component_id = Id.ComponentId;
-		Op.op.authority_change.authority = WORKER_AUTHORITY_AUTHORITATIVE;
-		OpList.Push(Op);
+		checkf(bInitiallyPresent, TEXT("Component %u updated on entity %lld without being in view."), ComponentId, EntityId);
+		ComponentData& Existing = Element.Components[ExistingIndex];
+		for (const ReceivedComponentChange& Change : Changes)
+		{
+			Existing.ApplyUpdate(Change.Update);
+		}
+		ComponentUpdates.Push(ComponentChange{ ComponentId, ComponentChange::UPDATE, nullptr, MergeUpdates(Changes) });
+		return;
 	}
 
-	for (const EntityComponentId& Id : AuthorityChanges.GetAuthorityGained())
+	// The component's state is the last data received with the updates after it applied.
+	// The delta hands out data it owns rather than the view's copy, which later deltas update in place or free.
+	const Schema_ComponentData* ReceivedData = Changes[LastPresenceChange].Data;
+	ComponentData NewData = ComponentData::CreateCopy(ReceivedData, ComponentId);
+	for (int32 i = LastPresenceChange + 1; i < Changes.Num(); ++i)
 	{
-		Worker_Op Op = {};
-		Op.op_type = WORKER_OP_TYPE_AUTHORITY_CHANGE;
-		Op.op.authority_change.entity_id = Id.EntityId;
-		Op.op.authority_change.component_id = Id.ComponentId;
-		Op.op.authority_change.authority = WORKER_AUTHORITY_AUTHORITATIVE;
-		OpList.Push(Op);
+		NewData.ApplyUpdate(Changes[i].Update);
 	}
+	Schema_ComponentData* NewDataPtr = LastPresenceChange + 1 < Changes.Num()
+		? OwnedData.Add_GetRef(NewData.DeepCopy()).GetUnderlying()
+		: const_cast<Schema_ComponentData*>(ReceivedData);
 
-	// todo Command requests ops are created here.
+	if (bInitiallyPresent)
+	{
+		Element.Components[ExistingIndex] = MoveTemp(NewData);
+		ComponentsRefreshed.Push(ComponentChange{ ComponentId, ComponentChange::COMPLETE_UPDATE, NewDataPtr, MergeUpdates(Changes) });
+	}
+	else
+	{
+		// The component is new to the reader, so the events of updates received alongside it are dropped.
+		Element.Components.Push(MoveTemp(NewData));
+		ComponentsAdded.Push(ComponentChange{ ComponentId, ComponentChange::ADD, NewDataPtr, nullptr });
+	}
+}
 
-	// The following ops do not have ordering constraints.
+void ViewDelta::Shard::ProcessAuthority(EntityViewElement& Element, TArrayView<const ReceivedAuthorityChange> Changes)
+{
+	const EntityComponentId Id{ Changes[0].EntityId, Changes[0].ComponentId };
 
-	for (const CreateEntityResponse& Response : CreateEntityResponses)
+	const bool bInitiallyAuthoritative = Element.Authority.Contains(Id.ComponentId);
+	bool bAuthoritative = bInitiallyAuthoritative;
+	bool bLostInBetween = false;
+	for (const ReceivedAuthorityChange& Change : Changes)
 	{
-		Worker_Op Op = {};
-		Op.op_type = WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE;
-		Op.op.create_entity_response.request_id = Response.RequestId;
-		Op.op.create_entity_response.status_code = Response.StatusCode;
-		// TODO: UNR-3163 - the string is located on a stack and gets corrupted
-		Op.op.create_entity_response.message = TCHAR_TO_UTF8(Response.Message.GetCharArray().GetData());
-		Op.op.create_entity_response.entity_id = Response.EntityId;
-		OpList.Push(Op);
+		switch (Change.Authority)
+		{
+		case WORKER_AUTHORITY_NOT_AUTHORITATIVE:
+			bLostInBetween |= bAuthoritative;
+			bAuthoritative = false;
+			break;
+		case WORKER_AUTHORITY_AUTHORITATIVE:
+			bAuthoritative = true;
+			break;
+		case WORKER_AUTHORITY_AUTHORITY_LOSS_IMMINENT:
+			// Still authoritative.
+			break;
+		}
 	}
 
-	return MakeUnique<ViewDeltaLegacyOpList>(MoveTemp(OpList));
+	if (!bInitiallyAuthoritative && bAuthoritative)
+	{
+		Element.Authority.Add(Id.ComponentId);
+		AuthorityGained.Push(Id);
+	}
+	else if (bInitiallyAuthoritative && !bAuthoritative)
+	{
+		Element.Authority.RemoveSingleSwap(Id.ComponentId);
+		AuthorityLost.Push(Id);
+	}
+	else if (bInitiallyAuthoritative && bLostInBetween)
+	{
+		AuthorityLostTemporarily.Push(Id);
+	}
 }
 
-void ViewDelta::Clear()
+Schema_ComponentUpdate* ViewDelta::Shard::MergeUpdates(TArrayView<const ReceivedComponentChange> Changes)
 {
-	CreateEntityResponses.Empty();
-	AuthorityChanges.Clear();
+	Schema_ComponentUpdate* FirstUpdate = nullptr;
+	ComponentUpdate* MergedUpdate = nullptr;
+	for (const ReceivedComponentChange& Change : Changes)
+	{
+		if (Change.Type != ComponentChange::UPDATE)
+		{
+			continue;
+		}
+
+		if (FirstUpdate == nullptr)
+		{
+			// A single update can be handed out as is, it lives as long as the op list does.
+			FirstUpdate = Change.Update;
+			continue;
+		}
+
+		if (MergedUpdate == nullptr)
+		{
+			MergedUpdate = &OwnedUpdates.Add_GetRef(ComponentUpdate::CreateCopy(FirstUpdate, Change.ComponentId));
+		}
+		MergedUpdate->Merge(Change.Update);
+	}
+
+	return MergedUpdate != nullptr ? MergedUpdate->GetUnderlying() : FirstUpdate;
 }
 
 }  // namespace SpatialGDK
@@ -7,21 +7,18 @@ namespace SpatialGDK
 {
 
 WorkerView::WorkerView()
-: LocalChanges(MakeUnique<MessagesToSend>())
+: CurrentDelta(0)
+, CurrentLocalChanges(0)
 {
 }
 
 const ViewDelta* WorkerView::GenerateViewDelta()
 {
-	Delta.Clear();
-	for (const auto& OpList : QueuedOps)
-	{
-		const uint32 OpCount = OpList->GetCount();
-		for (uint32 i = 0; i < OpCount; ++i)
-		{
-			ProcessOp((*OpList)[i]);
-		}
-	}
+	CurrentDelta = 1 - CurrentDelta;
+	ViewDelta& Delta = Deltas[CurrentDelta];
+
+	// Hands QueuedOps over to the delta and gets back the emptied array of the op lists it held.
+	Delta.SetFromOpLists(QueuedOps, View);
 
 	return &Delta;
 }
@@ -31,74 +28,103 @@ void WorkerView::EnqueueOpList(TUniquePtr<AbstractOpList> OpList)
 	QueuedOps.Push(MoveTemp(OpList));
 }
 
-TUniquePtr<MessagesToSend> WorkerView::FlushLocalChanges()
+MessagesToSend& WorkerView::FlushLocalChanges()
 {
-	TUniquePtr<MessagesToSend> OutgoingMessages = MoveTemp(LocalChanges);
-	LocalChanges = MakeUnique<MessagesToSend>();
+	MessagesToSend& OutgoingMessages = LocalChanges[CurrentLocalChanges];
+
+	// The other batch was sent after the previous flush, so its arrays can be reused.
+	CurrentLocalChanges = 1 - CurrentLocalChanges;
+	LocalChanges[CurrentLocalChanges].Reset();
+
 	return OutgoingMessages;
 }
 
+void WorkerView::SendReserveEntityIdsRequest(ReserveEntityIdsRequest Request)
+{
+	MessagesToSend& Changes = GetLocalChanges();
+	Changes.Order.Add({ MessagesToSend::RESERVE_ENTITY_IDS_REQUEST, Changes.ReserveEntityIdsRequests.Add(MoveTemp(Request)) });
+}
+
 void WorkerView::SendCreateEntityRequest(CreateEntityRequest Request)
 {
-	LocalChanges->CreateEntityRequests.Push(MoveTemp(Request));
-}
-
-void WorkerView::ProcessOp(const Worker_Op& Op)
-{
-	switch (static_cast<Worker_OpType>(Op.op_type))
-	{
-	case WORKER_OP_TYPE_DISCONNECT:
-		break;
-	case WORKER_OP_TYPE_FLAG_UPDATE:
-		break;
-	case WORKER_OP_TYPE_LOG_MESSAGE:
-		break;
-	case WORKER_OP_TYPE_METRICS:
-		break;
-	case WORKER_OP_TYPE_CRITICAL_SECTION:
-		break;
-	case WORKER_OP_TYPE_ADD_ENTITY:
-		break;
-	case WORKER_OP_TYPE_REMOVE_ENTITY:
-		break;
-	case WORKER_OP_TYPE_RESERVE_ENTITY_IDS_RESPONSE:
-		break;
-	case WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE:
-		HandleCreateEntityResponse(Op.op.create_entity_response);
-		break;
-	case WORKER_OP_TYPE_DELETE_ENTITY_RESPONSE:
-		break;
-	case WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE:
-		break;
-	case WORKER_OP_TYPE_ADD_COMPONENT:
-		break;
-	case WORKER_OP_TYPE_REMOVE_COMPONENT:
-		break;
-	case WORKER_OP_TYPE_AUTHORITY_CHANGE:
-		HandleAuthorityChange(Op.op.authority_change);
-		break;
-	case WORKER_OP_TYPE_COMPONENT_UPDATE:
-		break;
-	case WORKER_OP_TYPE_COMMAND_REQUEST:
-		break;
-	case WORKER_OP_TYPE_COMMAND_RESPONSE:
-		break;
-	}
-}
-
-void WorkerView::HandleAuthorityChange(const Worker_AuthorityChangeOp& AuthorityChange)
-{
-	Delta.SetAuthority(AuthorityChange.entity_id, AuthorityChange.component_id, static_cast<Worker_Authority>(AuthorityChange.authority));
-}
-
-void WorkerView::HandleCreateEntityResponse(const Worker_CreateEntityResponseOp& Response)
-{
-	Delta.AddCreateEntityResponse(CreateEntityResponse{
-		Response.request_id,
-		static_cast<Worker_StatusCode>(Response.status_code),
-		FString{Response.message},
-		Response.entity_id
-	});
+	MessagesToSend& Changes = GetLocalChanges();
+	Changes.Order.Add({ MessagesToSend::CREATE_ENTITY_REQUEST, Changes.CreateEntityRequests.Add(MoveTemp(Request)) });
+}
+
+void WorkerView::SendDeleteEntityRequest(DeleteEntityRequest Request)
+{
+	MessagesToSend& Changes = GetLocalChanges();
+	Changes.Order.Add({ MessagesToSend::DELETE_ENTITY_REQUEST, Changes.DeleteEntityRequests.Add(MoveTemp(Request)) });
+}
+
+void WorkerView::SendAddComponent(Worker_EntityId EntityId, ComponentData Data)
+{
+	MessagesToSend& Changes = GetLocalChanges();
+	Changes.Order.Add({ MessagesToSend::COMPONENT_MESSAGE, Changes.ComponentMessages.Emplace(EntityId, MoveTemp(Data)) });
+}
+
+void WorkerView::SendComponentUpdate(Worker_EntityId EntityId, ComponentUpdate Update)
+{
+	MessagesToSend& Changes = GetLocalChanges();
+	Changes.Order.Add({ MessagesToSend::COMPONENT_MESSAGE, Changes.ComponentMessages.Emplace(EntityId, MoveTemp(Update)) });
+}
+
+void WorkerView::SendRemoveComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+{
+	MessagesToSend& Changes = GetLocalChanges();
+	Changes.Order.Add({ MessagesToSend::COMPONENT_MESSAGE, Changes.ComponentMessages.Emplace(EntityId, ComponentId) });
+}
+
+void WorkerView::SendComponentInterest(Worker_EntityId EntityId, TArray<Worker_InterestOverride> Interests)
+{
+	MessagesToSend& Changes = GetLocalChanges();
+	Changes.Order.Add({ MessagesToSend::COMPONENT_INTEREST, Changes.ComponentInterests.Add(ComponentInterestMessage{ EntityId, MoveTemp(Interests) }) });
+}
+
+void WorkerView::SendEntityCommandRequest(EntityCommandRequest Request)
+{
+	MessagesToSend& Changes = GetLocalChanges();
+	Changes.Order.Add({ MessagesToSend::ENTITY_COMMAND_REQUEST, Changes.EntityCommandRequests.Add(MoveTemp(Request)) });
+}
+
+void WorkerView::SendEntityCommandResponse(EntityCommandResponse Response)
+{
+	MessagesToSend& Changes = GetLocalChanges();
+	Changes.Order.Add({ MessagesToSend::ENTITY_COMMAND_RESPONSE, Changes.EntityCommandResponses.Add(MoveTemp(Response)) });
+}
+
+void WorkerView::SendEntityCommandFailure(EntityCommandFailure Failure)
+{
+	MessagesToSend& Changes = GetLocalChanges();
+	Changes.Order.Add({ MessagesToSend::ENTITY_COMMAND_FAILURE, Changes.EntityCommandFailures.Add(MoveTemp(Failure)) });
+}
+
+void WorkerView::SendEntityQueryRequest(EntityQueryRequest Request)
+{
+	MessagesToSend& Changes = GetLocalChanges();
+	Changes.Order.Add({ MessagesToSend::ENTITY_QUERY_REQUEST, Changes.EntityQueryRequests.Add(MoveTemp(Request)) });
+}
+
+void WorkerView::SendLogMessage(LogMessage Log)
+{
+	MessagesToSend& Changes = GetLocalChanges();
+	Changes.Order.Add({ MessagesToSend::LOG, Changes.Logs.Add(MoveTemp(Log)) });
+}
+
+void WorkerView::SendMetrics(SpatialMetrics Metrics)
+{
+	MessagesToSend& Changes = GetLocalChanges();
+	Changes.Order.Add({ MessagesToSend::METRICS, Changes.Metrics.Add(MoveTemp(Metrics)) });
+}
+
+const EntityView& WorkerView::GetView() const
+{
+	return View;
+}
+
+MessagesToSend& WorkerView::GetLocalChanges()
+{
+	return LocalChanges[CurrentLocalChanges];
 }
 
 }  // namespace SpatialGDK
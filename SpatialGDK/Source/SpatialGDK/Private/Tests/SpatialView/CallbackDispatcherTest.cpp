@@ -0,0 +1,130 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "SpatialView/CallbackDispatcher.h"
+#include "SpatialView/OpList/ViewDeltaLegacyOpList.h"
+
+#define CALLBACKDISPATCHER_TEST(TestName) \
+	GDK_TEST(Core, CallbackDispatcher, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	const Worker_EntityId TestEntityId = 1;
+	const Worker_EntityId OtherEntityId = 2;
+	const Worker_ComponentId TestComponentId = 1000;
+	const Worker_ComponentId OtherComponentId = 1001;
+
+	Worker_Op CreateAddEntityOp(Worker_EntityId EntityId)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_ADD_ENTITY;
+		Op.op.add_entity.entity_id = EntityId;
+		return Op;
+	}
+
+	// The op only borrows Data, as an op list from the Worker SDK would.
+	Worker_Op CreateAddComponentOp(Worker_EntityId EntityId, const ComponentData& Data)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_ADD_COMPONENT;
+		Op.op.add_component.entity_id = EntityId;
+		Op.op.add_component.data.component_id = Data.GetComponentId();
+		Op.op.add_component.data.schema_type = Data.GetUnderlying();
+		return Op;
+	}
+
+	Worker_Op CreateAuthorityChangeOp(Worker_EntityId EntityId, Worker_ComponentId ComponentId, Worker_Authority Authority)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_AUTHORITY_CHANGE;
+		Op.op.authority_change.entity_id = EntityId;
+		Op.op.authority_change.component_id = ComponentId;
+		Op.op.authority_change.authority = Authority;
+		return Op;
+	}
+
+	void SetFromOps(ViewDelta& Delta, EntityView& View, TArray<Worker_Op> Ops)
+	{
+		TArray<TUniquePtr<AbstractOpList>> OpLists;
+		OpLists.Push(MakeUnique<ViewDeltaLegacyOpList>(MoveTemp(Ops)));
+		Delta.SetFromOpLists(OpLists, View);
+	}
+} // anonymous namespace
+
+CALLBACKDISPATCHER_TEST(GIVEN_callbacks_for_one_component_WHEN_InvokeCallbacks_called_THEN_only_changes_to_that_component_are_seen)
+{
+	// GIVEN
+	CallbackDispatcher Dispatcher;
+	TArray<Worker_EntityId> AddedEntities;
+	TArray<Worker_EntityId> AuthoritativeEntities;
+	Dispatcher.RegisterComponentAddedCallback(TestComponentId, [&AddedEntities](Worker_EntityId EntityId, const ComponentChange& Change)
+	{
+		AddedEntities.Add(EntityId);
+	});
+	Dispatcher.RegisterAuthorityGainedCallback(TestComponentId, [&AuthoritativeEntities](Worker_EntityId EntityId)
+	{
+		AuthoritativeEntities.Add(EntityId);
+	});
+
+	ViewDelta Delta;
+	EntityView View;
+	const ComponentData TestData(TestComponentId);
+	const ComponentData OtherData(OtherComponentId);
+	SetFromOps(Delta, View, {
+		CreateAddEntityOp(OtherEntityId),
+		CreateAddComponentOp(OtherEntityId, TestData),
+		CreateAddComponentOp(OtherEntityId, OtherData),
+		CreateAuthorityChangeOp(OtherEntityId, OtherComponentId, WORKER_AUTHORITY_AUTHORITATIVE),
+		CreateAddEntityOp(TestEntityId),
+		CreateAddComponentOp(TestEntityId, TestData),
+		CreateAuthorityChangeOp(TestEntityId, TestComponentId, WORKER_AUTHORITY_AUTHORITATIVE)
+	});
+
+	// WHEN
+	Dispatcher.InvokeCallbacks(Delta);
+
+	// THEN
+	TestEqual("Component added on both entities", AddedEntities.Num(), 2);
+	if (AddedEntities.Num() == 2)
+	{
+		TestEqual("Entities in id order", AddedEntities[0], TestEntityId);
+		TestEqual("Entities in id order", AddedEntities[1], OtherEntityId);
+	}
+	TestEqual("Authority gained only for the subscribed component", AuthoritativeEntities.Num(), 1);
+
+	return true;
+}
+
+CALLBACKDISPATCHER_TEST(GIVEN_a_removed_callback_WHEN_InvokeCallbacks_called_THEN_it_is_not_invoked)
+{
+	// GIVEN
+	CallbackDispatcher Dispatcher;
+	int32 RemovedInvocations = 0;
+	int32 KeptInvocations = 0;
+	const CallbackId Removed = Dispatcher.RegisterComponentAddedCallback(TestComponentId, [&RemovedInvocations](Worker_EntityId, const ComponentChange&)
+	{
+		++RemovedInvocations;
+	});
+	Dispatcher.RegisterComponentAddedCallback(TestComponentId, [&KeptInvocations](Worker_EntityId, const ComponentChange&)
+	{
+		++KeptInvocations;
+	});
+
+	ViewDelta Delta;
+	EntityView View;
+	const ComponentData TestData(TestComponentId);
+	SetFromOps(Delta, View, { CreateAddEntityOp(TestEntityId), CreateAddComponentOp(TestEntityId, TestData) });
+
+	// WHEN
+	Dispatcher.RemoveCallback(Removed);
+	Dispatcher.InvokeCallbacks(Delta);
+
+	// THEN
+	TestEqual("Removed callback not invoked", RemovedInvocations, 0);
+	TestEqual("Other callback invoked", KeptInvocations, 1);
+
+	return true;
+}
@@ -0,0 +1,76 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "SpatialView/FrameArena.h"
+
+#define FRAMEARENA_TEST(TestName) \
+	GDK_TEST(Core, FrameArena, TestName)
+
+using namespace SpatialGDK;
+
+FRAMEARENA_TEST(GIVEN_FrameArena_WHEN_allocating_THEN_allocations_are_aligned_and_do_not_overlap)
+{
+	// GIVEN
+	FrameArena Arena(64);
+
+	// WHEN
+	uint8* Byte = static_cast<uint8*>(Arena.Allocate(1, 1));
+	uint64* Numbers = Arena.AllocateArray<uint64>(4);
+	uint8* Large = static_cast<uint8*>(Arena.Allocate(256, 8));
+
+	// THEN
+	TestTrue("Array is aligned", IsAligned(Numbers, alignof(uint64)));
+	TestTrue("Array placed after the byte", reinterpret_cast<uint8*>(Numbers) >= Byte + 1);
+	TestTrue("Allocation larger than a block succeeds", Large != nullptr);
+	TestEqual("Bytes used", Arena.GetBytesUsed(), SIZE_T(1 + 4 * sizeof(uint64) + 256));
+
+	return true;
+}
+
+FRAMEARENA_TEST(GIVEN_FrameArena_that_needed_several_blocks_WHEN_reset_THEN_the_same_allocations_fit_in_one_block)
+{
+	// GIVEN
+	FrameArena Arena(64);
+	for (int32 i = 0; i < 8; ++i)
+	{
+		Arena.Allocate(48, 8);
+	}
+	const SIZE_T BytesReserved = Arena.GetBytesReserved();
+
+	// WHEN
+	Arena.Reset();
+	uint8* First = static_cast<uint8*>(Arena.Allocate(48, 8));
+	uint8* Last = First;
+	for (int32 i = 1; i < 8; ++i)
+	{
+		Last = static_cast<uint8*>(Arena.Allocate(48, 8));
+	}
+
+	// THEN
+	TestEqual("Same amount of memory reserved", Arena.GetBytesReserved(), BytesReserved);
+	TestTrue("All allocations in one contiguous block", Last == First + 7 * 48);
+
+	return true;
+}
+
+FRAMEARENA_TEST(GIVEN_ArenaArray_WHEN_elements_are_pushed_and_sorted_THEN_they_are_stored_in_arena_memory)
+{
+	// GIVEN
+	FrameArena Arena;
+	ArenaArray<int32> Array;
+	Array.Init(Arena, 3);
+
+	// WHEN
+	Array.Push(3);
+	Array.Push(1);
+	Array.Push(2);
+	Array.StableSort([](int32 Lhs, int32 Rhs) { return Lhs < Rhs; });
+
+	// THEN
+	TestEqual("Three elements", Array.Num(), 3);
+	TestTrue("Sorted", Array[0] == 1 && Array[1] == 2 && Array[2] == 3);
+	TestEqual("Capacity used", Arena.GetBytesUsed(), SIZE_T(3 * sizeof(int32)));
+
+	return true;
+}
@@ -3,12 +3,114 @@
 #include "Tests/TestDefinitions.h"
 
 #include "SpatialView/ViewDelta.h"
+#include "SpatialView/OpList/ViewDeltaLegacyOpList.h"
 
 #define VIEWDELTA_TEST(TestName) \
 	GDK_TEST(Core, ViewDelta, TestName)
 
 using namespace SpatialGDK; 
 
+namespace
+{
+	const Worker_EntityId TestEntityId = 1;
+	const Worker_EntityId OtherEntityId = 2;
+	const Worker_ComponentId TestComponentId = 1000;
+	const Worker_ComponentId OtherComponentId = 1001;
+	const Schema_FieldId TestFieldId = 1;
+	const Schema_FieldId TestEventId = 1;
+
+	Worker_Op CreateAddEntityOp(Worker_EntityId EntityId)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_ADD_ENTITY;
+		Op.op.add_entity.entity_id = EntityId;
+		return Op;
+	}
+
+	Worker_Op CreateRemoveEntityOp(Worker_EntityId EntityId)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_REMOVE_ENTITY;
+		Op.op.remove_entity.entity_id = EntityId;
+		return Op;
+	}
+
+	// The op only borrows Data, as an op list from the Worker SDK would.
+	Worker_Op CreateAddComponentOp(Worker_EntityId EntityId, const ComponentData& Data)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_ADD_COMPONENT;
+		Op.op.add_component.entity_id = EntityId;
+		Op.op.add_component.data.component_id = Data.GetComponentId();
+		Op.op.add_component.data.schema_type = Data.GetUnderlying();
+		return Op;
+	}
+
+	Worker_Op CreateComponentUpdateOp(Worker_EntityId EntityId, const ComponentUpdate& Update)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_COMPONENT_UPDATE;
+		Op.op.component_update.entity_id = EntityId;
+		Op.op.component_update.update.component_id = Update.GetComponentId();
+		Op.op.component_update.update.schema_type = Update.GetUnderlying();
+		return Op;
+	}
+
+	Worker_Op CreateRemoveComponentOp(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_REMOVE_COMPONENT;
+		Op.op.remove_component.entity_id = EntityId;
+		Op.op.remove_component.component_id = ComponentId;
+		return Op;
+	}
+
+	Worker_Op CreateAuthorityChangeOp(Worker_EntityId EntityId, Worker_ComponentId ComponentId, Worker_Authority Authority)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_AUTHORITY_CHANGE;
+		Op.op.authority_change.entity_id = EntityId;
+		Op.op.authority_change.component_id = ComponentId;
+		Op.op.authority_change.authority = Authority;
+		return Op;
+	}
+
+	ComponentData CreateTestData(uint32 Value, Worker_ComponentId ComponentId = TestComponentId)
+	{
+		ComponentData Data(ComponentId);
+		Schema_AddUint32(Data.GetFields(), TestFieldId, Value);
+		return Data;
+	}
+
+	ComponentUpdate CreateTestUpdate(uint32 Value)
+	{
+		ComponentUpdate Update(TestComponentId);
+		Schema_AddUint32(Update.GetFields(), TestFieldId, Value);
+		return Update;
+	}
+
+	ComponentUpdate CreateTestEvent()
+	{
+		ComponentUpdate Update(TestComponentId);
+		Schema_AddObject(Update.GetEvents(), TestEventId);
+		return Update;
+	}
+
+	void SetFromOps(ViewDelta& Delta, EntityView& View, TArray<Worker_Op> Ops)
+	{
+		TArray<TUniquePtr<AbstractOpList>> OpLists;
+		OpLists.Push(MakeUnique<ViewDeltaLegacyOpList>(MoveTemp(Ops)));
+		Delta.SetFromOpLists(OpLists, View);
+	}
+
+	// Sets up a view with TestEntityId holding TestComponentId with a value of 1.
+	void AddTestEntity(ViewDelta& Delta, EntityView& View)
+	{
+		const ComponentData Data = CreateTestData(1);
+		SetFromOps(Delta, View, { CreateAddEntityOp(TestEntityId), CreateAddComponentOp(TestEntityId, Data) });
+	}
+} // anonymous namespace
+
 VIEWDELTA_TEST(GIVEN_ViewDelta_with_multiple_CreateEntityResponse_added_WHEN_GetCreateEntityResponse_called_THEN_multiple_CreateEntityResponses_returned)
 {
 	// GIVEN
@@ -25,52 +127,209 @@ VIEWDELTA_TEST(GIVEN_ViewDelta_with_multiple_CreateEntityResponse_added_WHEN_Get
 	return true;
 }
 
-VIEWDELTA_TEST(GIVEN_ViewDelta_with_multiple_CreateEntityResponse_added_WHEN_GenerateLegacyOpList_called_THEN_multiple_ops_returned)
+VIEWDELTA_TEST(GIVEN_non_empty_ViewDelta_WHEN_Clear_called_THEN_GetCreateEntityResponse_returns_no_items)
 {
 	// GIVEN
 	ViewDelta Delta;
 	CreateEntityResponse Response{};
 	Delta.AddCreateEntityResponse(Response);
-	Delta.AddCreateEntityResponse(Response);
 
 	// WHEN
-	auto Responses = Delta.GenerateLegacyOpList();
+	Delta.Clear();
 
 	// THEN
-	TestTrue("Multiple Responses returned", Responses->GetCount() > 1);
+	auto Responses = Delta.GetCreateEntityResponses();
+	TestTrue("No Responses returned", Responses.Num() == 0);
+
 	return true;
 }
 
-VIEWDELTA_TEST(GIVEN_non_empty_ViewDelta_WHEN_Clear_called_THEN_GetCreateEntityResponse_returns_no_items)
+VIEWDELTA_TEST(GIVEN_ops_adding_and_removing_an_entity_WHEN_SetFromOpLists_called_THEN_no_changes_are_recorded)
 {
 	// GIVEN
 	ViewDelta Delta;
-	CreateEntityResponse Response{};
-	Delta.AddCreateEntityResponse(Response);
+	EntityView View;
+	const ComponentData Data = CreateTestData(1);
 
 	// WHEN
-	Delta.Clear();
+	SetFromOps(Delta, View, {
+		CreateAddEntityOp(TestEntityId),
+		CreateAddComponentOp(TestEntityId, Data),
+		CreateRemoveComponentOp(TestEntityId, TestComponentId),
+		CreateRemoveEntityOp(TestEntityId)
+	});
 
 	// THEN
-	auto Responses = Delta.GetCreateEntityResponses();
-	TestTrue("No Responses returned", Responses.Num() == 0);
+	TestEqual("No entity deltas", Delta.GetEntityDeltas().Num(), 0);
+	TestFalse("Entity is not in view", View.Contains(TestEntityId));
 
 	return true;
 }
 
-VIEWDELTA_TEST(GIVEN_non_empty_ViewDelta_WHEN_Clear_called_THEN_GenerateLegacyOpList_returns_no_items)
+VIEWDELTA_TEST(GIVEN_a_component_in_view_WHEN_updated_multiple_times_THEN_the_updates_are_merged)
 {
 	// GIVEN
 	ViewDelta Delta;
-	CreateEntityResponse Response{};
-	Delta.AddCreateEntityResponse(Response);
+	EntityView View;
+	AddTestEntity(Delta, View);
 
 	// WHEN
-	Delta.Clear();
+	const ComponentUpdate FirstUpdate = CreateTestUpdate(2);
+	const ComponentUpdate Event = CreateTestEvent();
+	const ComponentUpdate LastUpdate = CreateTestUpdate(3);
+	SetFromOps(Delta, View, {
+		CreateComponentUpdateOp(TestEntityId, FirstUpdate),
+		CreateComponentUpdateOp(TestEntityId, Event),
+		CreateComponentUpdateOp(TestEntityId, LastUpdate)
+	});
+
+	// THEN
+	TestEqual("One entity delta", Delta.GetEntityDeltas().Num(), 1);
+	if (Delta.GetEntityDeltas().Num() == 1)
+	{
+		const EntityDelta& Entity = Delta.GetEntityDeltas()[0];
+		TestFalse("Entity not added", Entity.bAdded);
+		TestEqual("One update", Entity.ComponentUpdates.Num(), 1);
+		if (Entity.ComponentUpdates.Num() == 1)
+		{
+			Schema_ComponentUpdate* Update = Entity.ComponentUpdates[0].Update;
+			TestEqual("Latest value", Schema_GetUint32(Schema_GetComponentUpdateFields(Update), TestFieldId), 3u);
+			TestEqual("Event kept", Schema_GetObjectCount(Schema_GetComponentUpdateEvents(Update), TestEventId), 1u);
+		}
+	}
+	TestEqual("View has the latest value", Schema_GetUint32(View[TestEntityId].Components[0].GetFields(), TestFieldId), 3u);
+
+	return true;
+}
+
+VIEWDELTA_TEST(GIVEN_a_component_in_view_WHEN_removed_and_added_again_THEN_a_complete_update_keeps_the_events)
+{
+	// GIVEN
+	ViewDelta Delta;
+	EntityView View;
+	AddTestEntity(Delta, View);
+
+	// WHEN
+	const ComponentUpdate Event = CreateTestEvent();
+	const ComponentData NewData = CreateTestData(4);
+	const ComponentUpdate LaterUpdate = CreateTestUpdate(5);
+	SetFromOps(Delta, View, {
+		CreateComponentUpdateOp(TestEntityId, Event),
+		CreateRemoveComponentOp(TestEntityId, TestComponentId),
+		CreateAddComponentOp(TestEntityId, NewData),
+		CreateComponentUpdateOp(TestEntityId, LaterUpdate)
+	});
 
 	// THEN
-	auto Responses = Delta.GenerateLegacyOpList();
-	TestTrue("No Responses returned", Responses->GetCount() == 0);
+	TestEqual("One entity delta", Delta.GetEntityDeltas().Num(), 1);
+	if (Delta.GetEntityDeltas().Num() == 1)
+	{
+		const EntityDelta& Entity = Delta.GetEntityDeltas()[0];
+		TestEqual("No components removed", Entity.ComponentsRemoved.Num(), 0);
+		TestEqual("No components added", Entity.ComponentsAdded.Num(), 0);
+		TestEqual("One complete update", Entity.ComponentsRefreshed.Num(), 1);
+		if (Entity.ComponentsRefreshed.Num() == 1)
+		{
+			const ComponentChange& Change = Entity.ComponentsRefreshed[0];
+			TestEqual("Later update applied to the data", Schema_GetUint32(Schema_GetComponentDataFields(Change.Data), TestFieldId), 5u);
+			TestEqual("Event kept", Schema_GetObjectCount(Schema_GetComponentUpdateEvents(Change.Update), TestEventId), 1u);
+		}
+	}
+
+	return true;
+}
+
+VIEWDELTA_TEST(GIVEN_ops_for_several_entities_interleaved_WHEN_SetFromOpLists_called_THEN_changes_are_grouped_and_sorted_by_entity_and_component)
+{
+	// GIVEN
+	ViewDelta Delta;
+	EntityView View;
+	const ComponentData OtherData = CreateTestData(1, OtherComponentId);
+	const ComponentData TestData = CreateTestData(1, TestComponentId);
+
+	// WHEN
+	SetFromOps(Delta, View, {
+		CreateAddEntityOp(OtherEntityId),
+		CreateAddEntityOp(TestEntityId),
+		CreateAddComponentOp(OtherEntityId, OtherData),
+		CreateAddComponentOp(TestEntityId, OtherData),
+		CreateAddComponentOp(TestEntityId, TestData),
+		CreateAuthorityChangeOp(OtherEntityId, OtherComponentId, WORKER_AUTHORITY_AUTHORITATIVE)
+	});
+
+	// THEN
+	const TArray<EntityDelta>& Entities = Delta.GetEntityDeltas();
+	TestEqual("Two entity deltas", Entities.Num(), 2);
+	if (Entities.Num() == 2)
+	{
+		TestTrue("Sorted by entity", Entities[0].EntityId == TestEntityId && Entities[1].EntityId == OtherEntityId);
+		TestTrue("Both added", Entities[0].bAdded && Entities[1].bAdded);
+		TestTrue("Components sorted", Entities[0].ComponentsAdded.Num() == 2
+			&& Entities[0].ComponentsAdded[0].ComponentId == TestComponentId
+			&& Entities[0].ComponentsAdded[1].ComponentId == OtherComponentId);
+		TestEqual("Authority on the right entity", Entities[1].AuthorityGained.Num(), 1);
+		TestEqual("No authority on the other", Entities[0].AuthorityGained.Num(), 0);
+	}
+
+	return true;
+}
+
+VIEWDELTA_TEST(GIVEN_authority_over_a_component_WHEN_lost_and_regained_THEN_it_is_recorded_as_lost_temporarily)
+{
+	// GIVEN
+	ViewDelta Delta;
+	EntityView View;
+	AddTestEntity(Delta, View);
+	SetFromOps(Delta, View, { CreateAuthorityChangeOp(TestEntityId, TestComponentId, WORKER_AUTHORITY_AUTHORITATIVE) });
+
+	// WHEN
+	SetFromOps(Delta, View, {
+		CreateAuthorityChangeOp(TestEntityId, TestComponentId, WORKER_AUTHORITY_NOT_AUTHORITATIVE),
+		CreateAuthorityChangeOp(TestEntityId, TestComponentId, WORKER_AUTHORITY_AUTHORITATIVE)
+	});
+
+	// THEN
+	TestEqual("Nothing gained", Delta.GetAuthorityGained().Num(), 0);
+	TestEqual("Nothing lost", Delta.GetAuthorityLost().Num(), 0);
+	TestEqual("Lost temporarily", Delta.GetAuthorityLostTemporarily().Num(), 1);
+	TestTrue("Still authoritative in the view", View[TestEntityId].Authority.Contains(TestComponentId));
+
+	return true;
+}
+
+VIEWDELTA_TEST(GIVEN_enough_ops_to_be_sharded_WHEN_SetFromOpLists_called_THEN_entity_deltas_are_merged_in_entity_order)
+{
+	// GIVEN
+	ViewDelta Delta;
+	EntityView View;
+	const ComponentData Data = CreateTestData(1);
+	const int32 EntityCount = 4096;
+
+	// Received in descending order, so the result has to be sorted across shards.
+	TArray<Worker_Op> Ops;
+	for (Worker_EntityId EntityId = EntityCount; EntityId > 0; --EntityId)
+	{
+		Ops.Push(CreateAddEntityOp(EntityId));
+		Ops.Push(CreateAddComponentOp(EntityId, Data));
+		Ops.Push(CreateAuthorityChangeOp(EntityId, TestComponentId, WORKER_AUTHORITY_AUTHORITATIVE));
+	}
+
+	// WHEN
+	SetFromOps(Delta, View, MoveTemp(Ops));
+
+	// THEN
+	const TArray<EntityDelta>& Entities = Delta.GetEntityDeltas();
+	TestEqual("One delta per entity", Entities.Num(), EntityCount);
+	TestEqual("One authority change per entity", Delta.GetAuthorityGained().Num(), EntityCount);
+	TestEqual("All entities in view", View.Num(), EntityCount);
+
+	bool bSorted = true;
+	for (int32 i = 0; i < Entities.Num(); ++i)
+	{
+		bSorted &= Entities[i].EntityId == i + 1 && Entities[i].ComponentsAdded.Num() == 1 && Entities[i].AuthorityGained.Num() == 1;
+		bSorted &= Delta.GetAuthorityGained()[i].EntityId == i + 1;
+	}
+	TestTrue("Sorted by entity with their own changes", bSorted);
 
 	return true;
 }
@@ -20,6 +20,75 @@ namespace
 		return Op;
 	}
 
+	const Worker_EntityId TestEntityId = 1;
+	const Worker_ComponentId TestComponentId = 1000;
+	const Schema_FieldId TestFieldId = 1;
+
+	Worker_Op CreateAddEntityOp(Worker_EntityId EntityId)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_ADD_ENTITY;
+		Op.op.add_entity.entity_id = EntityId;
+		return Op;
+	}
+
+	Worker_Op CreateRemoveEntityOp(Worker_EntityId EntityId)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_REMOVE_ENTITY;
+		Op.op.remove_entity.entity_id = EntityId;
+		return Op;
+	}
+
+	// The op only borrows Data, as an op list from the Worker SDK would.
+	Worker_Op CreateAddComponentOp(Worker_EntityId EntityId, const ComponentData& Data)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_ADD_COMPONENT;
+		Op.op.add_component.entity_id = EntityId;
+		Op.op.add_component.data.component_id = Data.GetComponentId();
+		Op.op.add_component.data.schema_type = Data.GetUnderlying();
+		return Op;
+	}
+
+	Worker_Op CreateComponentUpdateOp(Worker_EntityId EntityId, const ComponentUpdate& Update)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_COMPONENT_UPDATE;
+		Op.op.component_update.entity_id = EntityId;
+		Op.op.component_update.update.component_id = Update.GetComponentId();
+		Op.op.component_update.update.schema_type = Update.GetUnderlying();
+		return Op;
+	}
+
+	Worker_Op CreateRemoveComponentOp(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_REMOVE_COMPONENT;
+		Op.op.remove_component.entity_id = EntityId;
+		Op.op.remove_component.component_id = ComponentId;
+		return Op;
+	}
+
+	ComponentData CreateTestComponentData(uint32 Value)
+	{
+		ComponentData Data(TestComponentId);
+		Schema_AddUint32(Data.GetFields(), TestFieldId, Value);
+		return Data;
+	}
+
+	ComponentUpdate CreateTestComponentUpdate(uint32 Value)
+	{
+		ComponentUpdate Update(TestComponentId);
+		Schema_AddUint32(Update.GetFields(), TestFieldId, Value);
+		return Update;
+	}
+
+	void EnqueueOps(WorkerView& View, TArray<Worker_Op> Ops)
+	{
+		View.EnqueueOpList(MakeUnique<ViewDeltaLegacyOpList>(MoveTemp(Ops)));
+	}
+
 } // anonymous namespace
 
 WORKERVIEW_TEST(GIVEN_WorkerView_with_one_CreateEntityRequest_WHEN_FlushLocalChanges_called_THEN_one_CreateEntityRequest_returned)
@@ -30,10 +99,10 @@ WORKERVIEW_TEST(GIVEN_WorkerView_with_one_CreateEntityRequest_WHEN_FlushLocalCha
 	View.SendCreateEntityRequest(Request);
 
 	// WHEN
-	auto Messages = View.FlushLocalChanges();
+	MessagesToSend& Messages = View.FlushLocalChanges();
 
 	// THEN
-	TestTrue("WorkerView has one CreateEntityRequest", Messages->CreateEntityRequests.Num() == 1);
+	TestTrue("WorkerView has one CreateEntityRequest", Messages.CreateEntityRequests.Num() == 1);
 
 	return true;
 }
@@ -46,10 +115,63 @@ WORKERVIEW_TEST(GIVEN_WorkerView_with_multiple_CreateEntityRequest_WHEN_FlushLoc
 	View.SendCreateEntityRequest(Request);
 	View.SendCreateEntityRequest(Request);
 
-	auto Messages = View.FlushLocalChanges();
+	MessagesToSend& Messages = View.FlushLocalChanges();
+
+	// THEN
+	TestTrue("WorkerView has multiple CreateEntityRequest", Messages.CreateEntityRequests.Num() > 1);
+
+	return true;
+}
+
+WORKERVIEW_TEST(GIVEN_WorkerView_with_messages_of_several_types_WHEN_FlushLocalChanges_called_THEN_they_are_returned_in_one_batch)
+{
+	// GIVEN
+	WorkerView View;
+	View.SendAddComponent(TestEntityId, CreateTestComponentData(1));
+	View.SendComponentUpdate(TestEntityId, CreateTestComponentUpdate(2));
+	View.SendRemoveComponent(TestEntityId, TestComponentId);
+	View.SendDeleteEntityRequest(DeleteEntityRequest{ 1, TestEntityId, {} });
+	View.SendLogMessage(LogMessage{ WORKER_LOG_LEVEL_INFO, FName(TEXT("Test")), TEXT("Test log") });
+
+	// WHEN
+	MessagesToSend& Messages = View.FlushLocalChanges();
+
+	// THEN
+	TestTrue("Component messages kept in order", Messages.ComponentMessages.Num() == 3
+		&& Messages.ComponentMessages[0].Type == OutgoingComponentMessage::ADD
+		&& Messages.ComponentMessages[1].Type == OutgoingComponentMessage::UPDATE
+		&& Messages.ComponentMessages[2].Type == OutgoingComponentMessage::REMOVE);
+	TestEqual("One delete entity request", Messages.DeleteEntityRequests.Num(), 1);
+	TestEqual("One log", Messages.Logs.Num(), 1);
+
+	MessagesToSend& NextMessages = View.FlushLocalChanges();
+	TestEqual("Next batch is empty", NextMessages.ComponentMessages.Num() + NextMessages.DeleteEntityRequests.Num() + NextMessages.Logs.Num() + NextMessages.Order.Num(), 0);
+
+	return true;
+}
+
+WORKERVIEW_TEST(GIVEN_WorkerView_with_messages_of_several_types_WHEN_FlushLocalChanges_called_THEN_the_order_they_were_sent_in_is_kept)
+{
+	// GIVEN
+	WorkerView View;
+	View.SendComponentUpdate(TestEntityId, CreateTestComponentUpdate(1));
+	View.SendDeleteEntityRequest(DeleteEntityRequest{ 1, TestEntityId, {} });
+	View.SendLogMessage(LogMessage{ WORKER_LOG_LEVEL_INFO, FName(TEXT("Test")), TEXT("Test log") });
+	View.SendRemoveComponent(TestEntityId, TestComponentId);
+
+	// WHEN
+	MessagesToSend& Messages = View.FlushLocalChanges();
 
 	// THEN
-	TestTrue("WorkerView has multiple CreateEntityRequest", Messages->CreateEntityRequests.Num() > 1);
+	// A delete must not overtake the component messages sent before it for the same entity.
+	if (!TestTrue("Every message ordered", Messages.Order.Num() == 4))
+	{
+		return true;
+	}
+	TestTrue("Update first", Messages.Order[0].Type == MessagesToSend::COMPONENT_MESSAGE && Messages.Order[0].Index == 0);
+	TestTrue("Delete second", Messages.Order[1].Type == MessagesToSend::DELETE_ENTITY_REQUEST && Messages.Order[1].Index == 0);
+	TestTrue("Log third", Messages.Order[2].Type == MessagesToSend::LOG && Messages.Order[2].Index == 0);
+	TestTrue("Remove last", Messages.Order[3].Type == MessagesToSend::COMPONENT_MESSAGE && Messages.Order[3].Index == 1);
 
 	return true;
 }
@@ -67,7 +189,7 @@ WORKERVIEW_TEST(GIVEN_WorkerView_with_one_op_enqued_WHEN_GenerateViewDelta_calle
 	auto ViewDelta = View.GenerateViewDelta();
 
 	// THEN
-	TestTrue("ViewDelta has one op", ViewDelta->GenerateLegacyOpList()->GetCount() == 1);
+	TestTrue("ViewDelta has one CreateEntityResponse", ViewDelta->GetCreateEntityResponses().Num() == 1);
 
 	return true;
 }
@@ -86,7 +208,129 @@ WORKERVIEW_TEST(GIVEN_WorkerView_with_multiple_ops_engued_WHEN_GenerateViewDelta
 	auto ViewDelta = View.GenerateViewDelta();
 
 	// THEN
-	TestTrue("ViewDelta has multiple ops", ViewDelta->GenerateLegacyOpList()->GetCount() > 1);
+	TestTrue("ViewDelta has multiple CreateEntityResponses", ViewDelta->GetCreateEntityResponses().Num() > 1);
+
+	return true;
+}
+
+WORKERVIEW_TEST(GIVEN_WorkerView_WHEN_entity_and_component_added_THEN_view_and_ViewDelta_contain_them)
+{
+	// GIVEN
+	WorkerView View;
+	const ComponentData Data = CreateTestComponentData(1);
+	EnqueueOps(View, { CreateAddEntityOp(TestEntityId), CreateAddComponentOp(TestEntityId, Data) });
+
+	// WHEN
+	const ViewDelta* Delta = View.GenerateViewDelta();
+
+	// THEN
+	const TArray<EntityDelta>& Entities = Delta->GetEntityDeltas();
+	TestTrue("ViewDelta has the entity added", Entities.Num() == 1 && Entities[0].EntityId == TestEntityId && Entities[0].bAdded);
+	TestTrue("ViewDelta has the component added", Entities.Num() == 1 && Entities[0].ComponentsAdded.Num() == 1);
+
+	const EntityViewElement* Element = View.GetView().Find(TestEntityId);
+	TestTrue("Entity is in view", Element != nullptr);
+	if (Element != nullptr)
+	{
+		TestTrue("Component is in view", Element->Components.Num() == 1 && Element->Components[0].GetComponentId() == TestComponentId);
+	}
+
+	return true;
+}
+
+WORKERVIEW_TEST(GIVEN_WorkerView_with_a_component_WHEN_updated_THEN_view_has_the_new_value_and_ViewDelta_has_the_update)
+{
+	// GIVEN
+	WorkerView View;
+	const ComponentData Data = CreateTestComponentData(1);
+	EnqueueOps(View, { CreateAddEntityOp(TestEntityId), CreateAddComponentOp(TestEntityId, Data) });
+	View.GenerateViewDelta();
+
+	// WHEN
+	const ComponentUpdate Update = CreateTestComponentUpdate(2);
+	EnqueueOps(View, { CreateComponentUpdateOp(TestEntityId, Update) });
+	const ViewDelta* Delta = View.GenerateViewDelta();
+
+	// THEN
+	const TArray<EntityDelta>& Entities = Delta->GetEntityDeltas();
+	TestTrue("ViewDelta has no added entities", Entities.Num() == 1 && !Entities[0].bAdded);
+	TestTrue("ViewDelta has one update", Entities.Num() == 1 && Entities[0].ComponentUpdates.Num() == 1);
+	const EntityViewElement& Element = View.GetView()[TestEntityId];
+	TestEqual("View has the updated value", Schema_GetUint32(Element.Components[0].GetFields(), TestFieldId), 2u);
+
+	return true;
+}
+
+WORKERVIEW_TEST(GIVEN_WorkerView_with_a_component_WHEN_removed_and_added_again_THEN_ViewDelta_has_a_complete_update)
+{
+	// GIVEN
+	WorkerView View;
+	const ComponentData Data = CreateTestComponentData(1);
+	EnqueueOps(View, { CreateAddEntityOp(TestEntityId), CreateAddComponentOp(TestEntityId, Data) });
+	View.GenerateViewDelta();
+
+	// WHEN
+	const ComponentData NewData = CreateTestComponentData(3);
+	EnqueueOps(View, { CreateRemoveComponentOp(TestEntityId, TestComponentId), CreateAddComponentOp(TestEntityId, NewData) });
+	const ViewDelta* Delta = View.GenerateViewDelta();
+
+	// THEN
+	const TArray<EntityDelta>& Entities = Delta->GetEntityDeltas();
+	TestEqual("ViewDelta has one entity delta", Entities.Num(), 1);
+	if (Entities.Num() == 1)
+	{
+		TestEqual("ViewDelta has no removed components", Entities[0].ComponentsRemoved.Num(), 0);
+		TestEqual("ViewDelta has no added components", Entities[0].ComponentsAdded.Num(), 0);
+		TestTrue("ViewDelta has a complete update", Entities[0].ComponentsRefreshed.Num() == 1
+			&& Schema_GetUint32(Schema_GetComponentDataFields(Entities[0].ComponentsRefreshed[0].Data), TestFieldId) == 3);
+	}
+
+	return true;
+}
+
+WORKERVIEW_TEST(GIVEN_WorkerView_with_an_entity_WHEN_removed_THEN_view_no_longer_contains_it)
+{
+	// GIVEN
+	WorkerView View;
+	const ComponentData Data = CreateTestComponentData(1);
+	EnqueueOps(View, { CreateAddEntityOp(TestEntityId), CreateAddComponentOp(TestEntityId, Data) });
+	View.GenerateViewDelta();
+
+	// WHEN
+	EnqueueOps(View, { CreateRemoveComponentOp(TestEntityId, TestComponentId), CreateRemoveEntityOp(TestEntityId) });
+	const ViewDelta* Delta = View.GenerateViewDelta();
+
+	// THEN
+	const TArray<EntityDelta>& Entities = Delta->GetEntityDeltas();
+	TestTrue("ViewDelta has one removed component", Entities.Num() == 1 && Entities[0].ComponentsRemoved.Num() == 1);
+	TestTrue("ViewDelta has the entity removed", Entities.Num() == 1 && Entities[0].bRemoved);
+	TestFalse("Entity is not in view", View.GetView().Contains(TestEntityId));
+
+	return true;
+}
+
+WORKERVIEW_TEST(GIVEN_a_ViewDelta_with_an_added_component_WHEN_the_next_ViewDelta_updates_it_THEN_the_previous_ViewDelta_still_has_the_added_value)
+{
+	// GIVEN
+	WorkerView View;
+	const ComponentData Data = CreateTestComponentData(1);
+	EnqueueOps(View, { CreateAddEntityOp(TestEntityId), CreateAddComponentOp(TestEntityId, Data) });
+	const ViewDelta* PreviousDelta = View.GenerateViewDelta();
+
+	// WHEN
+	const ComponentUpdate Update = CreateTestComponentUpdate(2);
+	EnqueueOps(View, { CreateComponentUpdateOp(TestEntityId, Update) });
+	View.GenerateViewDelta();
+
+	// THEN
+	const TArray<EntityDelta>& Entities = PreviousDelta->GetEntityDeltas();
+	TestTrue("Previous ViewDelta still has the component added", Entities.Num() == 1 && Entities[0].ComponentsAdded.Num() == 1);
+	if (Entities.Num() == 1 && Entities[0].ComponentsAdded.Num() == 1)
+	{
+		TestEqual("Previous ViewDelta has the added value", Schema_GetUint32(Schema_GetComponentDataFields(Entities[0].ComponentsAdded[0].Data), TestFieldId), 1u);
+	}
+	const EntityViewElement& Element = View.GetView()[TestEntityId];
+	TestEqual("View has the updated value", Schema_GetUint32(Element.Components[0].GetFields(), TestFieldId), 2u);
 
 	return true;
 }
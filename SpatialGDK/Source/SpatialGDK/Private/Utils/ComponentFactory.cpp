@@ -15,6 +15,7 @@
 #include "Schema/Interest.h"
 #include "SpatialConstants.h"
 #include "Utils/InterestFactory.h"
+#include "Utils/PropertySerializationPlan.h"
 #include "Utils/RepLayoutUtils.h"
 #include "Utils/SpatialLatencyTracer.h"
 
@@ -46,12 +47,17 @@ ComponentFactory::ComponentFactory(bool bInterestDirty, USpatialNetDriver* InNet
 	, LatencyTracer(InLatencyTracer)
 { }
 
-uint32 ComponentFactory::FillSchemaObject(Schema_Object* ComponentObject, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool bIsInitialData, TraceKey* OutLatencyTraceId, TArray<Schema_FieldId>* ClearedIds /*= nullptr*/)
+uint32 ComponentFactory::FillSchemaObject(Schema_Object* ComponentObject, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, const FPropertySerializationPlan* Plan, bool bIsInitialData, TraceKey* OutLatencyTraceId, TArray<Schema_FieldId>* ClearedIds /*= nullptr*/)
 {
 	SCOPE_CYCLE_COUNTER(STAT_FactoryProcessPropertyUpdates);
 
 	const uint32 BytesStart = Schema_GetWriteBufferLength(ComponentObject);
 
+	if (Plan != nullptr && !Plan->IsBuiltFor(Changes.RepLayout))
+	{
+		Plan = nullptr;
+	}
+
 	// Populate the replicated data component updates from the replicated property changelist.
 	if (Changes.RepChanged.Num() > 0)
 	{
@@ -120,7 +126,14 @@ uint32 ComponentFactory::FillSchemaObject(Schema_Object* ComponentObject, UObjec
 
 				if (!bProcessedFastArrayProperty)
 				{
-					AddProperty(ComponentObject, HandleIterator.Handle, Cmd.Property, Data, ClearedIds);
+					if (Plan != nullptr)
+					{
+						AddProperty(ComponentObject, HandleIterator.Handle, Plan->GetRepWriter(HandleIterator.CmdIndex), Data, ClearedIds);
+					}
+					else
+					{
+						AddProperty(ComponentObject, HandleIterator.Handle, Cmd.Property, Data, ClearedIds);
+					}
 				}
 
 #if USE_NETWORK_PROFILER
@@ -155,6 +168,8 @@ uint32 ComponentFactory::FillHandoverSchemaObject(Schema_Object* ComponentObject
 {
 	const uint32 BytesStart = Schema_GetWriteBufferLength(ComponentObject);
 
+	const FPropertySerializationPlan* Plan = ClassInfoManager->GetOrCreateSerializationPlan(Info);
+
 	for (uint16 ChangedHandle : Changes)
 	{
 		check(ChangedHandle > 0 && ChangedHandle - 1 < Info.HandoverProperties.Num());
@@ -174,7 +189,14 @@ uint32 ComponentFactory::FillHandoverSchemaObject(Schema_Object* ComponentObject
 			*OutLatencyTraceId = LatencyTracer->RetrievePendingTrace(Object, PropertyInfo.Property);
 		}
 #endif
-		AddProperty(ComponentObject, ChangedHandle, PropertyInfo.Property, Data, ClearedIds);
+		if (Plan != nullptr)
+		{
+			AddProperty(ComponentObject, ChangedHandle, Plan->GetHandoverWriter(ChangedHandle - 1), Data, ClearedIds);
+		}
+		else
+		{
+			AddProperty(ComponentObject, ChangedHandle, PropertyInfo.Property, Data, ClearedIds);
+		}
 	}
 
 	const uint32 BytesEnd = Schema_GetWriteBufferLength(ComponentObject);
@@ -333,18 +355,32 @@ void ComponentFactory::AddProperty(Schema_Object* Object, Schema_FieldId FieldId
 	}
 }
 
+void ComponentFactory::AddProperty(Schema_Object* Object, Schema_FieldId FieldId, const FPropertyWriter& Writer, const uint8* Data, TArray<Schema_FieldId>* ClearedIds)
+{
+	if (Writer.Write == nullptr)
+	{
+		AddProperty(Object, FieldId, Writer.Property, Data, ClearedIds);
+		return;
+	}
+
+	FPropertyWriteContext Context{ PackageMap, ClearedIds, bInterestHasChanged };
+	Writer.Write(Writer, Context, Object, FieldId, Data);
+}
+
 TArray<FWorkerComponentData> ComponentFactory::CreateComponentDatas(UObject* Object, const FClassInfo& Info, const FRepChangeState& RepChangeState, const FHandoverChangeState& HandoverChangeState, uint32& OutBytesWritten)
 {
 	TArray<FWorkerComponentData> ComponentDatas;
 
+	const FPropertySerializationPlan* Plan = ClassInfoManager->GetOrCreateSerializationPlan(Info);
+
 	if (Info.SchemaComponents[SCHEMA_Data] != SpatialConstants::INVALID_COMPONENT_ID)
 	{
-		ComponentDatas.Add(CreateComponentData(Info.SchemaComponents[SCHEMA_Data], Object, RepChangeState, SCHEMA_Data, OutBytesWritten));
+		ComponentDatas.Add(CreateComponentData(Info.SchemaComponents[SCHEMA_Data], Object, RepChangeState, SCHEMA_Data, Plan, OutBytesWritten));
 	}
 
 	if (Info.SchemaComponents[SCHEMA_OwnerOnly] != SpatialConstants::INVALID_COMPONENT_ID)
 	{
-		ComponentDatas.Add(CreateComponentData(Info.SchemaComponents[SCHEMA_OwnerOnly], Object, RepChangeState, SCHEMA_OwnerOnly, OutBytesWritten));
+		ComponentDatas.Add(CreateComponentData(Info.SchemaComponents[SCHEMA_OwnerOnly], Object, RepChangeState, SCHEMA_OwnerOnly, Plan, OutBytesWritten));
 	}
 
 	if (Info.SchemaComponents[SCHEMA_Handover] != SpatialConstants::INVALID_COMPONENT_ID)
@@ -355,7 +391,7 @@ TArray<FWorkerComponentData> ComponentFactory::CreateComponentDatas(UObject* Obj
 	return ComponentDatas;
 }
 
-FWorkerComponentData ComponentFactory::CreateComponentData(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, uint32& OutBytesWritten)
+FWorkerComponentData ComponentFactory::CreateComponentData(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, const FPropertySerializationPlan* Plan, uint32& OutBytesWritten)
 {
 	FWorkerComponentData ComponentData = {};
 	ComponentData.component_id = ComponentId;
@@ -364,7 +400,7 @@ FWorkerComponentData ComponentFactory::CreateComponentData(Worker_ComponentId Co
 
 	// We're currently ignoring ClearedId fields, which is problematic if the initial replicated state
 	// is different to what the default state is (the client will have the incorrect data). UNR:959
-	OutBytesWritten += FillSchemaObject(ComponentObject, Object, Changes, PropertyGroup, true, GetTraceKeyFromComponentObject(ComponentData));
+	OutBytesWritten += FillSchemaObject(ComponentObject, Object, Changes, PropertyGroup, Plan, true, GetTraceKeyFromComponentObject(ComponentData));
 
 	return ComponentData;
 }
@@ -394,10 +430,12 @@ TArray<FWorkerComponentUpdate> ComponentFactory::CreateComponentUpdates(UObject*
 
 	if (RepChangeState)
 	{
+		const FPropertySerializationPlan* Plan = ClassInfoManager->GetOrCreateSerializationPlan(Info);
+
 		if (Info.SchemaComponents[SCHEMA_Data] != SpatialConstants::INVALID_COMPONENT_ID)
 		{
 			uint32 BytesWritten = 0;
-			FWorkerComponentUpdate MultiClientUpdate = CreateComponentUpdate(Info.SchemaComponents[SCHEMA_Data], Object, *RepChangeState, SCHEMA_Data, BytesWritten);
+			FWorkerComponentUpdate MultiClientUpdate = CreateComponentUpdate(Info.SchemaComponents[SCHEMA_Data], Object, *RepChangeState, SCHEMA_Data, Plan, BytesWritten);
 			if (BytesWritten > 0)
 			{
 				ComponentUpdates.Add(MultiClientUpdate);
@@ -408,7 +446,7 @@ TArray<FWorkerComponentUpdate> ComponentFactory::CreateComponentUpdates(UObject*
 		if (Info.SchemaComponents[SCHEMA_OwnerOnly] != SpatialConstants::INVALID_COMPONENT_ID)
 		{
 			uint32 BytesWritten = 0;
-			FWorkerComponentUpdate SingleClientUpdate = CreateComponentUpdate(Info.SchemaComponents[SCHEMA_OwnerOnly], Object, *RepChangeState, SCHEMA_OwnerOnly, BytesWritten);
+			FWorkerComponentUpdate SingleClientUpdate = CreateComponentUpdate(Info.SchemaComponents[SCHEMA_OwnerOnly], Object, *RepChangeState, SCHEMA_OwnerOnly, Plan, BytesWritten);
 			if (BytesWritten > 0)
 			{
 				ComponentUpdates.Add(SingleClientUpdate);
@@ -440,7 +478,7 @@ TArray<FWorkerComponentUpdate> ComponentFactory::CreateComponentUpdates(UObject*
 	return ComponentUpdates;
 }
 
-FWorkerComponentUpdate ComponentFactory::CreateComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, uint32& OutBytesWritten)
+FWorkerComponentUpdate ComponentFactory::CreateComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, const FPropertySerializationPlan* Plan, uint32& OutBytesWritten)
 {
 	FWorkerComponentUpdate ComponentUpdate = {};
 
@@ -450,7 +488,7 @@ FWorkerComponentUpdate ComponentFactory::CreateComponentUpdate(Worker_ComponentI
 
 	TArray<Schema_FieldId> ClearedIds;
 
-	uint32 BytesWritten = FillSchemaObject(ComponentObject, Object, Changes, PropertyGroup, false, GetTraceKeyFromComponentObject(ComponentUpdate), &ClearedIds);
+	uint32 BytesWritten = FillSchemaObject(ComponentObject, Object, Changes, PropertyGroup, Plan, false, GetTraceKeyFromComponentObject(ComponentUpdate), &ClearedIds);
 
 	for (Schema_FieldId Id : ClearedIds)
 	{
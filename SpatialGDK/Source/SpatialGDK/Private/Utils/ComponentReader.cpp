@@ -11,6 +11,8 @@
 #include "EngineClasses/SpatialNetBitReader.h"
 #include "Interop/SpatialConditionMapFilter.h"
 #include "SpatialConstants.h"
+#include "Utils/ComponentUpdateStaging.h"
+#include "Utils/PropertyApplyPlan.h"
 #include "Utils/SchemaUtils.h"
 #include "Utils/RepLayoutUtils.h"
 
@@ -115,7 +117,7 @@ void ComponentReader::ApplyComponentData(const Worker_ComponentData& ComponentDa
 	}
 }
 
-void ComponentReader::ApplyComponentUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject& Object, USpatialActorChannel& Channel, bool bIsHandover, bool& bOutReferencesChanged)
+void ComponentReader::ApplyComponentUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject& Object, USpatialActorChannel& Channel, bool bIsHandover, bool& bOutReferencesChanged, const FStagedComponentUpdate* StagedUpdate /* = nullptr */)
 {
 	if (Object.IsPendingKill())
 	{
@@ -124,6 +126,16 @@ void ComponentReader::ApplyComponentUpdate(const Worker_ComponentUpdate& Compone
 
 	Schema_Object* ComponentObject = Schema_GetComponentUpdateFields(ComponentUpdate.schema_type);
 
+	if (StagedUpdate != nullptr && !bIsHandover)
+	{
+		// The updated fields were already gathered when the update was staged.
+		if (StagedUpdate->GetUpdatedIds().Num() > 0)
+		{
+			ApplySchemaObject(ComponentObject, Object, Channel, false, StagedUpdate->GetUpdatedIds(), ComponentUpdate.component_id, bOutReferencesChanged, StagedUpdate);
+		}
+		return;
+	}
+
 	// Retrieve all the fields that have been updated in this component update
 	TArray<uint32> UpdatedIds;
 	UpdatedIds.SetNumUninitialized(Schema_GetUniqueFieldIdCount(ComponentObject));
@@ -150,7 +162,7 @@ void ComponentReader::ApplyComponentUpdate(const Worker_ComponentUpdate& Compone
 	}
 }
 
-void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject& Object, USpatialActorChannel& Channel, bool bIsInitialData, const TArray<Schema_FieldId>& UpdatedIds, Worker_ComponentId ComponentId, bool& bOutReferencesChanged)
+void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject& Object, USpatialActorChannel& Channel, bool bIsInitialData, const TArray<Schema_FieldId>& UpdatedIds, Worker_ComponentId ComponentId, bool& bOutReferencesChanged, const FStagedComponentUpdate* StagedUpdate /* = nullptr */)
 {
 	FObjectReplicator* Replicator = Channel.PreReceiveSpatialUpdate(&Object);
 	if (Replicator == nullptr)
@@ -159,6 +171,19 @@ void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject&
 		return;
 	}
 
+	// Values staged for a different rep layout don't line up with this object's properties.
+	if (StagedUpdate != nullptr && !StagedUpdate->IsStagedFor(*Replicator->RepLayout))
+	{
+		StagedUpdate = nullptr;
+	}
+
+	// Likewise for readers planned for a different rep layout.
+	const FPropertyApplyPlan* Plan = ClassInfoManager->GetOrCreateApplyPlan(ComponentId);
+	if (Plan != nullptr && !Plan->IsBuiltFor(*Replicator->RepLayout))
+	{
+		Plan = nullptr;
+	}
+
 	TUniquePtr<FRepState>& RepState = Replicator->RepState;
 	TArray<FRepLayoutCmd>& Cmds = Replicator->RepLayout->Cmds;
 	TArray<FHandleToCmdIndex>& BaseHandleToCmdIndex = Replicator->RepLayout->BaseHandleToCmdIndex;
@@ -189,6 +214,7 @@ void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject&
 			const FRepLayoutCmd& Cmd = Cmds[CmdIndex];
 			const FRepParentCmd& Parent = Parents[Cmd.ParentIndex];
 			int32 ShadowOffset = Cmd.ShadowOffset;
+			const FPropertyReader* Reader = Plan != nullptr ? Plan->GetReader(FieldId) : nullptr;
 
 			if (NetDriver->IsServer() || ConditionMap.IsRelevant(Parent.Condition))
 			{
@@ -258,12 +284,20 @@ void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject&
 					}
 					else
 					{
-						ApplyArray(ComponentObject, FieldId, RootObjectReferencesMap, ArrayProperty, Data, SwappedCmd.Offset, ShadowOffset, Cmd.ParentIndex, bOutReferencesChanged);
+						ApplyArray(ComponentObject, FieldId, RootObjectReferencesMap, ArrayProperty, Data, SwappedCmd.Offset, ShadowOffset, Cmd.ParentIndex, bOutReferencesChanged, Reader);
 					}
 				}
+				else if (StagedUpdate != nullptr && StagedUpdate->IsFieldStaged(FieldId))
+				{
+					StagedUpdate->ApplyField(FieldId, Cmd.Property, Data);
+				}
+				else if (Reader != nullptr && Reader->Read != nullptr)
+				{
+					Reader->Read(*Reader, ComponentObject, FieldId, 0, Data);
+				}
 				else
 				{
-					ApplyProperty(ComponentObject, FieldId, RootObjectReferencesMap, 0, Cmd.Property, Data, SwappedCmd.Offset, ShadowOffset, Cmd.ParentIndex, bOutReferencesChanged);
+					ApplyProperty(ComponentObject, FieldId, RootObjectReferencesMap, 0, Cmd.Property, Data, SwappedCmd.Offset, ShadowOffset, Cmd.ParentIndex, bOutReferencesChanged, Reader);
 				}
 
 				if (Cmd.Property->GetFName() == NAME_RemoteRole)
@@ -324,6 +358,12 @@ void ComponentReader::ApplyHandoverSchemaObject(Schema_Object* ComponentObject,
 
 	const FClassInfo& ClassInfo = ClassInfoManager->GetOrCreateClassInfoByClass(Object.GetClass());
 
+	const FPropertyApplyPlan* Plan = ClassInfoManager->GetOrCreateApplyPlan(ComponentId);
+	if (Plan != nullptr && !Plan->IsBuiltFor(Object.GetClass()))
+	{
+		Plan = nullptr;
+	}
+
 	for (uint32 FieldId : UpdatedIds)
 	{
 		// FieldId is the same as handover handle
@@ -335,21 +375,26 @@ void ComponentReader::ApplyHandoverSchemaObject(Schema_Object* ComponentObject,
 		const FHandoverPropertyInfo& PropertyInfo = ClassInfo.HandoverProperties[FieldId - 1];
 
 		uint8* Data = (uint8*)&Object + PropertyInfo.Offset;
+		const FPropertyReader* Reader = Plan != nullptr ? Plan->GetReader(FieldId) : nullptr;
 
 		if (UArrayProperty* ArrayProperty = Cast<UArrayProperty>(PropertyInfo.Property))
 		{
-			ApplyArray(ComponentObject, FieldId, RootObjectReferencesMap, ArrayProperty, Data, PropertyInfo.Offset, -1, -1, bOutReferencesChanged);
+			ApplyArray(ComponentObject, FieldId, RootObjectReferencesMap, ArrayProperty, Data, PropertyInfo.Offset, -1, -1, bOutReferencesChanged, Reader);
+		}
+		else if (Reader != nullptr && Reader->Read != nullptr)
+		{
+			Reader->Read(*Reader, ComponentObject, FieldId, 0, Data);
 		}
 		else
 		{
-			ApplyProperty(ComponentObject, FieldId, RootObjectReferencesMap, 0, PropertyInfo.Property, Data, PropertyInfo.Offset, -1, -1, bOutReferencesChanged);
+			ApplyProperty(ComponentObject, FieldId, RootObjectReferencesMap, 0, PropertyInfo.Property, Data, PropertyInfo.Offset, -1, -1, bOutReferencesChanged, Reader);
 		}
 	}
 
 	Channel.PostReceiveSpatialUpdate(&Object, TArray<UProperty*>());
 }
 
-void ComponentReader::ApplyProperty(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, uint32 Index, UProperty* Property, uint8* Data, int32 Offset, int32 ShadowOffset, int32 ParentIndex, bool& bOutReferencesChanged)
+void ComponentReader::ApplyProperty(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, uint32 Index, UProperty* Property, uint8* Data, int32 Offset, int32 ShadowOffset, int32 ParentIndex, bool& bOutReferencesChanged, const FPropertyReader* Reader /* = nullptr */)
 {
 	SCOPE_CYCLE_COUNTER(STAT_ReaderApplyProperty);
 
@@ -363,7 +408,14 @@ void ComponentReader::ApplyProperty(Schema_Object* Object, Schema_FieldId FieldI
 		FSpatialNetBitReader ValueDataReader(PackageMap, ValueData.GetData(), CountBits, NewDynamicRefs, NewUnresolvedRefs);
 		bool bHasUnmapped = false;
 
-		ReadStructProperty(ValueDataReader, StructProperty, NetDriver, Data, bHasUnmapped);
+		if (Reader != nullptr && (Reader->CppStructOps != nullptr || Reader->StructRepLayout.IsValid()))
+		{
+			ReadStruct(*Reader, ValueDataReader, PackageMap, Data, bHasUnmapped);
+		}
+		else
+		{
+			ReadStructProperty(ValueDataReader, StructProperty, NetDriver, Data, bHasUnmapped);
+		}
 		const bool bHasReferences = NewDynamicRefs.Num() > 0 || NewUnresolvedRefs.Num() > 0;
 
 		if (ReferencesChanged(InObjectReferencesMap, Offset, bHasReferences, NewDynamicRefs, NewUnresolvedRefs))
@@ -492,10 +544,39 @@ void ComponentReader::ApplyProperty(Schema_Object* Object, Schema_FieldId FieldI
 	}
 }
 
-void ComponentReader::ApplyArray(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, UArrayProperty* Property, uint8* Data, int32 Offset, int32 ShadowOffset, int32 ParentIndex, bool& bOutReferencesChanged)
+void ComponentReader::ApplyArray(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, UArrayProperty* Property, uint8* Data, int32 Offset, int32 ShadowOffset, int32 ParentIndex, bool& bOutReferencesChanged, const FPropertyReader* Reader /* = nullptr */)
 {
 	SCOPE_CYCLE_COUNTER(STAT_ReaderApplyArray);
 
+	const FPropertyReader* InnerReader = Reader != nullptr ? Reader->InnerReader.Get() : nullptr;
+
+	if (InnerReader != nullptr && InnerReader->Read != nullptr)
+	{
+		// Elements read without ApplyProperty can't hold object references, so there are none to track for the array.
+		InObjectReferencesMap.Remove(Offset);
+
+		FScriptArrayHelper ArrayHelper(Property, Data);
+
+		const int32 Count = InnerReader->Count(Object, FieldId);
+		ArrayHelper.Resize(Count);
+
+		if (InnerReader->ReadList != nullptr)
+		{
+			if (Count > 0)
+			{
+				InnerReader->ReadList(Object, FieldId, ArrayHelper.GetRawPtr(0));
+			}
+		}
+		else
+		{
+			for (int i = 0; i < Count; i++)
+			{
+				InnerReader->Read(*InnerReader, Object, FieldId, i, ArrayHelper.GetRawPtr(i));
+			}
+		}
+		return;
+	}
+
 	FObjectReferencesMap* ArrayObjectReferences;
 	bool bNewArrayMap = false;
 	if (FObjectReferences* ExistingEntry = InObjectReferencesMap.Find(Offset))
@@ -512,13 +593,13 @@ void ComponentReader::ApplyArray(Schema_Object* Object, Schema_FieldId FieldId,
 
 	FScriptArrayHelper ArrayHelper(Property, Data);
 
-	int Count = GetPropertyCount(Object, FieldId, Property->Inner);
+	int Count = InnerReader != nullptr && InnerReader->Count != nullptr ? InnerReader->Count(Object, FieldId) : GetPropertyCount(Object, FieldId, Property->Inner);
 	ArrayHelper.Resize(Count);
 
 	for (int i = 0; i < Count; i++)
 	{
 		int32 ElementOffset = i * Property->Inner->ElementSize;
-		ApplyProperty(Object, FieldId, *ArrayObjectReferences, i, Property->Inner, ArrayHelper.GetRawPtr(i), ElementOffset, ElementOffset, ParentIndex, bOutReferencesChanged);
+		ApplyProperty(Object, FieldId, *ArrayObjectReferences, i, Property->Inner, ArrayHelper.GetRawPtr(i), ElementOffset, ElementOffset, ParentIndex, bOutReferencesChanged, InnerReader);
 	}
 
 	if (ArrayObjectReferences->Num() > 0)
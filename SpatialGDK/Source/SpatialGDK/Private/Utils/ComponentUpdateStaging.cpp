@@ -0,0 +1,405 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/ComponentUpdateStaging.h"
+
+#include "Async/ParallelFor.h"
+#include "Net/RepLayout.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/UnrealType.h"
+
+#include "EngineClasses/SpatialNetDriver.h"
+#include "Interop/SpatialClassInfoManager.h"
+#include "SpatialConstants.h"
+
+DECLARE_CYCLE_STAT(TEXT("Staging StageComponentUpdates"), STAT_StagingStageComponentUpdates, STATGROUP_SpatialNet);
+
+namespace SpatialGDK
+{
+
+namespace
+{
+
+enum class EStagedFieldType : uint8
+{
+	None,
+	Bool,
+	Float,
+	Double,
+	Int32,
+	Int64,
+	Uint32,
+	Uint64
+};
+
+// Slots are aligned so the numeric properties can write to them directly.
+const int32 StagingSlotAlignment = 8;
+
+} // anonymous namespace
+
+struct FStagingLayout
+{
+	struct FField
+	{
+		EStagedFieldType Type = EStagedFieldType::None;
+		int32 BufferOffset = 0;
+		int32 Size = 0;
+		// The property that writes the decoded value, the underlying property for enums.
+		UNumericProperty* NumericProperty = nullptr;
+	};
+
+	TSharedPtr<FRepLayout> RepLayout;
+	// Indexed by rep handle - 1.
+	TArray<FField> Fields;
+	int32 BufferSize = 0;
+};
+
+namespace
+{
+
+// Picks how a property is read from schema, matching ComponentReader::ApplyProperty. Returns None for properties that
+// can only be decoded on the game thread.
+EStagedFieldType GetStagedFieldType(UProperty* Property, UNumericProperty*& OutNumericProperty)
+{
+	if (Property->IsA<UBoolProperty>())
+	{
+		return EStagedFieldType::Bool;
+	}
+
+	if (UEnumProperty* EnumProperty = Cast<UEnumProperty>(Property))
+	{
+		if (EnumProperty->ElementSize < 4)
+		{
+			OutNumericProperty = EnumProperty->GetUnderlyingProperty();
+			return EStagedFieldType::Uint32;
+		}
+		return GetStagedFieldType(EnumProperty->GetUnderlyingProperty(), OutNumericProperty);
+	}
+
+	UNumericProperty* NumericProperty = Cast<UNumericProperty>(Property);
+	if (NumericProperty == nullptr)
+	{
+		return EStagedFieldType::None;
+	}
+
+	OutNumericProperty = NumericProperty;
+
+	if (Property->IsA<UFloatProperty>())
+	{
+		return EStagedFieldType::Float;
+	}
+	if (Property->IsA<UDoubleProperty>())
+	{
+		return EStagedFieldType::Double;
+	}
+	if (Property->IsA<UInt8Property>() || Property->IsA<UInt16Property>() || Property->IsA<UIntProperty>())
+	{
+		return EStagedFieldType::Int32;
+	}
+	if (Property->IsA<UInt64Property>())
+	{
+		return EStagedFieldType::Int64;
+	}
+	if (Property->IsA<UByteProperty>() || Property->IsA<UUInt16Property>() || Property->IsA<UUInt32Property>())
+	{
+		return EStagedFieldType::Uint32;
+	}
+	if (Property->IsA<UUInt64Property>())
+	{
+		return EStagedFieldType::Uint64;
+	}
+
+	OutNumericProperty = nullptr;
+	return EStagedFieldType::None;
+}
+
+uint32 GetFieldCount(const Schema_Object* Object, Schema_FieldId FieldId, EStagedFieldType Type)
+{
+	switch (Type)
+	{
+	case EStagedFieldType::Bool:
+		return Schema_GetBoolCount(Object, FieldId);
+	case EStagedFieldType::Float:
+		return Schema_GetFloatCount(Object, FieldId);
+	case EStagedFieldType::Double:
+		return Schema_GetDoubleCount(Object, FieldId);
+	case EStagedFieldType::Int32:
+		return Schema_GetInt32Count(Object, FieldId);
+	case EStagedFieldType::Int64:
+		return Schema_GetInt64Count(Object, FieldId);
+	case EStagedFieldType::Uint32:
+		return Schema_GetUint32Count(Object, FieldId);
+	case EStagedFieldType::Uint64:
+		return Schema_GetUint64Count(Object, FieldId);
+	default:
+		return 0;
+	}
+}
+
+// Runs on worker threads. Only writes to the staging buffer, never to UObject memory.
+void DecodeField(const Schema_Object* Object, Schema_FieldId FieldId, const FStagingLayout::FField& Field, uint8* Slot)
+{
+	switch (Field.Type)
+	{
+	case EStagedFieldType::Bool:
+		*Slot = Schema_IndexBool(Object, FieldId, 0) != 0 ? 1 : 0;
+		break;
+	case EStagedFieldType::Float:
+		Field.NumericProperty->SetFloatingPointPropertyValue(Slot, Schema_IndexFloat(Object, FieldId, 0));
+		break;
+	case EStagedFieldType::Double:
+		Field.NumericProperty->SetFloatingPointPropertyValue(Slot, Schema_IndexDouble(Object, FieldId, 0));
+		break;
+	case EStagedFieldType::Int32:
+		Field.NumericProperty->SetIntPropertyValue(Slot, static_cast<int64>(Schema_IndexInt32(Object, FieldId, 0)));
+		break;
+	case EStagedFieldType::Int64:
+		Field.NumericProperty->SetIntPropertyValue(Slot, static_cast<int64>(Schema_IndexInt64(Object, FieldId, 0)));
+		break;
+	case EStagedFieldType::Uint32:
+		Field.NumericProperty->SetIntPropertyValue(Slot, static_cast<uint64>(Schema_IndexUint32(Object, FieldId, 0)));
+		break;
+	case EStagedFieldType::Uint64:
+		Field.NumericProperty->SetIntPropertyValue(Slot, static_cast<uint64>(Schema_IndexUint64(Object, FieldId, 0)));
+		break;
+	default:
+		checkNoEntry();
+	}
+}
+
+} // anonymous namespace
+
+bool FStagedComponentUpdate::IsStagedFor(const FRepLayout& RepLayout) const
+{
+	return Layout->RepLayout.Get() == &RepLayout;
+}
+
+bool FStagedComponentUpdate::IsFieldStaged(Schema_FieldId FieldId) const
+{
+	const int32 FieldIndex = static_cast<int32>(FieldId) - 1;
+	return FieldIndex >= 0 && FieldIndex < StagedFields.Num() && StagedFields[FieldIndex];
+}
+
+void FStagedComponentUpdate::ApplyField(Schema_FieldId FieldId, UProperty* Property, uint8* Data) const
+{
+	const FStagingLayout::FField& Field = Layout->Fields[FieldId - 1];
+	const uint8* Slot = Buffer.GetData() + Field.BufferOffset;
+
+	if (Field.Type == EStagedFieldType::Bool)
+	{
+		// Bool properties can be bitfields, so they can't be copied.
+		CastChecked<UBoolProperty>(Property)->SetPropertyValue(Data, *Slot != 0);
+	}
+	else
+	{
+		FMemory::Memcpy(Data, Slot, Field.Size);
+	}
+}
+
+FComponentUpdateStaging::FComponentUpdateStaging(USpatialNetDriver* InNetDriver)
+	: FComponentUpdateStaging(InNetDriver, [InNetDriver](Worker_ComponentId ComponentId) -> UClass*
+	{
+		const ESchemaComponentType Category = InNetDriver->ClassInfoManager->GetCategoryByComponentId(ComponentId);
+		if (Category != SCHEMA_Data && Category != SCHEMA_OwnerOnly)
+		{
+			return nullptr;
+		}
+
+		return InNetDriver->ClassInfoManager->GetClassInfoByComponentId(ComponentId).Class.Get();
+	})
+{
+}
+
+FComponentUpdateStaging::FComponentUpdateStaging(USpatialNetDriver* InNetDriver, FGetReplicatedClassFunction InGetReplicatedClass)
+	: NetDriver(InNetDriver)
+	, GetReplicatedClass(MoveTemp(InGetReplicatedClass))
+{
+}
+
+FComponentUpdateStaging::~FComponentUpdateStaging()
+{
+	Reset();
+}
+
+TSharedPtr<const FStagingLayout> FComponentUpdateStaging::GetOrCreateLayout(Worker_ComponentId ComponentId)
+{
+	const UClass* Class = GetReplicatedClass(ComponentId);
+	if (Class == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (const TSharedPtr<const FStagingLayout>* ExistingLayout = LayoutsByClass.Find(Class))
+	{
+		return *ExistingLayout;
+	}
+
+	TSharedPtr<FStagingLayout> Layout = MakeShared<FStagingLayout>();
+	Layout->RepLayout = NetDriver->GetObjectClassRepLayout(const_cast<UClass*>(Class));
+
+	const TArray<FHandleToCmdIndex>& BaseHandleToCmdIndex = Layout->RepLayout->BaseHandleToCmdIndex;
+	Layout->Fields.SetNum(BaseHandleToCmdIndex.Num());
+
+	for (int32 HandleIndex = 0; HandleIndex < BaseHandleToCmdIndex.Num(); ++HandleIndex)
+	{
+		const FRepLayoutCmd& Cmd = Layout->RepLayout->Cmds[BaseHandleToCmdIndex[HandleIndex].CmdIndex];
+		if (Cmd.Type == ERepLayoutCmdType::DynamicArray)
+		{
+			continue;
+		}
+
+		FStagingLayout::FField& Field = Layout->Fields[HandleIndex];
+		Field.Type = GetStagedFieldType(Cmd.Property, Field.NumericProperty);
+		if (Field.Type == EStagedFieldType::None)
+		{
+			continue;
+		}
+
+		Field.Size = Field.Type == EStagedFieldType::Bool ? 1 : Cmd.Property->ElementSize;
+		Field.BufferOffset = Layout->BufferSize;
+		Layout->BufferSize += Align(Field.Size, StagingSlotAlignment);
+	}
+
+	LayoutsByClass.Add(Class, Layout);
+	return Layout;
+}
+
+void FComponentUpdateStaging::StageComponentUpdates(const Worker_OpList& OpList)
+{
+	SCOPE_CYCLE_COUNTER(STAT_StagingStageComponentUpdates);
+
+	check(!StagedOpLists.Contains(&OpList));
+
+	TUniquePtr<FStagedOpList> StagedOpList = MakeUnique<FStagedOpList>();
+
+	// Layouts can create class infos and rep layouts, so they are looked up on the game thread before decoding.
+	for (size_t i = 0; i < OpList.op_count; ++i)
+	{
+		const Worker_Op& Op = OpList.ops[i];
+		if (Op.op_type != WORKER_OP_TYPE_COMPONENT_UPDATE)
+		{
+			continue;
+		}
+
+		const Worker_ComponentUpdate& Update = Op.op.component_update.update;
+		if (Update.component_id < SpatialConstants::MAX_RESERVED_SPATIAL_SYSTEM_COMPONENT_ID)
+		{
+			continue;
+		}
+
+		TSharedPtr<const FStagingLayout> Layout = GetOrCreateLayout(Update.component_id);
+		if (!Layout.IsValid() || Layout->BufferSize == 0)
+		{
+			continue;
+		}
+
+		StagedOpList->Schemas.Add(Update.schema_type);
+		FStagedComponentUpdate& StagedUpdate = StagedOpList->Updates.AddDefaulted_GetRef();
+		StagedUpdate.Layout = MoveTemp(Layout);
+	}
+
+	if (StagedOpList->Updates.Num() < MinUpdatesToStage)
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < StagedOpList->Schemas.Num(); ++Index)
+	{
+		StagedUpdateRefs.Add(StagedOpList->Schemas[Index], FStagedUpdateRef{ StagedOpList.Get(), Index });
+	}
+
+	// Nothing touches the staged updates on the game thread until the task has completed, see FStagedOpList::WaitForDecoding.
+	FStagedOpList* DecodedOpList = StagedOpList.Get();
+	StagedOpList->DecodeTask = FFunctionGraphTask::CreateAndDispatchWhenReady([DecodedOpList]()
+	{
+		ParallelFor(DecodedOpList->Updates.Num(), [DecodedOpList](int32 Index)
+		{
+			FStagedComponentUpdate& StagedUpdate = DecodedOpList->Updates[Index];
+			Schema_ComponentUpdate* Schema = DecodedOpList->Schemas[Index];
+			const FStagingLayout& Layout = *StagedUpdate.Layout;
+
+			Schema_Object* ComponentObject = Schema_GetComponentUpdateFields(Schema);
+
+			StagedUpdate.UpdatedIds.SetNumUninitialized(Schema_GetUniqueFieldIdCount(ComponentObject));
+			Schema_GetUniqueFieldIds(ComponentObject, StagedUpdate.UpdatedIds.GetData());
+
+			TArray<Schema_FieldId> ClearedIds;
+			ClearedIds.SetNumUninitialized(Schema_GetComponentUpdateClearedFieldCount(Schema));
+			Schema_GetComponentUpdateClearedFieldList(Schema, ClearedIds.GetData());
+			StagedUpdate.UpdatedIds.Append(ClearedIds);
+
+			StagedUpdate.StagedFields.Init(false, Layout.Fields.Num());
+			StagedUpdate.Buffer.SetNumUninitialized(Layout.BufferSize);
+
+			for (Schema_FieldId FieldId : StagedUpdate.UpdatedIds)
+			{
+				const int32 FieldIndex = static_cast<int32>(FieldId) - 1;
+				if (FieldIndex < 0 || FieldIndex >= Layout.Fields.Num())
+				{
+					// Invalid fields are reported when the update is applied.
+					continue;
+				}
+
+				const FStagingLayout::FField& Field = Layout.Fields[FieldIndex];
+				if (Field.Type == EStagedFieldType::None || GetFieldCount(ComponentObject, FieldId, Field.Type) == 0)
+				{
+					continue;
+				}
+
+				DecodeField(ComponentObject, FieldId, Field, StagedUpdate.Buffer.GetData() + Field.BufferOffset);
+				StagedUpdate.StagedFields[FieldIndex] = true;
+			}
+		});
+	}, TStatId(), nullptr, ENamedThreads::AnyBackgroundThreadNormalTask);
+
+	StagedOpLists.Add(&OpList, MoveTemp(StagedOpList));
+}
+
+const FStagedComponentUpdate* FComponentUpdateStaging::Find(const Worker_ComponentUpdate& Update) const
+{
+	const FStagedUpdateRef* Ref = StagedUpdateRefs.Find(Update.schema_type);
+	if (Ref == nullptr)
+	{
+		return nullptr;
+	}
+
+	Ref->StagedOpList->WaitForDecoding();
+	return &Ref->StagedOpList->Updates[Ref->Index];
+}
+
+void FComponentUpdateStaging::Release(const Worker_OpList& OpList)
+{
+	TUniquePtr<FStagedOpList> StagedOpList;
+	if (!StagedOpLists.RemoveAndCopyValue(&OpList, StagedOpList))
+	{
+		return;
+	}
+
+	// The task must not outlive the op list it reads from.
+	StagedOpList->WaitForDecoding();
+
+	for (const Schema_ComponentUpdate* Schema : StagedOpList->Schemas)
+	{
+		StagedUpdateRefs.Remove(Schema);
+	}
+}
+
+void FComponentUpdateStaging::Reset()
+{
+	for (const TPair<const Worker_OpList*, TUniquePtr<FStagedOpList>>& StagedOpList : StagedOpLists)
+	{
+		StagedOpList.Value->WaitForDecoding();
+	}
+
+	StagedOpLists.Reset();
+	StagedUpdateRefs.Reset();
+}
+
+void FComponentUpdateStaging::FStagedOpList::WaitForDecoding() const
+{
+	if (DecodeTask.IsValid() && !DecodeTask->IsComplete())
+	{
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(DecodeTask);
+	}
+}
+
+} // namespace SpatialGDK
@@ -0,0 +1,361 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/IncomingRPCScheduler.h"
+
+#include "HAL/PlatformTime.h"
+
+namespace SpatialGDK
+{
+
+namespace
+{
+
+// The wheel spans a few wait times, so deadlines never have to go round it more than once.
+const int32 WaitTimesPerWheel = 4;
+const double MinTickSeconds = 0.01;
+
+// Returns the ref whose resolution resolves ObjectRef: ObjectRef itself if it refers to an entity, otherwise the first ref in its outer
+// chain that does. Null if there is none, e.g. for level objects.
+const FUnrealObjectRef* GetResolvingRef(const FUnrealObjectRef& ObjectRef)
+{
+	const FUnrealObjectRef* Ref = &ObjectRef;
+	while (Ref->Entity == SpatialConstants::INVALID_ENTITY_ID)
+	{
+		if (!Ref->Outer.IsSet())
+		{
+			return nullptr;
+		}
+		Ref = &Ref->Outer.GetValue();
+	}
+	return Ref;
+}
+
+} // anonymous namespace
+
+FIncomingRPCScheduler::FIncomingRPCScheduler()
+{
+	WheelSlots.SetNum(NumWheelSlots);
+}
+
+void FIncomingRPCScheduler::Init(const FProcessIncomingRPCDelegate& InProcessingFunction, float InWaitSeconds, TFunction<double()> InClock /* = nullptr */)
+{
+	ProcessingFunction = InProcessingFunction;
+	Clock = InClock ? MoveTemp(InClock) : TFunction<double()>([] { return FPlatformTime::Seconds(); });
+	WaitSeconds = FMath::Max(InWaitSeconds, 0.0f);
+	TickSeconds = FMath::Max(WaitSeconds * WaitTimesPerWheel / NumWheelSlots, MinTickSeconds);
+	LastTick = GetTick(Clock());
+}
+
+void FIncomingRPCScheduler::ProcessOrQueueRPC(const FUnrealObjectRef& TargetObjectRef, ERPCType Type, RPCPayload&& Payload)
+{
+	const FQueueKey Key{ TargetObjectRef.Entity, Type };
+	FQueuedRPC RPC{ FPendingRPCParams(TargetObjectRef, Type, MoveTemp(Payload)), Clock() };
+
+	if (bProcessing || Queues.Contains(Key))
+	{
+		// RPCs wait behind the blocked ones of the same entity and type. A queue created while processing is processed straight after.
+		FRPCQueue& Queue = FindOrAddQueue(Key);
+		Queue.RPCs.Add(MoveTemp(RPC));
+		if (Queue.RPCs.Num() == 1)
+		{
+			DeferredQueues.Add(Key);
+		}
+		return;
+	}
+
+	TSet<FUnrealObjectRef> UnresolvedRefs;
+	ERPCResult Result = ERPCResult::Unknown;
+
+	bProcessing = true;
+	const bool bDone = ApplyRPC(RPC.Params, UnresolvedRefs, Result);
+	bProcessing = false;
+
+	if (!bDone)
+	{
+		FRPCQueue& Queue = FindOrAddQueue(Key);
+		Queue.RPCs.Insert(MoveTemp(RPC), 0);
+		Park(Key, Queue, Result, MoveTemp(UnresolvedRefs));
+	}
+
+	ProcessDeferredQueues();
+}
+
+void FIncomingRPCScheduler::OnObjectRefResolved(const FUnrealObjectRef& ObjectRef)
+{
+	TArray<FQueueKey> WaitingQueues;
+	const bool bHasWaitingQueues = WaitLists.RemoveAndCopyValue(ObjectRef, WaitingQueues);
+	if (bHasWaitingQueues || QueuesWaitingOnAnyRef.Num() > 0)
+	{
+		DeferredQueues.Append(WaitingQueues);
+		DeferredQueues.Append(QueuesWaitingOnAnyRef);
+		ProcessDeferredQueues();
+	}
+}
+
+void FIncomingRPCScheduler::Tick()
+{
+	const double Now = Clock();
+	const int64 CurrentTick = GetTick(Now);
+	if (CurrentTick <= LastTick)
+	{
+		return;
+	}
+
+	// After a full turn of the wheel every slot has been passed once.
+	const int64 FirstTick = FMath::Max(LastTick + 1, CurrentTick - NumWheelSlots + 1);
+	for (int64 Tick = FirstTick; Tick <= CurrentTick; ++Tick)
+	{
+		WheelSlots[static_cast<int32>(Tick % NumWheelSlots)].RemoveAll([this, Now](const FWheelEntry& Entry)
+		{
+			const FRPCQueue* Queue = Queues.Find(Entry.Key);
+			if (Queue == nullptr || Queue->Generation != Entry.Generation)
+			{
+				// The queue was emptied or woken up since.
+				return true;
+			}
+
+			if (Queue->Deadline > Now)
+			{
+				// Due on a later turn of the wheel.
+				return false;
+			}
+
+			DeferredQueues.Add(Entry.Key);
+			return true;
+		});
+	}
+
+	LastTick = CurrentTick;
+
+	ProcessDeferredQueues();
+}
+
+void FIncomingRPCScheduler::DropForEntity(Worker_EntityId EntityId)
+{
+	TArray<ERPCType> QueuedTypes;
+	if (!QueuedTypesByEntity.RemoveAndCopyValue(EntityId, QueuedTypes))
+	{
+		return;
+	}
+
+	for (ERPCType Type : QueuedTypes)
+	{
+		const FQueueKey Key{ EntityId, Type };
+		if (FRPCQueue* Queue = Queues.Find(Key))
+		{
+			Unpark(Key, *Queue);
+			Queues.Remove(Key);
+		}
+	}
+}
+
+bool FIncomingRPCScheduler::ObjectHasRPCsQueuedOfType(Worker_EntityId EntityId, ERPCType Type) const
+{
+	const FRPCQueue* Queue = Queues.Find(FQueueKey{ EntityId, Type });
+	return Queue != nullptr && Queue->RPCs.Num() > 0;
+}
+
+int32 FIncomingRPCScheduler::GetNumQueuedRPCs() const
+{
+	int32 NumQueuedRPCs = 0;
+	for (const auto& Queue : Queues)
+	{
+		NumQueuedRPCs += Queue.Value.RPCs.Num();
+	}
+	return NumQueuedRPCs;
+}
+
+FIncomingRPCScheduler::FRPCQueue& FIncomingRPCScheduler::FindOrAddQueue(const FQueueKey& Key)
+{
+	if (FRPCQueue* Queue = Queues.Find(Key))
+	{
+		return *Queue;
+	}
+
+	QueuedTypesByEntity.FindOrAdd(Key.EntityId).Add(Key.Type);
+	return Queues.Add(Key);
+}
+
+void FIncomingRPCScheduler::RemoveQueue(const FQueueKey& Key)
+{
+	Queues.Remove(Key);
+
+	if (TArray<ERPCType>* QueuedTypes = QueuedTypesByEntity.Find(Key.EntityId))
+	{
+		QueuedTypes->RemoveSingleSwap(Key.Type);
+		if (QueuedTypes->Num() == 0)
+		{
+			QueuedTypesByEntity.Remove(Key.EntityId);
+		}
+	}
+}
+
+void FIncomingRPCScheduler::ProcessQueue(const FQueueKey& Key)
+{
+	FRPCQueue* Queue = Queues.Find(Key);
+	if (Queue == nullptr)
+	{
+		return;
+	}
+
+	Unpark(Key, *Queue);
+
+	int32 NumDone = 0;
+	while (true)
+	{
+		// Applying an RPC can queue further RPCs or drop the queue, so the queue is looked up again after each one.
+		Queue = Queues.Find(Key);
+		if (Queue == nullptr || NumDone > Queue->RPCs.Num())
+		{
+			return;
+		}
+
+		if (NumDone == Queue->RPCs.Num())
+		{
+			RemoveQueue(Key);
+			return;
+		}
+
+		// Applied from a local, as the queue's array can be reallocated while the RPC executes.
+		FQueuedRPC RPC = MoveTemp(Queue->RPCs[NumDone]);
+
+		TSet<FUnrealObjectRef> UnresolvedRefs;
+		ERPCResult Result = ERPCResult::Unknown;
+		if (ApplyRPC(RPC.Params, UnresolvedRefs, Result))
+		{
+			++NumDone;
+			continue;
+		}
+
+		Queue = Queues.Find(Key);
+		if (Queue == nullptr || !Queue->RPCs.IsValidIndex(NumDone))
+		{
+			return;
+		}
+
+		Queue->RPCs[NumDone] = MoveTemp(RPC);
+		Queue->RPCs.RemoveAt(0, NumDone);
+		Park(Key, *Queue, Result, MoveTemp(UnresolvedRefs));
+		return;
+	}
+}
+
+void FIncomingRPCScheduler::ProcessDeferredQueues()
+{
+	if (bProcessing)
+	{
+		// The outermost call processes them.
+		return;
+	}
+
+	bProcessing = true;
+
+	while (DeferredQueues.Num() > 0)
+	{
+		TArray<FQueueKey> QueuesToProcess = MoveTemp(DeferredQueues);
+		DeferredQueues.Reset();
+
+		for (const FQueueKey& Key : QueuesToProcess)
+		{
+			ProcessQueue(Key);
+		}
+	}
+
+	bProcessing = false;
+}
+
+bool FIncomingRPCScheduler::ApplyRPC(const FPendingRPCParams& Params, TSet<FUnrealObjectRef>& OutUnresolvedRefs, ERPCResult& OutResult)
+{
+	ensure(ProcessingFunction.IsBound());
+	const FRPCErrorInfo ErrorInfo = ProcessingFunction.Execute(Params, OutUnresolvedRefs);
+	OutResult = ErrorInfo.ErrorCode;
+
+	if (ErrorInfo.Success())
+	{
+		return true;
+	}
+
+#if !UE_BUILD_SHIPPING
+	LogRPCError(ErrorInfo, ERPCQueueType::Receive, Params);
+#endif
+	return ErrorInfo.bShouldDrop;
+}
+
+void FIncomingRPCScheduler::Park(const FQueueKey& Key, FRPCQueue& Queue, ERPCResult Result, TSet<FUnrealObjectRef>&& UnresolvedRefs)
+{
+	const FQueuedRPC& BlockedRPC = Queue.RPCs[0];
+
+	if (Result == ERPCResult::UnresolvedTargetObject)
+	{
+		UnresolvedRefs.Reset();
+		UnresolvedRefs.Add(BlockedRPC.Params.ObjectRef);
+	}
+	else if (Result != ERPCResult::UnresolvedParameters)
+	{
+		UnresolvedRefs.Reset();
+	}
+
+	for (const FUnrealObjectRef& ObjectRef : UnresolvedRefs)
+	{
+		if (const FUnrealObjectRef* ResolvingRef = GetResolvingRef(ObjectRef))
+		{
+			Queue.WaitingOn.AddUnique(*ResolvingRef);
+		}
+		else
+		{
+			Queue.bWaitingOnAnyRef = true;
+		}
+	}
+
+	for (const FUnrealObjectRef& ObjectRef : Queue.WaitingOn)
+	{
+		WaitLists.FindOrAdd(ObjectRef).Add(Key);
+	}
+	if (Queue.bWaitingOnAnyRef)
+	{
+		QueuesWaitingOnAnyRef.Add(Key);
+	}
+
+	// Unresolved parameters are waited for until the wait time has passed. After that, or for any other failure, the RPC is retried
+	// every wait time, as the old periodic processing did.
+	const double Now = Clock();
+	const double WaitTimeEnd = BlockedRPC.QueuedSeconds + WaitSeconds;
+	Queue.Deadline = WaitTimeEnd > Now ? WaitTimeEnd : Now + WaitSeconds;
+
+	// The tick after the deadline, so the processing function sees the wait time as passed.
+	const int64 DeadlineTick = FMath::Max(GetTick(Queue.Deadline) + 1, LastTick + 1);
+	WheelSlots[static_cast<int32>(DeadlineTick % NumWheelSlots)].Add(FWheelEntry{ Key, Queue.Generation });
+}
+
+void FIncomingRPCScheduler::Unpark(const FQueueKey& Key, FRPCQueue& Queue)
+{
+	for (const FUnrealObjectRef& ObjectRef : Queue.WaitingOn)
+	{
+		if (TArray<FQueueKey>* WaitList = WaitLists.Find(ObjectRef))
+		{
+			WaitList->RemoveSingleSwap(Key);
+			if (WaitList->Num() == 0)
+			{
+				WaitLists.Remove(ObjectRef);
+			}
+		}
+	}
+
+	Queue.WaitingOn.Reset();
+
+	if (Queue.bWaitingOnAnyRef)
+	{
+		QueuesWaitingOnAnyRef.RemoveSingleSwap(Key);
+		Queue.bWaitingOnAnyRef = false;
+	}
+
+	// Leaves the queue's entry on the wheel stale.
+	++Queue.Generation;
+}
+
+int64 FIncomingRPCScheduler::GetTick(double Seconds) const
+{
+	return static_cast<int64>(FMath::FloorToDouble(Seconds / TickSeconds));
+}
+
+} // namespace SpatialGDK
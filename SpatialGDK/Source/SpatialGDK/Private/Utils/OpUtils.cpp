@@ -5,41 +5,6 @@
 
 namespace SpatialGDK
 {
-void FindFirstOpOfType(const TArray<Worker_OpList*>& InOpLists, const Worker_OpType InOpType, Worker_Op** OutOp)
-{
-	for (const Worker_OpList* OpList : InOpLists)
-	{
-		for (size_t i = 0; i < OpList->op_count; ++i)
-		{
-			Worker_Op* Op = &OpList->ops[i];
-
-			if (Op->op_type == InOpType)
-			{
-				*OutOp = Op;
-				return;
-			}
-		}
-	}
-}
-
-void FindFirstOpOfTypeForComponent(const TArray<Worker_OpList*>& InOpLists, const Worker_OpType InOpType, const Worker_ComponentId InComponentId, Worker_Op** OutOp)
-{
-	for (const Worker_OpList* OpList : InOpLists)
-	{
-		for (size_t i = 0; i < OpList->op_count; ++i)
-		{
-			Worker_Op* Op = &OpList->ops[i];
-
-			if ((Op->op_type == InOpType) &&
-				GetComponentId(Op) == InComponentId)
-			{
-				*OutOp = Op;
-				return;
-			}
-		}
-	}
-}
-
 Worker_ComponentId GetComponentId(const Worker_Op* Op)
 {
 	switch (Op->op_type)
@@ -60,4 +25,64 @@ Worker_ComponentId GetComponentId(const Worker_Op* Op)
 		return SpatialConstants::INVALID_COMPONENT_ID;
 	}
 }
+
+Worker_EntityId GetEntityId(const Worker_Op* Op)
+{
+	switch (Op->op_type)
+	{
+	case WORKER_OP_TYPE_ADD_ENTITY:
+		return Op->op.add_entity.entity_id;
+	case WORKER_OP_TYPE_REMOVE_ENTITY:
+		return Op->op.remove_entity.entity_id;
+	case WORKER_OP_TYPE_ADD_COMPONENT:
+		return Op->op.add_component.entity_id;
+	case WORKER_OP_TYPE_REMOVE_COMPONENT:
+		return Op->op.remove_component.entity_id;
+	case WORKER_OP_TYPE_COMPONENT_UPDATE:
+		return Op->op.component_update.entity_id;
+	case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+		return Op->op.authority_change.entity_id;
+	case WORKER_OP_TYPE_COMMAND_REQUEST:
+		return Op->op.command_request.entity_id;
+	case WORKER_OP_TYPE_COMMAND_RESPONSE:
+		return Op->op.command_response.entity_id;
+	default:
+		return SpatialConstants::INVALID_ENTITY_ID;
+	}
+}
+
+void FFirstOpIndex::AddOpLists(const TArray<Worker_OpList*>& InOpLists)
+{
+	for (const Worker_OpList* OpList : InOpLists)
+	{
+		for (size_t i = 0; i < OpList->op_count; ++i)
+		{
+			Worker_Op* Op = &OpList->ops[i];
+
+			// Keeps the op already found for the key, if any.
+			FirstOps.FindOrAdd(MakeKey(static_cast<Worker_OpType>(Op->op_type), GetComponentId(Op)), Op);
+		}
+	}
+}
+
+void FFirstOpIndex::Reset()
+{
+	FirstOps.Reset();
+}
+
+Worker_Op* FFirstOpIndex::FindFirstOpOfType(const Worker_OpType OpType) const
+{
+	return FindFirstOpOfTypeForComponent(OpType, SpatialConstants::INVALID_COMPONENT_ID);
+}
+
+Worker_Op* FFirstOpIndex::FindFirstOpOfTypeForComponent(const Worker_OpType OpType, const Worker_ComponentId ComponentId) const
+{
+	Worker_Op* const* Op = FirstOps.Find(MakeKey(OpType, ComponentId));
+	return Op != nullptr ? *Op : nullptr;
+}
+
+uint64 FFirstOpIndex::MakeKey(const Worker_OpType OpType, const Worker_ComponentId ComponentId)
+{
+	return (static_cast<uint64>(OpType) << 32) | ComponentId;
+}
 } // namespace SpatialGDK
@@ -0,0 +1,268 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/PropertyApplyPlan.h"
+
+#include "Net/RepLayout.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include "UObject/UnrealType.h"
+
+#include "EngineClasses/SpatialNetBitReader.h"
+#include "EngineClasses/SpatialNetBitWriter.h"
+#include "EngineClasses/SpatialNetDriver.h"
+#include "Interop/SpatialClassInfoManager.h"
+#include "Schema/UnrealObjectRef.h"
+#include "Utils/RepLayoutUtils.h"
+#include "Utils/SchemaUtils.h"
+
+namespace SpatialGDK
+{
+
+namespace
+{
+
+template <typename TValue, typename TSchemaValue, TSchemaValue (*IndexFromSchema)(const Schema_Object*, Schema_FieldId, uint32_t)>
+void ReadNumber(const FPropertyReader& Reader, Schema_Object* Object, Schema_FieldId FieldId, uint32 Index, uint8* Data)
+{
+	*reinterpret_cast<TValue*>(Data) = static_cast<TValue>(IndexFromSchema(Object, FieldId, Index));
+}
+
+template <typename TSchemaValue, void (*GetListFromSchema)(const Schema_Object*, Schema_FieldId, TSchemaValue*)>
+void ReadList(const Schema_Object* Object, Schema_FieldId FieldId, uint8* Data)
+{
+	GetListFromSchema(Object, FieldId, reinterpret_cast<TSchemaValue*>(Data));
+}
+
+void ReadBool(const FPropertyReader& Reader, Schema_Object* Object, Schema_FieldId FieldId, uint32 Index, uint8* Data)
+{
+	// Bool properties can be bitfields, so they are written through the property.
+	static_cast<UBoolProperty*>(Reader.Property)->SetPropertyValue(Data, Schema_IndexBool(Object, FieldId, Index) != 0);
+}
+
+void ReadName(const FPropertyReader& Reader, Schema_Object* Object, Schema_FieldId FieldId, uint32 Index, uint8* Data)
+{
+	*reinterpret_cast<FName*>(Data) = FName(*IndexStringFromSchema(Object, FieldId, Index));
+}
+
+void ReadString(const FPropertyReader& Reader, Schema_Object* Object, Schema_FieldId FieldId, uint32 Index, uint8* Data)
+{
+	*reinterpret_cast<FString*>(Data) = IndexStringFromSchema(Object, FieldId, Index);
+}
+
+void ReadText(const FPropertyReader& Reader, Schema_Object* Object, Schema_FieldId FieldId, uint32 Index, uint8* Data)
+{
+	*reinterpret_cast<FText*>(Data) = FText::FromString(IndexStringFromSchema(Object, FieldId, Index));
+}
+
+void ReadSoftObject(const FPropertyReader& Reader, Schema_Object* Object, Schema_FieldId FieldId, uint32 Index, uint8* Data)
+{
+	FUnrealObjectRef ObjectRef = IndexObjectRefFromSchema(Object, FieldId, Index);
+	check(ObjectRef != FUnrealObjectRef::UNRESOLVED_OBJECT_REF);
+
+	*reinterpret_cast<FSoftObjectPtr*>(Data) = FUnrealObjectRef::ToSoftObjectPath(ObjectRef);
+}
+
+// Enums smaller than 4 bytes are read as uint32, whatever their underlying type.
+FPropertyReader::FReadFunction GetSmallEnumReadFunction(const UNumericProperty* UnderlyingProperty)
+{
+	if (UnderlyingProperty->IsA<UByteProperty>())
+	{
+		return &ReadNumber<uint8, uint32_t, &Schema_IndexUint32>;
+	}
+	if (UnderlyingProperty->IsA<UInt8Property>())
+	{
+		return &ReadNumber<int8, uint32_t, &Schema_IndexUint32>;
+	}
+	if (UnderlyingProperty->IsA<UUInt16Property>())
+	{
+		return &ReadNumber<uint16, uint32_t, &Schema_IndexUint32>;
+	}
+	if (UnderlyingProperty->IsA<UInt16Property>())
+	{
+		return &ReadNumber<int16, uint32_t, &Schema_IndexUint32>;
+	}
+	return nullptr;
+}
+
+// Picks the reader of a property, matching ComponentReader::ApplyProperty and ComponentReader::GetPropertyCount.
+FPropertyReader CreateReader(USpatialNetDriver* NetDriver, UProperty* Property)
+{
+	FPropertyReader Reader;
+	Reader.Property = Property;
+
+	if (UStructProperty* StructProperty = Cast<UStructProperty>(Property))
+	{
+		UScriptStruct* Struct = StructProperty->Struct;
+		if (Struct->StructFlags & STRUCT_NetSerializeNative)
+		{
+			Reader.CppStructOps = Struct->GetCppStructOps();
+			check(Reader.CppStructOps); // else should not have STRUCT_NetSerializeNative
+		}
+		else
+		{
+			Reader.StructRepLayout = NetDriver->GetStructRepLayout(Struct);
+		}
+		Reader.Count = &Schema_GetBytesCount;
+	}
+	else if (Property->IsA<UBoolProperty>())
+	{
+		Reader.Read = &ReadBool;
+		Reader.Count = &Schema_GetBoolCount;
+	}
+	else if (Property->IsA<UFloatProperty>())
+	{
+		Reader.Read = &ReadNumber<float, float, &Schema_IndexFloat>;
+		Reader.Count = &Schema_GetFloatCount;
+		Reader.ReadList = &ReadList<float, &Schema_GetFloatList>;
+	}
+	else if (Property->IsA<UDoubleProperty>())
+	{
+		Reader.Read = &ReadNumber<double, double, &Schema_IndexDouble>;
+		Reader.Count = &Schema_GetDoubleCount;
+		Reader.ReadList = &ReadList<double, &Schema_GetDoubleList>;
+	}
+	else if (Property->IsA<UInt8Property>())
+	{
+		Reader.Read = &ReadNumber<int8, int32_t, &Schema_IndexInt32>;
+		Reader.Count = &Schema_GetInt32Count;
+	}
+	else if (Property->IsA<UInt16Property>())
+	{
+		Reader.Read = &ReadNumber<int16, int32_t, &Schema_IndexInt32>;
+		Reader.Count = &Schema_GetInt32Count;
+	}
+	else if (Property->IsA<UIntProperty>())
+	{
+		Reader.Read = &ReadNumber<int32, int32_t, &Schema_IndexInt32>;
+		Reader.Count = &Schema_GetInt32Count;
+		Reader.ReadList = &ReadList<int32_t, &Schema_GetInt32List>;
+	}
+	else if (Property->IsA<UInt64Property>())
+	{
+		Reader.Read = &ReadNumber<int64, int64_t, &Schema_IndexInt64>;
+		Reader.Count = &Schema_GetInt64Count;
+		Reader.ReadList = &ReadList<int64_t, &Schema_GetInt64List>;
+	}
+	else if (Property->IsA<UByteProperty>())
+	{
+		Reader.Read = &ReadNumber<uint8, uint32_t, &Schema_IndexUint32>;
+		Reader.Count = &Schema_GetUint32Count;
+	}
+	else if (Property->IsA<UUInt16Property>())
+	{
+		Reader.Read = &ReadNumber<uint16, uint32_t, &Schema_IndexUint32>;
+		Reader.Count = &Schema_GetUint32Count;
+	}
+	else if (Property->IsA<UUInt32Property>())
+	{
+		Reader.Read = &ReadNumber<uint32, uint32_t, &Schema_IndexUint32>;
+		Reader.Count = &Schema_GetUint32Count;
+		Reader.ReadList = &ReadList<uint32_t, &Schema_GetUint32List>;
+	}
+	else if (Property->IsA<UUInt64Property>())
+	{
+		Reader.Read = &ReadNumber<uint64, uint64_t, &Schema_IndexUint64>;
+		Reader.Count = &Schema_GetUint64Count;
+		Reader.ReadList = &ReadList<uint64_t, &Schema_GetUint64List>;
+	}
+	else if (Property->IsA<USoftObjectProperty>())
+	{
+		Reader.Read = &ReadSoftObject;
+		Reader.Count = &Schema_GetObjectCount;
+	}
+	else if (Property->IsA<UObjectPropertyBase>())
+	{
+		Reader.Count = &Schema_GetObjectCount;
+	}
+	else if (Property->IsA<UNameProperty>())
+	{
+		Reader.Read = &ReadName;
+		Reader.Count = &Schema_GetBytesCount;
+	}
+	else if (Property->IsA<UStrProperty>())
+	{
+		Reader.Read = &ReadString;
+		Reader.Count = &Schema_GetBytesCount;
+	}
+	else if (Property->IsA<UTextProperty>())
+	{
+		Reader.Read = &ReadText;
+		Reader.Count = &Schema_GetBytesCount;
+	}
+	else if (UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Property))
+	{
+		Reader.InnerReader = MakeShared<FPropertyReader>(CreateReader(NetDriver, ArrayProperty->Inner));
+	}
+	else if (UEnumProperty* EnumProperty = Cast<UEnumProperty>(Property))
+	{
+		if (EnumProperty->ElementSize < 4)
+		{
+			Reader.Read = GetSmallEnumReadFunction(EnumProperty->GetUnderlyingProperty());
+			Reader.Count = &Schema_GetUint32Count;
+		}
+		else
+		{
+			return CreateReader(NetDriver, EnumProperty->GetUnderlyingProperty());
+		}
+	}
+
+	return Reader;
+}
+
+} // anonymous namespace
+
+void ReadStruct(const FPropertyReader& Reader, FSpatialNetBitReader& NetBitReader, USpatialPackageMapClient* PackageMap, uint8* Data, bool& bOutHasUnmapped)
+{
+	if (Reader.CppStructOps != nullptr)
+	{
+		bool bSuccess = true;
+		if (!Reader.CppStructOps->NetSerialize(NetBitReader, PackageMap, bSuccess, Data))
+		{
+			bOutHasUnmapped = true;
+		}
+
+		// Check the success of the serialization and print a warning if it failed. This is how native handles failed serialization.
+		if (!bSuccess)
+		{
+			UE_LOG(LogSpatialNetSerialize, Warning, TEXT("ReadStructProperty: NetSerialize %s failed."), *static_cast<const UStructProperty*>(Reader.Property)->Struct->GetFullName());
+		}
+	}
+	else
+	{
+		RepLayout_SerializePropertiesForStruct(*Reader.StructRepLayout, NetBitReader, PackageMap, Data, bOutHasUnmapped);
+	}
+}
+
+TSharedRef<const FPropertyApplyPlan> FPropertyApplyPlan::CreateForRepLayout(USpatialNetDriver* NetDriver, const FClassInfo& Info)
+{
+	TSharedRef<FPropertyApplyPlan> Plan = MakeShared<FPropertyApplyPlan>();
+	Plan->Class = Info.Class.Get();
+	Plan->RepLayout = NetDriver->GetObjectClassRepLayout(Info.Class.Get());
+
+	// Field ids are rep handles.
+	const TArray<FHandleToCmdIndex>& BaseHandleToCmdIndex = Plan->RepLayout->BaseHandleToCmdIndex;
+	Plan->Readers.Reserve(BaseHandleToCmdIndex.Num());
+	for (const FHandleToCmdIndex& HandleToCmdIndex : BaseHandleToCmdIndex)
+	{
+		Plan->Readers.Add(CreateReader(NetDriver, Plan->RepLayout->Cmds[HandleToCmdIndex.CmdIndex].Property));
+	}
+
+	return Plan;
+}
+
+TSharedRef<const FPropertyApplyPlan> FPropertyApplyPlan::CreateForHandover(USpatialNetDriver* NetDriver, const FClassInfo& Info)
+{
+	TSharedRef<FPropertyApplyPlan> Plan = MakeShared<FPropertyApplyPlan>();
+	Plan->Class = Info.Class.Get();
+
+	// Field ids are handover handles.
+	Plan->Readers.Reserve(Info.HandoverProperties.Num());
+	for (const FHandoverPropertyInfo& PropertyInfo : Info.HandoverProperties)
+	{
+		Plan->Readers.Add(CreateReader(NetDriver, PropertyInfo.Property));
+	}
+
+	return Plan;
+}
+
+} // namespace SpatialGDK
@@ -0,0 +1,276 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/PropertySerializationPlan.h"
+
+#include "Net/RepLayout.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include "UObject/UnrealType.h"
+
+#include "EngineClasses/SpatialNetBitWriter.h"
+#include "EngineClasses/SpatialNetDriver.h"
+#include "Interop/SpatialClassInfoManager.h"
+#include "Schema/UnrealObjectRef.h"
+#include "Utils/ComponentFactory.h"
+#include "Utils/RepLayoutUtils.h"
+#include "Utils/SchemaUtils.h"
+
+namespace SpatialGDK
+{
+
+namespace
+{
+
+template <typename TValue, typename TSchemaValue, void (*AddToSchema)(Schema_Object*, Schema_FieldId, TSchemaValue)>
+void WriteNumber(const FPropertyWriter& Writer, FPropertyWriteContext& Context, Schema_Object* Object, Schema_FieldId FieldId, const uint8* Data)
+{
+	AddToSchema(Object, FieldId, static_cast<TSchemaValue>(*reinterpret_cast<const TValue*>(Data)));
+}
+
+void WriteBool(const FPropertyWriter& Writer, FPropertyWriteContext& Context, Schema_Object* Object, Schema_FieldId FieldId, const uint8* Data)
+{
+	// Bool properties can be bitfields, so they are read through the property.
+	Schema_AddBool(Object, FieldId, (uint8)static_cast<const UBoolProperty*>(Writer.Property)->GetPropertyValue(Data));
+}
+
+void WriteName(const FPropertyWriter& Writer, FPropertyWriteContext& Context, Schema_Object* Object, Schema_FieldId FieldId, const uint8* Data)
+{
+	AddStringToSchema(Object, FieldId, reinterpret_cast<const FName*>(Data)->ToString());
+}
+
+void WriteString(const FPropertyWriter& Writer, FPropertyWriteContext& Context, Schema_Object* Object, Schema_FieldId FieldId, const uint8* Data)
+{
+	AddStringToSchema(Object, FieldId, *reinterpret_cast<const FString*>(Data));
+}
+
+void WriteText(const FPropertyWriter& Writer, FPropertyWriteContext& Context, Schema_Object* Object, Schema_FieldId FieldId, const uint8* Data)
+{
+	AddStringToSchema(Object, FieldId, reinterpret_cast<const FText*>(Data)->ToString());
+}
+
+void WriteSoftObject(const FPropertyWriter& Writer, FPropertyWriteContext& Context, Schema_Object* Object, Schema_FieldId FieldId, const uint8* Data)
+{
+	const FSoftObjectPtr* ObjectPtr = reinterpret_cast<const FSoftObjectPtr*>(Data);
+
+	AddObjectRefToSchema(Object, FieldId, FUnrealObjectRef::FromSoftObjectPath(ObjectPtr->ToSoftObjectPath()));
+}
+
+void WriteObject(const FPropertyWriter& Writer, FPropertyWriteContext& Context, Schema_Object* Object, Schema_FieldId FieldId, const uint8* Data)
+{
+	const UObjectPropertyBase* ObjectProperty = static_cast<const UObjectPropertyBase*>(Writer.Property);
+	UObject* ObjectValue = ObjectProperty->GetObjectPropertyValue(Data);
+
+	if (ObjectProperty->PropertyFlags & CPF_AlwaysInterested)
+	{
+		Context.bInterestHasChanged = true;
+	}
+	AddObjectRefToSchema(Object, FieldId, FUnrealObjectRef::FromObjectPtr(ObjectValue, Context.PackageMap));
+}
+
+void WriteNetSerializeStruct(const FPropertyWriter& Writer, FPropertyWriteContext& Context, Schema_Object* Object, Schema_FieldId FieldId, const uint8* Data)
+{
+	FSpatialNetBitWriter ValueDataWriter(Context.PackageMap);
+	bool bSuccess = true;
+	Writer.CppStructOps->NetSerialize(ValueDataWriter, Context.PackageMap, bSuccess, const_cast<uint8*>(Data));
+
+	// Check the success of the serialization and print a warning if it failed. This is how native handles failed serialization.
+	if (!bSuccess)
+	{
+		UE_LOG(LogComponentFactory, Warning, TEXT("AddProperty: NetSerialize %s failed."), *static_cast<const UStructProperty*>(Writer.Property)->Struct->GetFullName());
+		return;
+	}
+
+	AddBytesToSchema(Object, FieldId, ValueDataWriter);
+}
+
+void WriteRepLayoutStruct(const FPropertyWriter& Writer, FPropertyWriteContext& Context, Schema_Object* Object, Schema_FieldId FieldId, const uint8* Data)
+{
+	FSpatialNetBitWriter ValueDataWriter(Context.PackageMap);
+	bool bHasUnmapped = false;
+
+	RepLayout_SerializePropertiesForStruct(*Writer.StructRepLayout, ValueDataWriter, Context.PackageMap, const_cast<uint8*>(Data), bHasUnmapped);
+
+	AddBytesToSchema(Object, FieldId, ValueDataWriter);
+}
+
+void WriteArray(const FPropertyWriter& Writer, FPropertyWriteContext& Context, Schema_Object* Object, Schema_FieldId FieldId, const uint8* Data)
+{
+	const FPropertyWriter& InnerWriter = *Writer.InnerWriter;
+
+	FScriptArrayHelper ArrayHelper(static_cast<const UArrayProperty*>(Writer.Property), Data);
+	for (int i = 0; i < ArrayHelper.Num(); i++)
+	{
+		InnerWriter.Write(InnerWriter, Context, Object, FieldId, ArrayHelper.GetRawPtr(i));
+	}
+
+	if (ArrayHelper.Num() == 0 && Context.ClearedIds)
+	{
+		Context.ClearedIds->Add(FieldId);
+	}
+}
+
+void WriteNothing(const FPropertyWriter& Writer, FPropertyWriteContext& Context, Schema_Object* Object, Schema_FieldId FieldId, const uint8* Data)
+{
+	// These properties can be set to replicate, but won't serialize across the network.
+}
+
+// Enums smaller than 4 bytes are written as uint32, whatever their underlying type.
+FPropertyWriter::FWriteFunction GetSmallEnumWriteFunction(const UNumericProperty* UnderlyingProperty)
+{
+	if (UnderlyingProperty->IsA<UByteProperty>())
+	{
+		return &WriteNumber<uint8, uint32_t, &Schema_AddUint32>;
+	}
+	if (UnderlyingProperty->IsA<UInt8Property>())
+	{
+		return &WriteNumber<int8, uint32_t, &Schema_AddUint32>;
+	}
+	if (UnderlyingProperty->IsA<UUInt16Property>())
+	{
+		return &WriteNumber<uint16, uint32_t, &Schema_AddUint32>;
+	}
+	if (UnderlyingProperty->IsA<UInt16Property>())
+	{
+		return &WriteNumber<int16, uint32_t, &Schema_AddUint32>;
+	}
+	return nullptr;
+}
+
+// Picks the writer of a property, matching ComponentFactory::AddProperty. Properties it has no writer for, such as maps
+// and sets, keep a null write function so AddProperty reports them.
+FPropertyWriter CreateWriter(USpatialNetDriver* NetDriver, UProperty* Property)
+{
+	FPropertyWriter Writer;
+	Writer.Property = Property;
+
+	if (UStructProperty* StructProperty = Cast<UStructProperty>(Property))
+	{
+		UScriptStruct* Struct = StructProperty->Struct;
+		if (Struct->StructFlags & STRUCT_NetSerializeNative)
+		{
+			Writer.CppStructOps = Struct->GetCppStructOps();
+			check(Writer.CppStructOps); // else should not have STRUCT_NetSerializeNative
+			Writer.Write = &WriteNetSerializeStruct;
+		}
+		else
+		{
+			Writer.StructRepLayout = NetDriver->GetStructRepLayout(Struct);
+			Writer.Write = &WriteRepLayoutStruct;
+		}
+	}
+	else if (Property->IsA<UBoolProperty>())
+	{
+		Writer.Write = &WriteBool;
+	}
+	else if (Property->IsA<UFloatProperty>())
+	{
+		Writer.Write = &WriteNumber<float, float, &Schema_AddFloat>;
+	}
+	else if (Property->IsA<UDoubleProperty>())
+	{
+		Writer.Write = &WriteNumber<double, double, &Schema_AddDouble>;
+	}
+	else if (Property->IsA<UInt8Property>())
+	{
+		Writer.Write = &WriteNumber<int8, int32_t, &Schema_AddInt32>;
+	}
+	else if (Property->IsA<UInt16Property>())
+	{
+		Writer.Write = &WriteNumber<int16, int32_t, &Schema_AddInt32>;
+	}
+	else if (Property->IsA<UIntProperty>())
+	{
+		Writer.Write = &WriteNumber<int32, int32_t, &Schema_AddInt32>;
+	}
+	else if (Property->IsA<UInt64Property>())
+	{
+		Writer.Write = &WriteNumber<int64, int64_t, &Schema_AddInt64>;
+	}
+	else if (Property->IsA<UByteProperty>())
+	{
+		Writer.Write = &WriteNumber<uint8, uint32_t, &Schema_AddUint32>;
+	}
+	else if (Property->IsA<UUInt16Property>())
+	{
+		Writer.Write = &WriteNumber<uint16, uint32_t, &Schema_AddUint32>;
+	}
+	else if (Property->IsA<UUInt32Property>())
+	{
+		Writer.Write = &WriteNumber<uint32, uint32_t, &Schema_AddUint32>;
+	}
+	else if (Property->IsA<UUInt64Property>())
+	{
+		Writer.Write = &WriteNumber<uint64, uint64_t, &Schema_AddUint64>;
+	}
+	else if (Property->IsA<USoftObjectProperty>())
+	{
+		Writer.Write = &WriteSoftObject;
+	}
+	else if (Property->IsA<UObjectPropertyBase>())
+	{
+		Writer.Write = &WriteObject;
+	}
+	else if (Property->IsA<UNameProperty>())
+	{
+		Writer.Write = &WriteName;
+	}
+	else if (Property->IsA<UStrProperty>())
+	{
+		Writer.Write = &WriteString;
+	}
+	else if (Property->IsA<UTextProperty>())
+	{
+		Writer.Write = &WriteText;
+	}
+	else if (UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Property))
+	{
+		TSharedPtr<const FPropertyWriter> InnerWriter = MakeShared<FPropertyWriter>(CreateWriter(NetDriver, ArrayProperty->Inner));
+		if (InnerWriter->Write != nullptr)
+		{
+			Writer.InnerWriter = MoveTemp(InnerWriter);
+			Writer.Write = &WriteArray;
+		}
+	}
+	else if (UEnumProperty* EnumProperty = Cast<UEnumProperty>(Property))
+	{
+		if (EnumProperty->ElementSize < 4)
+		{
+			Writer.Write = GetSmallEnumWriteFunction(EnumProperty->GetUnderlyingProperty());
+		}
+		else
+		{
+			return CreateWriter(NetDriver, EnumProperty->GetUnderlyingProperty());
+		}
+	}
+	else if (Property->IsA<UDelegateProperty>() || Property->IsA<UMulticastDelegateProperty>() || Property->IsA<UInterfaceProperty>())
+	{
+		Writer.Write = &WriteNothing;
+	}
+
+	return Writer;
+}
+
+} // anonymous namespace
+
+FPropertySerializationPlan::FPropertySerializationPlan(USpatialNetDriver* NetDriver, const FClassInfo& Info)
+{
+	RepLayout = NetDriver->GetObjectClassRepLayout(Info.Class.Get());
+
+	RepWriters.SetNum(RepLayout->Cmds.Num());
+	for (int32 CmdIndex = 0; CmdIndex < RepLayout->Cmds.Num(); ++CmdIndex)
+	{
+		const FRepLayoutCmd& Cmd = RepLayout->Cmds[CmdIndex];
+		if (Cmd.Type != ERepLayoutCmdType::Return && Cmd.Property != nullptr)
+		{
+			RepWriters[CmdIndex] = CreateWriter(NetDriver, Cmd.Property);
+		}
+	}
+
+	HandoverWriters.Reserve(Info.HandoverProperties.Num());
+	for (const FHandoverPropertyInfo& PropertyInfo : Info.HandoverProperties)
+	{
+		HandoverWriters.Add(CreateWriter(NetDriver, PropertyInfo.Property));
+	}
+}
+
+} // namespace SpatialGDK
@@ -61,32 +61,32 @@ namespace
 			return TEXT("Unknown");
 		}
 	}
+}
 
-	void LogRPCError(const FRPCErrorInfo& ErrorInfo, ERPCQueueType QueueType, const FPendingRPCParams& Params)
+void LogRPCError(const FRPCErrorInfo& ErrorInfo, ERPCQueueType QueueType, const FPendingRPCParams& Params)
+{
+	const FTimespan TimeDiff = FDateTime::Now() - Params.Timestamp;
+
+	// The format is expected to be:
+	// Function <objectName>::<functionName> sending/execution dropped/queued for <duration>. Reason: <reason>
+	FString OutputLog = FString::Printf(TEXT("Function %s::%s %s %s for %s. Reason: %s"),
+		ErrorInfo.TargetObject.IsValid() ? *ErrorInfo.TargetObject->GetName() : TEXT("UNKNOWN"),
+		ErrorInfo.Function.IsValid() ? *ErrorInfo.Function->GetName() : TEXT("UNKNOWN"),
+		QueueType == ERPCQueueType::Send ? TEXT("sending") : QueueType == ERPCQueueType::Receive ? TEXT("execution") : TEXT("UNKNOWN"),
+		ErrorInfo.bShouldDrop ? TEXT("dropped") : TEXT("queued"),
+		*TimeDiff.ToString(),
+		*ERPCResultToString(ErrorInfo.ErrorCode));
+
+	const USpatialGDKSettings* SpatialGDKSettings = GetDefault<USpatialGDKSettings>();
+	check(SpatialGDKSettings != nullptr);
+
+	if (TimeDiff.GetTotalSeconds() > SpatialGDKSettings->GetSecondsBeforeWarning(ErrorInfo.ErrorCode))
 	{
-		const FTimespan TimeDiff = FDateTime::Now() - Params.Timestamp;
-
-		// The format is expected to be:
-		// Function <objectName>::<functionName> sending/execution dropped/queued for <duration>. Reason: <reason>
-		FString OutputLog = FString::Printf(TEXT("Function %s::%s %s %s for %s. Reason: %s"),
-			ErrorInfo.TargetObject.IsValid() ? *ErrorInfo.TargetObject->GetName() : TEXT("UNKNOWN"),
-			ErrorInfo.Function.IsValid() ? *ErrorInfo.Function->GetName() : TEXT("UNKNOWN"),
-			QueueType == ERPCQueueType::Send ? TEXT("sending") : QueueType == ERPCQueueType::Receive ? TEXT("execution") : TEXT("UNKNOWN"),
-			ErrorInfo.bShouldDrop ? TEXT("dropped") : TEXT("queued"),
-			*TimeDiff.ToString(),
-			*ERPCResultToString(ErrorInfo.ErrorCode));
-
-		const USpatialGDKSettings* SpatialGDKSettings = GetDefault<USpatialGDKSettings>();
-		check(SpatialGDKSettings != nullptr);
-
-		if (TimeDiff.GetTotalSeconds() > SpatialGDKSettings->GetSecondsBeforeWarning(ErrorInfo.ErrorCode))
-		{
-			UE_LOG(LogRPCContainer, Warning, TEXT("%s"), *OutputLog);
-		}
-		else
-		{
-			UE_LOG(LogRPCContainer, Verbose, TEXT("%s"), *OutputLog);
-		}
+		UE_LOG(LogRPCContainer, Warning, TEXT("%s"), *OutputLog);
+	}
+	else
+	{
+		UE_LOG(LogRPCContainer, Verbose, TEXT("%s"), *OutputLog);
 	}
 }
 
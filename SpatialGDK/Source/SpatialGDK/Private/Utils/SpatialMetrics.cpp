@@ -13,9 +13,10 @@ DEFINE_LOG_CATEGORY(LogSpatialMetrics);
 
 USpatialMetrics::WorkerMetricsDelegate USpatialMetrics::WorkerMetricsRecieved;
 
-void USpatialMetrics::Init(USpatialWorkerConnection* InConnection, float InNetServerMaxTickRate, bool bInIsServer)
+void USpatialMetrics::Init(SpatialOSWorkerInterface* InConnection, USpatialWorkerConnection* InWorkerConnection, float InNetServerMaxTickRate, bool bInIsServer)
 {
 	Connection = InConnection;
+	WorkerConnection = InWorkerConnection;
 	bIsServer = bInIsServer;
 	NetServerMaxTickRate = InNetServerMaxTickRate;
 
@@ -50,6 +51,15 @@ void USpatialMetrics::TickMetrics(float NetDriverTime)
 	DynamicFPSMetrics.GaugeMetrics.Add(DynamicFPSGauge);
 	DynamicFPSMetrics.Load = WorkerLoad;
 
+	if (WorkerConnection != nullptr && WorkerConnection->IsTrackingOutgoingMessageStats())
+	{
+		SpatialGDK::FOutgoingMessageStats OutgoingMessageStats = WorkerConnection->GetOutgoingMessageStats();
+		SpatialGDK::FOutgoingMessageStats NewOutgoingMessageStats = OutgoingMessageStats;
+		NewOutgoingMessageStats.Subtract(ReportedOutgoingMessageStats);
+		NewOutgoingMessageStats.AppendHistogramMetrics(DynamicFPSMetrics.HistogramMetrics);
+		ReportedOutgoingMessageStats = MoveTemp(OutgoingMessageStats);
+	}
+
 	TimeOfLastReport = NetDriverTime;
 	FramesSinceLastReport = 0;
 
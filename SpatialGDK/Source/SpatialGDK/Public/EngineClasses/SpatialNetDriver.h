@@ -5,13 +5,17 @@
 #include "EngineClasses/SpatialLoadBalanceEnforcer.h"
 #include "EngineClasses/SpatialVirtualWorkerTranslationManager.h"
 #include "EngineClasses/SpatialVirtualWorkerTranslator.h"
+#include "Interop/ActorPool.h"
 #include "Interop/Connection/ConnectionConfig.h"
 #include "Interop/SpatialDispatcher.h"
 #include "Interop/SpatialOutputDevice.h"
 #include "Interop/SpatialRPCService.h"
 #include "Interop/SpatialSnapshotManager.h"
+#include "Interop/TimeSlicedOpQueue.h"
+#include "Utils/ComponentUpdateStaging.h"
 #include "Utils/SpatialActorGroupManager.h"
 #include "Utils/InterestFactory.h"
+#include "Utils/OpUtils.h"
 
 #include "LoadBalancing/AbstractLockingPolicy.h"
 #include "SpatialConstants.h"
@@ -43,6 +47,7 @@ class USpatialSender;
 class USpatialStaticComponentView;
 class USpatialWorkerConnection;
 class USpatialWorkerFlags;
+class SpatialOSWorkerInterface;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSpatialOSNetDriver, Log, All);
 
@@ -79,11 +84,19 @@ public:
 	virtual void Shutdown() override;
 	virtual void NotifyActorFullyDormantForConnection(AActor* Actor, UNetConnection* NetConnection) override;
 	virtual void OnOwnerUpdated(AActor* Actor, AActor* OldOwner) override;
+	virtual bool ShouldClientDestroyActor(AActor* Actor) const override;
 	// End UNetDriver interface.
 
 	void OnConnectionToSpatialOSSucceeded();
 	void OnConnectionToSpatialOSFailed(uint8_t ConnectionStatusCode, const FString& ErrorMessage);
 
+	// Has the driver use InConnection instead of connecting through the game instance's connection manager, for example a worker
+	// connected to an SpatialGDK::FMockSpatialOSRuntime. Must be called before InitBase, and the connection must outlive the driver.
+	void SetConnectionOverride(SpatialOSWorkerInterface* InConnection) { ConnectionOverride = InConnection; }
+
+	// The connection made by the connection manager, or null if the driver uses a connection override.
+	USpatialWorkerConnection* GetWorkerConnection() const;
+
 #if !UE_BUILD_SHIPPING
 	bool HandleNetDumpCrossServerRPCCommand(const TCHAR* Cmd, FOutputDevice& Ar);
 #endif
@@ -105,6 +118,8 @@ public:
 	void PostSpawnPlayerController(APlayerController* PlayerController, const FString& ConnectionOwningWorkerId);
 
 	void AddActorChannel(Worker_EntityId EntityId, USpatialActorChannel* Channel);
+	// Makes room for the channels of a batch of actors about to be received.
+	void ReserveActorChannels(int32 NumChannels);
 	void RemoveActorChannel(Worker_EntityId EntityId, USpatialActorChannel& Channel);
 	TMap<Worker_EntityId_Key, USpatialActorChannel*>& GetEntityToActorChannelMap();
 
@@ -126,8 +141,8 @@ public:
 	TWeakObjectPtr<USpatialNetConnection> FindClientConnectionFromWorkerId(const FString& WorkerId);
 	void CleanUpClientConnection(USpatialNetConnection* ClientConnection);
 
-	UPROPERTY()
-	USpatialWorkerConnection* Connection;
+	// Kept alive by the connection manager, or by whoever set the connection override.
+	SpatialOSWorkerInterface* Connection;
 	UPROPERTY()
 	USpatialConnectionManager* ConnectionManager;
 	UPROPERTY()
@@ -160,6 +175,10 @@ public:
 	SpatialActorGroupManager* ActorGroupManager;
 	TUniquePtr<SpatialGDK::InterestFactory> InterestFactory;
 	TUniquePtr<SpatialLoadBalanceEnforcer> LoadBalanceEnforcer;
+	// Only set on clients with pooled actor classes.
+	TUniquePtr<SpatialGDK::FActorPool> ActorPool;
+	// Only set when component updates are staged on worker threads.
+	TUniquePtr<SpatialGDK::FComponentUpdateStaging> ComponentUpdateStaging;
 	TUniquePtr<SpatialVirtualWorkerTranslator> VirtualWorkerTranslator;
 
 	Worker_EntityId WorkerEntityId = SpatialConstants::INVALID_ENTITY_ID;
@@ -188,6 +207,8 @@ public:
 private:
 
 	TUniquePtr<SpatialDispatcher> Dispatcher;
+	// Op lists that are processed over several frames on clients with an op processing budget.
+	TUniquePtr<SpatialGDK::FTimeSlicedOpQueue> OpQueue;
 	TUniquePtr<SpatialSnapshotManager> SnapshotManager;
 	TUniquePtr<FSpatialOutputDevice> SpatialOutputDevice;
 
@@ -195,6 +216,8 @@ private:
 
 	TMap<Worker_EntityId_Key, USpatialActorChannel*> EntityToActorChannel;
 	TArray<Worker_OpList*> QueuedStartupOpLists;
+	// The first startup ops of each type in the op lists received this tick, so each readiness check is a lookup.
+	SpatialGDK::FFirstOpIndex StartupOpIndex;
 	TSet<Worker_EntityId_Key> DormantEntities;
 	TSet<TWeakObjectPtr<USpatialActorChannel>> PendingDormantChannels;
 
@@ -202,6 +225,8 @@ private:
 
 	FTimerManager TimerManager;
 
+	SpatialOSWorkerInterface* ConnectionOverride;
+
 	bool bAuthoritativeDestruction;
 	bool bConnectAsClient;
 	bool bPersistSpatialConnection;
@@ -229,9 +254,13 @@ private:
 	void QueryGSMToLoadMap();
 
 	void HandleStartupOpQueueing(const TArray<Worker_OpList*>& InOpLists);
-	bool FindAndDispatchStartupOpsServer(const TArray<Worker_OpList*>& InOpLists);
-	bool FindAndDispatchStartupOpsClient(const TArray<Worker_OpList*>& InOpLists);
+	bool FindAndDispatchStartupOpsServer(const SpatialGDK::FFirstOpIndex& OpIndex);
+	bool FindAndDispatchStartupOpsClient(const SpatialGDK::FFirstOpIndex& OpIndex);
 	void SelectiveProcessOps(TArray<Worker_Op*> FoundOps);
+	// Dispatches the ops, then flushes the receiver.
+	void ProcessOps(Worker_OpList* OpList);
+	// Destroys an op list taken from the connection once its ops have been processed, along with its staged component updates.
+	void DestroyOpList(Worker_OpList* OpList);
 
 	UFUNCTION()
 	void OnMapLoaded(UWorld* LoadedWorld);
@@ -34,6 +34,9 @@ public:
 	bool ResolveEntityActor(AActor* Actor, Worker_EntityId EntityId);
 	void ResolveSubobject(UObject* Object, const FUnrealObjectRef& ObjectRef);
 
+	// Makes room for the NetGUIDs of a batch of entity actors and their subobjects about to be resolved.
+	void ReserveEntityObjects(int32 NumObjects);
+
 	void RemoveEntityActor(Worker_EntityId EntityId);
 	void RemoveSubobject(const FUnrealObjectRef& ObjectRef);
 
@@ -83,6 +86,7 @@ public:
 		
 	FNetworkGUID AssignNewEntityActorNetGUID(AActor* Actor, Worker_EntityId EntityId);
 	void AssignNewSubobjectNetGUID(UObject* Subobject, const FUnrealObjectRef& SubobjectRef);
+	void ReserveEntityObjects(int32 NumObjects);
 
 	void RemoveEntityNetGUID(Worker_EntityId EntityId);
 	void RemoveSubobjectNetGUID(const FUnrealObjectRef& SubobjectRef);
@@ -0,0 +1,97 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Logging/LogMacros.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/WeakObjectPtr.h"
+
+#include "SpatialGDKSettings.h"
+
+class AActor;
+class FOutputDevice;
+class UActorComponent;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSpatialActorPool, Log, All);
+
+namespace SpatialGDK
+{
+
+// Actors of configured classes that were removed from a client's view and are parked for reuse, instead of being destroyed
+// and spawned again when their entities flap in and out of interest.
+//
+// Only classes implementing ISpatialPooledActor are pooled, as the actors have to reset their own non-replicated state.
+// Parking an actor detaches it, hides it, disables its collision and ticking and calls OnParkedInPool. Taking it out of
+// the pool moves it to its new spawn transform, restores what was disabled and calls OnTakenFromPool. Its actor channel
+// and NetGUIDs are cleaned up and recreated by the receiver as for any removed and received actor, the pool only keeps
+// the actor itself.
+class SPATIALGDK_API FActorPool
+{
+public:
+	struct FClassStats
+	{
+		// Actors taken out of the pool instead of being spawned.
+		uint64 Hits = 0;
+		// Actors spawned because the pool of their class was empty.
+		uint64 Misses = 0;
+		uint64 Parked = 0;
+		// Actors destroyed because the pool of their class was full.
+		uint64 Overflows = 0;
+	};
+
+	explicit FActorPool(const TArray<FPooledActorClass>& PooledActorClasses);
+
+	FActorPool(const FActorPool&) = delete;
+	FActorPool& operator=(const FActorPool&) = delete;
+
+	// Returns whether actors of the class are pooled at all, i.e. the class is configured and implements ISpatialPooledActor.
+	bool IsPooledClass(const UClass* Class);
+
+	// Starts parking an actor of a pooled class, while the caller cleans up its actor channel. Returns false without
+	// doing anything if the pool of its class is full. Must be followed by FinishParking.
+	bool BeginParking(AActor* Actor);
+	void FinishParking();
+	// Whether the actor is being parked, so cleaning up its actor channel must not destroy it.
+	bool IsParking(const AActor* Actor) const { return Actor != nullptr && Actor == ActorBeingParked; }
+
+	// Returns a parked actor of the class moved to the transform, or nullptr if there is none.
+	AActor* Take(const UClass* Class, const FTransform& Transform);
+
+	// Destroys all parked actors.
+	void Empty();
+
+	int32 GetNumParkedActors(const UClass* Class) const;
+	const FClassStats* GetClassStats(const UClass* Class) const;
+
+	// Writes the hit rate and number of parked actors of each pooled class to Ar.
+	void Dump(FOutputDevice& Ar) const;
+
+private:
+	struct FParkedActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		bool bWasHidden;
+		bool bHadCollision;
+		bool bWasTickEnabled;
+		TArray<TWeakObjectPtr<UActorComponent>> TickingComponents;
+	};
+
+	struct FClassPool
+	{
+		int32 MaxPooledActors = 0;
+		TArray<FParkedActor> ParkedActors;
+		FClassStats Stats;
+	};
+
+	// Returns the pool of a class, or nullptr if the class isn't pooled. The first lookup of each class resolves its configuration.
+	FClassPool* FindClassPool(const UClass* Class);
+
+	TMap<FSoftObjectPath, int32> MaxPooledActorsByClassPath;
+	TMap<TWeakObjectPtr<const UClass>, FClassPool> ClassPools;
+
+	AActor* ActorBeingParked = nullptr;
+};
+
+} // namespace SpatialGDK
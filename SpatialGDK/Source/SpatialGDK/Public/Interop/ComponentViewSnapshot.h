@@ -0,0 +1,115 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Set.h"
+#include "Templates/Atomic.h"
+
+#include "Interop/EntityComponentStore.h"
+#include "SpatialView/EntityComponentId.h"
+
+#include <WorkerSDK/improbable/c_worker.h>
+
+namespace SpatialGDK
+{
+
+// An immutable copy of the static component view as it was at the end of a frame.
+// Every accessor is const and touches no shared state, so any number of threads can read a snapshot at once.
+class SPATIALGDK_API FComponentViewSnapshot
+{
+public:
+	bool HasAuthority(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const
+	{
+		return Store.GetAuthority(EntityId, ComponentId) == WORKER_AUTHORITY_AUTHORITATIVE;
+	}
+
+	bool HasComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const
+	{
+		return Store.HasComponent(EntityId, ComponentId);
+	}
+
+	template <typename T>
+	const T* GetComponentData(Worker_EntityId EntityId) const
+	{
+		return static_cast<const T*>(Store.FindComponent(EntityId, T::ComponentId));
+	}
+
+	void GetEntityIds(TArray<Worker_EntityId_Key>& OutEntityIds) const { Store.GetEntityIds(OutEntityIds); }
+
+	// Counts the snapshots published before this one, so readers can tell whether they have seen it already.
+	uint64 GetPublishCount() const { return PublishCount; }
+
+private:
+	friend class FComponentViewSnapshots;
+
+	FEntityComponentStore Store;
+	uint64 PublishCount = 0;
+};
+
+// A snapshot held by a reader. The snapshot won't be changed until the reference is released or destroyed.
+class SPATIALGDK_API FComponentViewSnapshotRef
+{
+public:
+	FComponentViewSnapshotRef() = default;
+	FComponentViewSnapshotRef(FComponentViewSnapshotRef&& Other);
+	FComponentViewSnapshotRef& operator=(FComponentViewSnapshotRef&& Other);
+	~FComponentViewSnapshotRef();
+
+	FComponentViewSnapshotRef(const FComponentViewSnapshotRef&) = delete;
+	FComponentViewSnapshotRef& operator=(const FComponentViewSnapshotRef&) = delete;
+
+	void Release();
+
+	bool IsValid() const { return Snapshot != nullptr; }
+	const FComponentViewSnapshot& operator*() const { check(IsValid()); return *Snapshot; }
+	const FComponentViewSnapshot* operator->() const { check(IsValid()); return Snapshot; }
+
+private:
+	friend class FComponentViewSnapshots;
+
+	FComponentViewSnapshotRef(const FComponentViewSnapshot* InSnapshot, TAtomic<int32>* InReaderCount);
+
+	const FComponentViewSnapshot* Snapshot = nullptr;
+	TAtomic<int32>* ReaderCount = nullptr;
+};
+
+// Two snapshots of the static component view, one that readers can acquire and one that the game thread brings up to
+// date with the changes of the last frames before swapping them.
+//
+// Publishing only copies the entries that changed since the back snapshot was last published, so its cost follows the
+// number of changes rather than the size of the view. If a reader still holds the back snapshot, publishing is skipped
+// instead of waiting for it, and the changes are kept for the next publish. Readers should therefore release their
+// reference within a frame, or the snapshot they can acquire falls behind.
+//
+// Must outlive every reference acquired from it, which is why the static component view hands it out as a shared pointer.
+class SPATIALGDK_API FComponentViewSnapshots
+{
+public:
+	FComponentViewSnapshots();
+
+	// Game thread. Records that the entry for an entity's component changed in the live view.
+	void MarkChanged(Worker_EntityId EntityId, Worker_ComponentId ComponentId);
+
+	// Game thread. Copies the changed entries of Live into the back snapshot and makes it the one readers acquire.
+	// Returns false if the back snapshot is still being read.
+	bool Publish(const FEntityComponentStore& Live);
+
+	// Any thread. Returns the latest published snapshot.
+	FComponentViewSnapshotRef Acquire() const;
+
+private:
+	struct FBuffer
+	{
+		FComponentViewSnapshot Snapshot;
+		// Changes made since this snapshot was last published. A component changed several times is only copied once.
+		TSet<EntityComponentId> PendingChanges;
+		mutable TAtomic<int32> ReaderCount;
+	};
+
+	FBuffer Buffers[2];
+	TAtomic<int32> CurrentIndex;
+	uint64 PublishCount;
+};
+
+} // namespace SpatialGDK
@@ -0,0 +1,223 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Interop/Connection/SpatialOSWorkerInterface.h"
+#include "Schema/Interest.h"
+#include "Schema/StandardLibrary.h"
+#include "SpatialCommonTypes.h"
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/Set.h"
+#include "Containers/UnrealString.h"
+#include "Misc/Optional.h"
+#include "Templates/UniquePtr.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+#include <WorkerSDK/improbable/c_worker.h>
+
+DECLARE_LOG_CATEGORY_EXTERN(LogMockSpatialOSRuntime, Log, All);
+
+namespace SpatialGDK
+{
+
+class FMockSpatialOSWorkerConnection;
+
+// An in-process stand-in for the SpatialOS runtime, so that several server and client workers can be run against each other
+// in one process without a deployment, for example to benchmark how the net driver scales with the number of workers.
+//
+// The runtime keeps the entities and their component data, and decides for every connected worker:
+//  - authority, from the EntityAcl component. A component is delegated to the first connected worker whose attributes
+//    satisfy its write ACL; every worker has the implicit "workerId:<WorkerId>" attribute.
+//  - interest, from the Interest component. A worker sees the entities it is authoritative over and the entities matching the
+//    queries in the Interest of components it is authoritative over, as long as it satisfies their read ACL. Visible entities
+//    are always sent in full; result types and frequencies of queries are ignored.
+// Views are brought up to date lazily, the next time any worker asks for ops after a change that can affect them.
+//
+// Component updates from authoritative workers are applied to the stored data and forwarded to the other workers that see the
+// component. Reserve, create, delete and entity query requests are answered by the runtime, and commands are routed to the
+// worker authoritative over the target component. Commands only fail with a timeout when the worker handling them disconnects.
+// Component interest overrides, log messages and metrics are ignored.
+class SPATIALGDK_API FMockSpatialOSRuntime
+{
+public:
+	FMockSpatialOSRuntime();
+	~FMockSpatialOSRuntime();
+
+	FMockSpatialOSRuntime(const FMockSpatialOSRuntime&) = delete;
+	FMockSpatialOSRuntime& operator=(const FMockSpatialOSRuntime&) = delete;
+
+	// Connects a new worker to the runtime. The connection must be destroyed before the runtime.
+	TUniquePtr<FMockSpatialOSWorkerConnection> ConnectWorker(const FString& WorkerId, const WorkerAttributeSet& Attributes);
+
+	// Creates an entity directly, as if it had been loaded from a snapshot. Takes ownership of the component data.
+	Worker_EntityId CreateEntity(TArray<FWorkerComponentData>&& Components);
+
+	bool HasEntity(Worker_EntityId EntityId) const { return Entities.Contains(EntityId); }
+	int32 GetNumEntities() const { return Entities.Num(); }
+	Schema_ComponentData* GetComponentData(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const;
+
+	// Returns the worker the component is delegated to, or nullptr. Only up to date once views have been refreshed.
+	const FMockSpatialOSWorkerConnection* GetAuthoritativeWorker(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const;
+
+private:
+	friend class FMockSpatialOSWorkerConnection;
+
+	struct FMockEntity
+	{
+		TMap<Worker_ComponentId, Schema_ComponentData*> Components;
+
+		// Parsed from the component data, as they are needed on every view refresh.
+		TOptional<EntityAcl> Acl;
+		TOptional<Coordinates> Coords;
+		TOptional<Interest> EntityInterest;
+
+		TMap<Worker_ComponentId, FMockSpatialOSWorkerConnection*> Authority;
+	};
+
+	struct FPendingCommand
+	{
+		FMockSpatialOSWorkerConnection* Caller;
+		Worker_RequestId CallerRequestId;
+		FMockSpatialOSWorkerConnection* Target;
+		Worker_EntityId EntityId;
+		Worker_ComponentId ComponentId;
+		uint32 CommandIndex;
+	};
+
+	void DisconnectWorker(FMockSpatialOSWorkerConnection* Worker);
+
+	bool AddEntity(Worker_EntityId EntityId, TArray<FWorkerComponentData>& Components);
+	bool DeleteEntity(Worker_EntityId EntityId);
+	void AddComponent(FMockSpatialOSWorkerConnection* Sender, Worker_EntityId EntityId, const Worker_ComponentData& Data);
+	void RemoveComponent(FMockSpatialOSWorkerConnection* Sender, Worker_EntityId EntityId, Worker_ComponentId ComponentId);
+	void ApplyComponentUpdate(FMockSpatialOSWorkerConnection* Sender, Worker_EntityId EntityId, const Worker_ComponentUpdate& Update);
+	void RouteCommandRequest(FMockSpatialOSWorkerConnection* Caller, Worker_RequestId CallerRequestId, Worker_EntityId EntityId, const Worker_CommandRequest& Request);
+	void RouteCommandResponse(FMockSpatialOSWorkerConnection* Responder, Worker_RequestId RequestId, Schema_CommandResponse* Response, const FString& FailureMessage);
+	void AnswerEntityQuery(FMockSpatialOSWorkerConnection* Caller, Worker_RequestId RequestId, const Worker_EntityQuery& Query);
+
+	// Re-parses the components the runtime itself reads, and flags views for refreshing if they changed.
+	void OnComponentChanged(FMockEntity& Entity, Worker_ComponentId ComponentId);
+
+	// Brings authority and every worker's view up to date if anything changed since the last refresh.
+	void RefreshViewsIfNeeded();
+	void UpdateAuthority();
+	void RefreshView(FMockSpatialOSWorkerConnection& Worker);
+
+	bool IsAuthoritativeOverAny(const FMockEntity& Entity, const FMockSpatialOSWorkerConnection& Worker) const;
+	bool MatchesConstraint(const Worker_Constraint& Constraint, Worker_EntityId EntityId, const FMockEntity& Entity) const;
+	static bool MatchesQueryConstraint(const QueryConstraint& Constraint, Worker_EntityId EntityId, const FMockEntity& Entity, const TOptional<Coordinates>& Origin);
+	static bool SatisfiesRequirementSet(const WorkerRequirementSet& RequirementSet, const WorkerAttributeSet& Attributes);
+
+	TMap<Worker_EntityId, FMockEntity> Entities;
+	TArray<FMockSpatialOSWorkerConnection*> Workers;
+	TMap<Worker_RequestId, FPendingCommand> PendingCommands;
+
+	Worker_EntityId NextEntityId;
+	Worker_RequestId NextCommandRequestId;
+	bool bViewsDirty;
+};
+
+// A worker connected to an FMockSpatialOSRuntime. It can be handed to USpatialNetDriver::SetConnectionOverride to run a net driver
+// against the runtime.
+//
+// Ops are queued on the connection as the runtime produces them and handed out by GetOpList as a single op list. The op list
+// is owned by the connection and stays valid until it is passed to DestroyOpList, or the connection is destroyed. As with the
+// real connection, anything sent takes ownership of the schema data passed in.
+class SPATIALGDK_API FMockSpatialOSWorkerConnection : public SpatialOSWorkerInterface
+{
+public:
+	~FMockSpatialOSWorkerConnection();
+
+	FMockSpatialOSWorkerConnection(const FMockSpatialOSWorkerConnection&) = delete;
+	FMockSpatialOSWorkerConnection& operator=(const FMockSpatialOSWorkerConnection&) = delete;
+
+	bool IsEntityInView(Worker_EntityId EntityId) const { return View.Contains(EntityId); }
+	bool HasAuthority(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const;
+	int32 GetNumEntitiesInView() const { return View.Num(); }
+
+	virtual TArray<Worker_OpList*> GetOpList() override;
+	virtual Worker_RequestId SendReserveEntityIdsRequest(uint32_t NumOfEntities) override;
+	virtual Worker_RequestId SendCreateEntityRequest(TArray<FWorkerComponentData>&& Components, const Worker_EntityId* EntityId) override;
+	virtual Worker_RequestId SendDeleteEntityRequest(Worker_EntityId EntityId) override;
+	virtual void SendAddComponent(Worker_EntityId EntityId, FWorkerComponentData* ComponentData) override;
+	virtual void SendRemoveComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId) override;
+	virtual void SendComponentUpdate(Worker_EntityId EntityId, const FWorkerComponentUpdate* ComponentUpdate) override;
+	virtual Worker_RequestId SendCommandRequest(Worker_EntityId EntityId, const Worker_CommandRequest* Request, uint32_t CommandId) override;
+	virtual void SendCommandResponse(Worker_RequestId RequestId, const Worker_CommandResponse* Response) override;
+	virtual void SendCommandFailure(Worker_RequestId RequestId, const FString& Message) override;
+	virtual void SendLogMessage(uint8_t Level, const FName& LoggerName, const TCHAR* Message) override;
+	virtual void SendComponentInterest(Worker_EntityId EntityId, TArray<Worker_InterestOverride>&& ComponentInterest) override;
+	virtual Worker_RequestId SendEntityQueryRequest(const Worker_EntityQuery* EntityQuery) override;
+	virtual void SendMetrics(const SpatialGDK::SpatialMetrics& Metrics) override;
+
+	virtual PhysicalWorkerName GetWorkerId() const override { return WorkerId; }
+	virtual const TArray<FString>& GetWorkerAttributes() const override { return Attributes; }
+	virtual void DestroyOpList(Worker_OpList* OpList) override;
+
+private:
+	friend class FMockSpatialOSRuntime;
+
+	struct FEntityView
+	{
+		TSet<Worker_ComponentId> Components;
+		TSet<Worker_ComponentId> Authority;
+	};
+
+	// Ops and everything they point at. Only the outer arrays grow while ops are queued, which leaves the inner allocations in place.
+	struct FOpBatch
+	{
+		TArray<Worker_Op> Ops;
+		TArray<TArray<ANSICHAR>> Strings;
+		TArray<TArray<const char*>> AttributeLists;
+		TArray<TArray<Worker_Entity>> Entities;
+		TArray<TArray<Worker_ComponentData>> EntityComponents;
+		TArray<Schema_ComponentData*> ComponentData;
+		TArray<Schema_ComponentUpdate*> ComponentUpdates;
+		TArray<Schema_CommandRequest*> CommandRequests;
+		TArray<Schema_CommandResponse*> CommandResponses;
+
+		void Reset();
+	};
+
+	// An op list handed out by GetOpList, with the ops it points at.
+	struct FDeliveredOpList
+	{
+		Worker_OpList OpList;
+		FOpBatch Batch;
+	};
+
+	FMockSpatialOSWorkerConnection(FMockSpatialOSRuntime& InRuntime, const FString& InWorkerId, const WorkerAttributeSet& InAttributes);
+
+	Worker_Op& QueueOp(uint8 OpType);
+	const char* StoreString(const FString& String);
+
+	void QueueCriticalSection(bool bInCriticalSection);
+	void QueueAddEntity(Worker_EntityId EntityId);
+	void QueueRemoveEntity(Worker_EntityId EntityId);
+	void QueueAddComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId, const Schema_ComponentData* Data);
+	void QueueRemoveComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId);
+	void QueueAuthorityChange(Worker_EntityId EntityId, Worker_ComponentId ComponentId, bool bAuthoritative);
+	void QueueComponentUpdate(Worker_EntityId EntityId, Worker_ComponentId ComponentId, Schema_ComponentUpdate* Update);
+	void QueueReserveEntityIdsResponse(Worker_RequestId RequestId, Worker_EntityId FirstEntityId, uint32 NumberOfEntityIds);
+	void QueueCreateEntityResponse(Worker_RequestId RequestId, uint8 StatusCode, const FString& Message, Worker_EntityId EntityId);
+	void QueueDeleteEntityResponse(Worker_RequestId RequestId, uint8 StatusCode, const FString& Message, Worker_EntityId EntityId);
+	Worker_EntityQueryResponseOp& QueueEntityQueryResponse(Worker_RequestId RequestId);
+	void QueueCommandRequest(Worker_RequestId RequestId, Worker_EntityId EntityId, const FMockSpatialOSWorkerConnection& Caller, const Worker_CommandRequest& Request);
+	void QueueCommandResponse(Worker_RequestId RequestId, Worker_EntityId EntityId, uint8 StatusCode, const FString& Message, Worker_ComponentId ComponentId, uint32 CommandIndex, Schema_CommandResponse* Response);
+
+	FMockSpatialOSRuntime* Runtime;
+	FString WorkerId;
+	WorkerAttributeSet Attributes;
+
+	TMap<Worker_EntityId, FEntityView> View;
+
+	FOpBatch QueuedOps;
+	// Heap allocated, as the net driver can hold on to op lists across several calls to GetOpList.
+	TArray<TUniquePtr<FDeliveredOpList>> DeliveredOpLists;
+
+	Worker_RequestId NextRequestId;
+};
+
+} // namespace SpatialGDK
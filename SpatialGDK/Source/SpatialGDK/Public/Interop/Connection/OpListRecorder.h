@@ -0,0 +1,76 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Templates/UniquePtr.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+#include <WorkerSDK/improbable/c_worker.h>
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSpatialOpListRecording, Log, All);
+
+class FArchive;
+
+namespace SpatialGDK
+{
+
+// On-disk format shared by FOpListRecorder and FOpListReplayer.
+//
+// The file is a flat little-endian byte stream with no pointers, so it can be read straight out of a memory mapped file:
+//   Header:   uint32 Magic, uint32 Version
+//   Frame:    uint32 FrameSize (bytes following this field), double Timestamp (seconds since recording started), uint32 OpListCount, OpList...
+//   OpList:   uint32 OpCount, Op...
+//   Op:       uint8 OpType, followed by the fields of that op type in declaration order.
+// A frame holds every op list returned by one call to GetOpList. Strings are written as uint32 length + UTF-8 bytes, and schema
+// objects as uint32 length + serialized bytes, where a length of NullLength marks a missing string or schema object.
+namespace OpListRecording
+{
+	constexpr uint32 Magic = 0x52504F53; // "SOPR"
+	constexpr uint32 Version = 1;
+	constexpr uint32 NullLength = 0xFFFFFFFF;
+} // namespace OpListRecording
+
+// Writes the op lists received by a worker to disk so they can be replayed offline with FOpListReplayer.
+class SPATIALGDK_API FOpListRecorder
+{
+public:
+	~FOpListRecorder();
+
+	// Creates the recording file. Returns nullptr if the file could not be opened.
+	static TUniquePtr<FOpListRecorder> Create(const FString& Filename);
+
+	// Records all op lists returned by one call to GetOpList as a single frame.
+	void RecordFrame(const TArray<Worker_OpList*>& OpLists);
+
+	const FString& GetFilename() const { return Filename; }
+	uint32 GetNumRecordedFrames() const { return NumRecordedFrames; }
+
+private:
+	FOpListRecorder(const FString& InFilename, TUniquePtr<FArchive> InFileWriter);
+
+	void WriteOp(const Worker_Op& Op);
+	void WriteComponentData(const Worker_ComponentData& Data);
+	void WriteComponentUpdate(const Worker_ComponentUpdate& Update);
+	void WriteSchemaObject(Schema_Object* Object);
+	void WriteString(const char* String);
+	void WriteBytes(const void* Data, uint32 Length);
+
+	template <typename T>
+	void Write(T Value)
+	{
+		WriteBytes(&Value, sizeof(T));
+	}
+
+	FString Filename;
+	TUniquePtr<FArchive> FileWriter;
+	double StartTime;
+	uint32 NumRecordedFrames;
+
+	// Frames are encoded here first so that their size can be written ahead of them.
+	TArray<uint8> FrameBuffer;
+	TArray<uint8> SchemaBuffer;
+};
+
+} // namespace SpatialGDK
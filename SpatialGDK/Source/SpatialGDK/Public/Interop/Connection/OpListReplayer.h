@@ -0,0 +1,105 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Interop/Connection/SpatialOSWorkerInterface.h"
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+#include <WorkerSDK/improbable/c_worker.h>
+
+namespace SpatialGDK
+{
+
+enum class EOpListReplaySpeed : uint8
+{
+	// Frames are returned from GetOpList once the time they were recorded at has elapsed since Restart.
+	Recorded,
+	// Every call to GetOpList returns the next recorded frame.
+	Maximum
+};
+
+// Stands in for a worker connection by returning op lists recorded with FOpListRecorder, so the receive path
+// (SpatialDispatcher, USpatialReceiver and everything behind them) can be benchmarked without a deployment.
+//
+// The whole recording is decoded when it is loaded so replaying does not measure decoding. The op lists returned by GetOpList
+// are owned by the replayer and stay valid until the recording is unloaded, so DestroyOpList does nothing.
+// Anything sent through the replayer is swallowed.
+class SPATIALGDK_API FOpListReplayer : public SpatialOSWorkerInterface
+{
+public:
+	FOpListReplayer();
+	~FOpListReplayer();
+
+	FOpListReplayer(const FOpListReplayer&) = delete;
+	FOpListReplayer& operator=(const FOpListReplayer&) = delete;
+
+	// Loads and decodes a recording, replacing any previously loaded one. Returns false if the file is missing or malformed.
+	bool LoadRecording(const FString& Filename);
+
+	void SetReplaySpeed(EOpListReplaySpeed InReplaySpeed) { ReplaySpeed = InReplaySpeed; }
+
+	// Rewinds to the first frame. At recorded speed, the recording clock starts now.
+	void Restart();
+
+	bool IsFinished() const { return NextFrame >= Frames.Num(); }
+	int32 GetNumFrames() const { return Frames.Num(); }
+	int32 GetNumOps() const { return NumOps; }
+
+	virtual TArray<Worker_OpList*> GetOpList() override;
+	virtual Worker_RequestId SendReserveEntityIdsRequest(uint32_t NumOfEntities) override;
+	virtual Worker_RequestId SendCreateEntityRequest(TArray<FWorkerComponentData>&& Components, const Worker_EntityId* EntityId) override;
+	virtual Worker_RequestId SendDeleteEntityRequest(Worker_EntityId EntityId) override;
+	virtual void SendAddComponent(Worker_EntityId EntityId, FWorkerComponentData* ComponentData) override;
+	virtual void SendRemoveComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId) override;
+	virtual void SendComponentUpdate(Worker_EntityId EntityId, const FWorkerComponentUpdate* ComponentUpdate) override;
+	virtual Worker_RequestId SendCommandRequest(Worker_EntityId EntityId, const Worker_CommandRequest* Request, uint32_t CommandId) override;
+	virtual void SendCommandResponse(Worker_RequestId RequestId, const Worker_CommandResponse* Response) override;
+	virtual void SendCommandFailure(Worker_RequestId RequestId, const FString& Message) override;
+	virtual void SendLogMessage(uint8_t Level, const FName& LoggerName, const TCHAR* Message) override;
+	virtual void SendComponentInterest(Worker_EntityId EntityId, TArray<Worker_InterestOverride>&& ComponentInterest) override;
+	virtual Worker_RequestId SendEntityQueryRequest(const Worker_EntityQuery* EntityQuery) override;
+	virtual void SendMetrics(const SpatialGDK::SpatialMetrics& Metrics) override;
+
+	virtual PhysicalWorkerName GetWorkerId() const override;
+	virtual const TArray<FString>& GetWorkerAttributes() const override;
+	// Op lists stay owned by the replayer.
+	virtual void DestroyOpList(Worker_OpList* OpList) override {}
+
+private:
+	struct FReplayFrame
+	{
+		double Timestamp;
+		int32 FirstOpList;
+		int32 NumOpLists;
+	};
+
+	bool DecodeRecording(const uint8* Data, int64 Size);
+	void Unload();
+
+	FString Filename;
+	EOpListReplaySpeed ReplaySpeed;
+	double ReplayStartTime;
+	int32 NextFrame;
+	int32 NumOps;
+
+	TArray<FReplayFrame> Frames;
+	TArray<Worker_OpList> OpLists;
+
+	// Everything the decoded ops point at. Only the outer arrays grow while decoding, which leaves the inner allocations in place.
+	TArray<TArray<Worker_Op>> OpStorage;
+	TArray<TArray<ANSICHAR>> StringStorage;
+	TArray<TArray<const char*>> AttributeStorage;
+	TArray<TArray<Worker_Entity>> EntityStorage;
+	TArray<TArray<Worker_ComponentData>> ComponentDataStorage;
+	TArray<Schema_ComponentData*> OwnedComponentData;
+	TArray<Schema_ComponentUpdate*> OwnedComponentUpdates;
+	TArray<Schema_CommandRequest*> OwnedCommandRequests;
+	TArray<Schema_CommandResponse*> OwnedCommandResponses;
+
+	Worker_RequestId NextRequestId;
+};
+
+} // namespace SpatialGDK
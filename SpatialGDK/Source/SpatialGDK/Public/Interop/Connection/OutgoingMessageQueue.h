@@ -0,0 +1,141 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "HAL/Platform.h"
+#include "Templates/Atomic.h"
+#include "Templates/TypeCompatibleBytes.h"
+#include "Templates/UniquePtr.h"
+#include "Templates/UnrealTypeTraits.h"
+
+#include "Interop/Connection/OutgoingMessages.h"
+
+namespace SpatialGDK
+{
+
+namespace OutgoingMessageQueueDetail
+{
+	template <typename... Types>
+	struct TMaxSizeOf;
+
+	template <typename T>
+	struct TMaxSizeOf<T>
+	{
+		static constexpr SIZE_T Size = sizeof(T);
+		static constexpr SIZE_T Alignment = alignof(T);
+	};
+
+	template <typename T, typename... Rest>
+	struct TMaxSizeOf<T, Rest...>
+	{
+		static constexpr SIZE_T Size = sizeof(T) > TMaxSizeOf<Rest...>::Size ? sizeof(T) : TMaxSizeOf<Rest...>::Size;
+		static constexpr SIZE_T Alignment = alignof(T) > TMaxSizeOf<Rest...>::Alignment ? alignof(T) : TMaxSizeOf<Rest...>::Alignment;
+	};
+
+	using FAllOutgoingMessages = TMaxSizeOf<
+		FReserveEntityIdsRequest,
+		FCreateEntityRequest,
+		FDeleteEntityRequest,
+		FAddComponent,
+		FRemoveComponent,
+		FComponentUpdate,
+		FCommandRequest,
+		FCommandResponse,
+		FCommandFailure,
+		FLogMessage,
+		FComponentInterest,
+		FEntityQueryRequest,
+		FMetrics>;
+} // namespace OutgoingMessageQueueDetail
+
+// Bounded multi-producer, single-consumer ring buffer of outgoing messages.
+//
+// Each slot is large enough to hold any FOutgoingMessage subclass, and messages are constructed in place,
+// so the slots act as a tagged union (tagged by FOutgoingMessage::Type) and queueing a message does not
+// touch the allocator. Slots are recycled once the consumer has processed the message they hold.
+class SPATIALGDK_API FOutgoingMessageQueue
+{
+public:
+	static constexpr SIZE_T SlotSize = OutgoingMessageQueueDetail::FAllOutgoingMessages::Size;
+	static constexpr SIZE_T SlotAlignment = OutgoingMessageQueueDetail::FAllOutgoingMessages::Alignment;
+
+	// Capacity is rounded up to the next power of two.
+	explicit FOutgoingMessageQueue(uint32 InCapacity);
+	~FOutgoingMessageQueue();
+
+	FOutgoingMessageQueue(const FOutgoingMessageQueue&) = delete;
+	FOutgoingMessageQueue& operator=(const FOutgoingMessageQueue&) = delete;
+
+	// Constructs a message of type T in the next free slot. OnConstructed is invoked with the message
+	// before it becomes visible to the consumer. Returns false, without constructing anything, if the queue is full.
+	// Safe to call from multiple threads.
+	template <typename T, typename FuncType, typename... ArgsType>
+	bool TryEnqueue(FuncType&& OnConstructed, ArgsType&&... Args)
+	{
+		bool bWasEmpty;
+		return TryEnqueue<T>(bWasEmpty, Forward<FuncType>(OnConstructed), Forward<ArgsType>(Args)...);
+	}
+
+	// As above, and sets bOutWasEmpty if the consumer had already dequeued every earlier message when this one was published,
+	// in which case the consumer may have gone idle and needs waking up. Safe to call from multiple threads.
+	template <typename T, typename FuncType, typename... ArgsType>
+	bool TryEnqueue(bool& bOutWasEmpty, FuncType&& OnConstructed, ArgsType&&... Args)
+	{
+		static_assert(TIsDerivedFrom<T, FOutgoingMessage>::IsDerived, "Only outgoing messages can be queued");
+		static_assert(sizeof(T) <= SlotSize && alignof(T) <= SlotAlignment, "Outgoing message does not fit into a queue slot");
+
+		uint64 Position;
+		FSlot* Slot = ClaimSlot(Position);
+		if (Slot == nullptr)
+		{
+			return false;
+		}
+
+		T* Message = new (Slot->Storage.Data) T(Forward<ArgsType>(Args)...);
+		OnConstructed(static_cast<FOutgoingMessage*>(Message));
+		PublishSlot(Slot, Position);
+		bOutWasEmpty = DequeuePosition.Load() == Position;
+		return true;
+	}
+
+	// Returns the oldest message in the queue, or nullptr if the queue is empty.
+	// Must only be called from the consumer thread.
+	FOutgoingMessage* Peek();
+
+	// Destroys the message returned by Peek and releases its slot.
+	// Must only be called from the consumer thread.
+	void Pop();
+
+	bool IsEmpty() const;
+
+	// Approximate number of queued messages. Exact when there are no concurrent producers.
+	uint32 Num() const;
+
+	uint32 GetCapacity() const { return Capacity; }
+
+	// Doubles the capacity, keeping the queued messages in order. Messages are relocated bitwise, as TArray does with its elements.
+	// Must not be called while any other thread is using the queue.
+	void Grow();
+
+private:
+	struct FSlot
+	{
+		TAtomic<uint64> Sequence;
+		TAlignedBytes<SlotSize, SlotAlignment> Storage;
+	};
+
+	FSlot* ClaimSlot(uint64& OutPosition);
+	void PublishSlot(FSlot* Slot, uint64 Position);
+
+	TUniquePtr<FSlot[]> Slots;
+	uint32 Capacity;
+	uint64 IndexMask;
+
+	// Producers and the consumer touch these independently, so keep them on separate cache lines.
+	uint8 PadBeforeEnqueue[PLATFORM_CACHE_LINE_SIZE];
+	TAtomic<uint64> EnqueuePosition;
+	uint8 PadBeforeDequeue[PLATFORM_CACHE_LINE_SIZE];
+	TAtomic<uint64> DequeuePosition;
+};
+
+} // namespace SpatialGDK
@@ -0,0 +1,119 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "HAL/Platform.h"
+#include "Misc/Optional.h"
+#include "Templates/Function.h"
+#include "Templates/UniquePtr.h"
+
+#include "Interop/Connection/OutgoingMessages.h"
+
+namespace SpatialGDK
+{
+
+enum class EOutgoingMessagePriority : uint8
+{
+	// Component updates (which carry RPC ring buffers) and commands. Always sent in the flush they were queued in,
+	// unless they target an entity that still has deferred messages, which they must not overtake.
+	Critical,
+	// Entity lifecycle, components and entity queries. Sent in order, while the flush budget lasts.
+	Normal,
+	// Log messages, metrics and component interest. Sent after all normal messages, while the flush budget lasts.
+	Low
+};
+
+SPATIALGDK_API EOutgoingMessagePriority GetOutgoingMessagePriority(EOutgoingMessageType Type);
+
+// Whether sending the message makes the Worker SDK assign it a request id. The SDK assigns them in the order messages are
+// sent, while USpatialWorkerConnection predicts them in the order messages are queued, so these must never be reordered.
+SPATIALGDK_API bool IsOutgoingRequest(EOutgoingMessageType Type);
+
+// Estimates the number of bytes a message adds to the stream sent to SpatialOS.
+SPATIALGDK_API uint32 GetOutgoingMessageSize(const FOutgoingMessage& Message);
+// As GetOutgoingMessageSize, for a component update sent on its own, such as one coalesced from several queued updates.
+SPATIALGDK_API uint32 GetComponentUpdateSize(const Worker_ComponentUpdate& Update);
+
+// Limits on the outgoing traffic sent per flush. Zero means unlimited.
+struct FOutgoingMessageBudget
+{
+	uint32 MaxMessagesPerFlush = 0;
+	uint32 MaxBytesPerFlush = 0;
+	// Deferred messages are sent regardless of the budget once they have waited this many flushes.
+	uint32 MaxDeferredFlushes = 0;
+
+	bool IsLimited() const { return MaxMessagesPerFlush > 0 || MaxBytesPerFlush > 0; }
+};
+
+// Decides which outgoing messages are sent in each flush of the outgoing message queue.
+//
+// Critical messages always go out straight away and count towards the budget. Normal and low priority messages are
+// sent while the budget lasts, and moved off the queue into deferred lanes otherwise, to be sent in a later flush.
+// Relative order is preserved wherever it matters: normal messages are sent in the order they were queued, low priority
+// messages only once no normal messages are deferred, and critical messages to an entity with deferred messages are
+// deferred behind them. Messages that are assigned a request id are never reordered against each other: critical command
+// requests are deferred behind any deferred request. Without a budget every message is sent as it is dequeued, in queue order.
+class SPATIALGDK_API FOutgoingMessageScheduler
+{
+public:
+	// Returns whether the message was handed to the Worker SDK. Messages held back to be sent later, such as component updates
+	// being coalesced, don't count towards the budget until they are charged with ChargeSentMessage.
+	using FSendFunction = TFunctionRef<bool(FOutgoingMessage&)>;
+
+	explicit FOutgoingMessageScheduler(const FOutgoingMessageBudget& InBudget);
+
+	// Starts a flush, sending messages that have been deferred for too long and then as much deferred normal traffic as the budget allows.
+	void BeginFlush(FSendFunction Send);
+
+	// Sends a message dequeued from the outgoing queue, or moves it into a deferred lane. The caller still owns and releases the slot.
+	void Schedule(FOutgoingMessage& Message, FSendFunction Send);
+
+	// Ends a flush, sending as much deferred low priority traffic as the budget allows.
+	void EndFlush(FSendFunction Send);
+
+	// Counts a message sent outside of a send function, such as a coalesced component update, towards the budget of this flush.
+	void ChargeSentMessage(uint32 MessageBytes);
+	// Whether ChargeSentMessage needs the size of the message, rather than 0.
+	bool IsBudgetingBytes() const { return Budget.MaxBytesPerFlush > 0; }
+
+	// Destroys every deferred message without sending it, for when the connection is destroyed.
+	void DropDeferredMessages();
+
+	int32 GetNumDeferredMessages() const { return NormalLane.Num() + LowLane.Num(); }
+	uint32 GetNumMessagesSentThisFlush() const { return MessagesSent; }
+	uint32 GetNumBytesSentThisFlush() const { return BytesSent; }
+
+private:
+	struct FDeferredMessage
+	{
+		TUniquePtr<FOutgoingMessage> Message;
+		TOptional<Worker_EntityId> EntityId;
+		uint64 DeferredAtFlush;
+	};
+
+	bool HasBudget() const;
+	void SendMessage(FOutgoingMessage& Message, FSendFunction Send);
+	void Defer(TArray<FDeferredMessage>& Lane, FOutgoingMessage& Message, const TOptional<Worker_EntityId>& EntityId);
+
+	// Sends messages from the front of a lane while they are starved, or while there is budget if bRespectBudget is set.
+	void DrainLane(TArray<FDeferredMessage>& Lane, bool bRespectBudget, FSendFunction Send);
+
+	FOutgoingMessageBudget Budget;
+
+	TArray<FDeferredMessage> NormalLane;
+	TArray<FDeferredMessage> LowLane;
+
+	// Number of messages in NormalLane for each entity, so that later messages to those entities queue up behind them.
+	TMap<Worker_EntityId, int32> EntitiesWithDeferredMessages;
+
+	// Number of messages in NormalLane that are assigned a request id, so that later requests queue up behind them.
+	int32 NumDeferredRequests;
+
+	uint64 FlushCount;
+	uint32 MessagesSent;
+	uint32 BytesSent;
+};
+
+} // namespace SpatialGDK
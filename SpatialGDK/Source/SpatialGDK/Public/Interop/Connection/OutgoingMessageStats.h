@@ -0,0 +1,102 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "HAL/Platform.h"
+
+#include "Interop/Connection/OutgoingMessages.h"
+
+#include <WorkerSDK/improbable/c_worker.h>
+
+class FOutputDevice;
+
+namespace SpatialGDK
+{
+
+SPATIALGDK_API const TCHAR* GetOutgoingMessageTypeName(EOutgoingMessageType Type);
+
+// Log-linear histogram in the style of HdrHistogram. Values are grouped by their power of two, and each power of two is
+// split into SubBucketCount linear buckets, so a value is never off by more than 1 / SubBucketCount of itself.
+// Recording is O(1) and never allocates once the bucket for the largest value seen has been created.
+class SPATIALGDK_API FOutgoingMessageHistogram
+{
+public:
+	static constexpr uint32 SubBucketBits = 3;
+	static constexpr uint32 SubBucketCount = 1 << SubBucketBits;
+
+	void Record(uint64 Value);
+
+	// Removes the samples of an earlier copy of this histogram, leaving the samples recorded since.
+	void Subtract(const FOutgoingMessageHistogram& Earlier);
+
+	void Reset();
+
+	uint64 GetCount() const { return Count; }
+	uint64 GetSum() const { return Sum; }
+	uint64 GetMax() const { return Max; }
+
+	// Returns the highest value that is equivalent to the value at the given percentile (0-100).
+	uint64 GetValueAtPercentile(double Percentile) const;
+
+	// Exports the histogram with one bucket per power of two, up to 2^MaxExponent, and a last bucket for everything above.
+	HistogramMetric ToMetric(const std::string& Key, uint32 MaxExponent) const;
+
+	static uint32 GetBucketIndex(uint64 Value);
+	static uint64 GetBucketLowerBound(uint32 BucketIndex);
+
+private:
+	TArray<uint64> Buckets;
+	uint64 Count = 0;
+	uint64 Sum = 0;
+	uint64 Max = 0;
+};
+
+// Histograms of the outgoing traffic of a worker connection, per message type and per component for component updates.
+//
+// Queue latency is the time between a message being queued by the game thread and it being handed to the Worker SDK,
+// including any flushes it was deferred for. Send duration is the time the Worker SDK call itself took.
+// Latencies are in microseconds, payload sizes in bytes as estimated by GetOutgoingMessageSize.
+// Not thread safe, the owner is expected to synchronize recording with reading.
+class SPATIALGDK_API FOutgoingMessageStats
+{
+public:
+	static constexpr int32 NumMessageTypes = static_cast<int32>(EOutgoingMessageType::Metrics) + 1;
+
+	struct FMessageHistograms
+	{
+		FOutgoingMessageHistogram QueueLatencyMicros;
+		FOutgoingMessageHistogram SendDurationMicros;
+		FOutgoingMessageHistogram PayloadBytes;
+	};
+
+	FOutgoingMessageStats();
+
+	// SentCycles is the FPlatformTime::Cycles64() time the message was handed to the Worker SDK.
+	// Queue latency is skipped for messages queued while stats were disabled, which have no EnqueueCycles.
+	void RecordSentMessage(const FOutgoingMessage& Message, uint64 SentCycles, uint64 SendDurationCycles, uint32 PayloadBytes);
+
+	// As RecordSentMessage, for component updates that are sent once several queued updates have been coalesced into them.
+	// EnqueueCycles is that of the first of those updates.
+	void RecordSentComponentUpdate(Worker_ComponentId ComponentId, uint64 EnqueueCycles, uint64 SentCycles, uint64 SendDurationCycles, uint32 PayloadBytes);
+
+	void Subtract(const FOutgoingMessageStats& Earlier);
+	void Reset();
+
+	const FMessageHistograms& GetMessageHistograms(EOutgoingMessageType Type) const { return MessageHistograms[static_cast<int32>(Type)]; }
+	const TMap<Worker_ComponentId, FMessageHistograms>& GetComponentUpdateHistograms() const { return ComponentUpdateHistograms; }
+
+	// Appends one histogram metric per message type and component with samples, with keys such as
+	// "OutgoingMessages.ComponentUpdate.QueueLatencyMicros" and "OutgoingMessages.ComponentUpdate.1234.PayloadBytes".
+	void AppendHistogramMetrics(TArray<HistogramMetric>& OutMetrics) const;
+
+	// Writes a table of counts and percentiles to Ar.
+	void Dump(FOutputDevice& Ar) const;
+
+private:
+	TArray<FMessageHistograms> MessageHistograms;
+	TMap<Worker_ComponentId, FMessageHistograms> ComponentUpdateHistograms;
+};
+
+} // namespace SpatialGDK
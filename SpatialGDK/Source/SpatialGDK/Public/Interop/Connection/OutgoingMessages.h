@@ -9,10 +9,9 @@
 #include "Templates/UnrealTemplate.h"
 #include "Templates/UniquePtr.h"
 #include "UObject/NameTypes.h"
+#include "SpatialView/WorkerMetrics.h"
 #include "Utils/SpatialLatencyTracer.h"
 
-#include <string>
-
 #include <WorkerSDK/improbable/c_worker.h>
 
 namespace SpatialGDK
@@ -41,6 +40,8 @@ struct FOutgoingMessage
 	virtual ~FOutgoingMessage() {}
 
 	EOutgoingMessageType Type;
+	// FPlatformTime::Cycles64() when the message was queued, or 0 if outgoing message stats were disabled at the time.
+	uint64 EnqueueCycles = 0;
 };
 
 struct FReserveEntityIdsRequest : FOutgoingMessage
@@ -197,46 +198,6 @@ struct FEntityQueryRequest : FOutgoingMessage
 	TArray<Worker_ComponentId> ComponentIdStorage;
 };
 
-/** Parameters for a gauge metric. */
-struct GaugeMetric
-{
-	/* The name of the metric. */
-	std::string Key;
-	/* The current value of the metric. */
-	double Value;
-};
-
-/* Parameters for a histogram metric bucket. */
-struct HistogramMetricBucket
-{
-	/* The upper bound. */
-	double UpperBound;
-	/* The number of observations that were less than or equal to the upper bound. */
-	uint32 Samples;
-};
-
-/* Parameters for a histogram metric. */
-struct HistogramMetric
-{
-	/* The name of the metric. */
-	std::string Key;
-	/* The sum of all observations. */
-	double Sum;
-	/* Array of buckets. */
-	TArray<HistogramMetricBucket> Buckets;
-};
-
-/** Parameters for sending metrics to SpatialOS. */
-struct SpatialMetrics
-{
-	/** The load value of this worker. If NULL, do not report load. */
-	TOptional<double> Load;
-	/** Array of gauge metrics. */
-	TArray<GaugeMetric> GaugeMetrics;
-	/** Array of histogram metrics. */
-	TArray<HistogramMetric> HistogramMetrics;
-};
-
 struct FMetrics : FOutgoingMessage
 {
 	FMetrics(const SpatialMetrics& InMetrics)
@@ -247,4 +208,7 @@ struct FMetrics : FOutgoingMessage
 	SpatialMetrics Metrics;
 };
 
+// Destroys the schema objects a message owns. Only for messages that are dropped, as sending a message hands them over to the Worker SDK.
+SPATIALGDK_API void DestroyOutgoingMessageSchemaObjects(FOutgoingMessage& Message);
+
 }
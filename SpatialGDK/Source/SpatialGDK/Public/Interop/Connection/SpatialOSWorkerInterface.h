@@ -29,5 +29,17 @@ public:
 	virtual void SendComponentInterest(Worker_EntityId EntityId, TArray<Worker_InterestOverride>&& ComponentInterest) PURE_VIRTUAL(AbstractSpatialWorkerConnection::SendEntityQueryRequest, return;);
 	virtual Worker_RequestId SendEntityQueryRequest(const Worker_EntityQuery* EntityQuery) PURE_VIRTUAL(AbstractSpatialWorkerConnection::SendEntityQueryRequest, return 0;);
 	virtual void SendMetrics(const SpatialGDK::SpatialMetrics& Metrics) PURE_VIRTUAL(AbstractSpatialWorkerConnection::SendMetrics, return;);
+
+	virtual PhysicalWorkerName GetWorkerId() const PURE_VIRTUAL(AbstractSpatialWorkerConnection::GetWorkerId, return PhysicalWorkerName(););
+	virtual const TArray<FString>& GetWorkerAttributes() const PURE_VIRTUAL(AbstractSpatialWorkerConnection::GetWorkerAttributes, static const TArray<FString> NoAttributes; return NoAttributes;);
+
+	// Called once the ops of a list returned by GetOpList have been processed. Op lists come from the Worker SDK unless a
+	// connection says otherwise.
+	virtual void DestroyOpList(Worker_OpList* OpList) { Worker_OpList_Destroy(OpList); }
+
+	// Connections that exchange ops and messages with SpatialOS on a thread of their own do it in these instead when
+	// bRunSpatialWorkerConnectionOnGameThread is set. The net driver calls them once per tick.
+	virtual void QueueLatestOpList() {}
+	virtual void ProcessOutgoingMessages() {}
 };
 
@@ -3,12 +3,20 @@
 #pragma once
 
 #include "Containers/Queue.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/Event.h"
 #include "HAL/Runnable.h"
 #include "HAL/ThreadSafeBool.h"
+#include "Templates/Atomic.h"
 
 #include "Interop/Connection/SpatialOSWorkerInterface.h"
+#include "Interop/Connection/OutgoingMessageQueue.h"
+#include "Interop/Connection/OutgoingMessageScheduler.h"
+#include "Interop/Connection/OutgoingMessageStats.h"
 #include "Interop/Connection/OutgoingMessages.h"
+#include "Interop/Connection/OpListRecorder.h"
 #include "SpatialCommonTypes.h"
+#include "SpatialView/EntityComponentId.h"
 #include "UObject/WeakObjectPtr.h"
 
 #include <WorkerSDK/improbable/c_schema.h>
@@ -24,6 +32,7 @@ class SPATIALGDK_API USpatialWorkerConnection : public UObject, public FRunnable
 	GENERATED_BODY()
 
 public:
+	virtual void PostInitProperties() override;
 	void SetConnection(Worker_Connection* WorkerConnectionIn);
 	virtual void FinishDestroy() override;
 	void DestroyConnection();
@@ -44,8 +53,8 @@ public:
 	virtual Worker_RequestId SendEntityQueryRequest(const Worker_EntityQuery* EntityQuery) override;
 	virtual void SendMetrics(const SpatialGDK::SpatialMetrics& Metrics) override;
 
-	PhysicalWorkerName GetWorkerId() const;
-	const TArray<FString>& GetWorkerAttributes() const;
+	virtual PhysicalWorkerName GetWorkerId() const override;
+	virtual const TArray<FString>& GetWorkerAttributes() const override;
 
 	DECLARE_MULTICAST_DELEGATE_OneParam(FOnEnqueueMessage, const SpatialGDK::FOutgoingMessage*);
 	FOnEnqueueMessage OnEnqueueMessage;
@@ -53,8 +62,23 @@ public:
 	DECLARE_MULTICAST_DELEGATE_OneParam(FOnDequeueMessage, const SpatialGDK::FOutgoingMessage*);
 	FOnDequeueMessage OnDequeueMessage;
 
-	void QueueLatestOpList();
-	void ProcessOutgoingMessages();
+	// Moves the latest op list from the Worker SDK into the op list queue, without waiting for ops to arrive.
+	virtual void QueueLatestOpList() override;
+	virtual void ProcessOutgoingMessages() override;
+
+	// Records every op list returned by GetOpList to Filename, for offline replay with SpatialGDK::FOpListReplayer.
+	bool StartRecordingOpLists(const FString& Filename);
+	void StopRecordingOpLists();
+	bool IsRecordingOpLists() const { return OpListRecorder.IsValid(); }
+
+	uint32 GetOutgoingMessageQueueDepth() const;
+	uint32 GetOutgoingMessageQueueStallCount() const;
+
+	// Tracks queue latency, send duration and payload size of outgoing messages, see SpatialGDK::FOutgoingMessageStats.
+	void SetTrackOutgoingMessageStats(bool bTrack);
+	bool IsTrackingOutgoingMessageStats() const { return bTrackOutgoingMessageStats; }
+	SpatialGDK::FOutgoingMessageStats GetOutgoingMessageStats() const;
+	void ResetOutgoingMessageStats();
 
 private:
 	void CacheWorkerAttributes();
@@ -70,6 +94,17 @@ private:
 	template <typename T, typename... ArgsType>
 	void QueueOutgoingMessage(ArgsType&&... Args);
 
+	// Hands a single message over to the Worker SDK, or holds it back if it is a component update to be coalesced.
+	void SendOutgoingMessage(SpatialGDK::FOutgoingMessage* OutgoingMessage);
+
+	// Holds back a component update so that later updates to the same entity-component can be merged into it.
+	void CoalesceComponentUpdate(Worker_EntityId EntityId, const FWorkerComponentUpdate& Update, uint64 EnqueueCycles);
+	// Sends the held back updates, charging them to the flush budget and recording their stats as they are handed to the Worker SDK.
+	void SendCoalescedComponentUpdates();
+
+	// Destroys every message that was queued, deferred or held back but not sent, along with the schema objects it owns.
+	void DropOutgoingMessages();
+
 private:
 	Worker_Connection* WorkerConnection;
 
@@ -78,9 +113,40 @@ private:
 	FRunnableThread* OpsProcessingThread;
 	FThreadSafeBool KeepRunning = true;
 	float OpsUpdateInterval;
+	bool bWakeOnOutgoingMessage;
+	uint32 OpsPollIntervalMillis;
+
+	// Only created when the ops thread wakes on send. Triggered when a message is added to an empty OutgoingMessagesQueue, to wake it up.
+	FEvent* OutgoingMessageQueuedEvent = nullptr;
 
 	TQueue<Worker_OpList*> OpListQueue;
-	TQueue<TUniquePtr<SpatialGDK::FOutgoingMessage>> OutgoingMessagesQueue;
+	TUniquePtr<SpatialGDK::FOutgoingMessageQueue> OutgoingMessagesQueue;
+	// Number of times a Send call found the outgoing queue full and had to wait for it to drain.
+	TAtomic<uint32> OutgoingMessageQueueStalls;
+	// Applies the per flush budget to messages taken off OutgoingMessagesQueue. Only used on the thread processing outgoing messages.
+	TUniquePtr<SpatialGDK::FOutgoingMessageScheduler> OutgoingMessageScheduler;
+
+	struct FCoalescedComponentUpdate
+	{
+		Worker_EntityId EntityId;
+		FWorkerComponentUpdate Update;
+		// Of the first update coalesced into this one.
+		uint64 EnqueueCycles;
+	};
+
+	// Component updates dequeued since the last message of any other type, in the order they were first seen.
+	// Only used on the thread processing outgoing messages.
+	bool bCoalesceComponentUpdates;
+	TArray<FCoalescedComponentUpdate> CoalescedComponentUpdates;
+	TMap<SpatialGDK::EntityComponentId, int32> CoalescedComponentUpdateIndices;
+
+	TUniquePtr<SpatialGDK::FOpListRecorder> OpListRecorder;
+
+	// Written on the game thread by SetConnection and SetTrackOutgoingMessageStats, read when messages are queued and by the thread
+	// processing outgoing messages. Messages in flight when it changes are recorded or not, so no other state is synchronised with it.
+	TAtomic<bool> bTrackOutgoingMessageStats{ false };
+	SpatialGDK::FOutgoingMessageStats OutgoingMessageStats;
+	mutable FCriticalSection OutgoingMessageStatsMutex;
 
 	// RequestIds per worker connection start at 0 and incrementally go up each command sent.
 	Worker_RequestId NextRequestId = 0;
@@ -0,0 +1,187 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Templates/UniquePtr.h"
+
+#include "Schema/Component.h"
+#include "SpatialCommonTypes.h"
+#include "SpatialConstants.h"
+
+#include <WorkerSDK/improbable/c_worker.h>
+
+namespace SpatialGDK
+{
+
+// Fixed size slots for the components of one type. Slots are allocated in slabs, so components of the same type sit
+// next to each other in memory and adding or removing them only allocates when every slab is full.
+class SPATIALGDK_API FComponentSlabPool
+{
+public:
+	FComponentSlabPool(uint32 InSlotSize, uint32 InSlotAlignment);
+	~FComponentSlabPool();
+
+	FComponentSlabPool(const FComponentSlabPool&) = delete;
+	FComponentSlabPool& operator=(const FComponentSlabPool&) = delete;
+
+	void* Allocate();
+	void Free(void* Slot);
+
+	int32 GetNumAllocated() const { return NumAllocated; }
+	int32 GetNumSlabs() const { return Slabs.Num(); }
+
+private:
+	static constexpr uint32 SlotsPerSlab = 64;
+
+	void AddSlab();
+
+	uint32 SlotSize;
+	uint32 SlotAlignment;
+	TArray<void*> Slabs;
+	// Free slots are linked through their first bytes.
+	void* FreeList;
+	int32 NumAllocated;
+};
+
+// Components and authority of the entities in view, in a single open addressing table keyed by entity and component id.
+//
+// An entry holds whether the component is present, the worker's authority over it and, for components with a
+// handwritten schema type, the component itself, so looking any of them up is a single probe sequence in one array.
+// Components are constructed in a slab pool per component id. Entries are removed with backward shift deletion,
+// so lookups never have to step over tombstones.
+class SPATIALGDK_API FEntityComponentStore
+{
+public:
+	FEntityComponentStore();
+	~FEntityComponentStore();
+
+	FEntityComponentStore(const FEntityComponentStore&) = delete;
+	FEntityComponentStore& operator=(const FEntityComponentStore&) = delete;
+
+	// Returns null if the component is not present, or has no handwritten schema type.
+	FORCEINLINE Component* FindComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const
+	{
+		const int32 Index = FindIndex(EntityId, ComponentId);
+		return Index != INDEX_NONE ? Entries[Index].Data : nullptr;
+	}
+
+	FORCEINLINE bool HasComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const
+	{
+		const int32 Index = FindIndex(EntityId, ComponentId);
+		return Index != INDEX_NONE && Entries[Index].bHasComponent;
+	}
+
+	FORCEINLINE Worker_Authority GetAuthority(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const
+	{
+		const int32 Index = FindIndex(EntityId, ComponentId);
+		return Index != INDEX_NONE ? static_cast<Worker_Authority>(Entries[Index].Authority) : WORKER_AUTHORITY_NOT_AUTHORITATIVE;
+	}
+
+	// Adds a component of a handwritten schema type, replacing any existing one.
+	template <typename T>
+	void AddComponent(Worker_EntityId EntityId, const Worker_ComponentData& Data)
+	{
+		FComponentSlabPool& Pool = *FindOrAddComponentType(T::ComponentId, sizeof(T), alignof(T), &CopyConstructComponent<T>).Pool;
+		SetComponent(EntityId, T::ComponentId, new (Pool.Allocate()) T(Data));
+	}
+
+	// Records the presence of a component that has no handwritten schema type.
+	void AddComponentWithoutData(Worker_EntityId EntityId, Worker_ComponentId ComponentId);
+
+	// Authority outlives the component, until it changes or the entity is removed.
+	void RemoveComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId);
+	void SetAuthority(Worker_EntityId EntityId, Worker_ComponentId ComponentId, Worker_Authority Authority);
+	void RemoveEntity(Worker_EntityId EntityId);
+
+	// Makes the entry for an entity's component match the one in Source, copying the component data if there is any.
+	void CopyEntryFrom(const FEntityComponentStore& Source, Worker_EntityId EntityId, Worker_ComponentId ComponentId);
+
+	void GetEntityIds(TArray<Worker_EntityId_Key>& OutEntityIds) const { EntityComponentIds.GetKeys(OutEntityIds); }
+	// The components with an entry for the entity, whether present or only with authority, or null if there are none.
+	const TArray<Worker_ComponentId>* GetEntityComponentIds(Worker_EntityId EntityId) const { return EntityComponentIds.Find(EntityId); }
+
+private:
+	using FCopyConstructFunction = Component* (*)(void* Slot, const Component& Source);
+
+	template <typename T>
+	static Component* CopyConstructComponent(void* Slot, const Component& Source)
+	{
+		return new (Slot) T(static_cast<const T&>(Source));
+	}
+
+	struct FComponentType
+	{
+		TUniquePtr<FComponentSlabPool> Pool;
+		FCopyConstructFunction CopyConstruct;
+		uint32 Size;
+		uint32 Alignment;
+	};
+
+	struct FEntry
+	{
+		// INVALID_ENTITY_ID for an empty slot.
+		Worker_EntityId EntityId;
+		Worker_ComponentId ComponentId;
+		uint8 Authority;
+		bool bHasComponent;
+		Component* Data;
+	};
+
+	static constexpr int32 MinCapacity = 256;
+
+	static FORCEINLINE uint32 HashKey(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+	{
+		// Entity ids are mostly sequential and there are few component ids, so both are mixed through a 64 bit finalizer.
+		uint64 Key = (static_cast<uint64>(EntityId) * 0x9E3779B97F4A7C15ull) ^ ComponentId;
+		Key ^= Key >> 33;
+		Key *= 0xff51afd7ed558ccdull;
+		Key ^= Key >> 33;
+		return static_cast<uint32>(Key);
+	}
+
+	FORCEINLINE int32 FindIndex(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const
+	{
+		if (Entries.Num() == 0)
+		{
+			return INDEX_NONE;
+		}
+
+		const uint32 Mask = Entries.Num() - 1;
+		for (uint32 Index = HashKey(EntityId, ComponentId) & Mask;; Index = (Index + 1) & Mask)
+		{
+			const FEntry& Entry = Entries[Index];
+			if (Entry.EntityId == SpatialConstants::INVALID_ENTITY_ID)
+			{
+				return INDEX_NONE;
+			}
+			if (Entry.EntityId == EntityId && Entry.ComponentId == ComponentId)
+			{
+				return Index;
+			}
+		}
+	}
+
+	int32 FindOrAddIndex(Worker_EntityId EntityId, Worker_ComponentId ComponentId);
+	// Destroys the entry at Index and forgets it for its entity.
+	void RemoveEntry(int32 Index);
+	// Removes the entry at Index, shifting back the entries after it in its probe sequence.
+	void RemoveAt(int32 Index);
+	void Grow();
+
+	FComponentType& FindOrAddComponentType(Worker_ComponentId ComponentId, uint32 Size, uint32 Alignment, FCopyConstructFunction CopyConstruct);
+	void SetComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId, Component* Data);
+	void DestroyComponentData(FEntry& Entry);
+
+	// Power of two sized, at most half full.
+	TArray<FEntry> Entries;
+	int32 NumEntries;
+
+	TMap<Worker_ComponentId, FComponentType> ComponentTypes;
+
+	// The components with an entry per entity, so removing an entity doesn't have to search the table.
+	TMap<Worker_EntityId_Key, TArray<Worker_ComponentId>> EntityComponentIds;
+};
+
+} // namespace SpatialGDK
@@ -0,0 +1,89 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Misc/Optional.h"
+#include "Templates/Function.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/SoftObjectPtr.h"
+#include "UObject/WeakObjectPtr.h"
+
+#include "SpatialCommonTypes.h"
+
+class AActor;
+class UClass;
+
+namespace SpatialGDK
+{
+
+// Actors of entities that left a client's view and are kept for a while, in case their entity comes back into view.
+//
+// Each class lingers for the time configured for it or for its closest configured parent class, see
+// USpatialGDKSettings::ActorRemovalLingerSeconds. This only tracks which entities are lingering and until when: the receiver
+// keeps their actor channels, removes the actors whose time is up and restores those whose entity comes back.
+class SPATIALGDK_API FLingeringActors
+{
+public:
+	FLingeringActors();
+
+	// InClock returns the current time in seconds, FPlatformTime::Seconds if not set.
+	void Init(const TMap<TSoftClassPtr<AActor>, float>& LingerSecondsByClass, TFunction<double()> InClock = nullptr);
+
+	FLingeringActors(const FLingeringActors&) = delete;
+	FLingeringActors& operator=(const FLingeringActors&) = delete;
+
+	// Whether any class is configured to linger at all.
+	bool HasLingeringClasses() const { return LingerSecondsByClassPath.Num() > 0; }
+
+	// Returns how long actors of the class are kept, or 0 if they are removed straight away.
+	float GetLingerSeconds(UClass* Class);
+
+	// Starts keeping the actor of an entity that left the view. Returns false if actors of its class don't linger.
+	bool StartLingering(Worker_EntityId EntityId, AActor* Actor);
+
+	bool IsLingering(Worker_EntityId EntityId) const { return LingeringActors.Contains(EntityId); }
+
+	// Stops an entity lingering, because it came back into view. Returns its actor, or null if the actor was destroyed
+	// while out of view or the entity wasn't lingering.
+	AActor* StopLingering(Worker_EntityId EntityId);
+
+	// Stops every entity whose time is up lingering and returns them, so that their actors can be removed.
+	TArray<Worker_EntityId> TakeExpired();
+
+	// Seconds until the next entity's time is up, unset if no entity is lingering.
+	TOptional<double> GetSecondsUntilNextExpiry() const;
+
+	int32 Num() const { return LingeringActors.Num(); }
+
+private:
+	struct FLingeringActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		double ExpiryTime;
+	};
+
+	struct FExpiry
+	{
+		Worker_EntityId EntityId;
+		double ExpiryTime;
+
+		bool operator<(const FExpiry& Other) const { return ExpiryTime < Other.ExpiryTime; }
+	};
+
+	bool IsStale(const FExpiry& Expiry) const;
+	// Pops expiries of entities that stopped lingering, so that the top of ExpiryHeap is always the next entity to expire.
+	void DiscardStaleExpiries();
+
+	TFunction<double()> Clock;
+
+	TMap<FSoftObjectPath, float> LingerSecondsByClassPath;
+	TMap<TWeakObjectPtr<UClass>, float> LingerSecondsByClass;
+
+	TMap<Worker_EntityId_Key, FLingeringActor> LingeringActors;
+	// Min-heap of expiry times. Entities that stop lingering are left in it and skipped once they reach the top.
+	TArray<FExpiry> ExpiryHeap;
+};
+
+} // namespace SpatialGDK
@@ -0,0 +1,71 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Templates/Function.h"
+
+#include "SpatialConstants.h"
+
+#include <WorkerSDK/improbable/c_worker.h>
+
+namespace SpatialGDK
+{
+
+// User callbacks for ops on external schema components, keyed by component id and op type.
+//
+// Each component id in the external schema range has a fixed slot in a directly indexed table, so finding the callbacks
+// for an op costs the same however many components have callbacks registered. Components get their block of per op
+// type callback lists the first time a callback is registered for them.
+class SPATIALGDK_API FOpCallbackTable
+{
+public:
+	using FCallbackId = uint32;
+	using FOpCallback = TFunction<void(const Worker_Op*)>;
+
+	FOpCallbackTable();
+
+	static bool IsSupportedComponent(Worker_ComponentId ComponentId);
+	// Ops that refer to a component: add, remove, update, authority change, command request and command response.
+	static bool IsSupportedOpType(Worker_OpType OpType);
+
+	FCallbackId Add(Worker_ComponentId ComponentId, Worker_OpType OpType, FOpCallback Callback);
+	bool Remove(FCallbackId Id);
+
+	// Runs the callbacks registered for ComponentId and the type of Op, in the order they were added.
+	// Callbacks must not be added or removed from within a callback.
+	void Invoke(Worker_ComponentId ComponentId, const Worker_Op* Op) const;
+
+private:
+	static constexpr int32 NumComponents = SpatialConstants::MAX_EXTERNAL_SCHEMA_ID - SpatialConstants::MIN_EXTERNAL_SCHEMA_ID + 1;
+	static constexpr int32 NumOpTypes = 6;
+
+	static int32 GetOpTypeIndex(Worker_OpType OpType);
+
+	struct FCallbackData
+	{
+		FCallbackId Id;
+		FOpCallback Callback;
+	};
+
+	struct FComponentCallbacks
+	{
+		TArray<FCallbackData> ByOpType[NumOpTypes];
+	};
+
+	struct FCallbackLocation
+	{
+		int32 BlockIndex;
+		int32 OpTypeIndex;
+	};
+
+	// Index into ComponentBlocks for each component id, offset by MIN_EXTERNAL_SCHEMA_ID, or INDEX_NONE.
+	TArray<int32> ComponentBlockIndices;
+	TArray<FComponentCallbacks> ComponentBlocks;
+
+	TMap<FCallbackId, FCallbackLocation> CallbackLocations;
+	FCallbackId NextCallbackId;
+};
+
+} // namespace SpatialGDK
@@ -81,6 +81,12 @@ struct FClassInfo
 class SpatialActorGroupManager;
 class USpatialNetDriver;
 
+namespace SpatialGDK
+{
+class FPropertyApplyPlan;
+class FPropertySerializationPlan;
+}
+
 DECLARE_LOG_CATEGORY_EXTERN(LogSpatialClassInfoManager, Log, All)
 
 UCLASS()
@@ -104,6 +110,13 @@ public:
 	const FClassInfo& GetOrCreateClassInfoByObject(UObject* Object);
 	const FClassInfo& GetClassInfoByComponentId(Worker_ComponentId ComponentId);
 
+	// Returns the plan ComponentFactory writes the properties of the class with, building it on first use. Null if the class is gone.
+	const SpatialGDK::FPropertySerializationPlan* GetOrCreateSerializationPlan(const FClassInfo& Info);
+
+	// Returns the plan ComponentReader reads the properties of a data, owner only or handover component with, building it on
+	// first use. Null for other components, or if their class is gone.
+	const SpatialGDK::FPropertyApplyPlan* GetOrCreateApplyPlan(Worker_ComponentId ComponentId);
+
 	UClass* GetClassByComponentId(Worker_ComponentId ComponentId);
 	bool GetOffsetByComponentId(Worker_ComponentId ComponentId, uint32& OutOffset);
 	ESchemaComponentType GetCategoryByComponentId(Worker_ComponentId ComponentId);
@@ -153,4 +166,6 @@ private:
 	TMap<Worker_ComponentId, TSharedRef<FClassInfo>> ComponentToClassInfoMap;
 	TMap<Worker_ComponentId, uint32> ComponentToOffsetMap;
 	TMap<Worker_ComponentId, ESchemaComponentType> ComponentToCategoryMap;
+	TMap<TWeakObjectPtr<UClass>, TSharedRef<const SpatialGDK::FPropertySerializationPlan>> SerializationPlanMap;
+	TMap<Worker_ComponentId, TSharedRef<const SpatialGDK::FPropertyApplyPlan>> ComponentToApplyPlanMap;
 };
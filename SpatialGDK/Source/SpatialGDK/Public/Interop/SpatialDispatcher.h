@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 
+#include "Interop/OpCallbackTable.h"
 #include "Schema/Component.h"
 #include "Schema/StandardLibrary.h"
 #include "Schema/UnrealMetadata.h"
@@ -23,10 +24,13 @@ class USpatialWorkerFlags;
 class SPATIALGDK_API SpatialDispatcher
 {
 public:
-	using FCallbackId = uint32;
+	using FCallbackId = SpatialGDK::FOpCallbackTable::FCallbackId;
 
 	void Init(USpatialReceiver* InReceiver, USpatialStaticComponentView* InStaticComponentView, USpatialMetrics* InSpatialMetrics, USpatialWorkerFlags* InSpatialWorkerFlags);
 	void ProcessOps(Worker_OpList* OpList);
+	// ProcessOps without flushing the receiver, for callers that dispatch several op lists before flushing once.
+	void DispatchOps(Worker_OpList* OpList);
+	void FlushReceiverQueues();
 
 	// The following 2 methods should *only* be used by the Startup OpList Queueing flow
 	// from the SpatialNetDriver, and should be temporary since an alternative solution will be available via the Worker SDK soon.
@@ -45,24 +49,8 @@ public:
 	bool RemoveOpCallback(FCallbackId Id);
 
 private:
-	struct UserOpCallbackData
-	{
-		FCallbackId Id;
-		TFunction<void(const Worker_Op*)> Callback;
-	};
-
-	struct CallbackIdData
-	{
-		Worker_ComponentId ComponentId;
-		Worker_OpType OpType;
-	};
-
-	using OpTypeToCallbacksMap = TMap<Worker_OpType, TArray<UserOpCallbackData>>;
-
-	bool IsExternalSchemaOp(Worker_Op* Op) const;
-	void ProcessExternalSchemaOp(Worker_Op* Op);
+	void ProcessExternalSchemaOp(Worker_ComponentId ComponentId, Worker_Op* Op);
 	FCallbackId AddGenericOpCallback(Worker_ComponentId ComponentId, Worker_OpType OpType, const TFunction<void(const Worker_Op*)>& Callback);
-	void RunCallbacks(Worker_ComponentId ComponentId, const Worker_Op* Op);
 
 	TWeakObjectPtr<USpatialReceiver> Receiver;
 	TWeakObjectPtr<USpatialStaticComponentView> StaticComponentView;
@@ -71,12 +59,8 @@ private:
 	UPROPERTY()
 	USpatialWorkerFlags* SpatialWorkerFlags;
 
-	// This index is incremented and returned every time an AddOpCallback function is called.
-	// CallbackIds enable you to deregister callbacks using the RemoveOpCallback function. 
-	// RunCallbacks is called by the SpatialDispatcher and executes all user registered 
-	// callbacks for the matching component ID and network operation type.
-	FCallbackId NextCallbackId;
-	TMap<Worker_ComponentId, OpTypeToCallbacksMap> ComponentOpTypeToCallbacksMap;
-	TMap<FCallbackId, CallbackIdData> CallbackIdToDataMap;
-	TArray<const Worker_Op*> OpsToSkip;
+	// Executes all user registered callbacks for the matching component ID and network operation type.
+	// Lookups are direct array indexing, so dispatch cost doesn't depend on how many callbacks are registered.
+	SpatialGDK::FOpCallbackTable Callbacks;
+	TSet<const Worker_Op*> OpsToSkip;
 };
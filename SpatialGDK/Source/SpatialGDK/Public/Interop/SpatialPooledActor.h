@@ -0,0 +1,33 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+
+#include "SpatialPooledActor.generated.h"
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class USpatialPooledActor : public UInterface
+{
+	GENERATED_BODY()
+};
+
+// Actor classes listed in USpatialGDKSettings::PooledActorClasses are only pooled if they implement this interface.
+//
+// A pooled actor is reused for another entity without EndPlay or BeginPlay being called, and its actor channel only
+// replicates the new entity's replicated properties onto it. Everything else the actor set up in BeginPlay or changed
+// during its previous life, such as timers, bound delegates, spawned effects and non-replicated properties, has to be
+// cleaned up or reset by these hooks.
+class SPATIALGDK_API ISpatialPooledActor
+{
+	GENERATED_BODY()
+
+public:
+	// Called once the actor has been parked in the pool, hidden and with collision and ticking disabled.
+	virtual void OnParkedInPool() = 0;
+
+	// Called when the actor is taken out of the pool for a new entity, after it has been moved to its spawn transform
+	// and before the entity's replicated state is applied. Does the work BeginPlay would do for a newly spawned actor.
+	virtual void OnTakenFromPool() = 0;
+};
@@ -7,6 +7,7 @@
 #include "EngineClasses/SpatialActorChannel.h"
 #include "EngineClasses/SpatialNetDriver.h"
 #include "EngineClasses/SpatialPackageMapClient.h"
+#include "Interop/LingeringActors.h"
 #include "Interop/SpatialClassInfoManager.h"
 #include "Interop/SpatialOSDispatcherInterface.h"
 #include "Interop/SpatialRPCService.h"
@@ -17,6 +18,7 @@
 #include "Schema/StandardLibrary.h"
 #include "Schema/UnrealObjectRef.h"
 #include "SpatialCommonTypes.h"
+#include "Utils/IncomingRPCScheduler.h"
 #include "Utils/RPCContainer.h"
 
 #include <WorkerSDK/improbable/c_schema.h>
@@ -97,9 +99,43 @@ private:
 	void EnterCriticalSection();
 	void LeaveCriticalSection();
 
-	void ReceiveActor(Worker_EntityId EntityId);
+	// Actors received in the same critical section with the same class, which is found and has its info looked up once for all of them.
+	struct FReceivedActorGroup
+	{
+		FString ClassPath;
+		UClass* Class = nullptr;
+		const FClassInfo* ClassInfo = nullptr;
+		TArray<Worker_EntityId> EntityIds;
+	};
+
+	// A received actor whose BeginPlay is deferred until all actors received with it have been set up.
+	struct FReceivedActor
+	{
+		Worker_EntityId EntityId;
+		AActor* Actor;
+		USpatialActorChannel* Channel;
+	};
+
+	void ReceiveActors(const TArray<Worker_EntityId>& EntityIds);
+	// Returns whether the entity's actor already exists on this worker, e.g. because this worker spawned it.
+	bool ReceiveExistingActor(Worker_EntityId EntityId);
+	void ReceiveActor(Worker_EntityId EntityId, const FClassInfo& ActorClassInfo, const TArray<PendingAddComponentWrapper*>& EntityPendingAddComponents, TArray<FReceivedActor>& OutReceivedActors);
+	void FinishReceivingActor(const FReceivedActor& ReceivedActor);
 	void DestroyActor(AActor* Actor, Worker_EntityId EntityId);
 
+	// Keeps the actor of an entity that left the view for its class's linger time, returns false if it should be removed now.
+	bool TryLingerActor(Worker_EntityId EntityId);
+	// Sets the linger timer to fire when the next lingering actor's time is up.
+	void ScheduleLingeringActorExpiry();
+	void OnLingeringActorsExpired();
+	// Stops the removal timer of an entity that came back into view and returns its actor. Returns null if its actor didn't survive,
+	// in which case it is cleaned up so the entity can be received like any other.
+	AActor* StopLingering(Worker_EntityId EntityId);
+	// Applies the state of an entity that came back into view to its lingering actor, as returned by StopLingering.
+	void RestoreLingeringActor(Worker_EntityId EntityId, AActor& Actor, const TArray<PendingAddComponentWrapper*>& EntityPendingAddComponents);
+
+	// Whether the actor of a removed entity can be parked in the actor pool instead of being destroyed.
+	bool CanParkActor(AActor* Actor, const USpatialActorChannel& Channel) const;
 	AActor* TryGetOrCreateActor(SpatialGDK::UnrealMetadata* UnrealMetadata, SpatialGDK::SpawnData* SpawnData, SpatialGDK::NetOwningClientWorker* NetOwningClientWorkerData);
 	AActor* CreateActor(SpatialGDK::UnrealMetadata* UnrealMetadata, SpatialGDK::SpawnData* SpawnData, SpatialGDK::NetOwningClientWorker* NetOwningClientWorkerData);
 
@@ -124,12 +160,12 @@ private:
 
 	void ApplyComponentUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject& TargetObject, USpatialActorChannel& Channel, bool bIsHandover);
 
-	FRPCErrorInfo ApplyRPC(const FPendingRPCParams& Params);
-	ERPCResult ApplyRPCInternal(UObject* TargetObject, UFunction* Function, const SpatialGDK::RPCPayload& Payload, const FString& SenderWorkerId, bool bApplyWithUnresolvedRefs = false);
+	FRPCErrorInfo ApplyRPC(const FPendingRPCParams& Params, TSet<FUnrealObjectRef>& OutUnresolvedRefs);
+	ERPCResult ApplyRPCInternal(UObject* TargetObject, UFunction* Function, const SpatialGDK::RPCPayload& Payload, const FString& SenderWorkerId, bool bApplyWithUnresolvedRefs = false, TSet<FUnrealObjectRef>* OutUnresolvedRefs = nullptr);
 
 	void ReceiveCommandResponse(const Worker_CommandResponseOp& Op);
 
-	bool IsReceivedEntityTornOff(Worker_EntityId EntityId);
+	bool IsReceivedEntityTornOff(const TArray<PendingAddComponentWrapper*>& EntityPendingAddComponents);
 
 	void ProcessOrQueueIncomingRPC(const FUnrealObjectRef& InTargetObjectRef, SpatialGDK::RPCPayload InPayload);
 
@@ -225,7 +261,7 @@ private:
 	// Useful to manage entities going in and out of interest, in order to recover references to actors.
 	FObjectToRepStateMap ObjectRefToRepStateMap;
 
-	FRPCContainer IncomingRPCs{ ERPCQueueType::Receive };
+	SpatialGDK::FIncomingRPCScheduler IncomingRPCs;
 
 	bool bInCriticalSection;
 	TArray<Worker_EntityId> PendingAddActors;
@@ -246,6 +282,10 @@ private:
 	TMap<Worker_EntityId_Key, TWeakObjectPtr<USpatialNetConnection>> AuthorityPlayerControllerConnectionMap;
 
 	TMap<TPair<Worker_EntityId_Key, Worker_ComponentId>, PendingAddComponentWrapper> PendingDynamicSubobjectComponents;
+
+	// Entities that left the view whose actor is kept for a while in case they come back, and the timer that removes the actors.
+	SpatialGDK::FLingeringActors LingeringActors;
+	FTimerHandle LingeringActorsTimerHandle;
 	TMap<Worker_EntityId_Key, FString> WorkerConnectionEntities;
 
 	// TODO: Refactor into a separate class so we can add automated tests for this. UNR-2649
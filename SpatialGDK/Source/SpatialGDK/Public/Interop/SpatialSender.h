@@ -28,7 +28,7 @@ class USpatialReceiver;
 class USpatialStaticComponentView;
 class USpatialClassInfoManager;
 class SpatialActorGroupManager;
-class USpatialWorkerConnection;
+class SpatialOSWorkerInterface;
 
 struct FReliableRPCForRetry
 {
@@ -164,8 +164,7 @@ private:
 	UPROPERTY()
 	USpatialStaticComponentView* StaticComponentView;
 
-	UPROPERTY()
-	USpatialWorkerConnection* Connection;
+	SpatialOSWorkerInterface* Connection;
 
 	UPROPERTY()
 	USpatialReceiver* Receiver;
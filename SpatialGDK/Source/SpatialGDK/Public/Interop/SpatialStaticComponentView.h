@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "Interop/ComponentViewSnapshot.h"
+#include "Interop/EntityComponentStore.h"
 #include "Schema/Component.h"
 #include "Schema/StandardLibrary.h"
 #include "SpatialConstants.h"
@@ -9,8 +11,7 @@
 #include <WorkerSDK/improbable/c_schema.h>
 #include <WorkerSDK/improbable/c_worker.h>
 
-#include "Containers/Map.h"
-#include "Templates/UniquePtr.h"
+#include "Templates/SharedPointer.h"
 #include "UObject/Object.h"
 
 #include "SpatialStaticComponentView.generated.h"
@@ -26,15 +27,7 @@ public:
 	template <typename T>
 	T* GetComponentData(Worker_EntityId EntityId) const
 	{
-		if (const auto* ComponentStorageMap = EntityComponentMap.Find(EntityId))
-		{
-			if (const TUniquePtr<SpatialGDK::Component>* Component = ComponentStorageMap->Find(T::ComponentId))
-			{
-				return static_cast<T*>(Component->Get());
-			}
-		}
-
-		return nullptr;
+		return static_cast<T*>(Store.FindComponent(EntityId, T::ComponentId));
 	}
 
 	bool HasComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const;
@@ -45,11 +38,19 @@ public:
 	void OnComponentUpdate(const Worker_ComponentUpdateOp& Op);
 	void OnAuthorityChange(const Worker_AuthorityChangeOp& Op);
 
-	void GetEntityIds(TArray<Worker_EntityId_Key>& OutEntityIds) const { EntityComponentMap.GetKeys(OutEntityIds); }
+	void GetEntityIds(TArray<Worker_EntityId_Key>& OutEntityIds) const { Store.GetEntityIds(OutEntityIds); }
+
+	// Starts tracking changes so that read-only snapshots of the view can be published for other threads.
+	void EnableSnapshots();
+	// Publishes the changes since the last call to the snapshots, if they are enabled. Called once per frame.
+	void PublishSnapshot();
+	// Null unless snapshots are enabled. Readers on other threads should keep the shared pointer for as long as they
+	// may acquire snapshots from it.
+	TSharedPtr<SpatialGDK::FComponentViewSnapshots, ESPMode::ThreadSafe> GetSnapshots() const { return Snapshots; }
 
 private:
-	Worker_Authority GetAuthority(Worker_EntityId EntityId, Worker_ComponentId ComponentId) const;
+	void MarkChanged(Worker_EntityId EntityId, Worker_ComponentId ComponentId);
 
-	TMap<Worker_EntityId_Key, TMap<Worker_ComponentId, Worker_Authority>> EntityComponentAuthorityMap;
-	TMap<Worker_EntityId_Key, TMap<Worker_ComponentId, TUniquePtr<SpatialGDK::Component>>> EntityComponentMap;
+	SpatialGDK::FEntityComponentStore Store;
+	TSharedPtr<SpatialGDK::FComponentViewSnapshots, ESPMode::ThreadSafe> Snapshots;
 };
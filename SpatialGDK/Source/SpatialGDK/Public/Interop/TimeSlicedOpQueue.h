@@ -0,0 +1,113 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/Set.h"
+#include "HAL/PlatformTime.h"
+#include "Templates/Function.h"
+
+#include <WorkerSDK/improbable/c_worker.h>
+
+namespace SpatialGDK
+{
+
+// Queued op lists that are processed a slice at a time, so a large checkout is spread over several frames.
+//
+// Ops are processed in the order they were received, in chunks of a few ops at a time until the frame's budget is used
+// up. A critical section is never split by the budget, as the receiver expects to see it in full, and neither are the
+// remove component ops of an entity leaving view and its RemoveEntity op. Whenever ops are left over, the ones that
+// matter most to responsiveness - authority changes, commands and RPC endpoint updates - are processed ahead of the
+// rest, as long as no op left over before them refers to the same entity. They are then skipped when the rest of their
+// op list is processed. Urgent ops are found once, as their op list is enqueued, so the cost of
+// processing them ahead does not grow with the number of ops left over.
+class SPATIALGDK_API FTimeSlicedOpQueue
+{
+public:
+	using FProcessOpsFunction = TFunction<void(Worker_OpList*)>;
+	using FSkipOpFunction = TFunction<void(const Worker_Op*)>;
+	using FFlushFunction = TFunction<void()>;
+	using FDestroyOpListFunction = TFunction<void(Worker_OpList*)>;
+	using FGetTimeFunction = TFunction<double()>;
+
+	// ProcessOps is given views into the queued op lists. SkipOp is called for ops that were processed ahead of their
+	// op list, which ProcessOps must then skip. Flush is called once at the end of every call to ProcessOps that
+	// processed any ops, for the work the processed ops queued to be done once per frame.
+	FTimeSlicedOpQueue(FProcessOpsFunction InProcessOps, FSkipOpFunction InSkipOp, FFlushFunction InFlush,
+		FDestroyOpListFunction InDestroyOpList = &Worker_OpList_Destroy, FGetTimeFunction InGetTime = &FPlatformTime::Seconds);
+	~FTimeSlicedOpQueue();
+
+	FTimeSlicedOpQueue(const FTimeSlicedOpQueue&) = delete;
+	FTimeSlicedOpQueue& operator=(const FTimeSlicedOpQueue&) = delete;
+
+	// Takes ownership of the op lists.
+	void Enqueue(const TArray<Worker_OpList*>& OpLists);
+
+	// Processes queued ops until BudgetSeconds have passed, or all of them if BudgetSeconds is 0.
+	// At least one chunk of ops is processed on every call.
+	void ProcessOps(double BudgetSeconds);
+
+	bool IsEmpty() const { return OpLists.Num() == 0; }
+	uint32 GetNumQueuedOps() const;
+
+private:
+	static constexpr uint32 MaxOpsPerChunk = 16;
+
+	static bool IsUrgentOp(const Worker_Op& Op);
+	// Whether the op continues the remove component ops of an entity, which the SDK sends right before the entity's
+	// RemoveEntity op. A chunk must not end there, as the receiver flushes the remove component ops it queued at the end
+	// of ProcessOps, and only drops those of entities whose RemoveEntity op it has seen.
+	static bool ContinuesEntityRemoval(const Worker_OpList& OpList, uint32 OpIndex);
+
+	struct FQueuedOpList
+	{
+		Worker_OpList* OpList;
+		// The position of the list's first op among all ops ever enqueued.
+		uint64 FirstOpPosition;
+	};
+
+	struct FUrgentOp
+	{
+		Worker_Op* Op;
+		uint64 Position;
+		// The last op before it that refers to the same entity, which has to be processed first. Null if there is none.
+		const Worker_Op* Blocker;
+		uint64 BlockerPosition;
+		bool bInCriticalSection;
+	};
+
+	// Whether the op at Position has been processed, either by a chunk or ahead of its op list.
+	bool IsProcessed(const Worker_Op* Op, uint64 Position) const;
+	// The position of the next op a chunk will process.
+	uint64 GetNextOpPosition() const;
+
+	// Processes the next chunk of ops in the first queued op list, and destroys the list once it has been processed.
+	void ProcessNextChunk();
+	// Processes the urgent ops that can go ahead of the ops left over.
+	void ProcessUrgentOps();
+
+	FProcessOpsFunction ProcessOpsFunction;
+	FSkipOpFunction SkipOp;
+	FFlushFunction Flush;
+	FDestroyOpListFunction DestroyOpList;
+	FGetTimeFunction GetTime;
+
+	TArray<FQueuedOpList> OpLists;
+	// The next op to process in the first op list.
+	uint32 NextOpIndex;
+	bool bInCriticalSection;
+
+	// State of the ops enqueued so far, used to find the blockers of urgent ops as they are enqueued.
+	uint64 NumEnqueuedOps;
+	bool bEnqueuedInCriticalSection;
+	TMap<Worker_EntityId, TPair<const Worker_Op*, uint64>> LastEnqueuedOpByEntity;
+
+	// Urgent ops that have been neither processed nor processed ahead yet, in the order they were received.
+	TArray<FUrgentOp> PendingUrgentOps;
+
+	// Ops that were processed ahead of their op list and have not been reached by it yet.
+	TSet<const Worker_Op*> ProcessedAhead;
+};
+
+} // namespace SpatialGDK
@@ -5,10 +5,17 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSpatialGDKConsoleCommands, Log, All);
 
+class FOutputDevice;
 class UWorld;
 
 namespace SpatialGDKConsoleCommands
 {
 	void ConsoleCommand_ConnectToLocator(const TArray<FString>& Args, UWorld* World);
+	void ConsoleCommand_StartOpRecording(const TArray<FString>& Args, UWorld* World);
+	void ConsoleCommand_StopOpRecording(const TArray<FString>& Args, UWorld* World);
+	void ConsoleCommand_StartOutgoingMessageStats(const TArray<FString>& Args, UWorld* World);
+	void ConsoleCommand_StopOutgoingMessageStats(const TArray<FString>& Args, UWorld* World);
+	void ConsoleCommand_DumpOutgoingMessageStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar);
+	void ConsoleCommand_DumpActorPoolStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar);
 }
 // namespace
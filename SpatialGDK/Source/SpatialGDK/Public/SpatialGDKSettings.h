@@ -55,6 +55,20 @@ struct FDistanceFrequencyPair
 	float Frequency;
 };
 
+USTRUCT(BlueprintType)
+struct FPooledActorClass
+{
+	GENERATED_BODY()
+
+	/** Actors of exactly this class are pooled, subclasses need their own entry. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "SpatialGDK")
+	TSoftClassPtr<AActor> ActorClass;
+
+	/** The most actors of the class kept in the pool, further actors are destroyed as usual. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "SpatialGDK", meta = (ClampMin = "1"))
+	int32 MaxPooledActors = 32;
+};
+
 UCLASS(config = SpatialGDKSettings, defaultconfig)
 class SPATIALGDK_API USpatialGDKSettings : public UObject
 {
@@ -251,6 +265,101 @@ public:
 	UPROPERTY(Config)
 	bool bRunSpatialWorkerConnectionOnGameThread;
 
+	/**
+	 * EXPERIMENTAL: Instead of sleeping for the SpatialOS network update interval between polls, the SpatialWorkerConnection thread polls
+	 * the Worker SDK for ops every OpsPollIntervalMillis, and wakes up early to send outgoing messages as soon as the game thread queues them.
+	 * It never blocks in the Worker SDK waiting for ops, and the game thread picks up new ops on its next tick.
+	 * Not used when the connection runs on the game thread.
+	 */
+	UPROPERTY(Config)
+	bool bWakeSpatialWorkerConnectionOnSend;
+
+	/**
+	 * Interval, in milliseconds, at which a SpatialWorkerConnection thread that wakes on send polls for ops when no outgoing messages are queued,
+	 * 1 by default. Messages deferred by the outgoing message budget are also retried at this interval. Values below 1 are treated as 1.
+	 */
+	UPROPERTY(Config, meta = (EditCondition = "bWakeSpatialWorkerConnectionOnSend", ClampMin = "1"))
+	uint32 OpsPollIntervalMillis;
+
+	/**
+	 * EXPERIMENTAL: Merge component updates to the same entity-component that are sent in the same batch of outgoing messages into a single update,
+	 * including cleared fields and events. Updates are only merged until a message of another type is sent, so they never overtake other messages.
+	 */
+	UPROPERTY(Config)
+	bool bCoalesceOutgoingComponentUpdates;
+
+	/**
+	 * Number of outgoing messages that can be queued between the game thread and the SpatialWorkerConnection thread, rounded up to a power of two.
+	 * Storage for the queue is allocated once, up front. If the queue fills up, sending a message waits for the queue to drain,
+	 * except before the connection to SpatialOS is established, when the queue grows instead.
+	 */
+	UPROPERTY(Config)
+	uint32 OutgoingMessageQueueCapacity;
+
+	/**
+	 * EXPERIMENTAL: Maximum number of outgoing messages sent to SpatialOS per flush of the outgoing message queue, or 0 for no limit.
+	 * Component updates and commands ignore the budget, but are still deferred behind earlier deferred messages to the same entity, and command
+	 * requests behind any deferred request, so that they keep their order. Other messages are deferred to later flushes once the budget is
+	 * used up, with log messages, metrics and component interest sent last.
+	 */
+	UPROPERTY(Config)
+	uint32 MaxOutgoingMessagesPerFlush;
+
+	/** EXPERIMENTAL: Approximate number of bytes sent to SpatialOS per flush of the outgoing message queue, or 0 for no limit. See MaxOutgoingMessagesPerFlush. */
+	UPROPERTY(Config)
+	uint32 MaxOutgoingBytesPerFlush;
+
+	/** Number of flushes after which a message deferred by the outgoing budget is sent regardless of the budget, or 0 to never force it. */
+	UPROPERTY(Config)
+	uint32 MaxDeferredOutgoingMessageFlushes;
+
+	/**
+	 * Record histograms of queue latency, send duration and payload size of outgoing messages, per message type and per component.
+	 * They can be printed with the SpatialDumpOutgoingMessageStats console command, and are reported to SpatialOS with the other metrics.
+	 * Can also be toggled at runtime with SpatialStartOutgoingMessageStats and SpatialStopOutgoingMessageStats.
+	 */
+	UPROPERTY(Config)
+	bool bTrackOutgoingMessageStats;
+
+	/**
+	 * EXPERIMENTAL: Publish a read-only snapshot of the static component view at the end of every frame's op processing,
+	 * which other threads can read while the game thread processes the next frame's ops. Costs a copy of every changed component.
+	 */
+	UPROPERTY(Config)
+	bool bPublishComponentViewSnapshots;
+
+	/**
+	 * EXPERIMENTAL: Time in milliseconds clients spend on processing received ops each frame. Ops left over are processed
+	 * on the next frames, with authority changes and RPCs going ahead of the rest where possible. 0 processes all ops as they arrive.
+	 */
+	UPROPERTY(Config, meta = (ClampMin = "0.0"))
+	float ClientOpProcessingBudgetMillis;
+
+	/**
+	 * EXPERIMENTAL: Decode the bool, numeric and enum fields of received component updates on task graph threads as soon as their op list is
+	 * taken from the connection, so the game thread only copies the decoded values into the replicated properties. Only used for op lists with many updates.
+	 */
+	UPROPERTY(Config)
+	bool bStageComponentUpdatesOnWorkerThreads;
+
+	/**
+	 * EXPERIMENTAL: Actor classes that clients keep in a pool when their entity leaves interest, instead of destroying them, to reuse when
+	 * an entity of the same class is checked out again. Only classes implementing ISpatialPooledActor are pooled. Pooled actors are hidden with
+	 * collision and ticking disabled while parked, and don't get EndPlay or another BeginPlay, so they must reset their non-replicated state in
+	 * OnParkedInPool and OnTakenFromPool. Actors with dynamically attached subobjects are never pooled.
+	 * Hit rates can be printed with the SpatialDumpActorPoolStats console command.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Actor Pooling")
+	TArray<FPooledActorClass> PooledActorClasses;
+
+	/**
+	 * EXPERIMENTAL: Seconds clients keep the actor and actor channel of an entity that left their view, per actor class. If the entity comes
+	 * back within that time, the existing actor is updated with the received state instead of a new actor being spawned. Lingering actors
+	 * are left as they were and receive no updates. Subclasses use the time of their closest configured parent class.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Interest")
+	TMap<TSoftClassPtr<AActor>, float> ActorRemovalLingerSeconds;
+
 	/** RPC ring buffers is enabled when either the matching setting is set, or load balancing is enabled */
 	bool UseRPCRingBuffer() const;
 
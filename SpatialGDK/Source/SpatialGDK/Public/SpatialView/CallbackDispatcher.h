@@ -0,0 +1,101 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+#include "SpatialView/ViewDelta.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Templates/Function.h"
+#include <improbable/c_worker.h>
+
+namespace SpatialGDK
+{
+
+using CallbackId = int32;
+using ComponentChangeCallback = TFunction<void(Worker_EntityId EntityId, const ComponentChange& Change)>;
+using AuthorityChangeCallback = TFunction<void(Worker_EntityId EntityId)>;
+
+// Invokes callbacks registered for a component id with only the changes to that component.
+//
+// Once per delta, the changes to every component id with callbacks are sorted into a slice of their own in a single
+// pass, so each callback only iterates the changes it asked for instead of the whole delta.
+//
+// Callbacks are invoked in this order: components added, components refreshed, component updates, authority gained,
+// authority lost temporarily, authority lost, components removed. Within each of those, components are visited in
+// ascending id order and entities in ascending id order.
+class CallbackDispatcher
+{
+public:
+	CallbackDispatcher();
+
+	CallbackId RegisterComponentAddedCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback);
+	CallbackId RegisterComponentRemovedCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback);
+	// Called for UPDATE changes.
+	CallbackId RegisterComponentUpdateCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback);
+	// Called for COMPLETE_UPDATE changes.
+	CallbackId RegisterComponentRefreshCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback);
+	CallbackId RegisterAuthorityGainedCallback(Worker_ComponentId ComponentId, AuthorityChangeCallback Callback);
+	CallbackId RegisterAuthorityLostCallback(Worker_ComponentId ComponentId, AuthorityChangeCallback Callback);
+	CallbackId RegisterAuthorityLostTemporarilyCallback(Worker_ComponentId ComponentId, AuthorityChangeCallback Callback);
+
+	void RemoveCallback(CallbackId Id);
+
+	// Callbacks must not be registered or removed from within a callback.
+	void InvokeCallbacks(const ViewDelta& Delta);
+
+private:
+	template <typename CallbackType>
+	struct RegisteredCallback
+	{
+		CallbackId Id;
+		CallbackType Callback;
+	};
+
+	struct EntityComponentChange
+	{
+		Worker_EntityId EntityId;
+		const ComponentChange* Change;
+	};
+
+	// The callbacks for one component id, and the changes to it in the delta being dispatched.
+	struct ComponentSubscription
+	{
+		Worker_ComponentId ComponentId;
+
+		TArray<RegisteredCallback<ComponentChangeCallback>> AddedCallbacks;
+		TArray<RegisteredCallback<ComponentChangeCallback>> RemovedCallbacks;
+		TArray<RegisteredCallback<ComponentChangeCallback>> UpdateCallbacks;
+		TArray<RegisteredCallback<ComponentChangeCallback>> RefreshCallbacks;
+		TArray<RegisteredCallback<AuthorityChangeCallback>> AuthorityGainedCallbacks;
+		TArray<RegisteredCallback<AuthorityChangeCallback>> AuthorityLostCallbacks;
+		TArray<RegisteredCallback<AuthorityChangeCallback>> AuthorityLostTemporarilyCallbacks;
+
+		TArray<EntityComponentChange> Added;
+		TArray<EntityComponentChange> Removed;
+		TArray<EntityComponentChange> Updated;
+		TArray<EntityComponentChange> Refreshed;
+		TArray<Worker_EntityId> AuthorityGained;
+		TArray<Worker_EntityId> AuthorityLost;
+		TArray<Worker_EntityId> AuthorityLostTemporarily;
+
+		void ResetChanges();
+		bool RemoveCallback(CallbackId Id);
+	};
+
+	ComponentSubscription& FindOrAddSubscription(Worker_ComponentId ComponentId);
+	ComponentSubscription* FindSubscription(Worker_ComponentId ComponentId);
+
+	template <typename CallbackType>
+	CallbackId AddCallback(TArray<RegisteredCallback<CallbackType>>& Callbacks, CallbackType Callback);
+
+	// Sorts the changes in Delta into the slices of the subscribed components.
+	void SliceDelta(const ViewDelta& Delta);
+
+	// Sorted by component id.
+	TArray<ComponentSubscription> Subscriptions;
+	TMap<Worker_ComponentId, int32> SubscriptionIndices;
+
+	CallbackId NextCallbackId;
+	bool bInvokingCallbacks;
+};
+
+}  // namespace SpatialGDK
@@ -0,0 +1,60 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+#include "Templates/UniquePtr.h"
+#include <improbable/c_schema.h>
+#include <improbable/c_worker.h>
+
+namespace SpatialGDK
+{
+
+struct CommandRequestDeleter
+{
+	void operator()(Schema_CommandRequest* CommandRequest) const noexcept
+	{
+		if (CommandRequest != nullptr)
+		{
+			Schema_DestroyCommandRequest(CommandRequest);
+		}
+	}
+};
+
+using OwningCommandRequestPtr = TUniquePtr<Schema_CommandRequest, CommandRequestDeleter>;
+
+// An RAII wrapper for command requests.
+class CommandRequest
+{
+public:
+	// Creates a new command request.
+	CommandRequest(Worker_ComponentId ComponentId, Schema_FieldId CommandIndex);
+	// Takes ownership of a command request.
+	CommandRequest(OwningCommandRequestPtr Request, Worker_ComponentId ComponentId, Schema_FieldId CommandIndex);
+
+	~CommandRequest() = default;
+
+	// Creates a copy of the passed command request.
+	static CommandRequest CreateCopy(const Schema_CommandRequest* Request, Worker_ComponentId ComponentId, Schema_FieldId CommandIndex);
+
+	CommandRequest(const CommandRequest& Other) = delete;
+	CommandRequest(CommandRequest&& Other) = default;
+	CommandRequest& operator=(const CommandRequest& Other) = delete;
+	CommandRequest& operator=(CommandRequest&& Other) = default;
+
+	CommandRequest DeepCopy() const;
+	// Releases ownership of the command request.
+	Schema_CommandRequest* Release() &&;
+
+	Schema_Object* GetRequestObject() const;
+
+	Schema_CommandRequest* GetUnderlying() const;
+
+	Worker_ComponentId GetComponentId() const;
+	Schema_FieldId GetCommandIndex() const;
+
+private:
+	Worker_ComponentId ComponentId;
+	Schema_FieldId CommandIndex;
+	OwningCommandRequestPtr Request;
+};
+
+}  // namespace SpatialGDK
@@ -0,0 +1,60 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+#include "Templates/UniquePtr.h"
+#include <improbable/c_schema.h>
+#include <improbable/c_worker.h>
+
+namespace SpatialGDK
+{
+
+struct CommandResponseDeleter
+{
+	void operator()(Schema_CommandResponse* CommandResponse) const noexcept
+	{
+		if (CommandResponse != nullptr)
+		{
+			Schema_DestroyCommandResponse(CommandResponse);
+		}
+	}
+};
+
+using OwningCommandResponsePtr = TUniquePtr<Schema_CommandResponse, CommandResponseDeleter>;
+
+// An RAII wrapper for command responses.
+class CommandResponse
+{
+public:
+	// Creates a new command response.
+	CommandResponse(Worker_ComponentId ComponentId, Schema_FieldId CommandIndex);
+	// Takes ownership of a command response.
+	CommandResponse(OwningCommandResponsePtr Response, Worker_ComponentId ComponentId, Schema_FieldId CommandIndex);
+
+	~CommandResponse() = default;
+
+	// Creates a copy of the passed command response.
+	static CommandResponse CreateCopy(const Schema_CommandResponse* Response, Worker_ComponentId ComponentId, Schema_FieldId CommandIndex);
+
+	CommandResponse(const CommandResponse& Other) = delete;
+	CommandResponse(CommandResponse&& Other) = default;
+	CommandResponse& operator=(const CommandResponse& Other) = delete;
+	CommandResponse& operator=(CommandResponse&& Other) = default;
+
+	CommandResponse DeepCopy() const;
+	// Releases ownership of the command response.
+	Schema_CommandResponse* Release() &&;
+
+	Schema_Object* GetResponseObject() const;
+
+	Schema_CommandResponse* GetUnderlying() const;
+
+	Worker_ComponentId GetComponentId() const;
+	Schema_FieldId GetCommandIndex() const;
+
+private:
+	Worker_ComponentId ComponentId;
+	Schema_FieldId CommandIndex;
+	OwningCommandResponsePtr Response;
+};
+
+}  // namespace SpatialGDK
@@ -0,0 +1,76 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+#include "Templates/UniquePtr.h"
+#include <improbable/c_schema.h>
+#include <improbable/c_worker.h>
+
+namespace SpatialGDK
+{
+
+class ComponentUpdate;
+
+struct ComponentDataDeleter
+{
+	void operator()(Schema_ComponentData* ComponentData) const noexcept
+	{
+		if (ComponentData != nullptr)
+		{
+			Schema_DestroyComponentData(ComponentData);
+		}
+	}
+};
+
+using OwningComponentDataPtr = TUniquePtr<Schema_ComponentData, ComponentDataDeleter>;
+
+// An RAII wrapper for component data.
+class ComponentData
+{
+public:
+	// Creates a new component data.
+	explicit ComponentData(Worker_ComponentId Id);
+	// Takes ownership of component data.
+	ComponentData(OwningComponentDataPtr Data, Worker_ComponentId Id);
+
+	~ComponentData() = default;
+
+	// Creates a copy of the passed component data.
+	static ComponentData CreateCopy(const Schema_ComponentData* Data, Worker_ComponentId Id);
+
+	ComponentData(const ComponentData& Other) = delete;
+	ComponentData(ComponentData&& Other) = default;
+	ComponentData& operator=(const ComponentData& Other) = delete;
+	ComponentData& operator=(ComponentData&& Other) = default;
+
+	ComponentData DeepCopy() const;
+	// Releases ownership of the component data.
+	Schema_ComponentData* Release() &&;
+
+	// Applies the fields of an update, including cleared fields. Events are ignored.
+	// Returns false if the update could not be applied.
+	bool ApplyUpdate(const ComponentUpdate& Update);
+	bool ApplyUpdate(const Schema_ComponentUpdate* Update);
+
+	Schema_Object* GetFields() const;
+
+	Schema_ComponentData* GetUnderlying() const;
+
+	Worker_ComponentId GetComponentId() const;
+
+private:
+	Worker_ComponentId ComponentId;
+	OwningComponentDataPtr Data;
+};
+
+// Predicate for finding a component by id in a range of ComponentData.
+struct ComponentIdEquality
+{
+	Worker_ComponentId ComponentId;
+
+	bool operator()(const ComponentData& Component) const
+	{
+		return Component.GetComponentId() == ComponentId;
+	}
+};
+
+}  // namespace SpatialGDK
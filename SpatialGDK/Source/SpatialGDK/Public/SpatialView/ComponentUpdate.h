@@ -0,0 +1,64 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+#include "Templates/UniquePtr.h"
+#include <improbable/c_schema.h>
+#include <improbable/c_worker.h>
+
+namespace SpatialGDK
+{
+
+struct ComponentUpdateDeleter
+{
+	void operator()(Schema_ComponentUpdate* ComponentUpdate) const noexcept
+	{
+		if (ComponentUpdate != nullptr)
+		{
+			Schema_DestroyComponentUpdate(ComponentUpdate);
+		}
+	}
+};
+
+using OwningComponentUpdatePtr = TUniquePtr<Schema_ComponentUpdate, ComponentUpdateDeleter>;
+
+// An RAII wrapper for component updates.
+class ComponentUpdate
+{
+public:
+	// Creates a new component update.
+	explicit ComponentUpdate(Worker_ComponentId Id);
+	// Takes ownership of a component update.
+	ComponentUpdate(OwningComponentUpdatePtr Update, Worker_ComponentId Id);
+
+	~ComponentUpdate() = default;
+
+	// Creates a copy of the passed component update.
+	static ComponentUpdate CreateCopy(const Schema_ComponentUpdate* Update, Worker_ComponentId Id);
+
+	ComponentUpdate(const ComponentUpdate& Other) = delete;
+	ComponentUpdate(ComponentUpdate&& Other) = default;
+	ComponentUpdate& operator=(const ComponentUpdate& Other) = delete;
+	ComponentUpdate& operator=(ComponentUpdate&& Other) = default;
+
+	ComponentUpdate DeepCopy() const;
+	// Releases ownership of the component update.
+	Schema_ComponentUpdate* Release() &&;
+
+	// Appends the fields, cleared fields and events of Other to this update.
+	// Returns false if the updates could not be merged.
+	bool Merge(const ComponentUpdate& Other);
+	bool Merge(const Schema_ComponentUpdate* Other);
+
+	Schema_Object* GetFields() const;
+	Schema_Object* GetEvents() const;
+
+	Schema_ComponentUpdate* GetUnderlying() const;
+
+	Worker_ComponentId GetComponentId() const;
+
+private:
+	Worker_ComponentId ComponentId;
+	OwningComponentUpdatePtr Update;
+};
+
+}  // namespace SpatialGDK
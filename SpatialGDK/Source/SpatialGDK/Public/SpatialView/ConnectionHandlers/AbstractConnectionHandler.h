@@ -24,8 +24,9 @@ public:
 	// Gets the next queued OpList. If there is no OpList queued then an empty one is returned.
 	virtual TUniquePtr<AbstractOpList> GetNextOpList() = 0;
 
-	// Consumes messages and sends them to the deployment.
-	virtual void SendMessages(TUniquePtr<MessagesToSend> Messages) = 0;
+	// Consumes messages and sends them to the deployment, in the order they were added to the batch.
+	// The batch is owned by the caller, which reuses it once the messages have been sent.
+	virtual void SendMessages(MessagesToSend& Messages) = 0;
 
 	// todo implement this once spatial view can be used without the legacy worker connection.
 	// Return the unique ID for the worker.
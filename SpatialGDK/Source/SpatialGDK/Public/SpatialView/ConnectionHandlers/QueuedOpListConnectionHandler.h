@@ -4,6 +4,7 @@
 #include "SpatialView/ConnectionHandlers/AbstractConnectionHandler.h"
 #include "SpatialView/OpList/AbstractOpList.h"
 #include "Containers/Array.h"
+#include "Containers/Map.h"
 
 namespace SpatialGDK
 {
@@ -25,31 +26,22 @@ public:
 		return OpLists.Num();
 	}
 
-	TUniquePtr<AbstractOpList> GetNextOpList() override
-	{
-		TUniquePtr<AbstractOpList> NextOpList = MoveTemp(OpLists[0]);
-		OpLists.RemoveAt(0);
-		return NextOpList;
-	}
+	// Responses to requests sent by SendMessages carry the request id of the message they were sent with.
+	TUniquePtr<AbstractOpList> GetNextOpList() override;
 
 	void EnqueueOpList(TUniquePtr<AbstractOpList> OpList)
 	{
 		OpLists.Push(MoveTemp(OpList));
 	}
 
-	void SendMessages(TUniquePtr<MessagesToSend> Messages) override
-	{
-		for (auto& Request : Messages->CreateEntityRequests)
-		{
-			Worker_EntityId* EntityId = Request.EntityId.IsSet() ? &Request.EntityId.GetValue() : nullptr;
-			uint32* TimeoutMillis = Request.TimeoutMillis.IsSet() ? &Request.TimeoutMillis.GetValue() : nullptr;
-			Worker_Connection_SendCreateEntityRequest(Connection, Request.ComponentCount, Request.EntityComponents, EntityId, TimeoutMillis);
-		}
-	}
+	// Sends the whole batch in order, handing ownership of its schema data to the Worker SDK.
+	void SendMessages(MessagesToSend& Messages) override;
 
 private:
 	Worker_Connection* Connection;
 	TArray<TUniquePtr<AbstractOpList>> OpLists;
+	// Request ids assigned by the Worker SDK to the ids of the messages, until their responses are received.
+	TMap<Worker_RequestId, Worker_RequestId> SdkToMessageRequestIds;
 };
 
 }  // namespace SpatialGDK
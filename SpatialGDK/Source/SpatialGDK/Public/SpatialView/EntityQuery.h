@@ -0,0 +1,36 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+#include "Containers/Array.h"
+#include "Templates/UniquePtr.h"
+#include <improbable/c_worker.h>
+
+namespace SpatialGDK
+{
+
+// An owning copy of an entity query, so the constraints it points to stay valid until it is sent.
+class EntityQuery
+{
+public:
+	// Copies the query along with all of its nested constraints and snapshot component ids.
+	explicit EntityQuery(const Worker_EntityQuery& Query);
+
+	~EntityQuery() = default;
+
+	EntityQuery(const EntityQuery& Other) = delete;
+	EntityQuery(EntityQuery&& Other) = default;
+	EntityQuery& operator=(const EntityQuery& Other) = delete;
+	EntityQuery& operator=(EntityQuery&& Other) = default;
+
+	// Valid for the lifetime of this object.
+	const Worker_EntityQuery* GetWorkerQuery() const;
+
+private:
+	void CopyConstraint(Worker_Constraint& Constraint);
+
+	Worker_EntityQuery Query;
+	TArray<TUniquePtr<Worker_Constraint[]>> ConstraintStorage;
+	TArray<Worker_ComponentId> SnapshotComponentIds;
+};
+
+}  // namespace SpatialGDK
@@ -0,0 +1,23 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+#include "SpatialView/ComponentData.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include <improbable/c_worker.h>
+
+namespace SpatialGDK
+{
+
+// The state of an entity in the view. Components are stored contiguously, so processing all components of
+// an entity only touches one allocation.
+struct EntityViewElement
+{
+	TArray<ComponentData> Components;
+	// Components the worker is authoritative over.
+	TArray<Worker_ComponentId> Authority;
+};
+
+using EntityView = TMap<Worker_EntityId, EntityViewElement>;
+
+}  // namespace SpatialGDK
@@ -0,0 +1,116 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Templates/IsTriviallyDestructible.h"
+#include "Templates/Sorting.h"
+
+namespace SpatialGDK
+{
+
+// A linear allocator for memory that only lives for one frame.
+//
+// Allocating is a pointer bump, and nothing is freed until Reset. If a frame needs more than one block, Reset replaces
+// them with a single block large enough for all of them, so a steady workload stops allocating after its first frame.
+class FrameArena
+{
+public:
+	explicit FrameArena(SIZE_T MinBlockSize = 64 * 1024);
+	~FrameArena();
+
+	FrameArena(const FrameArena& Other) = delete;
+	FrameArena& operator=(const FrameArena& Other) = delete;
+
+	void* Allocate(SIZE_T Size, SIZE_T Alignment);
+
+	// Nothing allocated from the arena is ever destructed, so only trivially destructible types can be stored.
+	template <typename T>
+	T* AllocateArray(int32 Num)
+	{
+		static_assert(TIsTriviallyDestructible<T>::Value, "Frame arena memory is released without destructing its contents.");
+		return Num > 0 ? static_cast<T*>(Allocate(sizeof(T) * Num, alignof(T))) : nullptr;
+	}
+
+	// Releases everything allocated since the last reset.
+	void Reset();
+
+	SIZE_T GetBytesUsed() const;
+	SIZE_T GetBytesReserved() const;
+
+private:
+	struct Block
+	{
+		uint8* Memory;
+		SIZE_T Size;
+	};
+
+	Block AllocateBlock(SIZE_T Size);
+
+	SIZE_T MinBlockSize;
+	TArray<Block> Blocks;
+	// Offset into the last block.
+	SIZE_T Offset;
+	SIZE_T BytesUsed;
+};
+
+// An array with a fixed capacity in frame arena memory. It does not own its memory, which is released by resetting the
+// arena it was initialized from.
+template <typename T>
+class ArenaArray
+{
+public:
+	void Init(FrameArena& Arena, int32 InCapacity)
+	{
+		Data = Arena.AllocateArray<T>(InCapacity);
+		Count = 0;
+		Capacity = InCapacity;
+	}
+
+	// Forgets the arena memory. Has to be called before the arena it was initialized from is reset.
+	void Reset()
+	{
+		Data = nullptr;
+		Count = 0;
+		Capacity = 0;
+	}
+
+	T& Push(const T& Element)
+	{
+		check(Count < Capacity);
+		return *new (Data + Count++) T(Element);
+	}
+
+	template <typename PredicateType>
+	void StableSort(PredicateType Predicate)
+	{
+		::StableSort(Data, Count, Predicate);
+	}
+
+	int32 Num() const { return Count; }
+	int32 Max() const { return Capacity; }
+
+	T* GetData() { return Data; }
+	const T* GetData() const { return Data; }
+
+	T& operator[](int32 Index) { checkSlow(Index >= 0 && Index < Count); return Data[Index]; }
+	const T& operator[](int32 Index) const { checkSlow(Index >= 0 && Index < Count); return Data[Index]; }
+
+	T& Last() { check(Count > 0); return Data[Count - 1]; }
+	const T& Last() const { check(Count > 0); return Data[Count - 1]; }
+
+	TArrayView<T> GetView() { return TArrayView<T>(Data, Count); }
+	TArrayView<const T> GetView() const { return TArrayView<const T>(Data, Count); }
+
+	T* begin() { return Data; }
+	T* end() { return Data + Count; }
+	const T* begin() const { return Data; }
+	const T* end() const { return Data + Count; }
+
+private:
+	T* Data = nullptr;
+	int32 Count = 0;
+	int32 Capacity = 0;
+};
+
+}  // namespace SpatialGDK
@@ -2,15 +2,128 @@
 
 #pragma once
 #include "SpatialView/CommandMessages.h"
+#include "SpatialView/ComponentData.h"
+#include "SpatialView/ComponentUpdate.h"
+#include "SpatialView/WorkerMetrics.h"
 #include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "UObject/NameTypes.h"
+#include <improbable/c_worker.h>
 
 namespace SpatialGDK
 {
 
-// todo Placeholder for vertical slice. This should be revisited when we have more complicated messages.
+// An add, update or removal of a component. These share one array so they are sent in the order they were made.
+struct OutgoingComponentMessage
+{
+	enum EType
+	{
+		ADD,
+		UPDATE,
+		REMOVE
+	};
+
+	OutgoingComponentMessage(Worker_EntityId EntityId, ComponentData Data)
+	: EntityId(EntityId)
+	, ComponentId(Data.GetComponentId())
+	, Type(ADD)
+	, Data(MoveTemp(Data).Release())
+	{
+	}
+
+	OutgoingComponentMessage(Worker_EntityId EntityId, ComponentUpdate Update)
+	: EntityId(EntityId)
+	, ComponentId(Update.GetComponentId())
+	, Type(UPDATE)
+	, Update(MoveTemp(Update).Release())
+	{
+	}
+
+	OutgoingComponentMessage(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+	: EntityId(EntityId)
+	, ComponentId(ComponentId)
+	, Type(REMOVE)
+	{
+	}
+
+	Worker_EntityId EntityId;
+	Worker_ComponentId ComponentId;
+	EType Type;
+	// Set for ADD.
+	OwningComponentDataPtr Data;
+	// Set for UPDATE.
+	OwningComponentUpdatePtr Update;
+};
+
+struct ComponentInterestMessage
+{
+	Worker_EntityId EntityId;
+	TArray<Worker_InterestOverride> Interests;
+};
+
+struct LogMessage
+{
+	uint8 Level;
+	FName LoggerName;
+	FString Message;
+};
+
+// Everything a worker sends over one frame, batched by message type.
+// Order records every message in the order it was added, so they are sent in that order across types.
 struct MessagesToSend
 {
+	enum EMessageType
+	{
+		RESERVE_ENTITY_IDS_REQUEST,
+		CREATE_ENTITY_REQUEST,
+		COMPONENT_MESSAGE,
+		COMPONENT_INTEREST,
+		ENTITY_COMMAND_REQUEST,
+		ENTITY_COMMAND_RESPONSE,
+		ENTITY_COMMAND_FAILURE,
+		ENTITY_QUERY_REQUEST,
+		DELETE_ENTITY_REQUEST,
+		LOG,
+		METRICS
+	};
+
+	// A message, by its type and its index in the array for that type.
+	struct MessageRef
+	{
+		EMessageType Type;
+		int32 Index;
+	};
+
+	// Empties the batch, keeping the allocations of its arrays.
+	void Reset()
+	{
+		ReserveEntityIdsRequests.Reset();
+		CreateEntityRequests.Reset();
+		ComponentMessages.Reset();
+		ComponentInterests.Reset();
+		EntityCommandRequests.Reset();
+		EntityCommandResponses.Reset();
+		EntityCommandFailures.Reset();
+		EntityQueryRequests.Reset();
+		DeleteEntityRequests.Reset();
+		Logs.Reset();
+		Metrics.Reset();
+		Order.Reset();
+	}
+
+	TArray<ReserveEntityIdsRequest> ReserveEntityIdsRequests;
 	TArray<CreateEntityRequest> CreateEntityRequests;
+	TArray<OutgoingComponentMessage> ComponentMessages;
+	TArray<ComponentInterestMessage> ComponentInterests;
+	TArray<EntityCommandRequest> EntityCommandRequests;
+	TArray<EntityCommandResponse> EntityCommandResponses;
+	TArray<EntityCommandFailure> EntityCommandFailures;
+	TArray<EntityQueryRequest> EntityQueryRequests;
+	TArray<DeleteEntityRequest> DeleteEntityRequests;
+	TArray<LogMessage> Logs;
+	TArray<SpatialMetrics> Metrics;
+
+	TArray<MessageRef> Order;
 };
 
-}  // SpatialView
+}  // namespace SpatialGDK
@@ -1,6 +1,7 @@
 // Copyright (c) Improbable Worlds Ltd, All Rights Reserved
 
 #pragma once
+#include "SpatialView/CallbackDispatcher.h"
 #include "SpatialView/WorkerView.h"
 #include "SpatialView/ConnectionHandlers/AbstractConnectionHandler.h"
 #include "Templates/UniquePtr.h"
@@ -14,19 +15,50 @@ public:
 	explicit ViewCoordinator(TUniquePtr<AbstractConnectionHandler> ConnectionHandler);
 
 	void Advance();
+	// Invokes the callbacks registered for the changes of the last Advance.
+	void InvokeCallbacks();
+	// Sends everything queued by the Send functions since the last flush as one batch.
 	void FlushMessagesToSend();
 
+	void SendReserveEntityIdsRequest(ReserveEntityIdsRequest Request);
+	void SendCreateEntityRequest(CreateEntityRequest Request);
+	void SendDeleteEntityRequest(DeleteEntityRequest Request);
+	void SendAddComponent(Worker_EntityId EntityId, ComponentData Data);
+	void SendComponentUpdate(Worker_EntityId EntityId, ComponentUpdate Update);
+	void SendRemoveComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId);
+	void SendComponentInterest(Worker_EntityId EntityId, TArray<Worker_InterestOverride> Interests);
+	void SendEntityCommandRequest(EntityCommandRequest Request);
+	void SendEntityCommandResponse(EntityCommandResponse Response);
+	void SendEntityCommandFailure(EntityCommandFailure Failure);
+	void SendEntityQueryRequest(EntityQueryRequest Request);
+	void SendLogMessage(LogMessage Log);
+	void SendMetrics(SpatialMetrics Metrics);
+
 	const TArray<CreateEntityResponse>& GetCreateEntityResponses() const;
+	// The changes of the last Advance, per entity and sorted by entity id.
+	const TArray<EntityDelta>& GetEntityDeltas() const;
 	const TArray<EntityComponentId>& GetAuthorityGained() const;
 	const TArray<EntityComponentId>& GetAuthorityLost() const;
 	const TArray<EntityComponentId>& GetAuthorityLostTemporarily() const;
 
-	TUniquePtr<AbstractOpList> GenerateLegacyOpList() const;
+	const EntityView& GetView() const;
+
+	// Subscriptions to the changes of a single component. Each callback only iterates the changes to its component,
+	// sliced out of the delta once per InvokeCallbacks. See CallbackDispatcher for the order they are invoked in.
+	CallbackId RegisterComponentAddedCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback);
+	CallbackId RegisterComponentRemovedCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback);
+	CallbackId RegisterComponentUpdateCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback);
+	CallbackId RegisterComponentRefreshCallback(Worker_ComponentId ComponentId, ComponentChangeCallback Callback);
+	CallbackId RegisterAuthorityGainedCallback(Worker_ComponentId ComponentId, AuthorityChangeCallback Callback);
+	CallbackId RegisterAuthorityLostCallback(Worker_ComponentId ComponentId, AuthorityChangeCallback Callback);
+	CallbackId RegisterAuthorityLostTemporarilyCallback(Worker_ComponentId ComponentId, AuthorityChangeCallback Callback);
+	void RemoveCallback(CallbackId Id);
 
 private:
 	const ViewDelta* Delta;
 	WorkerView View;
 	TUniquePtr<AbstractConnectionHandler> ConnectionHandler;
+	CallbackDispatcher Dispatcher;
 };
 
 }  // namespace SpatialGDK
@@ -2,39 +2,190 @@
 
 #pragma once
 #include "SpatialView/CommandMessages.h"
+#include "SpatialView/ComponentUpdate.h"
+#include "SpatialView/EntityComponentId.h"
+#include "SpatialView/EntityView.h"
+#include "SpatialView/FrameArena.h"
 #include "SpatialView/OpList/AbstractOpList.h"
-#include "SpatialView/AuthorityRecord.h"
 #include "Containers/Array.h"
+#include "Containers/ArrayView.h"
 #include "Templates/UniquePtr.h"
 #include <improbable/c_worker.h>
 
 namespace SpatialGDK
 {
 
+// The net change to a single component of an entity.
+struct ComponentChange
+{
+	enum EChangeType
+	{
+		ADD,
+		UPDATE,
+		COMPLETE_UPDATE,
+		REMOVE
+	};
+
+	Worker_ComponentId ComponentId;
+	EChangeType Type;
+	// The state of the component after the change for ADD and COMPLETE_UPDATE, owned by the delta.
+	Schema_ComponentData* Data;
+	// The update for UPDATE. For COMPLETE_UPDATE, all updates received for the component over the delta, of which only
+	// the events should be read, or null if there were none.
+	Schema_ComponentUpdate* Update;
+};
+
+// The net changes to a single entity. Each array is sorted by component id.
+struct EntityDelta
+{
+	Worker_EntityId EntityId;
+	// The entity entered the view. All of its components are in ComponentsAdded.
+	bool bAdded;
+	// The entity left the view. All of its components are in ComponentsRemoved.
+	bool bRemoved;
+	TArrayView<const ComponentChange> ComponentsAdded;
+	TArrayView<const ComponentChange> ComponentsRemoved;
+	TArrayView<const ComponentChange> ComponentUpdates;
+	// Components whose state was replaced as a whole, e.g. by being removed and added again.
+	TArrayView<const ComponentChange> ComponentsRefreshed;
+	TArrayView<const EntityComponentId> AuthorityGained;
+	TArrayView<const EntityComponentId> AuthorityLost;
+	TArrayView<const EntityComponentId> AuthorityLostTemporarily;
+};
+
+// The changes to a worker's view since the last delta, grouped by entity.
+//
+// Changes are recorded in their net form: an entity or component that was added and removed again is not
+// reported at all, a component that was removed and added again is reported as a complete update, multiple
+// updates to the same component are merged into one, and updates to a component added within the delta are
+// folded into its data.
+//
+// Large deltas are split into shards by entity id and processed on the task graph. Shards never touch each other's
+// entities, and their results are merged in entity id order, so the delta is the same however many shards are used.
+//
+// The records of each delta are allocated from a frame arena that is reset by the next SetFromOpLists or Clear,
+// so generating a delta of a similar size to the last one does not allocate records. Schema data is still allocated
+// for the view's copy of each added component, and for updates and data that are merged within the delta.
+//
+// Pointers to schema data in the delta are valid until the next call to SetFromOpLists or Clear. They point into the
+// op lists the delta holds or into data it owns, never into the view, so applying later deltas does not change them.
 class ViewDelta
 {
 public:
+	// Sorts the ops by entity and component, reduces them to their net changes and applies those to View.
+	// The delta takes the op lists, as some of the changes point into them, and hands back the emptied array of the
+	// previous ones in OpLists so its allocation can be reused.
+	void SetFromOpLists(TArray<TUniquePtr<AbstractOpList>>& OpLists, EntityView& View);
+
 	void AddCreateEntityResponse(CreateEntityResponse Response);
 
-	void SetAuthority(Worker_EntityId EntityId, Worker_ComponentId ComponentId, Worker_Authority Authority);
+	// Entities with any change, sorted by entity id.
+	const TArray<EntityDelta>& GetEntityDeltas() const;
 
 	const TArray<CreateEntityResponse>& GetCreateEntityResponses() const;
+
+	// Authority changes over all entities, sorted by entity id and then component id.
 	const TArray<EntityComponentId>& GetAuthorityGained() const;
 	const TArray<EntityComponentId>& GetAuthorityLost() const;
 	const TArray<EntityComponentId>& GetAuthorityLostTemporarily() const;
 
-	// Returns an array of ops equivalent to the current state of the view delta.
-	// It is expected that Clear should be called between calls to GenerateLegacyOpList.
-	// todo Remove this once the view delta is not read via a legacy op list.
-	TUniquePtr<AbstractOpList> GenerateLegacyOpList() const;
-
 	void Clear();
 
 private:
+	struct ReceivedEntityChange
+	{
+		Worker_EntityId EntityId;
+		bool bAdded;
+	};
+
+	struct ReceivedComponentChange
+	{
+		Worker_EntityId EntityId;
+		Worker_ComponentId ComponentId;
+		ComponentChange::EChangeType Type;
+		// Owned by the op list.
+		const Schema_ComponentData* Data;
+		Schema_ComponentUpdate* Update;
+	};
+
+	struct ReceivedAuthorityChange
+	{
+		Worker_EntityId EntityId;
+		Worker_ComponentId ComponentId;
+		Worker_Authority Authority;
+	};
+
+	// The changes to the entities whose id maps to this shard. Records live in the delta's frame arena.
+	struct Shard
+	{
+		void Reset();
+
+		// Allocates space for the number of received changes counted, and for everything they can produce.
+		void Init(FrameArena& Arena);
+
+		void SortReceivedChanges();
+		// Adds the entities that are not in view but will be after the delta. Must not run in parallel with other shards.
+		void AddEntitiesEnteringView(EntityView& View);
+		// Applies the shard's changes to the entity elements in View, without adding or removing entities.
+		// Safe to run in parallel with other shards once all of them have added their entities.
+		void Process(EntityView& View);
+		void RemoveEntitiesLeavingView(EntityView& View);
+
+		void ProcessEntity(EntityView& View, Worker_EntityId EntityId, TArrayView<const ReceivedEntityChange> EntityChanges,
+			TArrayView<const ReceivedComponentChange> ComponentChanges, TArrayView<const ReceivedAuthorityChange> AuthorityChanges);
+		// Each of these takes all changes received for one component of an entity, in the order they were received.
+		void ProcessComponent(EntityViewElement& Element, TArrayView<const ReceivedComponentChange> Changes);
+		void ProcessAuthority(EntityViewElement& Element, TArrayView<const ReceivedAuthorityChange> Changes);
+
+		// Returns the received updates merged into one, or null if there are none.
+		Schema_ComponentUpdate* MergeUpdates(TArrayView<const ReceivedComponentChange> Changes);
+
+		int32 EntityChangeCount = 0;
+		int32 ComponentChangeCount = 0;
+		int32 AuthorityChangeCount = 0;
+
+		ArenaArray<ReceivedEntityChange> ReceivedEntityChanges;
+		ArenaArray<ReceivedComponentChange> ReceivedComponentChanges;
+		ArenaArray<ReceivedAuthorityChange> ReceivedAuthorityChanges;
+
+		// Sorted by entity id.
+		ArenaArray<Worker_EntityId> EntitiesEnteringView;
+		ArenaArray<Worker_EntityId> EntitiesLeavingView;
+
+		// Every received change produces at most one net change, so these never run out of space.
+		ArenaArray<EntityDelta> EntityDeltas;
+		ArenaArray<ComponentChange> ComponentsAdded;
+		ArenaArray<ComponentChange> ComponentsRemoved;
+		ArenaArray<ComponentChange> ComponentUpdates;
+		ArenaArray<ComponentChange> ComponentsRefreshed;
+		ArenaArray<EntityComponentId> AuthorityGained;
+		ArenaArray<EntityComponentId> AuthorityLost;
+		ArenaArray<EntityComponentId> AuthorityLostTemporarily;
+
+		// Data of components added with updates after them, and merged updates.
+		TArray<ComponentData> OwnedData;
+		TArray<ComponentUpdate> OwnedUpdates;
+	};
+
+	void CountOp(const Worker_Op& Op);
+	void GatherOp(const Worker_Op& Op);
+	Shard& GetShard(Worker_EntityId EntityId);
+
+	// Merges the results of all shards in entity id order.
+	void MergeShards();
+
+	TArray<TUniquePtr<AbstractOpList>> OpLists;
+
+	FrameArena Arena;
+	TArray<Shard> Shards;
+
+	TArray<EntityDelta> EntityDeltas;
+	TArray<EntityComponentId> AuthorityGained;
+	TArray<EntityComponentId> AuthorityLost;
+	TArray<EntityComponentId> AuthorityLostTemporarily;
+
 	// todo wrap world command responses in their own record?
 	TArray<CreateEntityResponse> CreateEntityResponses;
-
-	AuthorityRecord AuthorityChanges;
 };
 
 }  // namespace SpatialGDK
@@ -1,8 +1,10 @@
 // Copyright (c) Improbable Worlds Ltd, All Rights Reserved
 
 #pragma once
-#include "MessagesToSend.h"
-#include "ViewDelta.h"
+#include "SpatialView/EntityView.h"
+#include "SpatialView/MessagesToSend.h"
+#include "SpatialView/OpList/AbstractOpList.h"
+#include "SpatialView/ViewDelta.h"
 #include "Templates/UniquePtr.h"
 #include <WorkerSDK/improbable/c_worker.h>
 
@@ -15,27 +17,45 @@ public:
 	WorkerView();
 
 	// Process queued op lists to create a new view delta.
-	// The view delta will exist until the next call to advance.
+	// Deltas are double buffered: the returned delta, including the schema data it points to, stays readable and unchanged
+	// until the call after the next one.
 	const ViewDelta* GenerateViewDelta();
 
 	// Add an OpList to generate the next ViewDelta.
 	void EnqueueOpList(TUniquePtr<AbstractOpList> OpList);
 
 	// Ensure all local changes have been applied and return the resulting MessagesToSend.
-	TUniquePtr<MessagesToSend> FlushLocalChanges();
+	// Everything sent since the last flush is returned as a single batch. Batches are double buffered and reused: the
+	// returned batch stays valid until the next call, which empties it to collect the batch after next.
+	MessagesToSend& FlushLocalChanges();
 
+	void SendReserveEntityIdsRequest(ReserveEntityIdsRequest Request);
 	void SendCreateEntityRequest(CreateEntityRequest Request);
+	void SendDeleteEntityRequest(DeleteEntityRequest Request);
+	void SendAddComponent(Worker_EntityId EntityId, ComponentData Data);
+	void SendComponentUpdate(Worker_EntityId EntityId, ComponentUpdate Update);
+	void SendRemoveComponent(Worker_EntityId EntityId, Worker_ComponentId ComponentId);
+	void SendComponentInterest(Worker_EntityId EntityId, TArray<Worker_InterestOverride> Interests);
+	void SendEntityCommandRequest(EntityCommandRequest Request);
+	void SendEntityCommandResponse(EntityCommandResponse Response);
+	void SendEntityCommandFailure(EntityCommandFailure Failure);
+	void SendEntityQueryRequest(EntityQueryRequest Request);
+	void SendLogMessage(LogMessage Log);
+	void SendMetrics(SpatialMetrics Metrics);
+
+	// The entities and components currently in view, up to date with the last generated view delta.
+	const EntityView& GetView() const;
 
 private:
-	void ProcessOp(const Worker_Op& Op);
-
-	void HandleAuthorityChange(const Worker_AuthorityChangeOp& AuthorityChange);
-	void HandleCreateEntityResponse(const Worker_CreateEntityResponseOp& Response);
+	MessagesToSend& GetLocalChanges();
 
 	TArray<TUniquePtr<AbstractOpList>> QueuedOps;
 
-	ViewDelta Delta;
-	TUniquePtr<MessagesToSend> LocalChanges;
+	EntityView View;
+	ViewDelta Deltas[2];
+	int32 CurrentDelta;
+	MessagesToSend LocalChanges[2];
+	int32 CurrentLocalChanges;
 };
 
 }  // namespace SpatialGDK
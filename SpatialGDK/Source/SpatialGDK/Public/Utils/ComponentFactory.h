@@ -25,6 +25,9 @@ enum EReplicatedPropertyGroup : uint32;
 namespace SpatialGDK
 {
 
+class FPropertySerializationPlan;
+struct FPropertyWriter;
+
 class SPATIALGDK_API ComponentFactory
 {
 public:
@@ -38,16 +41,23 @@ public:
 	static FWorkerComponentData CreateEmptyComponentData(Worker_ComponentId ComponentId);
 
 private:
-	FWorkerComponentData CreateComponentData(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, uint32& OutBytesWritten);
-	FWorkerComponentUpdate CreateComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, uint32& OutBytesWritten);
+	// Lets the serialization plan tests compare both ways of writing a property.
+	friend struct FComponentFactoryTestAccess;
+
+	FWorkerComponentData CreateComponentData(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, const FPropertySerializationPlan* Plan, uint32& OutBytesWritten);
+	FWorkerComponentUpdate CreateComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, const FPropertySerializationPlan* Plan, uint32& OutBytesWritten);
 
-	uint32 FillSchemaObject(Schema_Object* ComponentObject, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool bIsInitialData, TraceKey* OutLatencyTraceId, TArray<Schema_FieldId>* ClearedIds = nullptr);
+	// Plan may be null, or built for another rep layout than Changes', in which case properties are written with AddProperty.
+	uint32 FillSchemaObject(Schema_Object* ComponentObject, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, const FPropertySerializationPlan* Plan, bool bIsInitialData, TraceKey* OutLatencyTraceId, TArray<Schema_FieldId>* ClearedIds = nullptr);
 
 	FWorkerComponentUpdate CreateHandoverComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, const FClassInfo& Info, const FHandoverChangeState& Changes, uint32& OutBytesWritten);
 
 	uint32 FillHandoverSchemaObject(Schema_Object* ComponentObject, UObject* Object, const FClassInfo& Info, const FHandoverChangeState& Changes, bool bIsInitialData, TraceKey* OutLatencyTraceId, TArray<Schema_FieldId>* ClearedIds = nullptr);
 
+	// Writes a property by checking its type. Writers from a serialization plan have to write the same schema as this does.
 	void AddProperty(Schema_Object* Object, Schema_FieldId FieldId, UProperty* Property, const uint8* Data, TArray<Schema_FieldId>* ClearedIds);
+	// Writes a property with its writer from a serialization plan, falling back to checking its type if it has none.
+	void AddProperty(Schema_Object* Object, Schema_FieldId FieldId, const FPropertyWriter& Writer, const uint8* Data, TArray<Schema_FieldId>* ClearedIds);
 
 	USpatialNetDriver* NetDriver;
 	USpatialPackageMapClient* PackageMap;
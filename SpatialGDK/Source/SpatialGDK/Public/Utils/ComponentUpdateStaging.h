@@ -0,0 +1,117 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Array.h"
+#include "Containers/BitArray.h"
+#include "Containers/Map.h"
+#include "Templates/Function.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+#include <WorkerSDK/improbable/c_worker.h>
+
+class FRepLayout;
+class UClass;
+class UProperty;
+class USpatialNetDriver;
+
+namespace SpatialGDK
+{
+
+struct FStagingLayout;
+
+// The fields of one component update that were decoded ahead of being applied.
+class SPATIALGDK_API FStagedComponentUpdate
+{
+public:
+	// The updated and cleared field ids of the update, in the order ComponentReader processes them.
+	const TArray<Schema_FieldId>& GetUpdatedIds() const { return UpdatedIds; }
+
+	// Whether the update was decoded against this rep layout. Objects replicated with any other layout have to decode it themselves.
+	bool IsStagedFor(const FRepLayout& RepLayout) const;
+
+	bool IsFieldStaged(Schema_FieldId FieldId) const;
+
+	// Writes the staged value of a field into the property memory at Data.
+	void ApplyField(Schema_FieldId FieldId, UProperty* Property, uint8* Data) const;
+
+private:
+	friend class FComponentUpdateStaging;
+
+	TSharedPtr<const FStagingLayout> Layout;
+	TArray<Schema_FieldId> UpdatedIds;
+	// Indexed by rep handle - 1.
+	TBitArray<> StagedFields;
+	TArray<uint8> Buffer;
+};
+
+// Decodes the replicated fields of the component updates in an op list on the task graph, while the game thread carries on.
+//
+// Each class gets a staging layout built from its rep layout: every bool, numeric and enum property is given a slot in a
+// buffer with the same in-memory representation as the property. Worker threads read the schema fields of the updates
+// into these buffers, so applying them on the game thread is a copy per field, with RepNotifies handled as before.
+// Object references, structs, strings and arrays depend on the package map and are still decoded on the game thread.
+//
+// Op lists are staged as soon as they are taken from the connection, and decoding overlaps with the game thread
+// dispatching the ops received before them. Staged updates are keyed by the address of their schema data, so they are
+// only valid while their op list is alive. Release has to be called for an op list before it is destroyed.
+class SPATIALGDK_API FComponentUpdateStaging
+{
+public:
+	// Returns the class whose replicated properties a component carries, or null for components that aren't staged.
+	using FGetReplicatedClassFunction = TFunction<UClass*(Worker_ComponentId)>;
+
+	// Looks classes up in the class info manager of the net driver.
+	explicit FComponentUpdateStaging(USpatialNetDriver* InNetDriver);
+	FComponentUpdateStaging(USpatialNetDriver* InNetDriver, FGetReplicatedClassFunction InGetReplicatedClass);
+	~FComponentUpdateStaging();
+
+	// Starts decoding the fields of all replicated component updates in OpList on the task graph and returns without waiting.
+	// Op lists with fewer than MinUpdatesToStage updates are left to be decoded when they are applied, as handing them to
+	// the task graph would cost more than it saves.
+	void StageComponentUpdates(const Worker_OpList& OpList);
+
+	// Returns the staged fields of Update, or null if it wasn't staged. Waits for its op list to finish decoding if needed.
+	const FStagedComponentUpdate* Find(const Worker_ComponentUpdate& Update) const;
+
+	// Waits for OpList to finish decoding and drops its staged updates.
+	void Release(const Worker_OpList& OpList);
+
+	// Releases every staged op list.
+	void Reset();
+
+	static constexpr int32 MinUpdatesToStage = 32;
+
+private:
+	// The staged updates of one op list, and the task decoding them.
+	struct FStagedOpList
+	{
+		TArray<FStagedComponentUpdate> Updates;
+		TArray<Schema_ComponentUpdate*> Schemas;
+		FGraphEventRef DecodeTask;
+
+		void WaitForDecoding() const;
+	};
+
+	struct FStagedUpdateRef
+	{
+		const FStagedOpList* StagedOpList;
+		int32 Index;
+	};
+
+	TSharedPtr<const FStagingLayout> GetOrCreateLayout(Worker_ComponentId ComponentId);
+
+	USpatialNetDriver* NetDriver;
+	FGetReplicatedClassFunction GetReplicatedClass;
+
+	TMap<TWeakObjectPtr<const UClass>, TSharedPtr<const FStagingLayout>> LayoutsByClass;
+
+	// Decode tasks write to the staged op lists, so they are heap allocated to keep their address stable.
+	TMap<const Worker_OpList*, TUniquePtr<FStagedOpList>> StagedOpLists;
+	TMap<const Schema_ComponentUpdate*, FStagedUpdateRef> StagedUpdateRefs;
+};
+
+} // namespace SpatialGDK
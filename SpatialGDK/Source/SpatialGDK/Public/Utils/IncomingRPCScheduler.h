@@ -0,0 +1,124 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Schema/RPCPayload.h"
+#include "Schema/UnrealObjectRef.h"
+#include "SpatialConstants.h"
+#include "Utils/RPCContainer.h"
+
+#include "CoreMinimal.h"
+
+// Applies a received RPC. When the RPC can't be applied because of unresolved parameters, OutUnresolvedRefs holds the refs it waits on.
+DECLARE_DELEGATE_RetVal_TwoParams(FRPCErrorInfo, FProcessIncomingRPCDelegate, const FPendingRPCParams&, TSet<FUnrealObjectRef>& /* OutUnresolvedRefs */)
+
+namespace SpatialGDK
+{
+
+// Queues received RPCs that can't be applied yet, in order per entity and RPC type, and retries them only when they may succeed.
+//
+// Only the oldest RPC of each queue is ever attempted. When it fails on unresolved references, the queue is parked in the wait list of
+// each reference and retried once any of them is resolved. Path based references, such as stably named subobjects of dynamic actors,
+// are waited on through the entity reference at the end of their outer chain, which is the one resolved along with them. References
+// with no entity in their outer chain, such as level objects, have no resolution of their own, so their queues are retried whenever
+// any reference is resolved. Every parked queue also has a deadline on a timer wheel: the time at which the
+// processing function stops waiting for unresolved parameters, or the retry period for RPCs that failed for any other reason.
+// The cost of retrying is therefore proportional to the references resolved and deadlines reached, not to the number of queued RPCs.
+class SPATIALGDK_API FIncomingRPCScheduler
+{
+public:
+	static constexpr int32 NumWheelSlots = 64;
+
+	FIncomingRPCScheduler();
+
+	// InWaitSeconds is how long RPCs wait for unresolved parameters, see USpatialGDKSettings::QueuedIncomingRPCWaitTime.
+	// InClock returns the current time in seconds, FPlatformTime::Seconds if not set.
+	void Init(const FProcessIncomingRPCDelegate& InProcessingFunction, float InWaitSeconds, TFunction<double()> InClock = nullptr);
+
+	void ProcessOrQueueRPC(const FUnrealObjectRef& TargetObjectRef, ERPCType Type, RPCPayload&& Payload);
+
+	// Retries the queues waiting on ObjectRef, and those waiting on any reference.
+	void OnObjectRefResolved(const FUnrealObjectRef& ObjectRef);
+
+	// Retries the queues whose deadline has passed. Expected to be called every GetTickSeconds().
+	void Tick();
+
+	void DropForEntity(Worker_EntityId EntityId);
+
+	bool ObjectHasRPCsQueuedOfType(Worker_EntityId EntityId, ERPCType Type) const;
+	int32 GetNumQueuedRPCs() const;
+	int32 GetNumWaitingRefs() const { return WaitLists.Num(); }
+	int32 GetNumQueuesWaitingOnAnyRef() const { return QueuesWaitingOnAnyRef.Num(); }
+
+	double GetTickSeconds() const { return TickSeconds; }
+
+private:
+	struct FQueueKey
+	{
+		Worker_EntityId EntityId;
+		ERPCType Type;
+
+		bool operator==(const FQueueKey& Other) const { return EntityId == Other.EntityId && Type == Other.Type; }
+		friend uint32 GetTypeHash(const FQueueKey& Key) { return HashCombine(GetTypeHash(static_cast<int64>(Key.EntityId)), GetTypeHash(static_cast<uint8>(Key.Type))); }
+	};
+
+	struct FQueuedRPC
+	{
+		FPendingRPCParams Params;
+		double QueuedSeconds;
+	};
+
+	// A queue only exists while its oldest RPC is blocked, and is then parked in the wait lists of WaitingOn and on the wheel.
+	struct FRPCQueue
+	{
+		TArray<FQueuedRPC> RPCs;
+		TArray<FUnrealObjectRef> WaitingOn;
+		bool bWaitingOnAnyRef = false;
+		double Deadline = 0.0;
+		// Bumped whenever the queue is unparked, so wheel entries of earlier parks can be told apart.
+		uint32 Generation = 0;
+	};
+
+	struct FWheelEntry
+	{
+		FQueueKey Key;
+		uint32 Generation;
+	};
+
+	// Queues are only added and removed through these, to keep QueuedTypesByEntity in sync.
+	FRPCQueue& FindOrAddQueue(const FQueueKey& Key);
+	void RemoveQueue(const FQueueKey& Key);
+
+	// Applies as many RPCs of the queue as possible, then parks it or removes it once empty.
+	void ProcessQueue(const FQueueKey& Key);
+	void ProcessDeferredQueues();
+
+	// Returns whether the RPC is done with, either applied or dropped.
+	bool ApplyRPC(const FPendingRPCParams& Params, TSet<FUnrealObjectRef>& OutUnresolvedRefs, ERPCResult& OutResult);
+
+	void Park(const FQueueKey& Key, FRPCQueue& Queue, ERPCResult Result, TSet<FUnrealObjectRef>&& UnresolvedRefs);
+	void Unpark(const FQueueKey& Key, FRPCQueue& Queue);
+
+	int64 GetTick(double Seconds) const;
+
+	FProcessIncomingRPCDelegate ProcessingFunction;
+	TFunction<double()> Clock;
+	double WaitSeconds = 0.0;
+	double TickSeconds = 0.0;
+
+	TMap<FQueueKey, FRPCQueue> Queues;
+	// The RPC types with a queue in Queues, per entity, so an entity's queues can be found without going through every RPC type.
+	TMap<Worker_EntityId_Key, TArray<ERPCType>> QueuedTypesByEntity;
+	TMap<FUnrealObjectRef, TArray<FQueueKey>> WaitLists;
+	TArray<FQueueKey> QueuesWaitingOnAnyRef;
+
+	TArray<TArray<FWheelEntry>> WheelSlots;
+	// The last tick whose slot was processed.
+	int64 LastTick = 0;
+
+	// Queues to process once the current processing finishes, as applying an RPC can resolve refs or receive further RPCs.
+	TArray<FQueueKey> DeferredQueues;
+	bool bProcessing = false;
+};
+
+} // namespace SpatialGDK
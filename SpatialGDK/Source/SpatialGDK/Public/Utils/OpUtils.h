@@ -8,7 +8,25 @@
 
 namespace SpatialGDK
 {
-void FindFirstOpOfType(const TArray<Worker_OpList*>& InOpLists, const Worker_OpType OpType, Worker_Op** OutOp);
-void FindFirstOpOfTypeForComponent(const TArray<Worker_OpList*>& InOpLists, const Worker_OpType OpType, const Worker_ComponentId ComponentId, Worker_Op** OutOp);
 Worker_ComponentId GetComponentId(const Worker_Op* Op);
+// Returns the entity an op refers to, or SpatialConstants::INVALID_ENTITY_ID for ops that don't refer to one.
+Worker_EntityId GetEntityId(const Worker_Op* Op);
+
+// The first op of each op type and component id in a set of op lists, found in a single pass over the ops.
+// Ops stay owned by their op lists, so the index must be reset before the op lists are destroyed.
+class SPATIALGDK_API FFirstOpIndex
+{
+public:
+	void AddOpLists(const TArray<Worker_OpList*>& InOpLists);
+	void Reset();
+
+	// For ops that don't refer to a component, e.g. world command responses.
+	Worker_Op* FindFirstOpOfType(const Worker_OpType OpType) const;
+	Worker_Op* FindFirstOpOfTypeForComponent(const Worker_OpType OpType, const Worker_ComponentId ComponentId) const;
+
+private:
+	static uint64 MakeKey(const Worker_OpType OpType, const Worker_ComponentId ComponentId);
+
+	TMap<uint64, Worker_Op*> FirstOps;
+};
 } // namespace SpatialGDK
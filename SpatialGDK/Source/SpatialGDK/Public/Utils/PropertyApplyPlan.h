@@ -0,0 +1,79 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/Class.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+
+class FRepLayout;
+class FSpatialNetBitReader;
+class UProperty;
+class USpatialNetDriver;
+class USpatialPackageMapClient;
+
+struct FClassInfo;
+
+namespace SpatialGDK
+{
+
+// Reads one property from schema, picked once per component rather than by casting the property on every read.
+struct FPropertyReader
+{
+	using FReadFunction = void (*)(const FPropertyReader& Reader, Schema_Object* Object, Schema_FieldId FieldId, uint32 Index, uint8* Data);
+	using FCountFunction = uint32 (*)(const Schema_Object* Object, Schema_FieldId FieldId);
+	using FReadListFunction = void (*)(const Schema_Object* Object, Schema_FieldId FieldId, uint8* Data);
+
+	// Null for properties that can hold object references or that the plan has no reader for. These are applied by
+	// ComponentReader::ApplyProperty, which tracks their references.
+	FReadFunction Read = nullptr;
+	// The number of values of the property in a field, used when the property is an array's element.
+	FCountFunction Count = nullptr;
+	UProperty* Property = nullptr;
+
+	// For structs, whichever of these the struct is serialized with.
+	UScriptStruct::ICppStructOps* CppStructOps = nullptr;
+	TSharedPtr<FRepLayout> StructRepLayout;
+
+	// For arrays, the reader of the elements.
+	TSharedPtr<const FPropertyReader> InnerReader;
+	// For arrays of numbers that schema stores as they are laid out in memory, reads all the elements at once.
+	FReadListFunction ReadList = nullptr;
+};
+
+// Reads a struct with the struct ops or rep layout the reader was built with, as ReadStructProperty does.
+SPATIALGDK_API void ReadStruct(const FPropertyReader& Reader, FSpatialNetBitReader& NetBitReader, USpatialPackageMapClient* PackageMap, uint8* Data, bool& bOutHasUnmapped);
+
+// The property readers of one schema component, built once by USpatialClassInfoManager and used by ComponentReader to
+// apply the data and updates of the component.
+class SPATIALGDK_API FPropertyApplyPlan
+{
+public:
+	// Builds the readers of the replicated properties in the rep layout of the class, indexed by rep handle.
+	static TSharedRef<const FPropertyApplyPlan> CreateForRepLayout(USpatialNetDriver* NetDriver, const FClassInfo& Info);
+	// Builds the readers of the handover properties of the class, indexed by handover handle.
+	static TSharedRef<const FPropertyApplyPlan> CreateForHandover(USpatialNetDriver* NetDriver, const FClassInfo& Info);
+
+	// Whether the plan was built from this rep layout. Objects replicated with any other layout have to be read without it.
+	bool IsBuiltFor(const FRepLayout& InRepLayout) const { return RepLayout.IsValid() && RepLayout.Get() == &InRepLayout; }
+	// Whether the plan was built from the handover properties of this class.
+	bool IsBuiltFor(const UClass* InClass) const { return !RepLayout.IsValid() && Class.Get() == InClass; }
+
+	// Null for field ids the plan has no property for.
+	const FPropertyReader* GetReader(Schema_FieldId FieldId) const
+	{
+		const int32 ReaderIndex = static_cast<int32>(FieldId) - 1;
+		return ReaderIndex >= 0 && ReaderIndex < Readers.Num() ? &Readers[ReaderIndex] : nullptr;
+	}
+
+private:
+	TSharedPtr<FRepLayout> RepLayout;
+	TWeakObjectPtr<const UClass> Class;
+	// Indexed by field id - 1.
+	TArray<FPropertyReader> Readers;
+};
+
+} // namespace SpatialGDK
@@ -0,0 +1,68 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/Class.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+
+class FRepLayout;
+class UProperty;
+class USpatialNetDriver;
+class USpatialPackageMapClient;
+
+struct FClassInfo;
+
+namespace SpatialGDK
+{
+
+// The state of a ComponentFactory that writers need.
+struct FPropertyWriteContext
+{
+	USpatialPackageMapClient* PackageMap;
+	TArray<Schema_FieldId>* ClearedIds;
+	bool& bInterestHasChanged;
+};
+
+// Writes one property to schema, picked once per class rather than by casting the property on every write.
+struct FPropertyWriter
+{
+	using FWriteFunction = void (*)(const FPropertyWriter& Writer, FPropertyWriteContext& Context, Schema_Object* Object, Schema_FieldId FieldId, const uint8* Data);
+
+	// Null for properties the plan has no writer for, which are written by ComponentFactory::AddProperty.
+	FWriteFunction Write = nullptr;
+	UProperty* Property = nullptr;
+
+	// For structs, whichever of these the struct is serialized with.
+	UScriptStruct::ICppStructOps* CppStructOps = nullptr;
+	TSharedPtr<FRepLayout> StructRepLayout;
+
+	// For arrays, the writer of the elements.
+	TSharedPtr<const FPropertyWriter> InnerWriter;
+};
+
+// The property writers of a class, built once by USpatialClassInfoManager and used by ComponentFactory to fill
+// the replicated and handover components of its objects.
+class SPATIALGDK_API FPropertySerializationPlan
+{
+public:
+	FPropertySerializationPlan(USpatialNetDriver* NetDriver, const FClassInfo& Info);
+
+	// Whether the plan was built from this rep layout. Objects replicated with any other layout have to be written without it.
+	bool IsBuiltFor(const FRepLayout& InRepLayout) const { return RepLayout.Get() == &InRepLayout; }
+
+	// Indexed by rep layout cmd index.
+	const FPropertyWriter& GetRepWriter(int32 CmdIndex) const { return RepWriters[CmdIndex]; }
+
+	// Indexed by handover handle - 1.
+	const FPropertyWriter& GetHandoverWriter(int32 HandoverIndex) const { return HandoverWriters[HandoverIndex]; }
+
+private:
+	TSharedPtr<FRepLayout> RepLayout;
+	TArray<FPropertyWriter> RepWriters;
+	TArray<FPropertyWriter> HandoverWriters;
+};
+
+} // namespace SpatialGDK
@@ -84,6 +84,9 @@ struct SPATIALGDK_API FPendingRPCParams
 	ERPCType Type;
 };
 
+// Logs why an RPC was queued or dropped, as a warning once it has been queued for longer than the warning time of its error.
+SPATIALGDK_API void LogRPCError(const FRPCErrorInfo& ErrorInfo, ERPCQueueType QueueType, const FPendingRPCParams& Params);
+
 class SPATIALGDK_API FRPCContainer
 {
 public:
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 
+#include "Interop/Connection/OutgoingMessageStats.h"
 #include "SpatialConstants.h"
 
 #include <WorkerSDK/improbable/c_schema.h>
@@ -11,6 +12,7 @@
 
 #include "SpatialMetrics.generated.h"
 
+class SpatialOSWorkerInterface;
 class USpatialWorkerConnection;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSpatialMetrics, Log, All);
@@ -21,7 +23,8 @@ class SPATIALGDK_API USpatialMetrics : public UObject
 	GENERATED_BODY()
 
 public:
-	void Init(USpatialWorkerConnection* Connection, float MaxServerTickRate, bool bIsServer);
+	// Outgoing message stats are only reported for WorkerConnection, which may be null if the net driver uses another connection.
+	void Init(SpatialOSWorkerInterface* Connection, USpatialWorkerConnection* WorkerConnection, float MaxServerTickRate, bool bIsServer);
 
 	void TickMetrics(float NetDriverTime);
 
@@ -57,8 +60,9 @@ public:
 
 private:
 
+	SpatialOSWorkerInterface* Connection;
 	UPROPERTY()
-	USpatialWorkerConnection* Connection;
+	USpatialWorkerConnection* WorkerConnection;
 
 	bool bIsServer;
 	float NetServerMaxTickRate;
@@ -71,6 +75,9 @@ private:
 	double AverageFPS;
 	double WorkerLoad;
 
+	// Outgoing message histograms as of the last report. Only the samples recorded since then are reported each time.
+	SpatialGDK::FOutgoingMessageStats ReportedOutgoingMessageStats;
+
 	// RPC tracking is activated with "SpatialStartRPCMetrics" and stopped with "SpatialStopRPCMetrics"
 	// console command. It will record every sent RPC as well as the size of its payload, and then display
 	// tracked data upon stopping. Calling these console commands on the client will also start/stop RPC
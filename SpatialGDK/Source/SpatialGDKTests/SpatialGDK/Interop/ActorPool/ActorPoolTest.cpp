@@ -0,0 +1,131 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "Interop/ActorPool.h"
+#include "PooledActorSpy.h"
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+
+#define ACTORPOOL_TEST(TestName) \
+	GDK_TEST(Core, ActorPool, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	TArray<FPooledActorClass> CreatePooledActorClasses(int32 MaxPooledActors)
+	{
+		FPooledActorClass PooledActorClass;
+		PooledActorClass.ActorClass = APooledActorSpy::StaticClass();
+		PooledActorClass.MaxPooledActors = MaxPooledActors;
+		return { PooledActorClass };
+	}
+
+	bool Park(FActorPool& Pool, AActor* Actor)
+	{
+		if (!Pool.BeginParking(Actor))
+		{
+			return false;
+		}
+		Pool.FinishParking();
+		return true;
+	}
+} // anonymous namespace
+
+ACTORPOOL_TEST(GIVEN_pooled_actor_classes_WHEN_classes_are_checked_THEN_only_the_exact_classes_are_pooled)
+{
+	// GIVEN
+	FActorPool Pool(CreatePooledActorClasses(4));
+
+	// WHEN
+	const bool bSpyPooled = Pool.IsPooledClass(APooledActorSpy::StaticClass());
+	const bool bParentPooled = Pool.IsPooledClass(AActor::StaticClass());
+
+	// THEN
+	TestTrue("Configured class is pooled", bSpyPooled);
+	TestFalse("Parent class is not pooled", bParentPooled);
+	TestTrue("No stats for classes that aren't pooled", Pool.GetClassStats(AActor::StaticClass()) == nullptr);
+
+	return true;
+}
+
+ACTORPOOL_TEST(GIVEN_a_configured_class_without_pooling_hooks_WHEN_it_is_checked_THEN_it_is_not_pooled)
+{
+	// GIVEN
+	FPooledActorClass ClassWithoutHooks;
+	ClassWithoutHooks.ActorClass = APawn::StaticClass();
+	ClassWithoutHooks.MaxPooledActors = 4;
+	FActorPool Pool({ ClassWithoutHooks });
+
+	AddExpectedError(TEXT("doesn't implement ISpatialPooledActor"), EAutomationExpectedErrorFlags::Contains, 1);
+
+	// WHEN
+	const bool bPawnPooled = Pool.IsPooledClass(APawn::StaticClass());
+
+	// THEN
+	TestFalse("Class that doesn't implement ISpatialPooledActor is not pooled", bPawnPooled);
+	TestTrue("No stats for classes that aren't pooled", Pool.GetClassStats(APawn::StaticClass()) == nullptr);
+
+	return true;
+}
+
+ACTORPOOL_TEST(GIVEN_a_parked_actor_WHEN_an_actor_of_its_class_is_taken_THEN_it_is_reused_and_restored)
+{
+	// GIVEN
+	FActorPool Pool(CreatePooledActorClasses(4));
+	APooledActorSpy* Actor = NewObject<APooledActorSpy>();
+	const bool bParked = Park(Pool, Actor);
+
+	// THEN
+	TestTrue("Actor parked", bParked);
+	TestEqual("Parked hook called", Actor->TimesParked, 1);
+	TestEqual("Taken hook not called yet", Actor->TimesTaken, 0);
+	TestFalse("Not parking anymore", Pool.IsParking(Actor));
+	TestTrue("Parked actor hidden", Actor->bHidden);
+	TestFalse("Parked actor collision disabled", Actor->GetActorEnableCollision());
+	TestEqual("One actor parked", Pool.GetNumParkedActors(APooledActorSpy::StaticClass()), 1);
+
+	// WHEN
+	AActor* FirstTaken = Pool.Take(APooledActorSpy::StaticClass(), FTransform::Identity);
+	AActor* SecondTaken = Pool.Take(APooledActorSpy::StaticClass(), FTransform::Identity);
+
+	// THEN
+	TestTrue("Parked actor reused", FirstTaken == Actor);
+	TestTrue("Nothing left to reuse", SecondTaken == nullptr);
+	TestFalse("Reused actor visible", Actor->bHidden);
+	TestTrue("Reused actor collision enabled", Actor->GetActorEnableCollision());
+	TestEqual("Taken hook called once", Actor->TimesTaken, 1);
+
+	const FActorPool::FClassStats* Stats = Pool.GetClassStats(APooledActorSpy::StaticClass());
+	TestTrue("Stats for pooled class", Stats != nullptr);
+	if (Stats != nullptr)
+	{
+		TestEqual("Hits", Stats->Hits, uint64(1));
+		TestEqual("Misses", Stats->Misses, uint64(1));
+		TestEqual("Parked", Stats->Parked, uint64(1));
+	}
+
+	return true;
+}
+
+ACTORPOOL_TEST(GIVEN_a_full_pool_WHEN_another_actor_is_parked_THEN_it_is_refused)
+{
+	// GIVEN
+	FActorPool Pool(CreatePooledActorClasses(1));
+	Park(Pool, NewObject<APooledActorSpy>());
+
+	// WHEN
+	AActor* Actor = NewObject<APooledActorSpy>();
+	const bool bParked = Park(Pool, Actor);
+
+	// THEN
+	TestFalse("Actor refused", bParked);
+	TestFalse("Refused actor not parking", Pool.IsParking(Actor));
+	TestEqual("Pool still holds one actor", Pool.GetNumParkedActors(APooledActorSpy::StaticClass()), 1);
+	TestEqual("Overflow counted", Pool.GetClassStats(APooledActorSpy::StaticClass())->Overflows, uint64(1));
+
+	return true;
+}
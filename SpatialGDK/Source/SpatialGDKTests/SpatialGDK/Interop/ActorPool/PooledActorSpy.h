@@ -0,0 +1,22 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Interop/SpatialPooledActor.h"
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+
+#include "PooledActorSpy.generated.h"
+
+UCLASS()
+class APooledActorSpy : public AActor, public ISpatialPooledActor
+{
+	GENERATED_BODY()
+public:
+	virtual void OnParkedInPool() override;
+	virtual void OnTakenFromPool() override;
+
+	int32 TimesParked = 0;
+	int32 TimesTaken = 0;
+};
@@ -0,0 +1,87 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "Interop/ComponentViewSnapshot.h"
+#include "Interop/EntityComponentStore.h"
+#include "Schema/StandardLibrary.h"
+
+#include "CoreMinimal.h"
+
+#define COMPONENTVIEWSNAPSHOT_TEST(TestName) \
+	GDK_TEST(Core, ComponentViewSnapshot, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	const Worker_EntityId TestEntityId = 1;
+	const Worker_ComponentId TestComponentId = 1000;
+
+	void AddComponent(FEntityComponentStore& Live, FComponentViewSnapshots& Snapshots, Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+	{
+		Live.AddComponentWithoutData(EntityId, ComponentId);
+		Snapshots.MarkChanged(EntityId, ComponentId);
+	}
+} // anonymous namespace
+
+COMPONENTVIEWSNAPSHOT_TEST(GIVEN_changes_to_the_live_view_WHEN_published_THEN_only_published_changes_are_in_the_snapshot)
+{
+	// GIVEN
+	FEntityComponentStore Live;
+	FComponentViewSnapshots Snapshots;
+
+	Worker_ComponentData Data = Position(Coordinates{ 1.0, 2.0, 3.0 }).CreatePositionData();
+	Live.AddComponent<Position>(TestEntityId, Data);
+	Schema_DestroyComponentData(Data.schema_type);
+	Live.SetAuthority(TestEntityId, Position::ComponentId, WORKER_AUTHORITY_AUTHORITATIVE);
+	Snapshots.MarkChanged(TestEntityId, Position::ComponentId);
+
+	// WHEN
+	const bool bPublished = Snapshots.Publish(Live);
+	AddComponent(Live, Snapshots, TestEntityId, TestComponentId);
+
+	// THEN
+	TestTrue("Published", bPublished);
+	FComponentViewSnapshotRef Snapshot = Snapshots.Acquire();
+	TestTrue("Authority in snapshot", Snapshot->HasAuthority(TestEntityId, Position::ComponentId));
+	const Position* SnapshotPosition = Snapshot->GetComponentData<Position>(TestEntityId);
+	TestTrue("Position copied", SnapshotPosition != nullptr && SnapshotPosition->Coords.Z == 3.0);
+	TestTrue("Position is a copy", static_cast<const void*>(SnapshotPosition) != static_cast<const void*>(Live.FindComponent(TestEntityId, Position::ComponentId)));
+	TestFalse("Unpublished change not in snapshot", Snapshot->HasComponent(TestEntityId, TestComponentId));
+
+	return true;
+}
+
+COMPONENTVIEWSNAPSHOT_TEST(GIVEN_a_reader_holding_the_back_snapshot_WHEN_published_THEN_publishing_is_skipped_until_it_is_released)
+{
+	// GIVEN
+	FEntityComponentStore Live;
+	FComponentViewSnapshots Snapshots;
+	AddComponent(Live, Snapshots, TestEntityId, TestComponentId);
+	Snapshots.Publish(Live);
+	FComponentViewSnapshotRef HeldSnapshot = Snapshots.Acquire();
+
+	AddComponent(Live, Snapshots, TestEntityId, TestComponentId + 1);
+	Snapshots.Publish(Live);
+
+	// WHEN
+	AddComponent(Live, Snapshots, TestEntityId, TestComponentId + 2);
+	const bool bPublishedWhileHeld = Snapshots.Publish(Live);
+	const bool bHeldSnapshotUnchanged = !HeldSnapshot->HasComponent(TestEntityId, TestComponentId + 1);
+	HeldSnapshot.Release();
+	const bool bPublishedAfterRelease = Snapshots.Publish(Live);
+
+	// THEN
+	TestFalse("Publish skipped while the back snapshot is held", bPublishedWhileHeld);
+	TestTrue("Held snapshot unchanged", bHeldSnapshotUnchanged);
+	TestTrue("Published after release", bPublishedAfterRelease);
+
+	FComponentViewSnapshotRef Snapshot = Snapshots.Acquire();
+	TestTrue("First change", Snapshot->HasComponent(TestEntityId, TestComponentId));
+	TestTrue("Change of the skipped frame", Snapshot->HasComponent(TestEntityId, TestComponentId + 1));
+	TestTrue("Latest change", Snapshot->HasComponent(TestEntityId, TestComponentId + 2));
+	TestEqual("Publish count", Snapshot->GetPublishCount(), uint64(3));
+
+	return true;
+}
@@ -0,0 +1,261 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "Interop/Connection/MockSpatialOSRuntime.h"
+#include "Schema/Interest.h"
+#include "Schema/StandardLibrary.h"
+#include "SpatialConstants.h"
+
+#include "CoreMinimal.h"
+
+#define MOCKSPATIALOSRUNTIME_TEST(TestName) \
+	GDK_TEST(Core, MockSpatialOSRuntime, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	const Worker_ComponentId TestComponentId = 1000;
+	const Worker_ComponentId ClientComponentId = 1001;
+	const Schema_FieldId TestFieldId = 1;
+	const uint32 TestFieldValue = 7;
+
+	const FString ServerAttribute = TEXT("UnrealWorker");
+	const FString ClientWorkerId = TEXT("Client");
+
+	FWorkerComponentData CreateTestComponentData(Worker_ComponentId ComponentId, uint32 Value)
+	{
+		Worker_ComponentData Data{};
+		Data.component_id = ComponentId;
+		Data.schema_type = Schema_CreateComponentData();
+		Schema_AddUint32(Schema_GetComponentDataFields(Data.schema_type), TestFieldId, Value);
+		return Data;
+	}
+
+	FWorkerComponentData CreateAclData(const WriteAclMap& WriteAcl)
+	{
+		const WorkerRequirementSet ReadAcl = { { ServerAttribute }, { FString::Printf(TEXT("workerId:%s"), *ClientWorkerId) } };
+		return EntityAcl(ReadAcl, WriteAcl).CreateEntityAclData();
+	}
+
+	// An entity owned by the server, carrying the test component.
+	TArray<FWorkerComponentData> CreateServerEntityComponents()
+	{
+		const WorkerRequirementSet ServerRequirement = { { ServerAttribute } };
+
+		TArray<FWorkerComponentData> Components;
+		Components.Add(CreateAclData({ { SpatialConstants::ENTITY_ACL_COMPONENT_ID, ServerRequirement }, { TestComponentId, ServerRequirement } }));
+		Components.Add(Position(Coordinates{ 0.0, 0.0, 0.0 }).CreatePositionData());
+		Components.Add(CreateTestComponentData(TestComponentId, 0));
+		return Components;
+	}
+
+	// An entity owned by the client, whose interest brings in every entity with the test component.
+	TArray<FWorkerComponentData> CreateClientEntityComponents()
+	{
+		const WorkerRequirementSet ClientRequirement = { { FString::Printf(TEXT("workerId:%s"), *ClientWorkerId) } };
+
+		QueryConstraint Constraint;
+		Constraint.ComponentConstraint = TestComponentId;
+		Query ClientQuery;
+		ClientQuery.Constraint = Constraint;
+		ClientQuery.FullSnapshotResult = true;
+		ComponentInterest ClientInterest;
+		ClientInterest.Queries.Add(ClientQuery);
+		Interest InterestComponent;
+		InterestComponent.ComponentInterestMap.Add(ClientComponentId, ClientInterest);
+
+		TArray<FWorkerComponentData> Components;
+		Components.Add(CreateAclData({ { ClientComponentId, ClientRequirement } }));
+		Components.Add(InterestComponent.CreateInterestData());
+		Components.Add(CreateTestComponentData(ClientComponentId, 0));
+		return Components;
+	}
+
+	const Worker_Op* FindOp(const TArray<Worker_OpList*>& OpLists, uint8 OpType, int32 Occurrence = 0)
+	{
+		for (const Worker_OpList* OpList : OpLists)
+		{
+			for (uint32 i = 0; i < OpList->op_count; ++i)
+			{
+				if (OpList->ops[i].op_type == OpType && Occurrence-- == 0)
+				{
+					return &OpList->ops[i];
+				}
+			}
+		}
+		return nullptr;
+	}
+
+	bool HasAuthorityChange(const TArray<Worker_OpList*>& OpLists, Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+	{
+		for (int32 i = 0; const Worker_Op* Op = FindOp(OpLists, WORKER_OP_TYPE_AUTHORITY_CHANGE, i); ++i)
+		{
+			if (Op->op.authority_change.entity_id == EntityId && Op->op.authority_change.component_id == ComponentId)
+			{
+				return Op->op.authority_change.authority == WORKER_AUTHORITY_AUTHORITATIVE;
+			}
+		}
+		return false;
+	}
+} // anonymous namespace
+
+MOCKSPATIALOSRUNTIME_TEST(GIVEN_an_entity_delegated_to_a_server_WHEN_the_server_gets_ops_THEN_it_receives_the_entity_and_authority)
+{
+	// GIVEN
+	FMockSpatialOSRuntime Runtime;
+	TUniquePtr<FMockSpatialOSWorkerConnection> Server = Runtime.ConnectWorker(TEXT("Server"), { ServerAttribute });
+	const Worker_EntityId EntityId = Runtime.CreateEntity(CreateServerEntityComponents());
+
+	// WHEN
+	TArray<Worker_OpList*> OpLists = Server->GetOpList();
+
+	// THEN
+	const Worker_Op* AddEntityOp = FindOp(OpLists, WORKER_OP_TYPE_ADD_ENTITY);
+	TestTrue("Entity added", AddEntityOp != nullptr && AddEntityOp->op.add_entity.entity_id == EntityId);
+	TestTrue("Added inside a critical section", FindOp(OpLists, WORKER_OP_TYPE_CRITICAL_SECTION) != nullptr);
+	TestTrue("Authoritative over the test component", HasAuthorityChange(OpLists, EntityId, TestComponentId));
+	TestTrue("Entity in view", Server->IsEntityInView(EntityId));
+	TestTrue("Runtime reports server as authoritative", Runtime.GetAuthoritativeWorker(EntityId, TestComponentId) == Server.Get());
+	TestEqual("No more ops", Server->GetOpList().Num(), 0);
+
+	return true;
+}
+
+MOCKSPATIALOSRUNTIME_TEST(GIVEN_a_client_with_interest_in_an_entity_WHEN_the_server_updates_it_THEN_the_update_is_forwarded_to_the_client)
+{
+	// GIVEN
+	FMockSpatialOSRuntime Runtime;
+	TUniquePtr<FMockSpatialOSWorkerConnection> Server = Runtime.ConnectWorker(TEXT("Server"), { ServerAttribute });
+	TUniquePtr<FMockSpatialOSWorkerConnection> Client = Runtime.ConnectWorker(ClientWorkerId, { TEXT("UnrealClient") });
+	const Worker_EntityId ServerEntityId = Runtime.CreateEntity(CreateServerEntityComponents());
+	const Worker_EntityId ClientEntityId = Runtime.CreateEntity(CreateClientEntityComponents());
+	Server->GetOpList();
+	Client->GetOpList();
+
+	// WHEN
+	FWorkerComponentUpdate Update{};
+	Update.component_id = TestComponentId;
+	Update.schema_type = Schema_CreateComponentUpdate();
+	Schema_AddUint32(Schema_GetComponentUpdateFields(Update.schema_type), TestFieldId, TestFieldValue);
+	Server->SendComponentUpdate(ServerEntityId, &Update);
+
+	TArray<Worker_OpList*> ClientOps = Client->GetOpList();
+	TArray<Worker_OpList*> ServerOps = Server->GetOpList();
+
+	// THEN
+	TestTrue("Client sees the server entity", Client->IsEntityInView(ServerEntityId));
+	TestTrue("Client sees its own entity", Client->IsEntityInView(ClientEntityId));
+	TestFalse("Server does not see the client entity", Server->IsEntityInView(ClientEntityId));
+
+	const Worker_Op* UpdateOp = FindOp(ClientOps, WORKER_OP_TYPE_COMPONENT_UPDATE);
+	TestTrue("Client received the update", UpdateOp != nullptr && UpdateOp->op.component_update.entity_id == ServerEntityId);
+	if (UpdateOp != nullptr)
+	{
+		TestEqual("Forwarded value", Schema_GetUint32(Schema_GetComponentUpdateFields(UpdateOp->op.component_update.update.schema_type), TestFieldId), TestFieldValue);
+	}
+	TestTrue("Server does not receive its own update", FindOp(ServerOps, WORKER_OP_TYPE_COMPONENT_UPDATE) == nullptr);
+	TestEqual("Stored value", Schema_GetUint32(Schema_GetComponentDataFields(Runtime.GetComponentData(ServerEntityId, TestComponentId)), TestFieldId), TestFieldValue);
+
+	return true;
+}
+
+MOCKSPATIALOSRUNTIME_TEST(GIVEN_reserved_entity_ids_WHEN_an_entity_is_created_and_deleted_THEN_responses_are_received)
+{
+	// GIVEN
+	FMockSpatialOSRuntime Runtime;
+	TUniquePtr<FMockSpatialOSWorkerConnection> Server = Runtime.ConnectWorker(TEXT("Server"), { ServerAttribute });
+	const Worker_RequestId ReserveRequestId = Server->SendReserveEntityIdsRequest(2);
+	const Worker_Op* ReserveOp = FindOp(Server->GetOpList(), WORKER_OP_TYPE_RESERVE_ENTITY_IDS_RESPONSE);
+	TestTrue("Reserve response received", ReserveOp != nullptr && ReserveOp->op.reserve_entity_ids_response.request_id == ReserveRequestId);
+	if (ReserveOp == nullptr)
+	{
+		return true;
+	}
+	const Worker_EntityId EntityId = ReserveOp->op.reserve_entity_ids_response.first_entity_id;
+
+	// WHEN
+	Server->SendCreateEntityRequest(CreateServerEntityComponents(), &EntityId);
+	TArray<Worker_OpList*> CreateOps = Server->GetOpList();
+	const Worker_Op* CreateOp = FindOp(CreateOps, WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE);
+	const bool bCreated = CreateOp != nullptr && CreateOp->op.create_entity_response.status_code == WORKER_STATUS_CODE_SUCCESS;
+	const bool bAddedToView = FindOp(CreateOps, WORKER_OP_TYPE_ADD_ENTITY) != nullptr;
+
+	Server->SendDeleteEntityRequest(EntityId);
+	TArray<Worker_OpList*> DeleteOps = Server->GetOpList();
+
+	// THEN
+	TestTrue("Entity created", bCreated);
+	TestTrue("Created entity added to the view", bAddedToView);
+	const Worker_Op* DeleteOp = FindOp(DeleteOps, WORKER_OP_TYPE_DELETE_ENTITY_RESPONSE);
+	TestTrue("Entity deleted", DeleteOp != nullptr && DeleteOp->op.delete_entity_response.status_code == WORKER_STATUS_CODE_SUCCESS);
+	TestTrue("Deleted entity removed from the view", FindOp(DeleteOps, WORKER_OP_TYPE_REMOVE_ENTITY) != nullptr);
+	TestFalse("Entity no longer exists", Runtime.HasEntity(EntityId));
+
+	return true;
+}
+
+MOCKSPATIALOSRUNTIME_TEST(GIVEN_entities_WHEN_queried_by_component_THEN_only_matching_entities_are_returned)
+{
+	// GIVEN
+	FMockSpatialOSRuntime Runtime;
+	TUniquePtr<FMockSpatialOSWorkerConnection> Server = Runtime.ConnectWorker(TEXT("Server"), { ServerAttribute });
+	const Worker_EntityId ServerEntityId = Runtime.CreateEntity(CreateServerEntityComponents());
+	Runtime.CreateEntity(CreateClientEntityComponents());
+
+	// WHEN
+	Worker_EntityQuery Query{};
+	Query.constraint.constraint_type = WORKER_CONSTRAINT_TYPE_COMPONENT;
+	Query.constraint.constraint.component_constraint.component_id = TestComponentId;
+	Query.result_type = WORKER_RESULT_TYPE_SNAPSHOT;
+	Server->SendEntityQueryRequest(&Query);
+	const Worker_Op* QueryOp = FindOp(Server->GetOpList(), WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE);
+
+	// THEN
+	TestTrue("Query response received", QueryOp != nullptr);
+	if (QueryOp != nullptr)
+	{
+		const Worker_EntityQueryResponseOp& Response = QueryOp->op.entity_query_response;
+		TestEqual("Result count", Response.result_count, 1u);
+		TestTrue("Matching entity returned with its components", Response.results != nullptr && Response.results[0].entity_id == ServerEntityId && Response.results[0].component_count == 3);
+	}
+
+	return true;
+}
+
+MOCKSPATIALOSRUNTIME_TEST(GIVEN_an_op_list_that_is_held_on_to_WHEN_more_op_lists_are_received_THEN_it_stays_valid_until_it_is_destroyed)
+{
+	// GIVEN
+	FMockSpatialOSRuntime Runtime;
+	TUniquePtr<FMockSpatialOSWorkerConnection> Server = Runtime.ConnectWorker(TEXT("Server"), { ServerAttribute });
+	const Worker_EntityId FirstEntityId = Runtime.CreateEntity(CreateServerEntityComponents());
+	TArray<Worker_OpList*> FirstOpLists = Server->GetOpList();
+
+	// WHEN
+	const Worker_EntityId SecondEntityId = Runtime.CreateEntity(CreateServerEntityComponents());
+	TArray<Worker_OpList*> SecondOpLists = Server->GetOpList();
+
+	// THEN
+	const Worker_Op* FirstAddEntityOp = FindOp(FirstOpLists, WORKER_OP_TYPE_ADD_ENTITY);
+	const Worker_Op* SecondAddEntityOp = FindOp(SecondOpLists, WORKER_OP_TYPE_ADD_ENTITY);
+	TestTrue("First op list still holds the first entity", FirstAddEntityOp != nullptr && FirstAddEntityOp->op.add_entity.entity_id == FirstEntityId);
+	TestTrue("Second op list holds the second entity", SecondAddEntityOp != nullptr && SecondAddEntityOp->op.add_entity.entity_id == SecondEntityId);
+
+	// WHEN
+	for (Worker_OpList* OpList : FirstOpLists)
+	{
+		Server->DestroyOpList(OpList);
+	}
+
+	// THEN
+	SecondAddEntityOp = FindOp(SecondOpLists, WORKER_OP_TYPE_ADD_ENTITY);
+	TestTrue("Second op list unaffected", SecondAddEntityOp != nullptr && SecondAddEntityOp->op.add_entity.entity_id == SecondEntityId);
+
+	for (Worker_OpList* OpList : SecondOpLists)
+	{
+		Server->DestroyOpList(OpList);
+	}
+
+	return true;
+}
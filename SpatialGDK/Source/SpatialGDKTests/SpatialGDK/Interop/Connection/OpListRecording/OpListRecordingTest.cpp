@@ -0,0 +1,133 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "Interop/Connection/OpListRecorder.h"
+#include "Interop/Connection/OpListReplayer.h"
+
+#include "CoreMinimal.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#define OPLISTRECORDING_TEST(TestName) \
+	GDK_TEST(Core, OpListRecording, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	const Worker_EntityId TestEntityId = 42;
+	const Worker_ComponentId TestComponentId = 1000;
+	const Schema_FieldId TestFieldId = 1;
+	const Schema_FieldId TestClearedFieldId = 2;
+	const uint32 TestFieldValue = 7;
+
+	FString GetRecordingFilename()
+	{
+		return FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("OpListRecordingTest.ops"));
+	}
+
+	Worker_Op CreateAddEntityOp()
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_ADD_ENTITY;
+		Op.op.add_entity.entity_id = TestEntityId;
+		return Op;
+	}
+
+	Worker_Op CreateComponentUpdateOp(Schema_ComponentUpdate* SchemaUpdate)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_COMPONENT_UPDATE;
+		Op.op.component_update.entity_id = TestEntityId;
+		Op.op.component_update.update.component_id = TestComponentId;
+		Op.op.component_update.update.schema_type = SchemaUpdate;
+		return Op;
+	}
+
+	void RecordOps(TArray<Worker_Op>& Ops, int32 NumFrames)
+	{
+		TUniquePtr<FOpListRecorder> Recorder = FOpListRecorder::Create(GetRecordingFilename());
+		Worker_OpList OpList{};
+		OpList.ops = Ops.GetData();
+		OpList.op_count = Ops.Num();
+
+		for (int32 i = 0; i < NumFrames; i++)
+		{
+			Recorder->RecordFrame({ &OpList });
+		}
+	}
+} // anonymous namespace
+
+OPLISTRECORDING_TEST(GIVEN_a_recording_WHEN_replayed_at_maximum_speed_THEN_one_frame_is_returned_per_call)
+{
+	// GIVEN
+	TArray<Worker_Op> Ops;
+	Ops.Add(CreateAddEntityOp());
+	RecordOps(Ops, 2);
+
+	FOpListReplayer Replayer;
+	TestTrue("Recording loaded", Replayer.LoadRecording(GetRecordingFilename()));
+	Replayer.SetReplaySpeed(EOpListReplaySpeed::Maximum);
+
+	// WHEN
+	TArray<Worker_OpList*> FirstFrame = Replayer.GetOpList();
+	TArray<Worker_OpList*> SecondFrame = Replayer.GetOpList();
+	TArray<Worker_OpList*> ThirdFrame = Replayer.GetOpList();
+
+	// THEN
+	TestEqual("Frames in recording", Replayer.GetNumFrames(), 2);
+	TestEqual("First frame op lists", FirstFrame.Num(), 1);
+	TestEqual("Second frame op lists", SecondFrame.Num(), 1);
+	TestEqual("Nothing left to replay", ThirdFrame.Num(), 0);
+	TestTrue("Replay finished", Replayer.IsFinished());
+	TestTrue("Add entity op replayed", FirstFrame[0]->op_count == 1 && FirstFrame[0]->ops[0].op_type == WORKER_OP_TYPE_ADD_ENTITY && FirstFrame[0]->ops[0].op.add_entity.entity_id == TestEntityId);
+
+	IFileManager::Get().Delete(*GetRecordingFilename());
+	return true;
+}
+
+OPLISTRECORDING_TEST(GIVEN_a_recorded_component_update_WHEN_replayed_THEN_schema_payload_and_cleared_fields_are_restored)
+{
+	// GIVEN
+	Schema_ComponentUpdate* SchemaUpdate = Schema_CreateComponentUpdate();
+	Schema_AddUint32(Schema_GetComponentUpdateFields(SchemaUpdate), TestFieldId, TestFieldValue);
+	Schema_AddComponentUpdateClearedField(SchemaUpdate, TestClearedFieldId);
+
+	TArray<Worker_Op> Ops;
+	Ops.Add(CreateComponentUpdateOp(SchemaUpdate));
+	RecordOps(Ops, 1);
+	Schema_DestroyComponentUpdate(SchemaUpdate);
+
+	// WHEN
+	FOpListReplayer Replayer;
+	Replayer.LoadRecording(GetRecordingFilename());
+	Replayer.SetReplaySpeed(EOpListReplaySpeed::Maximum);
+	TArray<Worker_OpList*> Frame = Replayer.GetOpList();
+
+	// THEN
+	TestEqual("Frame op lists", Frame.Num(), 1);
+	const Worker_ComponentUpdateOp& Op = Frame[0]->ops[0].op.component_update;
+	TestTrue("Update has schema data", Op.update.schema_type != nullptr);
+	TestEqual("Entity id", static_cast<int64>(Op.entity_id), static_cast<int64>(TestEntityId));
+	TestEqual("Component id", Op.update.component_id, TestComponentId);
+	TestEqual("Field value", Schema_GetUint32(Schema_GetComponentUpdateFields(Op.update.schema_type), TestFieldId), TestFieldValue);
+	TestEqual("Cleared field count", Schema_GetComponentUpdateClearedFieldCount(Op.update.schema_type), 1u);
+
+	IFileManager::Get().Delete(*GetRecordingFilename());
+	return true;
+}
+
+OPLISTRECORDING_TEST(GIVEN_a_file_that_is_not_a_recording_WHEN_loaded_THEN_loading_fails)
+{
+	FFileHelper::SaveStringToFile(TEXT("Not a recording"), *GetRecordingFilename());
+	AddExpectedError(TEXT("is not an op recording"), EAutomationExpectedErrorFlags::Contains, 1);
+
+	FOpListReplayer Replayer;
+	TestFalse("Recording loaded", Replayer.LoadRecording(GetRecordingFilename()));
+	TestEqual("Frames in recording", Replayer.GetNumFrames(), 0);
+
+	IFileManager::Get().Delete(*GetRecordingFilename());
+	return true;
+}
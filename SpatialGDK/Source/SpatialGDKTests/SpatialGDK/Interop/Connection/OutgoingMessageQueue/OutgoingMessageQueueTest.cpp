@@ -0,0 +1,171 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "Interop/Connection/OutgoingMessageQueue.h"
+
+#include "CoreMinimal.h"
+
+#define OUTGOINGMESSAGEQUEUE_TEST(TestName) \
+	GDK_TEST(Core, FOutgoingMessageQueue, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	void IgnoreEnqueue(const FOutgoingMessage*)
+	{
+	}
+} // anonymous namespace
+
+OUTGOINGMESSAGEQUEUE_TEST(GIVEN_an_empty_queue_WHEN_peeked_THEN_nothing_is_returned)
+{
+	FOutgoingMessageQueue Queue(4);
+
+	TestTrue("Queue is empty", Queue.IsEmpty());
+	TestTrue("Peek returns nothing", Queue.Peek() == nullptr);
+
+	return true;
+}
+
+OUTGOINGMESSAGEQUEUE_TEST(GIVEN_a_capacity_that_is_not_a_power_of_two_WHEN_queue_is_created_THEN_capacity_is_rounded_up)
+{
+	FOutgoingMessageQueue Queue(5);
+
+	TestEqual("Capacity", Queue.GetCapacity(), 8u);
+
+	return true;
+}
+
+OUTGOINGMESSAGEQUEUE_TEST(GIVEN_queued_messages_WHEN_dequeued_THEN_they_are_returned_in_order)
+{
+	FOutgoingMessageQueue Queue(4);
+	Queue.TryEnqueue<FDeleteEntityRequest>(&IgnoreEnqueue, 1);
+	Queue.TryEnqueue<FRemoveComponent>(&IgnoreEnqueue, 2, 3);
+
+	TestEqual("Queue depth", Queue.Num(), 2u);
+
+	FOutgoingMessage* First = Queue.Peek();
+	TestTrue("First message is a delete entity request", First != nullptr && First->Type == EOutgoingMessageType::DeleteEntityRequest);
+	TestEqual("First message entity", static_cast<FDeleteEntityRequest*>(First)->EntityId, static_cast<Worker_EntityId>(1));
+	Queue.Pop();
+
+	FOutgoingMessage* Second = Queue.Peek();
+	TestTrue("Second message is a remove component", Second != nullptr && Second->Type == EOutgoingMessageType::RemoveComponent);
+	TestEqual("Second message component", static_cast<FRemoveComponent*>(Second)->ComponentId, static_cast<Worker_ComponentId>(3));
+	Queue.Pop();
+
+	TestTrue("Queue is empty", Queue.IsEmpty());
+
+	return true;
+}
+
+OUTGOINGMESSAGEQUEUE_TEST(GIVEN_a_full_queue_WHEN_enqueueing_THEN_it_fails_until_a_slot_is_released)
+{
+	FOutgoingMessageQueue Queue(2);
+	TestTrue("First enqueue succeeds", Queue.TryEnqueue<FDeleteEntityRequest>(&IgnoreEnqueue, 1));
+	TestTrue("Second enqueue succeeds", Queue.TryEnqueue<FDeleteEntityRequest>(&IgnoreEnqueue, 2));
+	TestFalse("Enqueue into full queue fails", Queue.TryEnqueue<FDeleteEntityRequest>(&IgnoreEnqueue, 3));
+
+	Queue.Pop();
+
+	TestTrue("Enqueue after pop succeeds", Queue.TryEnqueue<FDeleteEntityRequest>(&IgnoreEnqueue, 3));
+	TestEqual("Oldest remaining message", static_cast<FDeleteEntityRequest*>(Queue.Peek())->EntityId, static_cast<Worker_EntityId>(2));
+
+	return true;
+}
+
+OUTGOINGMESSAGEQUEUE_TEST(GIVEN_an_empty_queue_WHEN_enqueueing_THEN_only_the_first_message_since_it_was_drained_reports_it_empty)
+{
+	FOutgoingMessageQueue Queue(4);
+	bool bFirstWasEmpty = false;
+	bool bSecondWasEmpty = true;
+	Queue.TryEnqueue<FDeleteEntityRequest>(bFirstWasEmpty, &IgnoreEnqueue, 1);
+	Queue.TryEnqueue<FDeleteEntityRequest>(bSecondWasEmpty, &IgnoreEnqueue, 2);
+
+	TestTrue("First message found the queue empty", bFirstWasEmpty);
+	TestFalse("Second message did not find the queue empty", bSecondWasEmpty);
+
+	Queue.Pop();
+	bool bAfterPopWasEmpty = true;
+	Queue.TryEnqueue<FDeleteEntityRequest>(bAfterPopWasEmpty, &IgnoreEnqueue, 3);
+
+	TestFalse("Message queued behind an undrained one did not find the queue empty", bAfterPopWasEmpty);
+
+	Queue.Pop();
+	Queue.Pop();
+	bool bAfterDrainWasEmpty = false;
+	Queue.TryEnqueue<FDeleteEntityRequest>(bAfterDrainWasEmpty, &IgnoreEnqueue, 4);
+
+	TestTrue("Message queued after the queue was drained found it empty", bAfterDrainWasEmpty);
+
+	return true;
+}
+
+OUTGOINGMESSAGEQUEUE_TEST(GIVEN_a_full_queue_that_has_wrapped_around_WHEN_grown_THEN_messages_keep_their_order_and_more_can_be_queued)
+{
+	FOutgoingMessageQueue Queue(2);
+	Queue.TryEnqueue<FDeleteEntityRequest>(&IgnoreEnqueue, 1);
+	Queue.Pop();
+	Queue.TryEnqueue<FCommandFailure>(&IgnoreEnqueue, 2, FString(TEXT("Some failure message")));
+	Queue.TryEnqueue<FDeleteEntityRequest>(&IgnoreEnqueue, 3);
+
+	Queue.Grow();
+
+	TestEqual("Capacity doubled", Queue.GetCapacity(), 4u);
+	TestTrue("Enqueue after growing succeeds", Queue.TryEnqueue<FDeleteEntityRequest>(&IgnoreEnqueue, 4));
+	TestTrue("Enqueue after growing succeeds", Queue.TryEnqueue<FDeleteEntityRequest>(&IgnoreEnqueue, 5));
+	TestFalse("Enqueue into grown full queue fails", Queue.TryEnqueue<FDeleteEntityRequest>(&IgnoreEnqueue, 6));
+
+	FCommandFailure* Failure = static_cast<FCommandFailure*>(Queue.Peek());
+	if (!TestTrue("Relocated message is first", Failure != nullptr && Failure->Type == EOutgoingMessageType::CommandFailure))
+	{
+		return true;
+	}
+	TestEqual("Relocated message keeps its data", Failure->Message, FString(TEXT("Some failure message")));
+	Queue.Pop();
+
+	TestEqual("Second message", static_cast<FDeleteEntityRequest*>(Queue.Peek())->EntityId, static_cast<Worker_EntityId>(3));
+	Queue.Pop();
+	TestEqual("Third message", static_cast<FDeleteEntityRequest*>(Queue.Peek())->EntityId, static_cast<Worker_EntityId>(4));
+	Queue.Pop();
+	TestEqual("Fourth message", static_cast<FDeleteEntityRequest*>(Queue.Peek())->EntityId, static_cast<Worker_EntityId>(5));
+	Queue.Pop();
+	TestTrue("Queue is empty", Queue.IsEmpty());
+
+	return true;
+}
+
+OUTGOINGMESSAGEQUEUE_TEST(GIVEN_a_message_with_owned_data_WHEN_popped_THEN_its_destructor_runs)
+{
+	FOutgoingMessageQueue Queue(2);
+	Queue.TryEnqueue<FCommandFailure>(&IgnoreEnqueue, 1, FString(TEXT("Some failure message")));
+
+	TestEqual("Message contents", static_cast<FCommandFailure*>(Queue.Peek())->Message, FString(TEXT("Some failure message")));
+	Queue.Pop();
+
+	// Wrap around the ring to make sure the released slot is reusable.
+	for (int32 i = 0; i < 4; i++)
+	{
+		TestTrue("Enqueue succeeds", Queue.TryEnqueue<FCommandFailure>(&IgnoreEnqueue, i, FString::FromInt(i)));
+		TestEqual("Message contents", static_cast<FCommandFailure*>(Queue.Peek())->Message, FString::FromInt(i));
+		Queue.Pop();
+	}
+
+	return true;
+}
+
+OUTGOINGMESSAGEQUEUE_TEST(GIVEN_an_enqueue_callback_WHEN_message_is_enqueued_THEN_callback_receives_the_constructed_message)
+{
+	FOutgoingMessageQueue Queue(2);
+	const FOutgoingMessage* CallbackMessage = nullptr;
+
+	Queue.TryEnqueue<FReserveEntityIdsRequest>([&CallbackMessage](const FOutgoingMessage* Message)
+	{
+		CallbackMessage = Message;
+	}, 10);
+
+	TestTrue("Callback received the queued message", CallbackMessage != nullptr && CallbackMessage == Queue.Peek());
+
+	return true;
+}
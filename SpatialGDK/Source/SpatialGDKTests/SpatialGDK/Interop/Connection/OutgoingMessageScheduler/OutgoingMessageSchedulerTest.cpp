@@ -0,0 +1,339 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "Interop/Connection/OutgoingMessageScheduler.h"
+
+#include "CoreMinimal.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+
+#define OUTGOINGMESSAGESCHEDULER_TEST(TestName) \
+	GDK_TEST(Core, OutgoingMessageScheduler, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	const Worker_EntityId TestEntityId = 1;
+	const Worker_EntityId OtherEntityId = 2;
+	const Worker_ComponentId TestComponentId = 1000;
+
+	FOutgoingMessageBudget CreateBudget(uint32 MaxMessagesPerFlush, uint32 MaxDeferredFlushes = 0)
+	{
+		FOutgoingMessageBudget Budget;
+		Budget.MaxMessagesPerFlush = MaxMessagesPerFlush;
+		Budget.MaxDeferredFlushes = MaxDeferredFlushes;
+		return Budget;
+	}
+
+	FComponentUpdate CreateUpdate(Worker_EntityId EntityId)
+	{
+		FWorkerComponentUpdate Update{};
+		Update.component_id = TestComponentId;
+		return FComponentUpdate(EntityId, Update);
+	}
+
+	FLogMessage CreateLogMessage()
+	{
+		return FLogMessage(WORKER_LOG_LEVEL_INFO, FName(TEXT("Test")), TEXT("Test log"));
+	}
+
+	// Records the type and entity of every message that is sent.
+	struct FSentMessages
+	{
+		TArray<EOutgoingMessageType> Types;
+		TArray<Worker_EntityId> EntityIds;
+
+		bool Record(FOutgoingMessage& Message)
+		{
+			Types.Add(Message.Type);
+			if (Message.Type == EOutgoingMessageType::ComponentUpdate)
+			{
+				EntityIds.Add(static_cast<FComponentUpdate&>(Message).EntityId);
+			}
+			else if (Message.Type == EOutgoingMessageType::DeleteEntityRequest)
+			{
+				EntityIds.Add(static_cast<FDeleteEntityRequest&>(Message).EntityId);
+			}
+			return true;
+		}
+	};
+} // anonymous namespace
+
+OUTGOINGMESSAGESCHEDULER_TEST(GIVEN_no_budget_WHEN_messages_are_scheduled_THEN_all_are_sent_in_order)
+{
+	// GIVEN
+	FOutgoingMessageScheduler Scheduler(CreateBudget(0));
+	FSentMessages Sent;
+	const auto Send = [&Sent](FOutgoingMessage& Message) { return Sent.Record(Message); };
+
+	FLogMessage LogMessage = CreateLogMessage();
+	FDeleteEntityRequest DeleteRequest(TestEntityId);
+	FComponentUpdate Update = CreateUpdate(OtherEntityId);
+
+	// WHEN
+	Scheduler.BeginFlush(Send);
+	Scheduler.Schedule(LogMessage, Send);
+	Scheduler.Schedule(DeleteRequest, Send);
+	Scheduler.Schedule(Update, Send);
+	Scheduler.EndFlush(Send);
+
+	// THEN
+	TestEqual("Messages sent", Sent.Types.Num(), 3);
+	TestTrue("Sent in queue order", Sent.Types.Num() == 3
+		&& Sent.Types[0] == EOutgoingMessageType::LogMessage
+		&& Sent.Types[1] == EOutgoingMessageType::DeleteEntityRequest
+		&& Sent.Types[2] == EOutgoingMessageType::ComponentUpdate);
+	TestEqual("Nothing deferred", Scheduler.GetNumDeferredMessages(), 0);
+
+	return true;
+}
+
+OUTGOINGMESSAGESCHEDULER_TEST(GIVEN_an_exhausted_budget_WHEN_messages_are_scheduled_THEN_component_updates_are_still_sent_and_the_rest_is_deferred)
+{
+	// GIVEN
+	FOutgoingMessageScheduler Scheduler(CreateBudget(1));
+	FSentMessages Sent;
+	const auto Send = [&Sent](FOutgoingMessage& Message) { return Sent.Record(Message); };
+
+	FDeleteEntityRequest FirstDelete(TestEntityId);
+	FDeleteEntityRequest SecondDelete(OtherEntityId);
+	FLogMessage LogMessage = CreateLogMessage();
+	FComponentUpdate Update = CreateUpdate(3);
+
+	// WHEN
+	Scheduler.BeginFlush(Send);
+	Scheduler.Schedule(FirstDelete, Send);
+	Scheduler.Schedule(SecondDelete, Send);
+	Scheduler.Schedule(LogMessage, Send);
+	Scheduler.Schedule(Update, Send);
+	Scheduler.EndFlush(Send);
+
+	// THEN
+	TestEqual("Messages sent", Sent.Types.Num(), 2);
+	TestTrue("First delete and the update were sent", Sent.Types.Num() == 2
+		&& Sent.Types[0] == EOutgoingMessageType::DeleteEntityRequest
+		&& Sent.Types[1] == EOutgoingMessageType::ComponentUpdate);
+	TestEqual("Second delete and log deferred", Scheduler.GetNumDeferredMessages(), 2);
+
+	// WHEN
+	Sent = FSentMessages();
+	Scheduler.BeginFlush(Send);
+	Scheduler.EndFlush(Send);
+
+	// THEN
+	TestTrue("Deferred delete sent on the next flush", Sent.Types.Num() == 1 && Sent.Types[0] == EOutgoingMessageType::DeleteEntityRequest);
+
+	// WHEN
+	Sent = FSentMessages();
+	Scheduler.BeginFlush(Send);
+	Scheduler.EndFlush(Send);
+
+	// THEN
+	TestTrue("Deferred log sent once normal traffic is done", Sent.Types.Num() == 1 && Sent.Types[0] == EOutgoingMessageType::LogMessage);
+	TestEqual("Nothing deferred", Scheduler.GetNumDeferredMessages(), 0);
+
+	return true;
+}
+
+OUTGOINGMESSAGESCHEDULER_TEST(GIVEN_a_deferred_message_to_an_entity_WHEN_an_update_to_that_entity_is_scheduled_THEN_the_update_is_sent_after_it)
+{
+	// GIVEN
+	FOutgoingMessageScheduler Scheduler(CreateBudget(1));
+	FSentMessages Sent;
+	const auto Send = [&Sent](FOutgoingMessage& Message) { return Sent.Record(Message); };
+
+	FDeleteEntityRequest FirstDelete(OtherEntityId);
+	FDeleteEntityRequest DeferredDelete(TestEntityId);
+	FComponentUpdate BlockedUpdate = CreateUpdate(TestEntityId);
+	FComponentUpdate OtherUpdate = CreateUpdate(OtherEntityId);
+
+	// WHEN
+	Scheduler.BeginFlush(Send);
+	Scheduler.Schedule(FirstDelete, Send);
+	Scheduler.Schedule(DeferredDelete, Send);
+	Scheduler.Schedule(BlockedUpdate, Send);
+	Scheduler.Schedule(OtherUpdate, Send);
+	Scheduler.EndFlush(Send);
+
+	// THEN
+	TestTrue("Update to another entity overtakes the deferred delete", Sent.EntityIds.Num() == 2 && Sent.EntityIds[1] == OtherEntityId);
+	TestEqual("Delete and blocked update deferred", Scheduler.GetNumDeferredMessages(), 2);
+
+	// WHEN
+	Sent = FSentMessages();
+	Scheduler.BeginFlush(Send);
+	Scheduler.EndFlush(Send);
+	Scheduler.BeginFlush(Send);
+	Scheduler.EndFlush(Send);
+
+	// THEN
+	TestTrue("Delete sent before the update", Sent.Types.Num() == 2
+		&& Sent.Types[0] == EOutgoingMessageType::DeleteEntityRequest
+		&& Sent.Types[1] == EOutgoingMessageType::ComponentUpdate);
+
+	return true;
+}
+
+OUTGOINGMESSAGESCHEDULER_TEST(GIVEN_budget_used_up_by_component_updates_WHEN_a_message_has_been_deferred_for_too_long_THEN_it_is_sent_anyway)
+{
+	// GIVEN
+	FOutgoingMessageScheduler Scheduler(CreateBudget(1, /*MaxDeferredFlushes*/ 2));
+	FSentMessages Sent;
+	const auto Send = [&Sent](FOutgoingMessage& Message) { return Sent.Record(Message); };
+
+	FComponentUpdate FirstUpdate = CreateUpdate(OtherEntityId);
+	FLogMessage LogMessage = CreateLogMessage();
+
+	Scheduler.BeginFlush(Send);
+	Scheduler.Schedule(FirstUpdate, Send);
+	Scheduler.Schedule(LogMessage, Send);
+	Scheduler.EndFlush(Send);
+	TestEqual("Log deferred", Scheduler.GetNumDeferredMessages(), 1);
+
+	// WHEN
+	for (int32 Flush = 0; Flush < 2; ++Flush)
+	{
+		FComponentUpdate Update = CreateUpdate(OtherEntityId);
+		Scheduler.BeginFlush(Send);
+		Scheduler.Schedule(Update, Send);
+		Scheduler.EndFlush(Send);
+	}
+
+	// THEN
+	TestTrue("Log sent once starved", Sent.Types.Contains(EOutgoingMessageType::LogMessage));
+	TestEqual("Nothing deferred", Scheduler.GetNumDeferredMessages(), 0);
+
+	return true;
+}
+
+OUTGOINGMESSAGESCHEDULER_TEST(GIVEN_a_deferred_create_entity_request_WHEN_a_command_request_is_scheduled_THEN_each_gets_the_request_id_predicted_when_queued)
+{
+	// GIVEN
+	FOutgoingMessageScheduler Scheduler(CreateBudget(1));
+
+	// Request ids are predicted in the order messages are queued, and assigned by the SDK in the order they are sent.
+	FDeleteEntityRequest FirstDelete(OtherEntityId);
+	FCreateEntityRequest CreateRequest(TArray<FWorkerComponentData>(), &TestEntityId);
+	FCommandRequest CommandRequest(TestEntityId, Worker_CommandRequest{}, 1);
+	const TMap<const FOutgoingMessage*, Worker_RequestId> PredictedRequestIds = {
+		{ &FirstDelete, 0 },
+		{ &CreateRequest, 1 },
+		{ &CommandRequest, 2 }
+	};
+
+	TMap<const FOutgoingMessage*, Worker_RequestId> AssignedRequestIds;
+	Worker_RequestId NextSdkRequestId = 0;
+	const auto Send = [&AssignedRequestIds, &NextSdkRequestId](FOutgoingMessage& Message)
+	{
+		if (IsOutgoingRequest(Message.Type))
+		{
+			AssignedRequestIds.Add(&Message, NextSdkRequestId++);
+		}
+		return true;
+	};
+
+	// WHEN
+	Scheduler.BeginFlush(Send);
+	Scheduler.Schedule(FirstDelete, Send);
+	Scheduler.Schedule(CreateRequest, Send);
+	Scheduler.Schedule(CommandRequest, Send);
+	Scheduler.EndFlush(Send);
+
+	// THEN
+	TestEqual("Create entity and command requests deferred", Scheduler.GetNumDeferredMessages(), 2);
+
+	// WHEN
+	for (int32 Flush = 0; Flush < 2; ++Flush)
+	{
+		Scheduler.BeginFlush(Send);
+		Scheduler.EndFlush(Send);
+	}
+
+	// THEN
+	TestEqual("Nothing deferred", Scheduler.GetNumDeferredMessages(), 0);
+	TestEqual("Create entity request id", AssignedRequestIds.FindRef(&CreateRequest), PredictedRequestIds.FindRef(&CreateRequest));
+	TestEqual("Command request id", AssignedRequestIds.FindRef(&CommandRequest), PredictedRequestIds.FindRef(&CommandRequest));
+
+	return true;
+}
+
+OUTGOINGMESSAGESCHEDULER_TEST(GIVEN_component_updates_held_back_to_be_coalesced_WHEN_they_are_sent_THEN_the_budget_is_charged_once_per_sent_update)
+{
+	// GIVEN
+	FOutgoingMessageScheduler Scheduler(CreateBudget(2));
+	FSentMessages Sent;
+	const auto HoldBackUpdates = [&Sent](FOutgoingMessage& Message)
+	{
+		return Message.Type == EOutgoingMessageType::ComponentUpdate ? false : Sent.Record(Message);
+	};
+
+	FComponentUpdate FirstUpdate = CreateUpdate(TestEntityId);
+	FComponentUpdate SecondUpdate = CreateUpdate(TestEntityId);
+	FDeleteEntityRequest FirstDelete(OtherEntityId);
+	FDeleteEntityRequest SecondDelete(3);
+
+	// WHEN
+	Scheduler.BeginFlush(HoldBackUpdates);
+	Scheduler.Schedule(FirstUpdate, HoldBackUpdates);
+	Scheduler.Schedule(SecondUpdate, HoldBackUpdates);
+
+	// THEN
+	TestEqual("Held back updates not charged", Scheduler.GetNumMessagesSentThisFlush(), 0u);
+
+	// WHEN
+	// Both updates were merged into one, sent when flushed.
+	Scheduler.ChargeSentMessage(0);
+	Scheduler.Schedule(FirstDelete, HoldBackUpdates);
+	Scheduler.Schedule(SecondDelete, HoldBackUpdates);
+	Scheduler.EndFlush(HoldBackUpdates);
+
+	// THEN
+	TestEqual("Merged update and first delete charged", Scheduler.GetNumMessagesSentThisFlush(), 2u);
+	TestTrue("First delete sent", Sent.Types.Num() == 1 && Sent.EntityIds[0] == OtherEntityId);
+	TestEqual("Second delete deferred", Scheduler.GetNumDeferredMessages(), 1);
+
+	return true;
+}
+
+OUTGOINGMESSAGESCHEDULER_TEST(GIVEN_deferred_messages_WHEN_they_are_dropped_THEN_none_are_sent_and_later_messages_are_not_held_behind_them)
+{
+	// GIVEN
+	FOutgoingMessageScheduler Scheduler(CreateBudget(1));
+	FSentMessages Sent;
+	const auto Send = [&Sent](FOutgoingMessage& Message) { return Sent.Record(Message); };
+
+	FDeleteEntityRequest FirstDelete(OtherEntityId);
+	FWorkerComponentData Data{};
+	Data.component_id = TestComponentId;
+	Data.schema_type = Schema_CreateComponentData();
+	FAddComponent AddComponent(TestEntityId, Data);
+	FLogMessage LogMessage = CreateLogMessage();
+
+	Scheduler.BeginFlush(Send);
+	Scheduler.Schedule(FirstDelete, Send);
+	Scheduler.Schedule(AddComponent, Send);
+	Scheduler.Schedule(LogMessage, Send);
+	Scheduler.EndFlush(Send);
+
+	// WHEN
+	// Destroys the schema data of the deferred add component message.
+	Scheduler.DropDeferredMessages();
+
+	// THEN
+	TestEqual("Nothing deferred", Scheduler.GetNumDeferredMessages(), 0);
+
+	// WHEN
+	Sent = FSentMessages();
+	FComponentUpdate Update = CreateUpdate(TestEntityId);
+	Scheduler.BeginFlush(Send);
+	Scheduler.Schedule(Update, Send);
+	Scheduler.EndFlush(Send);
+
+	// THEN
+	TestEqual("Only the new update sent", Sent.Types.Num(), 1);
+	TestEqual("Update to the entity of a dropped message not deferred", Scheduler.GetNumDeferredMessages(), 0);
+
+	return true;
+}
@@ -0,0 +1,153 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "Interop/Connection/OutgoingMessageStats.h"
+
+#include "CoreMinimal.h"
+
+#define OUTGOINGMESSAGESTATS_TEST(TestName) \
+	GDK_TEST(Core, OutgoingMessageStats, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	const Worker_ComponentId TestComponentId = 1000;
+
+	FComponentUpdate CreateUpdate()
+	{
+		FWorkerComponentUpdate Update{};
+		Update.component_id = TestComponentId;
+		return FComponentUpdate(1, Update);
+	}
+} // anonymous namespace
+
+OUTGOINGMESSAGESTATS_TEST(GIVEN_values_WHEN_bucketed_THEN_buckets_are_contiguous_and_within_precision)
+{
+	// GIVEN
+	const uint64 Values[] = { 0, 1, 7, 8, 15, 16, 17, 31, 32, 1000, 123456789, MAX_uint64 };
+
+	for (const uint64 Value : Values)
+	{
+		// WHEN
+		const uint32 BucketIndex = FOutgoingMessageHistogram::GetBucketIndex(Value);
+		const uint64 LowerBound = FOutgoingMessageHistogram::GetBucketLowerBound(BucketIndex);
+
+		// THEN
+		TestTrue(FString::Printf(TEXT("%llu is above the bucket's lower bound"), Value), LowerBound <= Value);
+		TestTrue(FString::Printf(TEXT("%llu is within an eighth of the bucket's lower bound"), Value), Value - LowerBound <= LowerBound / FOutgoingMessageHistogram::SubBucketCount);
+		if (Value < MAX_uint64)
+		{
+			TestTrue(FString::Printf(TEXT("%llu is below the next bucket"), Value), FOutgoingMessageHistogram::GetBucketLowerBound(BucketIndex + 1) > Value);
+		}
+	}
+
+	return true;
+}
+
+OUTGOINGMESSAGESTATS_TEST(GIVEN_a_histogram_of_1_to_1000_WHEN_percentiles_are_read_THEN_they_are_within_precision)
+{
+	// GIVEN
+	FOutgoingMessageHistogram Histogram;
+	for (uint64 Value = 1; Value <= 1000; ++Value)
+	{
+		Histogram.Record(Value);
+	}
+
+	// WHEN
+	const uint64 Median = Histogram.GetValueAtPercentile(50.0);
+	const uint64 P99 = Histogram.GetValueAtPercentile(99.0);
+
+	// THEN
+	TestEqual("Count", Histogram.GetCount(), uint64(1000));
+	TestEqual("Sum", Histogram.GetSum(), uint64(500500));
+	TestEqual("Max", Histogram.GetMax(), uint64(1000));
+	TestTrue("Median close to 500", Median >= 500 && Median <= 500 + 500 / FOutgoingMessageHistogram::SubBucketCount);
+	TestTrue("99th percentile close to 990", P99 >= 990 && P99 <= 1000);
+	TestEqual("100th percentile is the maximum", Histogram.GetValueAtPercentile(100.0), uint64(1000));
+
+	return true;
+}
+
+OUTGOINGMESSAGESTATS_TEST(GIVEN_an_earlier_copy_WHEN_subtracted_and_exported_THEN_only_new_samples_are_reported_in_cumulative_buckets)
+{
+	// GIVEN
+	FOutgoingMessageHistogram Histogram;
+	Histogram.Record(3);
+	const FOutgoingMessageHistogram Earlier = Histogram;
+	Histogram.Record(5);
+	Histogram.Record(100);
+
+	// WHEN
+	Histogram.Subtract(Earlier);
+	const HistogramMetric Metric = Histogram.ToMetric("Test", 8);
+
+	// THEN
+	TestEqual("Count", Histogram.GetCount(), uint64(2));
+	TestEqual("Sum", Metric.Sum, 105.0);
+	TestEqual("One bucket per power of two and one for the rest", Metric.Buckets.Num(), 10);
+	TestEqual("Nothing below 4", Metric.Buckets[2].Samples, 0u);
+	TestEqual("One sample below 8", Metric.Buckets[3].Samples, 1u);
+	TestEqual("Two samples below 128", Metric.Buckets[7].Samples, 2u);
+	TestEqual("All samples in the last bucket", Metric.Buckets.Last().Samples, 2u);
+
+	return true;
+}
+
+OUTGOINGMESSAGESTATS_TEST(GIVEN_a_sent_component_update_WHEN_recorded_THEN_it_is_tracked_per_type_and_per_component)
+{
+	// GIVEN
+	FOutgoingMessageStats Stats;
+	FComponentUpdate Update = CreateUpdate();
+	Update.EnqueueCycles = 1000;
+
+	FLogMessage LogMessage(0, FName(TEXT("Test")), TEXT("Queued while stats were off"));
+
+	// WHEN
+	Stats.RecordSentMessage(Update, 2000, 10, 64);
+	Stats.RecordSentMessage(LogMessage, 2000, 10, 32);
+
+	TArray<HistogramMetric> Metrics;
+	Stats.AppendHistogramMetrics(Metrics);
+
+	// THEN
+	const FOutgoingMessageStats::FMessageHistograms& UpdateHistograms = Stats.GetMessageHistograms(EOutgoingMessageType::ComponentUpdate);
+	TestEqual("Update latency recorded", UpdateHistograms.QueueLatencyMicros.GetCount(), uint64(1));
+	TestEqual("Update size recorded", UpdateHistograms.PayloadBytes.GetMax(), uint64(64));
+	TestTrue("Per component histograms", Stats.GetComponentUpdateHistograms().Contains(TestComponentId));
+
+	const FOutgoingMessageStats::FMessageHistograms& LogHistograms = Stats.GetMessageHistograms(EOutgoingMessageType::LogMessage);
+	TestEqual("No latency without an enqueue time", LogHistograms.QueueLatencyMicros.GetCount(), uint64(0));
+	TestEqual("Log size recorded", LogHistograms.PayloadBytes.GetCount(), uint64(1));
+
+	// Update and per component update with 3 histograms each, log message without latency.
+	TestEqual("Exported metrics", Metrics.Num(), 8);
+	TestTrue("Metric key", Metrics.ContainsByPredicate([](const HistogramMetric& Metric)
+	{
+		return Metric.Key == "OutgoingMessages.ComponentUpdate.1000.QueueLatencyMicros";
+	}));
+
+	return true;
+}
+
+OUTGOINGMESSAGESTATS_TEST(GIVEN_a_coalesced_component_update_WHEN_recorded_as_sent_THEN_it_counts_once_from_the_first_enqueue)
+{
+	// GIVEN
+	FOutgoingMessageStats Stats;
+	const uint64 FirstEnqueueCycles = 1000;
+
+	// WHEN
+	Stats.RecordSentComponentUpdate(TestComponentId, FirstEnqueueCycles, 2000, 10, 64);
+
+	// THEN
+	const FOutgoingMessageStats::FMessageHistograms& UpdateHistograms = Stats.GetMessageHistograms(EOutgoingMessageType::ComponentUpdate);
+	TestEqual("One update sent", UpdateHistograms.SendDurationMicros.GetCount(), uint64(1));
+	TestEqual("Latency recorded from the first enqueue", UpdateHistograms.QueueLatencyMicros.GetCount(), uint64(1));
+	TestEqual("Size of the coalesced update recorded", UpdateHistograms.PayloadBytes.GetMax(), uint64(64));
+
+	const FOutgoingMessageStats::FMessageHistograms* ComponentHistograms = Stats.GetComponentUpdateHistograms().Find(TestComponentId);
+	TestTrue("Per component histograms", ComponentHistograms != nullptr && ComponentHistograms->PayloadBytes.GetCount() == 1);
+
+	return true;
+}
@@ -0,0 +1,133 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "Interop/EntityComponentStore.h"
+#include "Schema/StandardLibrary.h"
+
+#include "CoreMinimal.h"
+
+#define ENTITYCOMPONENTSTORE_TEST(TestName) \
+	GDK_TEST(Core, EntityComponentStore, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	const Worker_EntityId TestEntityId = 1;
+	const Worker_ComponentId TestComponentId = 1000;
+
+	void AddPosition(FEntityComponentStore& Store, Worker_EntityId EntityId, const Coordinates& Coords)
+	{
+		Worker_ComponentData Data = Position(Coords).CreatePositionData();
+		Store.AddComponent<Position>(EntityId, Data);
+		Schema_DestroyComponentData(Data.schema_type);
+	}
+} // anonymous namespace
+
+ENTITYCOMPONENTSTORE_TEST(GIVEN_many_entities_WHEN_every_other_one_is_removed_THEN_the_rest_can_still_be_found)
+{
+	// GIVEN
+	const int32 EntityCount = 2000;
+	FEntityComponentStore Store;
+	for (Worker_EntityId EntityId = 1; EntityId <= EntityCount; ++EntityId)
+	{
+		Store.AddComponentWithoutData(EntityId, TestComponentId);
+		Store.AddComponentWithoutData(EntityId, TestComponentId + 1);
+	}
+
+	// WHEN
+	for (Worker_EntityId EntityId = 1; EntityId <= EntityCount; EntityId += 2)
+	{
+		Store.RemoveEntity(EntityId);
+	}
+
+	// THEN
+	bool bAllCorrect = true;
+	for (Worker_EntityId EntityId = 1; EntityId <= EntityCount; ++EntityId)
+	{
+		const bool bExpected = EntityId % 2 == 0;
+		bAllCorrect &= Store.HasComponent(EntityId, TestComponentId) == bExpected;
+		bAllCorrect &= Store.HasComponent(EntityId, TestComponentId + 1) == bExpected;
+	}
+	TestTrue("Only the remaining entities have components", bAllCorrect);
+
+	TArray<Worker_EntityId_Key> EntityIds;
+	Store.GetEntityIds(EntityIds);
+	TestEqual("Remaining entities", EntityIds.Num(), EntityCount / 2);
+
+	return true;
+}
+
+ENTITYCOMPONENTSTORE_TEST(GIVEN_an_authoritative_component_WHEN_the_component_is_removed_THEN_authority_remains_until_the_entity_is_removed)
+{
+	// GIVEN
+	FEntityComponentStore Store;
+	Store.AddComponentWithoutData(TestEntityId, TestComponentId);
+	Store.SetAuthority(TestEntityId, TestComponentId, WORKER_AUTHORITY_AUTHORITATIVE);
+
+	// WHEN
+	Store.RemoveComponent(TestEntityId, TestComponentId);
+
+	// THEN
+	TestFalse("Component removed", Store.HasComponent(TestEntityId, TestComponentId));
+	TestTrue("Still authoritative", Store.GetAuthority(TestEntityId, TestComponentId) == WORKER_AUTHORITY_AUTHORITATIVE);
+
+	Store.RemoveEntity(TestEntityId);
+	TestTrue("Authority removed with the entity", Store.GetAuthority(TestEntityId, TestComponentId) == WORKER_AUTHORITY_NOT_AUTHORITATIVE);
+
+	return true;
+}
+
+ENTITYCOMPONENTSTORE_TEST(GIVEN_components_with_data_WHEN_added_and_removed_THEN_they_are_constructed_in_reused_pool_slots)
+{
+	// GIVEN
+	FEntityComponentStore Store;
+	AddPosition(Store, TestEntityId, Coordinates{ 1.0, 2.0, 3.0 });
+
+	// WHEN
+	const Position* First = static_cast<const Position*>(Store.FindComponent(TestEntityId, Position::ComponentId));
+	const Coordinates FirstCoords = First != nullptr ? First->Coords : Coordinates{};
+	Store.RemoveComponent(TestEntityId, Position::ComponentId);
+	AddPosition(Store, TestEntityId + 1, Coordinates{ 4.0, 5.0, 6.0 });
+	const Position* Second = static_cast<const Position*>(Store.FindComponent(TestEntityId + 1, Position::ComponentId));
+
+	// THEN
+	TestEqual("First position read from data", FirstCoords.Y, 2.0);
+	TestNull("Removed component not found", Store.FindComponent(TestEntityId, Position::ComponentId));
+	TestTrue("Second position found", Second != nullptr);
+	TestTrue("Freed slot reused", static_cast<const void*>(First) == static_cast<const void*>(Second));
+	if (Second != nullptr)
+	{
+		TestEqual("Second position read from data", Second->Coords.Z, 6.0);
+	}
+
+	return true;
+}
+
+ENTITYCOMPONENTSTORE_TEST(GIVEN_a_component_with_data_WHEN_it_is_added_again_and_copied_THEN_the_latest_data_is_found_in_both_stores)
+{
+	// GIVEN
+	FEntityComponentStore Store;
+	Worker_ComponentData FirstData = Metadata(TEXT("First")).CreateMetadataData();
+	Store.AddComponent<Metadata>(TestEntityId, FirstData);
+	Schema_DestroyComponentData(FirstData.schema_type);
+
+	// WHEN
+	Worker_ComponentData SecondData = Metadata(TEXT("Second")).CreateMetadataData();
+	Store.AddComponent<Metadata>(TestEntityId, SecondData);
+	Schema_DestroyComponentData(SecondData.schema_type);
+
+	FEntityComponentStore Copy;
+	Copy.CopyEntryFrom(Store, TestEntityId, Metadata::ComponentId);
+
+	// THEN
+	const Metadata* Replaced = static_cast<const Metadata*>(Store.FindComponent(TestEntityId, Metadata::ComponentId));
+	const Metadata* Copied = static_cast<const Metadata*>(Copy.FindComponent(TestEntityId, Metadata::ComponentId));
+	TestTrue("Component replaced", Replaced != nullptr && Replaced->EntityType == TEXT("Second"));
+	TestTrue("Component copied", Copied != nullptr && Copied->EntityType == TEXT("Second"));
+	TestTrue("Copy has its own component", static_cast<const void*>(Replaced) != static_cast<const void*>(Copied));
+	TestEqual("One entry for the entity", Store.GetEntityComponentIds(TestEntityId)->Num(), 1);
+
+	return true;
+}
@@ -0,0 +1,191 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "Interop/LingeringActors.h"
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+
+#define LINGERINGACTORS_TEST(TestName) \
+	GDK_TEST(Core, LingeringActors, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	const Worker_EntityId TestEntityId = 1;
+	const Worker_EntityId OtherTestEntityId = 2;
+	const float TestLingerSeconds = 5.0f;
+
+	void InitLingeringActors(FLingeringActors& LingeringActors, const double& Now)
+	{
+		TMap<TSoftClassPtr<AActor>, float> LingerSecondsByClass;
+		LingerSecondsByClass.Add(APawn::StaticClass(), TestLingerSeconds);
+		LingeringActors.Init(LingerSecondsByClass, [&Now] { return Now; });
+	}
+} // anonymous namespace
+
+LINGERINGACTORS_TEST(GIVEN_a_configured_class_WHEN_linger_times_are_looked_up_THEN_subclasses_inherit_it_and_other_classes_do_not_linger)
+{
+	// GIVEN
+	double Now = 0.0;
+	FLingeringActors LingeringActors;
+	InitLingeringActors(LingeringActors, Now);
+
+	// WHEN
+	AActor* Actor = NewObject<AActor>();
+	const bool bActorLingering = LingeringActors.StartLingering(TestEntityId, Actor);
+
+	// THEN
+	TestTrue("Classes are configured to linger", LingeringActors.HasLingeringClasses());
+	TestEqual("Configured class lingers", LingeringActors.GetLingerSeconds(APawn::StaticClass()), TestLingerSeconds);
+	TestEqual("Parent class does not linger", LingeringActors.GetLingerSeconds(AActor::StaticClass()), 0.0f);
+	TestFalse("Actor of a class that doesn't linger is refused", bActorLingering);
+	TestFalse("Refused entity not lingering", LingeringActors.IsLingering(TestEntityId));
+
+	return true;
+}
+
+LINGERINGACTORS_TEST(GIVEN_a_lingering_actor_WHEN_its_time_is_up_THEN_its_entity_expires)
+{
+	// GIVEN
+	double Now = 0.0;
+	FLingeringActors LingeringActors;
+	InitLingeringActors(LingeringActors, Now);
+	LingeringActors.StartLingering(TestEntityId, NewObject<APawn>());
+
+	Now = 1.0;
+	LingeringActors.StartLingering(OtherTestEntityId, NewObject<APawn>());
+
+	// WHEN
+	Now = TestLingerSeconds - 1.0;
+	const TArray<Worker_EntityId> ExpiredBeforeTime = LingeringActors.TakeExpired();
+
+	// THEN
+	TestEqual("Nothing expired before its time", ExpiredBeforeTime.Num(), 0);
+	TestTrue("Next expiry set", LingeringActors.GetSecondsUntilNextExpiry().IsSet());
+	TestEqual("Next expiry is the first entity's", LingeringActors.GetSecondsUntilNextExpiry().Get(0.0), 1.0);
+
+	// WHEN
+	Now = TestLingerSeconds;
+	const TArray<Worker_EntityId> Expired = LingeringActors.TakeExpired();
+
+	// THEN
+	TestTrue("Only the first entity expired", Expired.Num() == 1 && Expired[0] == TestEntityId);
+	TestFalse("Expired entity no longer lingering", LingeringActors.IsLingering(TestEntityId));
+	TestTrue("Other entity still lingering", LingeringActors.IsLingering(OtherTestEntityId));
+	TestEqual("Next expiry is the other entity's", LingeringActors.GetSecondsUntilNextExpiry().Get(0.0), 1.0);
+
+	// WHEN
+	Now = TestLingerSeconds + 1.0;
+	const TArray<Worker_EntityId> OtherExpired = LingeringActors.TakeExpired();
+
+	// THEN
+	TestTrue("Other entity expired", OtherExpired.Num() == 1 && OtherExpired[0] == OtherTestEntityId);
+	TestEqual("Nothing lingering", LingeringActors.Num(), 0);
+	TestFalse("No next expiry", LingeringActors.GetSecondsUntilNextExpiry().IsSet());
+
+	return true;
+}
+
+LINGERINGACTORS_TEST(GIVEN_a_lingering_actor_WHEN_its_entity_comes_back_within_the_window_THEN_the_actor_is_restored_and_never_expires)
+{
+	// GIVEN
+	double Now = 0.0;
+	FLingeringActors LingeringActors;
+	InitLingeringActors(LingeringActors, Now);
+	APawn* Pawn = NewObject<APawn>();
+	LingeringActors.StartLingering(TestEntityId, Pawn);
+
+	// WHEN
+	Now = TestLingerSeconds - 1.0;
+	AActor* RestoredActor = LingeringActors.StopLingering(TestEntityId);
+
+	// THEN
+	TestTrue("Lingering actor returned", RestoredActor == Pawn);
+	TestFalse("Entity no longer lingering", LingeringActors.IsLingering(TestEntityId));
+
+	// WHEN
+	Now = TestLingerSeconds + 1.0;
+	const TArray<Worker_EntityId> Expired = LingeringActors.TakeExpired();
+
+	// THEN
+	TestEqual("Restored entity never expires", Expired.Num(), 0);
+	TestFalse("No next expiry", LingeringActors.GetSecondsUntilNextExpiry().IsSet());
+
+	return true;
+}
+
+LINGERINGACTORS_TEST(GIVEN_several_lingering_actors_WHEN_the_next_one_to_expire_comes_back_THEN_the_next_expiry_is_the_following_ones)
+{
+	// GIVEN
+	double Now = 0.0;
+	FLingeringActors LingeringActors;
+	InitLingeringActors(LingeringActors, Now);
+	LingeringActors.StartLingering(TestEntityId, NewObject<APawn>());
+
+	Now = 2.0;
+	LingeringActors.StartLingering(OtherTestEntityId, NewObject<APawn>());
+
+	// WHEN
+	Now = 3.0;
+	LingeringActors.StopLingering(TestEntityId);
+
+	// THEN
+	TestEqual("Next expiry is the other entity's", LingeringActors.GetSecondsUntilNextExpiry().Get(0.0), TestLingerSeconds - 1.0);
+
+	// WHEN
+	LingeringActors.StartLingering(TestEntityId, NewObject<APawn>());
+	Now = TestLingerSeconds + 2.0;
+	const TArray<Worker_EntityId> Expired = LingeringActors.TakeExpired();
+
+	// THEN
+	TestTrue("Only the other entity expired", Expired.Num() == 1 && Expired[0] == OtherTestEntityId);
+	TestTrue("Entity that lingered again is still lingering", LingeringActors.IsLingering(TestEntityId));
+	TestEqual("Next expiry is from when the entity lingered again", LingeringActors.GetSecondsUntilNextExpiry().Get(0.0), 1.0);
+
+	return true;
+}
+
+LINGERINGACTORS_TEST(GIVEN_a_lingering_actor_that_was_destroyed_WHEN_its_entity_comes_back_THEN_no_actor_is_returned)
+{
+	// GIVEN
+	double Now = 0.0;
+	FLingeringActors LingeringActors;
+	InitLingeringActors(LingeringActors, Now);
+	APawn* Pawn = NewObject<APawn>();
+	LingeringActors.StartLingering(TestEntityId, Pawn);
+	Pawn->MarkPendingKill();
+
+	// WHEN
+	AActor* RestoredActor = LingeringActors.StopLingering(TestEntityId);
+
+	// THEN
+	TestTrue("No actor returned", RestoredActor == nullptr);
+	TestFalse("Entity no longer lingering", LingeringActors.IsLingering(TestEntityId));
+	TestEqual("Nothing lingering", LingeringActors.Num(), 0);
+
+	return true;
+}
+
+LINGERINGACTORS_TEST(GIVEN_an_entity_that_is_not_lingering_WHEN_it_stops_lingering_THEN_no_actor_is_returned)
+{
+	// GIVEN
+	double Now = 0.0;
+	FLingeringActors LingeringActors;
+	InitLingeringActors(LingeringActors, Now);
+	LingeringActors.StartLingering(TestEntityId, NewObject<APawn>());
+	Now = TestLingerSeconds;
+	LingeringActors.TakeExpired();
+
+	// WHEN
+	AActor* RestoredActor = LingeringActors.StopLingering(TestEntityId);
+
+	// THEN
+	TestTrue("No actor returned for an expired entity", RestoredActor == nullptr);
+	TestTrue("No actor returned for an unknown entity", LingeringActors.StopLingering(OtherTestEntityId) == nullptr);
+
+	return true;
+}
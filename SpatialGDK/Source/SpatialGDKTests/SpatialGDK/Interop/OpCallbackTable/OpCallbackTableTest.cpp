@@ -0,0 +1,130 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "Interop/OpCallbackTable.h"
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+#define OPCALLBACKTABLE_TEST(TestName) \
+	GDK_TEST(Core, OpCallbackTable, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	const Worker_ComponentId TestComponentId = SpatialConstants::MIN_EXTERNAL_SCHEMA_ID;
+	const Worker_ComponentId OtherComponentId = SpatialConstants::MAX_EXTERNAL_SCHEMA_ID;
+
+	Worker_Op CreateComponentUpdateOp(Worker_ComponentId ComponentId)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_COMPONENT_UPDATE;
+		Op.op.component_update.entity_id = 1;
+		Op.op.component_update.update.component_id = ComponentId;
+		return Op;
+	}
+
+	// Returns the average time in nanoseconds it takes to find and run the callbacks of an op.
+	double MeasureDispatchNanosPerOp(const FOpCallbackTable& Table, const TArray<Worker_Op>& Ops, int32 Iterations)
+	{
+		const double StartSeconds = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (const Worker_Op& Op : Ops)
+			{
+				Table.Invoke(Op.op.component_update.update.component_id, &Op);
+			}
+		}
+		const double ElapsedSeconds = FPlatformTime::Seconds() - StartSeconds;
+		return ElapsedSeconds * 1e9 / (static_cast<double>(Ops.Num()) * Iterations);
+	}
+} // anonymous namespace
+
+OPCALLBACKTABLE_TEST(GIVEN_callbacks_for_different_op_types_WHEN_an_op_is_invoked_THEN_only_matching_callbacks_run)
+{
+	// GIVEN
+	FOpCallbackTable Table;
+	int32 UpdateCallbacks = 0;
+	int32 OtherCallbacks = 0;
+	Table.Add(TestComponentId, WORKER_OP_TYPE_COMPONENT_UPDATE, [&UpdateCallbacks](const Worker_Op*) { ++UpdateCallbacks; });
+	Table.Add(TestComponentId, WORKER_OP_TYPE_ADD_COMPONENT, [&OtherCallbacks](const Worker_Op*) { ++OtherCallbacks; });
+	Table.Add(OtherComponentId, WORKER_OP_TYPE_COMPONENT_UPDATE, [&OtherCallbacks](const Worker_Op*) { ++OtherCallbacks; });
+
+	// WHEN
+	const Worker_Op Op = CreateComponentUpdateOp(TestComponentId);
+	Table.Invoke(TestComponentId, &Op);
+
+	// THEN
+	TestEqual("Update callback ran", UpdateCallbacks, 1);
+	TestEqual("No other callback ran", OtherCallbacks, 0);
+
+	return true;
+}
+
+OPCALLBACKTABLE_TEST(GIVEN_a_removed_callback_WHEN_an_op_is_invoked_THEN_it_does_not_run)
+{
+	// GIVEN
+	FOpCallbackTable Table;
+	int32 RemovedCallbacks = 0;
+	int32 KeptCallbacks = 0;
+	const FOpCallbackTable::FCallbackId RemovedId = Table.Add(TestComponentId, WORKER_OP_TYPE_COMPONENT_UPDATE, [&RemovedCallbacks](const Worker_Op*) { ++RemovedCallbacks; });
+	Table.Add(TestComponentId, WORKER_OP_TYPE_COMPONENT_UPDATE, [&KeptCallbacks](const Worker_Op*) { ++KeptCallbacks; });
+
+	// WHEN
+	const bool bRemoved = Table.Remove(RemovedId);
+	const bool bRemovedTwice = Table.Remove(RemovedId);
+	const Worker_Op Op = CreateComponentUpdateOp(TestComponentId);
+	Table.Invoke(TestComponentId, &Op);
+
+	// THEN
+	TestTrue("Callback removed", bRemoved);
+	TestFalse("Callback only removed once", bRemovedTwice);
+	TestEqual("Removed callback did not run", RemovedCallbacks, 0);
+	TestEqual("Other callback ran", KeptCallbacks, 1);
+
+	return true;
+}
+
+OPCALLBACKTABLE_TEST(GIVEN_few_or_all_components_with_callbacks_WHEN_ops_are_dispatched_THEN_the_cost_per_op_is_reported)
+{
+	// GIVEN
+	const int32 OpCount = 1024;
+	const int32 Iterations = 100;
+
+	int32 Invocations = 0;
+	const auto CountInvocation = [&Invocations](const Worker_Op*) { ++Invocations; };
+
+	FOpCallbackTable FewCallbacks;
+	FewCallbacks.Add(TestComponentId, WORKER_OP_TYPE_COMPONENT_UPDATE, CountInvocation);
+
+	FOpCallbackTable AllCallbacks;
+	int32 AllCallbackCount = 0;
+	for (Worker_ComponentId ComponentId = SpatialConstants::MIN_EXTERNAL_SCHEMA_ID; ComponentId <= SpatialConstants::MAX_EXTERNAL_SCHEMA_ID; ++ComponentId)
+	{
+		AllCallbacks.Add(ComponentId, WORKER_OP_TYPE_ADD_COMPONENT, CountInvocation);
+		AllCallbacks.Add(ComponentId, WORKER_OP_TYPE_AUTHORITY_CHANGE, CountInvocation);
+		AllCallbackCount += 2;
+	}
+	AllCallbacks.Add(TestComponentId, WORKER_OP_TYPE_COMPONENT_UPDATE, CountInvocation);
+	AllCallbackCount++;
+
+	// Half of the ops have a callback, the other half are looked up and skipped.
+	TArray<Worker_Op> Ops;
+	for (int32 i = 0; i < OpCount; ++i)
+	{
+		Ops.Add(CreateComponentUpdateOp(i % 2 == 0 ? TestComponentId : OtherComponentId));
+	}
+
+	// WHEN
+	const double FewNanosPerOp = MeasureDispatchNanosPerOp(FewCallbacks, Ops, Iterations);
+	const double AllNanosPerOp = MeasureDispatchNanosPerOp(AllCallbacks, Ops, Iterations);
+
+	// THEN
+	AddInfo(FString::Printf(TEXT("Dispatch with 1 callback registered: %.1f ns per op"), FewNanosPerOp));
+	AddInfo(FString::Printf(TEXT("Dispatch with %d callbacks registered: %.1f ns per op"), AllCallbackCount, AllNanosPerOp));
+	TestEqual("Every op with a callback ran it", Invocations, OpCount / 2 * Iterations * 2);
+
+	return true;
+}
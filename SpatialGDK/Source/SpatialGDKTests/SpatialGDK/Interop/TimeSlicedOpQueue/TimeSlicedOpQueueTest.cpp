@@ -0,0 +1,297 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "Interop/TimeSlicedOpQueue.h"
+
+#include "CoreMinimal.h"
+#include "SpatialConstants.h"
+
+#define TIMESLICEDOPQUEUE_TEST(TestName) \
+	GDK_TEST(Core, TimeSlicedOpQueue, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	const Worker_ComponentId TestComponentId = 1000;
+
+	Worker_Op CreateComponentUpdateOp(Worker_EntityId EntityId)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_COMPONENT_UPDATE;
+		Op.op.component_update.entity_id = EntityId;
+		Op.op.component_update.update.component_id = TestComponentId;
+		return Op;
+	}
+
+	Worker_Op CreateAuthorityChangeOp(Worker_EntityId EntityId)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_AUTHORITY_CHANGE;
+		Op.op.authority_change.entity_id = EntityId;
+		Op.op.authority_change.component_id = TestComponentId;
+		Op.op.authority_change.authority = WORKER_AUTHORITY_AUTHORITATIVE;
+		return Op;
+	}
+
+	Worker_Op CreateRemoveComponentOp(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_REMOVE_COMPONENT;
+		Op.op.remove_component.entity_id = EntityId;
+		Op.op.remove_component.component_id = ComponentId;
+		return Op;
+	}
+
+	Worker_Op CreateRemoveEntityOp(Worker_EntityId EntityId)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_REMOVE_ENTITY;
+		Op.op.remove_entity.entity_id = EntityId;
+		return Op;
+	}
+
+	Worker_Op CreateCriticalSectionOp(bool bInCriticalSection)
+	{
+		Worker_Op Op{};
+		Op.op_type = WORKER_OP_TYPE_CRITICAL_SECTION;
+		Op.op.critical_section.in_critical_section = bInCriticalSection ? 1 : 0;
+		return Op;
+	}
+
+	// Stands in for the dispatcher, recording the ops it processes and skipping the ones it is told to skip.
+	// Every call takes a second on the fake clock.
+	struct FTestReceiver
+	{
+		TArray<const Worker_Op*> ProcessedOps;
+		TSet<const Worker_Op*> OpsToSkip;
+		double Time = 0.0;
+		int32 DestroyedOpLists = 0;
+		int32 NumFlushes = 0;
+
+		TUniquePtr<FTimeSlicedOpQueue> CreateQueue()
+		{
+			return MakeUnique<FTimeSlicedOpQueue>(
+				[this](Worker_OpList* OpList)
+				{
+					for (uint32 i = 0; i < OpList->op_count; ++i)
+					{
+						if (OpsToSkip.Remove(&OpList->ops[i]) == 0)
+						{
+							ProcessedOps.Add(&OpList->ops[i]);
+						}
+					}
+					Time += 1.0;
+				},
+				[this](const Worker_Op* Op) { OpsToSkip.Add(Op); },
+				[this]() { ++NumFlushes; },
+				[this](Worker_OpList*) { ++DestroyedOpLists; },
+				[this]() { return Time; });
+		}
+	};
+
+	Worker_OpList CreateOpList(TArray<Worker_Op>& Ops)
+	{
+		Worker_OpList OpList;
+		OpList.op_count = Ops.Num();
+		OpList.ops = Ops.GetData();
+		return OpList;
+	}
+} // anonymous namespace
+
+TIMESLICEDOPQUEUE_TEST(GIVEN_more_ops_than_fit_in_the_budget_WHEN_processed_THEN_the_rest_are_processed_on_the_next_call)
+{
+	// GIVEN
+	TArray<Worker_Op> Ops;
+	for (Worker_EntityId EntityId = 1; EntityId <= 40; ++EntityId)
+	{
+		Ops.Add(CreateComponentUpdateOp(EntityId));
+	}
+	Worker_OpList OpList = CreateOpList(Ops);
+
+	FTestReceiver Receiver;
+	TUniquePtr<FTimeSlicedOpQueue> Queue = Receiver.CreateQueue();
+	Queue->Enqueue({ &OpList });
+
+	// WHEN
+	Queue->ProcessOps(1.5);
+
+	// THEN
+	TestEqual("Two chunks processed within the budget", Receiver.ProcessedOps.Num(), 32);
+	TestEqual("Ops left over", Queue->GetNumQueuedOps(), 8u);
+	TestEqual("Op list kept", Receiver.DestroyedOpLists, 0);
+
+	// WHEN
+	Queue->ProcessOps(1.5);
+
+	// THEN
+	TestEqual("All ops processed", Receiver.ProcessedOps.Num(), 40);
+	TestTrue("Ops processed in order", Receiver.ProcessedOps.Last() == &Ops.Last());
+	TestTrue("Queue empty", Queue->IsEmpty());
+	TestEqual("Op list destroyed", Receiver.DestroyedOpLists, 1);
+
+	return true;
+}
+
+TIMESLICEDOPQUEUE_TEST(GIVEN_a_critical_section_longer_than_a_chunk_WHEN_processed_with_a_small_budget_THEN_it_is_not_split)
+{
+	// GIVEN
+	TArray<Worker_Op> Ops;
+	Ops.Add(CreateCriticalSectionOp(true));
+	for (int32 i = 0; i < 20; ++i)
+	{
+		Ops.Add(CreateComponentUpdateOp(1));
+	}
+	Ops.Add(CreateCriticalSectionOp(false));
+	for (int32 i = 0; i < 10; ++i)
+	{
+		Ops.Add(CreateComponentUpdateOp(2));
+	}
+	Worker_OpList OpList = CreateOpList(Ops);
+
+	FTestReceiver Receiver;
+	TUniquePtr<FTimeSlicedOpQueue> Queue = Receiver.CreateQueue();
+	Queue->Enqueue({ &OpList });
+
+	// WHEN
+	Queue->ProcessOps(0.5);
+
+	// THEN
+	TestEqual("The whole critical section processed", Receiver.ProcessedOps.Num(), 22);
+	TestEqual("Ops after the critical section left over", Queue->GetNumQueuedOps(), 10u);
+
+	return true;
+}
+
+TIMESLICEDOPQUEUE_TEST(GIVEN_a_critical_section_spanning_op_lists_WHEN_processed_with_a_small_budget_THEN_it_is_not_split)
+{
+	// GIVEN
+	TArray<Worker_Op> FirstOps;
+	FirstOps.Add(CreateCriticalSectionOp(true));
+	FirstOps.Add(CreateComponentUpdateOp(1));
+	Worker_OpList FirstOpList = CreateOpList(FirstOps);
+
+	TArray<Worker_Op> SecondOps;
+	SecondOps.Add(CreateComponentUpdateOp(1));
+	SecondOps.Add(CreateCriticalSectionOp(false));
+	Worker_OpList SecondOpList = CreateOpList(SecondOps);
+
+	FTestReceiver Receiver;
+	TUniquePtr<FTimeSlicedOpQueue> Queue = Receiver.CreateQueue();
+	Queue->Enqueue({ &FirstOpList, &SecondOpList });
+
+	// WHEN
+	Queue->ProcessOps(0.5);
+
+	// THEN
+	TestEqual("Both op lists processed", Receiver.ProcessedOps.Num(), 4);
+	TestTrue("Queue empty", Queue->IsEmpty());
+
+	return true;
+}
+
+TIMESLICEDOPQUEUE_TEST(GIVEN_left_over_ops_WHEN_processed_THEN_authority_changes_for_other_entities_go_ahead_and_are_processed_once)
+{
+	// GIVEN
+	TArray<Worker_Op> Ops;
+	for (int32 i = 0; i < 20; ++i)
+	{
+		Ops.Add(CreateComponentUpdateOp(1));
+	}
+	Ops.Add(CreateAuthorityChangeOp(2));
+	Ops.Add(CreateAuthorityChangeOp(1));
+	Worker_OpList OpList = CreateOpList(Ops);
+	const Worker_Op* OtherEntityAuthorityOp = &Ops[20];
+	const Worker_Op* SameEntityAuthorityOp = &Ops[21];
+
+	FTestReceiver Receiver;
+	TUniquePtr<FTimeSlicedOpQueue> Queue = Receiver.CreateQueue();
+	Queue->Enqueue({ &OpList });
+
+	// WHEN
+	Queue->ProcessOps(0.5);
+
+	// THEN
+	TestEqual("A chunk and the authority change for the other entity processed", Receiver.ProcessedOps.Num(), 17);
+	TestTrue("Authority change for the other entity went ahead", Receiver.ProcessedOps.Last() == OtherEntityAuthorityOp);
+	TestFalse("Authority change behind updates to the same entity kept in order", Receiver.ProcessedOps.Contains(SameEntityAuthorityOp));
+
+	// WHEN
+	Queue->ProcessOps(0.5);
+
+	// THEN
+	TestEqual("Every op processed once", Receiver.ProcessedOps.Num(), Ops.Num());
+	TestTrue("Authority change for the same entity processed last", Receiver.ProcessedOps.Last() == SameEntityAuthorityOp);
+	TestEqual("Nothing left to skip", Receiver.OpsToSkip.Num(), 0);
+	TestTrue("Queue empty", Queue->IsEmpty());
+
+	return true;
+}
+
+TIMESLICEDOPQUEUE_TEST(GIVEN_ops_processed_in_several_chunks_and_ahead_of_the_queue_WHEN_processed_THEN_the_receiver_is_flushed_once_per_call)
+{
+	// GIVEN
+	TArray<Worker_Op> Ops;
+	for (Worker_EntityId EntityId = 1; EntityId <= 40; ++EntityId)
+	{
+		Ops.Add(CreateComponentUpdateOp(EntityId));
+	}
+	Ops.Add(CreateAuthorityChangeOp(41));
+	Worker_OpList OpList = CreateOpList(Ops);
+
+	FTestReceiver Receiver;
+	TUniquePtr<FTimeSlicedOpQueue> Queue = Receiver.CreateQueue();
+	Queue->Enqueue({ &OpList });
+
+	// WHEN
+	Queue->ProcessOps(1.5);
+
+	// THEN
+	TestEqual("Two chunks and the authority change processed", Receiver.ProcessedOps.Num(), 33);
+	TestEqual("Flushed once", Receiver.NumFlushes, 1);
+
+	// WHEN
+	Queue->ProcessOps(1.5);
+	Queue->ProcessOps(1.5);
+
+	// THEN
+	TestEqual("Every op processed once", Receiver.ProcessedOps.Num(), Ops.Num());
+	TestEqual("Flushed once for the call that processed the rest", Receiver.NumFlushes, 2);
+	TestTrue("Queue empty", Queue->IsEmpty());
+
+	return true;
+}
+
+TIMESLICEDOPQUEUE_TEST(GIVEN_an_entity_removal_across_the_end_of_a_chunk_WHEN_processed_with_a_small_budget_THEN_its_remove_entity_op_is_processed_before_the_flush)
+{
+	// GIVEN
+	TArray<Worker_Op> Ops;
+	for (int32 i = 0; i < 14; ++i)
+	{
+		Ops.Add(CreateComponentUpdateOp(1));
+	}
+	// The chunk would end after the second remove component op.
+	Ops.Add(CreateRemoveComponentOp(2, TestComponentId));
+	Ops.Add(CreateRemoveComponentOp(2, TestComponentId + 1));
+	Ops.Add(CreateRemoveComponentOp(2, TestComponentId + 2));
+	Ops.Add(CreateRemoveEntityOp(2));
+	Ops.Add(CreateComponentUpdateOp(3));
+	Worker_OpList OpList = CreateOpList(Ops);
+	const Worker_Op* RemoveEntityOp = &Ops[17];
+
+	FTestReceiver Receiver;
+	TUniquePtr<FTimeSlicedOpQueue> Queue = Receiver.CreateQueue();
+	Queue->Enqueue({ &OpList });
+
+	// WHEN
+	Queue->ProcessOps(0.5);
+
+	// THEN
+	TestEqual("The chunk extended to the end of the entity removal", Receiver.ProcessedOps.Num(), 18);
+	TestTrue("Remove entity op processed in the same chunk", Receiver.ProcessedOps.Last() == RemoveEntityOp);
+	TestEqual("Flushed once, after the remove entity op", Receiver.NumFlushes, 1);
+	TestEqual("Op after the entity removal left over", Queue->GetNumQueuedOps(), 1u);
+
+	return true;
+}
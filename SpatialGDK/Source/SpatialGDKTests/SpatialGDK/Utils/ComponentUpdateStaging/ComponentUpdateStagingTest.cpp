@@ -0,0 +1,286 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "StagingTestObject.h"
+
+#include "EngineClasses/SpatialNetDriver.h"
+#include "Utils/ComponentReader.h"
+#include "Utils/ComponentUpdateStaging.h"
+
+#include "CoreMinimal.h"
+#include "Net/RepLayout.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/UnrealType.h"
+
+#define COMPONENTUPDATESTAGING_TEST(TestName) \
+	GDK_TEST(Core, ComponentUpdateStaging, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	const Worker_ComponentId TestComponentId = 10000;
+
+	// Writes a value that is out of range for the properties smaller than their schema type, so that they have to be narrowed.
+	void AddTestValue(Schema_Object* Object, Schema_FieldId FieldId, UProperty* Property)
+	{
+		if (Property->IsA<UBoolProperty>())
+		{
+			Schema_AddBool(Object, FieldId, 1);
+		}
+		else if (UEnumProperty* EnumProperty = Cast<UEnumProperty>(Property))
+		{
+			if (EnumProperty->ElementSize < 4)
+			{
+				Schema_AddUint32(Object, FieldId, 0xFFFFFFFE);
+			}
+			else
+			{
+				AddTestValue(Object, FieldId, EnumProperty->GetUnderlyingProperty());
+			}
+		}
+		else if (Property->IsA<UFloatProperty>())
+		{
+			Schema_AddFloat(Object, FieldId, 1.5f);
+		}
+		else if (Property->IsA<UDoubleProperty>())
+		{
+			Schema_AddDouble(Object, FieldId, 2.25);
+		}
+		else if (Property->IsA<UInt8Property>() || Property->IsA<UInt16Property>() || Property->IsA<UIntProperty>())
+		{
+			Schema_AddInt32(Object, FieldId, -100000);
+		}
+		else if (Property->IsA<UInt64Property>())
+		{
+			Schema_AddInt64(Object, FieldId, -(int64(1) << 40));
+		}
+		else if (Property->IsA<UByteProperty>() || Property->IsA<UUInt16Property>() || Property->IsA<UUInt32Property>())
+		{
+			Schema_AddUint32(Object, FieldId, 0xFFFE1234);
+		}
+		else if (Property->IsA<UUInt64Property>())
+		{
+			Schema_AddUint64(Object, FieldId, (uint64(1) << 40) + 5);
+		}
+	}
+
+	// An op list of enough updates to the test component to be staged. The first update is left for the test to fill.
+	struct FTestOpList
+	{
+		TArray<Worker_Op> Ops;
+		Worker_OpList OpList;
+
+		FTestOpList()
+		{
+			for (int32 i = 0; i < FComponentUpdateStaging::MinUpdatesToStage; ++i)
+			{
+				Worker_Op& Op = Ops.AddZeroed_GetRef();
+				Op.op_type = WORKER_OP_TYPE_COMPONENT_UPDATE;
+				Op.op.component_update.entity_id = i + 1;
+				Op.op.component_update.update.component_id = TestComponentId;
+				Op.op.component_update.update.schema_type = Schema_CreateComponentUpdate();
+			}
+			OpList.op_count = Ops.Num();
+			OpList.ops = Ops.GetData();
+		}
+
+		~FTestOpList()
+		{
+			for (Worker_Op& Op : Ops)
+			{
+				Schema_DestroyComponentUpdate(Op.op.component_update.update.schema_type);
+			}
+		}
+
+		const Worker_ComponentUpdate& GetFirstUpdate() const { return Ops[0].op.component_update.update; }
+		Schema_Object* GetFirstUpdateFields() const { return Schema_GetComponentUpdateFields(GetFirstUpdate().schema_type); }
+	};
+
+	TUniquePtr<FComponentUpdateStaging> CreateStaging(USpatialNetDriver* NetDriver)
+	{
+		return MakeUnique<FComponentUpdateStaging>(NetDriver, [](Worker_ComponentId ComponentId) -> UClass*
+		{
+			return ComponentId == TestComponentId ? UStagingTestObject::StaticClass() : nullptr;
+		});
+	}
+} // anonymous namespace
+
+COMPONENTUPDATESTAGING_TEST(GIVEN_an_update_of_every_staged_field_type_WHEN_it_is_staged_and_applied_THEN_the_properties_match_ComponentReader)
+{
+	// GIVEN
+	USpatialNetDriver* NetDriver = NewObject<USpatialNetDriver>();
+	TSharedPtr<FRepLayout> RepLayout = NetDriver->GetObjectClassRepLayout(UStagingTestObject::StaticClass());
+	TUniquePtr<FComponentUpdateStaging> Staging = CreateStaging(NetDriver);
+
+	FTestOpList TestOpList;
+	Schema_Object* Fields = TestOpList.GetFirstUpdateFields();
+	for (int32 HandleIndex = 0; HandleIndex < RepLayout->BaseHandleToCmdIndex.Num(); ++HandleIndex)
+	{
+		const FRepLayoutCmd& Cmd = RepLayout->Cmds[RepLayout->BaseHandleToCmdIndex[HandleIndex].CmdIndex];
+		AddTestValue(Fields, HandleIndex + 1, Cmd.Property);
+	}
+
+	UStagingTestObject* StagedObject = NewObject<UStagingTestObject>();
+	UStagingTestObject* ReaderObject = NewObject<UStagingTestObject>();
+	FObjectReferencesMap ObjectReferences;
+	ComponentReader Reader(NetDriver, ObjectReferences);
+	bool bReferencesChanged = false;
+
+	// WHEN
+	Staging->StageComponentUpdates(TestOpList.OpList);
+	const FStagedComponentUpdate* StagedUpdate = Staging->Find(TestOpList.GetFirstUpdate());
+
+	// THEN
+	if (!TestTrue("Update staged", StagedUpdate != nullptr && StagedUpdate->IsStagedFor(*RepLayout)))
+	{
+		return true;
+	}
+
+	TestEqual("Every field staged", StagedUpdate->GetUpdatedIds().Num(), RepLayout->BaseHandleToCmdIndex.Num());
+	for (int32 HandleIndex = 0; HandleIndex < RepLayout->BaseHandleToCmdIndex.Num(); ++HandleIndex)
+	{
+		const Schema_FieldId FieldId = HandleIndex + 1;
+		const FRepLayoutCmd& Cmd = RepLayout->Cmds[RepLayout->BaseHandleToCmdIndex[HandleIndex].CmdIndex];
+		uint8* StagedData = reinterpret_cast<uint8*>(StagedObject) + Cmd.Offset;
+		uint8* ReaderData = reinterpret_cast<uint8*>(ReaderObject) + Cmd.Offset;
+
+		if (!TestTrue(FString::Printf(TEXT("%s staged"), *Cmd.Property->GetName()), StagedUpdate->IsFieldStaged(FieldId)))
+		{
+			continue;
+		}
+
+		StagedUpdate->ApplyField(FieldId, Cmd.Property, StagedData);
+		Reader.ApplyProperty(Fields, FieldId, ObjectReferences, 0, Cmd.Property, ReaderData, Cmd.Offset, Cmd.ShadowOffset, Cmd.ParentIndex, bReferencesChanged);
+
+		TestTrue(FString::Printf(TEXT("%s matches ComponentReader"), *Cmd.Property->GetName()), FMemory::Memcmp(StagedData, ReaderData, Cmd.Property->ElementSize) == 0);
+	}
+
+	// Spot checks that the values were narrowed, rather than both sides being left untouched.
+	TestEqual("Int8 narrowed", StagedObject->Int8Value, static_cast<int8>(-100000));
+	TestEqual("Int16 narrowed", StagedObject->Int16Value, static_cast<int16>(-100000));
+	TestEqual("UInt16 narrowed", StagedObject->UInt16Value, static_cast<uint16>(0x1234));
+	TestTrue("Signed small enum", StagedObject->Int8EnumValue == EStagingTestInt8Enum::Negative);
+	TestTrue("Enum read through its underlying property", StagedObject->Int32EnumValue == static_cast<EStagingTestInt32Enum>(-100000));
+
+	return true;
+}
+
+COMPONENTUPDATESTAGING_TEST(GIVEN_an_update_to_one_bool_bitfield_WHEN_it_is_staged_and_applied_THEN_the_other_bits_of_its_byte_are_kept)
+{
+	// GIVEN
+	USpatialNetDriver* NetDriver = NewObject<USpatialNetDriver>();
+	TSharedPtr<FRepLayout> RepLayout = NetDriver->GetObjectClassRepLayout(UStagingTestObject::StaticClass());
+	TUniquePtr<FComponentUpdateStaging> Staging = CreateStaging(NetDriver);
+
+	int32 SecondFlagHandleIndex = INDEX_NONE;
+	for (int32 HandleIndex = 0; HandleIndex < RepLayout->BaseHandleToCmdIndex.Num(); ++HandleIndex)
+	{
+		if (RepLayout->Cmds[RepLayout->BaseHandleToCmdIndex[HandleIndex].CmdIndex].Property->GetFName() == GET_MEMBER_NAME_CHECKED(UStagingTestObject, bSecondFlag))
+		{
+			SecondFlagHandleIndex = HandleIndex;
+		}
+	}
+	if (!TestTrue("Second flag replicated", SecondFlagHandleIndex != INDEX_NONE))
+	{
+		return true;
+	}
+
+	const Schema_FieldId FieldId = SecondFlagHandleIndex + 1;
+	const FRepLayoutCmd& Cmd = RepLayout->Cmds[RepLayout->BaseHandleToCmdIndex[SecondFlagHandleIndex].CmdIndex];
+
+	FTestOpList TestOpList;
+	Schema_AddBool(TestOpList.GetFirstUpdateFields(), FieldId, 1);
+
+	UStagingTestObject* StagedObject = NewObject<UStagingTestObject>();
+	UStagingTestObject* ReaderObject = NewObject<UStagingTestObject>();
+	StagedObject->bFirstFlag = 1;
+	ReaderObject->bFirstFlag = 1;
+
+	FObjectReferencesMap ObjectReferences;
+	ComponentReader Reader(NetDriver, ObjectReferences);
+	bool bReferencesChanged = false;
+
+	// WHEN
+	Staging->StageComponentUpdates(TestOpList.OpList);
+	const FStagedComponentUpdate* StagedUpdate = Staging->Find(TestOpList.GetFirstUpdate());
+	if (!TestTrue("Bitfield staged", StagedUpdate != nullptr && StagedUpdate->IsFieldStaged(FieldId)))
+	{
+		return true;
+	}
+
+	StagedUpdate->ApplyField(FieldId, Cmd.Property, reinterpret_cast<uint8*>(StagedObject) + Cmd.Offset);
+	Reader.ApplyProperty(TestOpList.GetFirstUpdateFields(), FieldId, ObjectReferences, 0, Cmd.Property, reinterpret_cast<uint8*>(ReaderObject) + Cmd.Offset, Cmd.Offset, Cmd.ShadowOffset, Cmd.ParentIndex, bReferencesChanged);
+
+	// THEN
+	TestTrue("Updated bit set", StagedObject->bSecondFlag == 1);
+	TestTrue("Other bit of the byte kept", StagedObject->bFirstFlag == 1);
+	TestTrue("Byte matches ComponentReader", FMemory::Memcmp(reinterpret_cast<uint8*>(StagedObject) + Cmd.Offset, reinterpret_cast<uint8*>(ReaderObject) + Cmd.Offset, Cmd.Property->ElementSize) == 0);
+
+	return true;
+}
+
+COMPONENTUPDATESTAGING_TEST(GIVEN_an_update_staged_for_a_class_WHEN_checked_against_the_rep_layout_of_another_class_THEN_it_is_not_staged_for_it)
+{
+	// GIVEN
+	USpatialNetDriver* NetDriver = NewObject<USpatialNetDriver>();
+	TSharedPtr<FRepLayout> RepLayout = NetDriver->GetObjectClassRepLayout(UStagingTestObject::StaticClass());
+	TSharedPtr<FRepLayout> SubobjectRepLayout = NetDriver->GetObjectClassRepLayout(UStagingTestSubobject::StaticClass());
+	TUniquePtr<FComponentUpdateStaging> Staging = CreateStaging(NetDriver);
+
+	FTestOpList TestOpList;
+
+	// WHEN
+	Staging->StageComponentUpdates(TestOpList.OpList);
+	const FStagedComponentUpdate* StagedUpdate = Staging->Find(TestOpList.GetFirstUpdate());
+
+	// THEN
+	// ComponentReader decodes the update itself when it isn't staged for the rep layout of the object it is applied to.
+	TestTrue("Staged for the rep layout of its class", StagedUpdate != nullptr && StagedUpdate->IsStagedFor(*RepLayout));
+	TestTrue("Not staged for the rep layout of another class", StagedUpdate != nullptr && !StagedUpdate->IsStagedFor(*SubobjectRepLayout));
+
+	return true;
+}
+
+COMPONENTUPDATESTAGING_TEST(GIVEN_fewer_updates_than_worth_staging_WHEN_staged_THEN_none_are_staged)
+{
+	// GIVEN
+	USpatialNetDriver* NetDriver = NewObject<USpatialNetDriver>();
+	TUniquePtr<FComponentUpdateStaging> Staging = CreateStaging(NetDriver);
+
+	FTestOpList TestOpList;
+	TestOpList.OpList.op_count = FComponentUpdateStaging::MinUpdatesToStage - 1;
+
+	// WHEN
+	Staging->StageComponentUpdates(TestOpList.OpList);
+
+	// THEN
+	TestTrue("Left to be decoded when applied", Staging->Find(TestOpList.GetFirstUpdate()) == nullptr);
+
+	return true;
+}
+
+COMPONENTUPDATESTAGING_TEST(GIVEN_two_staged_op_lists_WHEN_the_first_is_released_THEN_only_the_updates_of_the_second_are_found)
+{
+	// GIVEN
+	USpatialNetDriver* NetDriver = NewObject<USpatialNetDriver>();
+	TUniquePtr<FComponentUpdateStaging> Staging = CreateStaging(NetDriver);
+
+	FTestOpList FirstOpList;
+	FTestOpList SecondOpList;
+	Staging->StageComponentUpdates(FirstOpList.OpList);
+	Staging->StageComponentUpdates(SecondOpList.OpList);
+
+	// WHEN
+	Staging->Release(FirstOpList.OpList);
+
+	// THEN
+	// Staged updates are kept per op list, so an op list processed over several frames keeps its updates until it is destroyed.
+	TestTrue("Released op list not found", Staging->Find(FirstOpList.GetFirstUpdate()) == nullptr);
+	TestTrue("Other op list still found", Staging->Find(SecondOpList.GetFirstUpdate()) != nullptr);
+
+	Staging->Release(SecondOpList.OpList);
+
+	return true;
+}
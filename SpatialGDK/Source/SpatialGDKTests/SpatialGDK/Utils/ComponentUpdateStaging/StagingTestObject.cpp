@@ -0,0 +1,27 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "StagingTestObject.h"
+
+#include "Net/UnrealNetwork.h"
+
+void UStagingTestObject::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UStagingTestObject, bFirstFlag);
+	DOREPLIFETIME(UStagingTestObject, bSecondFlag);
+	DOREPLIFETIME(UStagingTestObject, bPlainBool);
+	DOREPLIFETIME(UStagingTestObject, Int8Value);
+	DOREPLIFETIME(UStagingTestObject, Int16Value);
+	DOREPLIFETIME(UStagingTestObject, Int32Value);
+	DOREPLIFETIME(UStagingTestObject, Int64Value);
+	DOREPLIFETIME(UStagingTestObject, ByteValue);
+	DOREPLIFETIME(UStagingTestObject, UInt16Value);
+	DOREPLIFETIME(UStagingTestObject, UInt32Value);
+	DOREPLIFETIME(UStagingTestObject, UInt64Value);
+	DOREPLIFETIME(UStagingTestObject, FloatValue);
+	DOREPLIFETIME(UStagingTestObject, DoubleValue);
+	DOREPLIFETIME(UStagingTestObject, Int8EnumValue);
+	DOREPLIFETIME(UStagingTestObject, UInt16EnumValue);
+	DOREPLIFETIME(UStagingTestObject, Int32EnumValue);
+}
@@ -0,0 +1,93 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "StagingTestObject.generated.h"
+
+UENUM()
+enum class EStagingTestInt8Enum : int8
+{
+	Negative = -2,
+	Positive = 3
+};
+
+UENUM()
+enum class EStagingTestUInt16Enum : uint16
+{
+	Small = 1,
+	Large = 0x1234
+};
+
+UENUM()
+enum class EStagingTestInt32Enum : int32
+{
+	Negative = -100000,
+	Positive = 7
+};
+
+// Has a replicated property of every type FComponentUpdateStaging decodes ahead of time.
+UCLASS()
+class UStagingTestObject : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	UPROPERTY(Replicated)
+	uint8 bFirstFlag : 1;
+
+	UPROPERTY(Replicated)
+	uint8 bSecondFlag : 1;
+
+	UPROPERTY(Replicated)
+	bool bPlainBool;
+
+	UPROPERTY(Replicated)
+	int8 Int8Value;
+
+	UPROPERTY(Replicated)
+	int16 Int16Value;
+
+	UPROPERTY(Replicated)
+	int32 Int32Value;
+
+	UPROPERTY(Replicated)
+	int64 Int64Value;
+
+	UPROPERTY(Replicated)
+	uint8 ByteValue;
+
+	UPROPERTY(Replicated)
+	uint16 UInt16Value;
+
+	UPROPERTY(Replicated)
+	uint32 UInt32Value;
+
+	UPROPERTY(Replicated)
+	uint64 UInt64Value;
+
+	UPROPERTY(Replicated)
+	float FloatValue;
+
+	UPROPERTY(Replicated)
+	double DoubleValue;
+
+	UPROPERTY(Replicated)
+	EStagingTestInt8Enum Int8EnumValue;
+
+	UPROPERTY(Replicated)
+	EStagingTestUInt16Enum UInt16EnumValue;
+
+	UPROPERTY(Replicated)
+	EStagingTestInt32Enum Int32EnumValue;
+};
+
+// Replicated with a rep layout of its own, which updates staged for UStagingTestObject don't match.
+UCLASS()
+class UStagingTestSubobject : public UStagingTestObject
+{
+	GENERATED_BODY()
+};
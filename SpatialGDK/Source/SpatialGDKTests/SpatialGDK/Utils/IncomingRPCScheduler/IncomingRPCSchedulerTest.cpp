@@ -0,0 +1,285 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "Utils/IncomingRPCScheduler.h"
+
+#include "CoreMinimal.h"
+
+#define INCOMINGRPCSCHEDULER_TEST(TestName) \
+	GDK_TEST(Core, FIncomingRPCScheduler, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	const float WaitSeconds = 1.0f;
+	const ERPCType AnyRPCType = ERPCType::ClientReliable;
+
+	// A stably named subobject of the actor of an entity, referred to by path.
+	FUnrealObjectRef CreateSubobjectPathRef(Worker_EntityId OuterEntityId)
+	{
+		return FUnrealObjectRef(0, 0, TEXT("Subobject"), FUnrealObjectRef(OuterEntityId, 0));
+	}
+
+	// An actor placed in a level, which has no entity in its outer chain.
+	FUnrealObjectRef CreateLevelObjectRef()
+	{
+		FUnrealObjectRef PackageRef(0, 0);
+		PackageRef.Path = FString(TEXT("/Game/Maps/TestLevel"));
+		return FUnrealObjectRef(0, 0, TEXT("LevelActor"), FUnrealObjectRef(0, 0, TEXT("PersistentLevel"), PackageRef));
+	}
+
+	// Applies RPCs once their parameter is resolved, or with it unresolved once the wait time has passed.
+	struct FFakeReceiver
+	{
+		// Each RPC has a single parameter. Unless set in PathParameterRefs, it is the object with the entity id in the RPC's index.
+		FUnrealObjectRef GetParameterRef(const FPendingRPCParams& Params) const
+		{
+			if (const FUnrealObjectRef* PathRef = PathParameterRefs.Find(Params.Payload.Index))
+			{
+				return *PathRef;
+			}
+			return FUnrealObjectRef(Params.Payload.Index, 0);
+		}
+
+		// Path based refs are resolved along with their outer.
+		bool IsResolved(const FUnrealObjectRef& Ref) const
+		{
+			return ResolvedRefs.Contains(Ref) || (Ref.Outer.IsSet() && IsResolved(Ref.Outer.GetValue()));
+		}
+
+		FRPCErrorInfo ApplyRPC(const FPendingRPCParams& Params, TSet<FUnrealObjectRef>& OutUnresolvedRefs)
+		{
+			Attempts++;
+			const FUnrealObjectRef ParameterRef = GetParameterRef(Params);
+			if (!IsResolved(ParameterRef) && Now - QueuedSeconds.FindRef(Params.Payload.Index) <= WaitSeconds)
+			{
+				OutUnresolvedRefs.Add(ParameterRef);
+				return FRPCErrorInfo{ nullptr, nullptr, ERPCResult::UnresolvedParameters };
+			}
+
+			AppliedIndices.Add(Params.Payload.Index);
+			return FRPCErrorInfo{ nullptr, nullptr, ERPCResult::Success };
+		}
+
+		void Init(FIncomingRPCScheduler& Scheduler)
+		{
+			Scheduler.Init(FProcessIncomingRPCDelegate::CreateRaw(this, &FFakeReceiver::ApplyRPC), WaitSeconds, [this] { return Now; });
+		}
+
+		void Receive(FIncomingRPCScheduler& Scheduler, Worker_EntityId EntityId, uint32 ParameterEntityId, ERPCType Type = AnyRPCType)
+		{
+			QueuedSeconds.Add(ParameterEntityId, Now);
+			Scheduler.ProcessOrQueueRPC(FUnrealObjectRef(EntityId, 0), Type, RPCPayload(0, ParameterEntityId, TArray<uint8>()));
+		}
+
+		void Resolve(FIncomingRPCScheduler& Scheduler, uint32 ParameterEntityId)
+		{
+			Resolve(Scheduler, FUnrealObjectRef(ParameterEntityId, 0));
+		}
+
+		void Resolve(FIncomingRPCScheduler& Scheduler, const FUnrealObjectRef& Ref)
+		{
+			ResolvedRefs.Add(Ref);
+			Scheduler.OnObjectRefResolved(Ref);
+		}
+
+		double Now = 100.0;
+		int32 Attempts = 0;
+		TSet<FUnrealObjectRef> ResolvedRefs;
+		TMap<uint32, FUnrealObjectRef> PathParameterRefs;
+		TMap<uint32, double> QueuedSeconds;
+		TArray<uint32> AppliedIndices;
+	};
+} // anonymous namespace
+
+INCOMINGRPCSCHEDULER_TEST(GIVEN_an_rpc_with_an_unresolved_parameter_WHEN_the_parameter_is_resolved_THEN_it_is_applied)
+{
+	// GIVEN
+	FIncomingRPCScheduler Scheduler;
+	FFakeReceiver Receiver;
+	Receiver.Init(Scheduler);
+	Receiver.Receive(Scheduler, 1, 10);
+
+	TestTrue("RPC is queued", Scheduler.ObjectHasRPCsQueuedOfType(1, AnyRPCType));
+	TestEqual("Waiting on the parameter", Scheduler.GetNumWaitingRefs(), 1);
+
+	// WHEN
+	Receiver.Resolve(Scheduler, 10);
+
+	// THEN
+	TestFalse("RPC is no longer queued", Scheduler.ObjectHasRPCsQueuedOfType(1, AnyRPCType));
+	TestEqual("Applied", Receiver.AppliedIndices.Num(), 1);
+	TestEqual("No refs waited on", Scheduler.GetNumWaitingRefs(), 0);
+
+	return true;
+}
+
+INCOMINGRPCSCHEDULER_TEST(GIVEN_rpcs_waiting_on_different_refs_WHEN_one_ref_is_resolved_THEN_only_its_rpcs_are_retried)
+{
+	// GIVEN
+	FIncomingRPCScheduler Scheduler;
+	FFakeReceiver Receiver;
+	Receiver.Init(Scheduler);
+	for (Worker_EntityId EntityId = 1; EntityId <= 100; ++EntityId)
+	{
+		Receiver.Receive(Scheduler, EntityId, 1000 + EntityId);
+	}
+	const int32 AttemptsBefore = Receiver.Attempts;
+
+	// WHEN
+	Receiver.Resolve(Scheduler, 1050);
+	Receiver.Resolve(Scheduler, 2000);
+
+	// THEN
+	TestEqual("Only the RPC waiting on the resolved ref was attempted", Receiver.Attempts - AttemptsBefore, 1);
+	TestEqual("Applied", Receiver.AppliedIndices.Num(), 1);
+	TestEqual("Other RPCs still queued", Scheduler.GetNumQueuedRPCs(), 99);
+
+	return true;
+}
+
+INCOMINGRPCSCHEDULER_TEST(GIVEN_rpcs_of_the_same_entity_and_type_WHEN_the_first_is_blocked_THEN_later_ones_are_applied_in_order_after_it)
+{
+	// GIVEN
+	FIncomingRPCScheduler Scheduler;
+	FFakeReceiver Receiver;
+	Receiver.Init(Scheduler);
+	Receiver.ResolvedRefs.Add(FUnrealObjectRef(20, 0));
+	Receiver.Receive(Scheduler, 1, 10);
+	Receiver.Receive(Scheduler, 1, 20);
+
+	TestEqual("Second RPC waits behind the first", Receiver.AppliedIndices.Num(), 0);
+
+	// WHEN
+	Receiver.Resolve(Scheduler, 10);
+
+	// THEN
+	TestEqual("Both applied", Receiver.AppliedIndices.Num(), 2);
+	TestTrue("In order", Receiver.AppliedIndices.Num() == 2 && Receiver.AppliedIndices[0] == 10 && Receiver.AppliedIndices[1] == 20);
+	TestEqual("Nothing queued", Scheduler.GetNumQueuedRPCs(), 0);
+
+	return true;
+}
+
+INCOMINGRPCSCHEDULER_TEST(GIVEN_an_rpc_whose_parameter_is_never_resolved_WHEN_the_wait_time_passes_THEN_it_is_applied_on_the_next_tick)
+{
+	// GIVEN
+	FIncomingRPCScheduler Scheduler;
+	FFakeReceiver Receiver;
+	Receiver.Init(Scheduler);
+	Receiver.Receive(Scheduler, 1, 10);
+
+	// WHEN
+	Receiver.Now += WaitSeconds / 2;
+	Scheduler.Tick();
+	const int32 AttemptsBeforeDeadline = Receiver.Attempts;
+
+	Receiver.Now += WaitSeconds / 2 + Scheduler.GetTickSeconds() * 2;
+	Scheduler.Tick();
+
+	// THEN
+	TestEqual("Not retried before the deadline", AttemptsBeforeDeadline, 1);
+	TestEqual("Applied after the deadline", Receiver.AppliedIndices.Num(), 1);
+	TestEqual("Nothing queued", Scheduler.GetNumQueuedRPCs(), 0);
+	TestEqual("No refs waited on", Scheduler.GetNumWaitingRefs(), 0);
+
+	return true;
+}
+
+INCOMINGRPCSCHEDULER_TEST(GIVEN_queued_rpcs_WHEN_dropped_for_their_entity_THEN_they_are_not_applied_when_resolved)
+{
+	// GIVEN
+	FIncomingRPCScheduler Scheduler;
+	FFakeReceiver Receiver;
+	Receiver.Init(Scheduler);
+	Receiver.Receive(Scheduler, 1, 10);
+
+	// WHEN
+	Scheduler.DropForEntity(1);
+	Receiver.Resolve(Scheduler, 10);
+
+	// THEN
+	TestEqual("Nothing applied", Receiver.AppliedIndices.Num(), 0);
+	TestEqual("Nothing queued", Scheduler.GetNumQueuedRPCs(), 0);
+	TestEqual("No refs waited on", Scheduler.GetNumWaitingRefs(), 0);
+
+	return true;
+}
+
+INCOMINGRPCSCHEDULER_TEST(GIVEN_queued_rpcs_of_several_types_WHEN_dropped_for_their_entity_THEN_only_that_entitys_queues_are_dropped)
+{
+	// GIVEN
+	FIncomingRPCScheduler Scheduler;
+	FFakeReceiver Receiver;
+	Receiver.Init(Scheduler);
+	Receiver.Receive(Scheduler, 1, 10, ERPCType::ClientReliable);
+	Receiver.Receive(Scheduler, 1, 11, ERPCType::CrossServer);
+	Receiver.Receive(Scheduler, 2, 12, ERPCType::CrossServer);
+
+	// WHEN
+	Scheduler.DropForEntity(1);
+
+	// THEN
+	TestFalse("Reliable RPCs of the entity dropped", Scheduler.ObjectHasRPCsQueuedOfType(1, ERPCType::ClientReliable));
+	TestFalse("Cross server RPCs of the entity dropped", Scheduler.ObjectHasRPCsQueuedOfType(1, ERPCType::CrossServer));
+	TestTrue("Other entity's RPCs still queued", Scheduler.ObjectHasRPCsQueuedOfType(2, ERPCType::CrossServer));
+	TestEqual("Only the other entity's RPC queued", Scheduler.GetNumQueuedRPCs(), 1);
+
+	// WHEN
+	Receiver.Resolve(Scheduler, 12);
+
+	// THEN
+	TestEqual("Other entity's RPC applied", Receiver.AppliedIndices.Num(), 1);
+	TestEqual("Nothing queued", Scheduler.GetNumQueuedRPCs(), 0);
+
+	return true;
+}
+
+INCOMINGRPCSCHEDULER_TEST(GIVEN_an_rpc_with_an_unresolved_subobject_parameter_referred_to_by_path_WHEN_its_outer_entity_is_resolved_THEN_it_is_applied)
+{
+	// GIVEN
+	FIncomingRPCScheduler Scheduler;
+	FFakeReceiver Receiver;
+	Receiver.Init(Scheduler);
+	Receiver.PathParameterRefs.Add(10, CreateSubobjectPathRef(20));
+	Receiver.Receive(Scheduler, 1, 10);
+
+	TestTrue("RPC is queued", Scheduler.ObjectHasRPCsQueuedOfType(1, AnyRPCType));
+	TestEqual("Waiting on the outer entity", Scheduler.GetNumWaitingRefs(), 1);
+
+	// WHEN
+	Receiver.Resolve(Scheduler, 20);
+
+	// THEN
+	TestEqual("Applied before the wait time passed", Receiver.AppliedIndices.Num(), 1);
+	TestEqual("Nothing queued", Scheduler.GetNumQueuedRPCs(), 0);
+	TestEqual("No refs waited on", Scheduler.GetNumWaitingRefs(), 0);
+
+	return true;
+}
+
+INCOMINGRPCSCHEDULER_TEST(GIVEN_an_rpc_with_an_unresolved_level_object_parameter_WHEN_any_ref_is_resolved_THEN_it_is_retried)
+{
+	// GIVEN
+	FIncomingRPCScheduler Scheduler;
+	FFakeReceiver Receiver;
+	Receiver.Init(Scheduler);
+	const FUnrealObjectRef LevelObjectRef = CreateLevelObjectRef();
+	Receiver.PathParameterRefs.Add(10, LevelObjectRef);
+	Receiver.Receive(Scheduler, 1, 10);
+
+	TestEqual("Waiting on any ref", Scheduler.GetNumQueuesWaitingOnAnyRef(), 1);
+
+	// WHEN
+	Receiver.ResolvedRefs.Add(LevelObjectRef);
+	Receiver.Resolve(Scheduler, 30);
+
+	// THEN
+	TestEqual("Applied before the wait time passed", Receiver.AppliedIndices.Num(), 1);
+	TestEqual("Nothing queued", Scheduler.GetNumQueuedRPCs(), 0);
+	TestEqual("No queues waiting on any ref", Scheduler.GetNumQueuesWaitingOnAnyRef(), 0);
+
+	return true;
+}
@@ -0,0 +1,116 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "Utils/OpUtils.h"
+
+#include "CoreMinimal.h"
+
+#define OPUTILS_TEST(TestName) \
+	GDK_TEST(Core, OpUtils, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	const Worker_ComponentId TestComponentId = 10000;
+	const Worker_ComponentId OtherTestComponentId = 10001;
+
+	struct FTestOpList
+	{
+		TArray<Worker_Op> Ops;
+		Worker_OpList OpList;
+
+		void AddComponentUpdate(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+		{
+			Worker_Op& Op = Ops.AddZeroed_GetRef();
+			Op.op_type = WORKER_OP_TYPE_COMPONENT_UPDATE;
+			Op.op.component_update.entity_id = EntityId;
+			Op.op.component_update.update.component_id = ComponentId;
+		}
+
+		void AddCreateEntityResponse(Worker_RequestId RequestId)
+		{
+			Worker_Op& Op = Ops.AddZeroed_GetRef();
+			Op.op_type = WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE;
+			Op.op.create_entity_response.request_id = RequestId;
+		}
+
+		Worker_OpList* GetOpList()
+		{
+			OpList.op_count = Ops.Num();
+			OpList.ops = Ops.GetData();
+			return &OpList;
+		}
+	};
+} // anonymous namespace
+
+OPUTILS_TEST(GIVEN_several_op_lists_WHEN_they_are_indexed_THEN_the_first_op_of_each_type_and_component_is_found)
+{
+	// GIVEN
+	FTestOpList FirstOpList;
+	FirstOpList.AddComponentUpdate(1, TestComponentId);
+	FirstOpList.AddComponentUpdate(2, TestComponentId);
+
+	FTestOpList SecondOpList;
+	SecondOpList.AddCreateEntityResponse(1);
+	SecondOpList.AddComponentUpdate(3, OtherTestComponentId);
+	SecondOpList.AddCreateEntityResponse(2);
+
+	// WHEN
+	FFirstOpIndex OpIndex;
+	OpIndex.AddOpLists({ FirstOpList.GetOpList(), SecondOpList.GetOpList() });
+
+	// THEN
+	TestTrue("First update to the component found", OpIndex.FindFirstOpOfTypeForComponent(WORKER_OP_TYPE_COMPONENT_UPDATE, TestComponentId) == &FirstOpList.Ops[0]);
+	TestTrue("First update to the other component found in a later op list", OpIndex.FindFirstOpOfTypeForComponent(WORKER_OP_TYPE_COMPONENT_UPDATE, OtherTestComponentId) == &SecondOpList.Ops[1]);
+	TestTrue("First op of a type without a component found", OpIndex.FindFirstOpOfType(WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE) == &SecondOpList.Ops[0]);
+	TestTrue("Nothing found for an op type that isn't in the op lists", OpIndex.FindFirstOpOfType(WORKER_OP_TYPE_DELETE_ENTITY_RESPONSE) == nullptr);
+	TestTrue("Nothing found for a component without ops", OpIndex.FindFirstOpOfTypeForComponent(WORKER_OP_TYPE_COMPONENT_UPDATE, OtherTestComponentId + 1) == nullptr);
+
+	return true;
+}
+
+OPUTILS_TEST(GIVEN_an_index_of_earlier_op_lists_WHEN_more_op_lists_are_added_THEN_the_earliest_op_is_kept)
+{
+	// GIVEN
+	FTestOpList FirstOpList;
+	FirstOpList.AddComponentUpdate(1, TestComponentId);
+
+	FFirstOpIndex OpIndex;
+	OpIndex.AddOpLists({ FirstOpList.GetOpList() });
+
+	// WHEN
+	FTestOpList SecondOpList;
+	SecondOpList.AddComponentUpdate(2, TestComponentId);
+	OpIndex.AddOpLists({ SecondOpList.GetOpList() });
+
+	// THEN
+	TestTrue("Op from the earlier op list kept", OpIndex.FindFirstOpOfTypeForComponent(WORKER_OP_TYPE_COMPONENT_UPDATE, TestComponentId) == &FirstOpList.Ops[0]);
+
+	return true;
+}
+
+OPUTILS_TEST(GIVEN_an_index_of_last_ticks_op_lists_WHEN_it_is_reset_and_this_ticks_op_lists_are_added_THEN_only_this_ticks_ops_are_found)
+{
+	// GIVEN
+	FTestOpList LastTickOpList;
+	LastTickOpList.AddComponentUpdate(1, TestComponentId);
+	LastTickOpList.AddCreateEntityResponse(1);
+
+	FFirstOpIndex OpIndex;
+	OpIndex.AddOpLists({ LastTickOpList.GetOpList() });
+
+	// WHEN
+	OpIndex.Reset();
+
+	FTestOpList ThisTickOpList;
+	ThisTickOpList.AddComponentUpdate(2, TestComponentId);
+	OpIndex.AddOpLists({ ThisTickOpList.GetOpList() });
+
+	// THEN
+	TestTrue("Update from this tick found", OpIndex.FindFirstOpOfTypeForComponent(WORKER_OP_TYPE_COMPONENT_UPDATE, TestComponentId) == &ThisTickOpList.Ops[0]);
+	TestTrue("Op only in last tick's op list not found", OpIndex.FindFirstOpOfType(WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE) == nullptr);
+
+	return true;
+}
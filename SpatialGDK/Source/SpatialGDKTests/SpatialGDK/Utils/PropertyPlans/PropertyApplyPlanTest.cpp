@@ -0,0 +1,220 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "PropertyPlanTestObject.h"
+
+#include "EngineClasses/SpatialNetDriver.h"
+#include "Interop/SpatialClassInfoManager.h"
+#include "Utils/ComponentFactory.h"
+#include "Utils/ComponentReader.h"
+#include "Utils/PropertyApplyPlan.h"
+
+#include "CoreMinimal.h"
+#include "Net/RepLayout.h"
+#include "UObject/UnrealType.h"
+
+#define PROPERTYAPPLYPLAN_TEST(TestName) \
+	GDK_TEST(Core, PropertyApplyPlan, TestName)
+
+using namespace SpatialGDK;
+
+namespace
+{
+	FClassInfo CreateTestClassInfo()
+	{
+		FClassInfo Info;
+		Info.Class = UPropertyPlanTestObject::StaticClass();
+		return Info;
+	}
+
+	int32 FindHandleIndex(const FRepLayout& RepLayout, FName PropertyName)
+	{
+		for (int32 HandleIndex = 0; HandleIndex < RepLayout.BaseHandleToCmdIndex.Num(); ++HandleIndex)
+		{
+			if (RepLayout.Cmds[RepLayout.BaseHandleToCmdIndex[HandleIndex].CmdIndex].Property->GetFName() == PropertyName)
+			{
+				return HandleIndex;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	// Applies a field the way ComponentReader::ApplySchemaObject does, with the reader of the plan if there is one.
+	void ApplyField(ComponentReader& Reader, FObjectReferencesMap& ObjectReferences, Schema_Object* Fields, Schema_FieldId FieldId, const FRepLayoutCmd& Cmd, const FPropertyReader* PropertyReader, UObject* Object)
+	{
+		uint8* Data = reinterpret_cast<uint8*>(Object) + Cmd.Offset;
+		bool bReferencesChanged = false;
+
+		if (UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Cmd.Property))
+		{
+			Reader.ApplyArray(Fields, FieldId, ObjectReferences, ArrayProperty, Data, Cmd.Offset, Cmd.ShadowOffset, Cmd.ParentIndex, bReferencesChanged, PropertyReader);
+		}
+		else if (PropertyReader != nullptr && PropertyReader->Read != nullptr)
+		{
+			PropertyReader->Read(*PropertyReader, Fields, FieldId, 0, Data);
+		}
+		else
+		{
+			Reader.ApplyProperty(Fields, FieldId, ObjectReferences, 0, Cmd.Property, Data, Cmd.Offset, Cmd.ShadowOffset, Cmd.ParentIndex, bReferencesChanged, PropertyReader);
+		}
+	}
+} // anonymous namespace
+
+PROPERTYAPPLYPLAN_TEST(GIVEN_a_field_of_every_read_type_WHEN_applied_with_its_plan_reader_THEN_the_property_matches_ApplyProperty)
+{
+	// GIVEN
+	USpatialNetDriver* NetDriver = NewObject<USpatialNetDriver>();
+	TSharedPtr<FRepLayout> RepLayout = NetDriver->GetObjectClassRepLayout(UPropertyPlanTestObject::StaticClass());
+	TSharedRef<const FPropertyApplyPlan> Plan = FPropertyApplyPlan::CreateForRepLayout(NetDriver, CreateTestClassInfo());
+	ComponentFactory Factory(false, NetDriver, nullptr);
+
+	UPropertyPlanTestObject* SourceObject = NewObject<UPropertyPlanTestObject>();
+	SourceObject->SetTestValues();
+
+	Schema_ComponentData* ComponentData = Schema_CreateComponentData();
+	Schema_Object* Fields = Schema_GetComponentDataFields(ComponentData);
+	for (int32 HandleIndex = 0; HandleIndex < RepLayout->BaseHandleToCmdIndex.Num(); ++HandleIndex)
+	{
+		const FRepLayoutCmd& Cmd = RepLayout->Cmds[RepLayout->BaseHandleToCmdIndex[HandleIndex].CmdIndex];
+		Factory.AddProperty(Fields, HandleIndex + 1, Cmd.Property, reinterpret_cast<const uint8*>(SourceObject) + Cmd.Offset, nullptr);
+	}
+
+	UPropertyPlanTestObject* PlanObject = NewObject<UPropertyPlanTestObject>();
+	UPropertyPlanTestObject* PropertyObject = NewObject<UPropertyPlanTestObject>();
+	FObjectReferencesMap PlanObjectReferences;
+	FObjectReferencesMap PropertyObjectReferences;
+	ComponentReader PlanReader(NetDriver, PlanObjectReferences);
+	ComponentReader PropertyReader(NetDriver, PropertyObjectReferences);
+
+	// WHEN
+	for (int32 HandleIndex = 0; HandleIndex < RepLayout->BaseHandleToCmdIndex.Num(); ++HandleIndex)
+	{
+		const Schema_FieldId FieldId = HandleIndex + 1;
+		const FRepLayoutCmd& Cmd = RepLayout->Cmds[RepLayout->BaseHandleToCmdIndex[HandleIndex].CmdIndex];
+
+		ApplyField(PlanReader, PlanObjectReferences, Fields, FieldId, Cmd, Plan->GetReader(FieldId), PlanObject);
+		ApplyField(PropertyReader, PropertyObjectReferences, Fields, FieldId, Cmd, nullptr, PropertyObject);
+	}
+
+	// THEN
+	for (int32 HandleIndex = 0; HandleIndex < RepLayout->BaseHandleToCmdIndex.Num(); ++HandleIndex)
+	{
+		const FRepLayoutCmd& Cmd = RepLayout->Cmds[RepLayout->BaseHandleToCmdIndex[HandleIndex].CmdIndex];
+		const FString PropertyName = Cmd.Property->GetName();
+		const uint8* SourceData = reinterpret_cast<const uint8*>(SourceObject) + Cmd.Offset;
+		const uint8* PlanData = reinterpret_cast<const uint8*>(PlanObject) + Cmd.Offset;
+		const uint8* PropertyData = reinterpret_cast<const uint8*>(PropertyObject) + Cmd.Offset;
+
+		TestTrue(FString::Printf(TEXT("%s has a plan reader"), *PropertyName), Plan->GetReader(HandleIndex + 1) != nullptr);
+		TestTrue(FString::Printf(TEXT("%s matches ApplyProperty"), *PropertyName), Cmd.Property->Identical(PlanData, PropertyData));
+		TestTrue(FString::Printf(TEXT("%s read back"), *PropertyName), Cmd.Property->Identical(PlanData, SourceData));
+	}
+
+	// Spot checks of the values most easily mangled by reading them through the wrong type.
+	TestTrue("Only the set bit of the bitfield byte is read", PlanObject->bFirstFlag == 0 && PlanObject->bSecondFlag == 1);
+	TestTrue("Signed small enum", PlanObject->Int8EnumValue == EPropertyPlanTestInt8Enum::Negative);
+	TestTrue("Unsigned small enum", PlanObject->UInt16EnumValue == EPropertyPlanTestUInt16Enum::Large);
+	TestTrue("Enum read through its underlying property", PlanObject->Int32EnumValue == EPropertyPlanTestInt32Enum::Negative);
+	TestEqual("Int8", PlanObject->Int8Value, SourceObject->Int8Value);
+	TestEqual("UInt16", PlanObject->UInt16Value, SourceObject->UInt16Value);
+
+	Schema_DestroyComponentData(ComponentData);
+
+	return true;
+}
+
+PROPERTYAPPLYPLAN_TEST(GIVEN_arrays_of_numbers_schema_stores_as_laid_out_in_memory_WHEN_the_plan_is_built_THEN_they_are_read_as_lists)
+{
+	// GIVEN
+	USpatialNetDriver* NetDriver = NewObject<USpatialNetDriver>();
+	TSharedPtr<FRepLayout> RepLayout = NetDriver->GetObjectClassRepLayout(UPropertyPlanTestObject::StaticClass());
+
+	// WHEN
+	TSharedRef<const FPropertyApplyPlan> Plan = FPropertyApplyPlan::CreateForRepLayout(NetDriver, CreateTestClassInfo());
+
+	// THEN
+	const FName ListArrays[] = {
+		GET_MEMBER_NAME_CHECKED(UPropertyPlanTestObject, Int32Array),
+		GET_MEMBER_NAME_CHECKED(UPropertyPlanTestObject, Int64Array),
+		GET_MEMBER_NAME_CHECKED(UPropertyPlanTestObject, UInt32Array),
+		GET_MEMBER_NAME_CHECKED(UPropertyPlanTestObject, UInt64Array),
+		GET_MEMBER_NAME_CHECKED(UPropertyPlanTestObject, FloatArray),
+		GET_MEMBER_NAME_CHECKED(UPropertyPlanTestObject, DoubleArray)
+	};
+	for (const FName& ArrayName : ListArrays)
+	{
+		const FPropertyReader* Reader = Plan->GetReader(FindHandleIndex(*RepLayout, ArrayName) + 1);
+		TestTrue(FString::Printf(TEXT("%s read as a list"), *ArrayName.ToString()), Reader != nullptr && Reader->InnerReader.IsValid() && Reader->InnerReader->ReadList != nullptr);
+	}
+
+	// Elements narrower than their schema type, or that can hold object references, have to be read one at a time.
+	const FName ElementArrays[] = {
+		GET_MEMBER_NAME_CHECKED(UPropertyPlanTestObject, BoolArray),
+		GET_MEMBER_NAME_CHECKED(UPropertyPlanTestObject, Int8Array),
+		GET_MEMBER_NAME_CHECKED(UPropertyPlanTestObject, Int8EnumArray),
+		GET_MEMBER_NAME_CHECKED(UPropertyPlanTestObject, StructArray),
+		GET_MEMBER_NAME_CHECKED(UPropertyPlanTestObject, ObjectArray)
+	};
+	for (const FName& ArrayName : ElementArrays)
+	{
+		const FPropertyReader* Reader = Plan->GetReader(FindHandleIndex(*RepLayout, ArrayName) + 1);
+		TestTrue(FString::Printf(TEXT("%s read one element at a time"), *ArrayName.ToString()), Reader != nullptr && Reader->InnerReader.IsValid() && Reader->InnerReader->ReadList == nullptr);
+	}
+
+	return true;
+}
+
+PROPERTYAPPLYPLAN_TEST(GIVEN_arrays_of_other_lengths_WHEN_applied_with_a_list_reader_THEN_they_are_resized_to_the_field)
+{
+	// GIVEN
+	USpatialNetDriver* NetDriver = NewObject<USpatialNetDriver>();
+	TSharedPtr<FRepLayout> RepLayout = NetDriver->GetObjectClassRepLayout(UPropertyPlanTestObject::StaticClass());
+	TSharedRef<const FPropertyApplyPlan> Plan = FPropertyApplyPlan::CreateForRepLayout(NetDriver, CreateTestClassInfo());
+
+	const int32 Int32ArrayHandleIndex = FindHandleIndex(*RepLayout, GET_MEMBER_NAME_CHECKED(UPropertyPlanTestObject, Int32Array));
+	const int32 DoubleArrayHandleIndex = FindHandleIndex(*RepLayout, GET_MEMBER_NAME_CHECKED(UPropertyPlanTestObject, DoubleArray));
+	const int32 FloatArrayHandleIndex = FindHandleIndex(*RepLayout, GET_MEMBER_NAME_CHECKED(UPropertyPlanTestObject, FloatArray));
+	const int32 EmptyArrayHandleIndex = FindHandleIndex(*RepLayout, GET_MEMBER_NAME_CHECKED(UPropertyPlanTestObject, EmptyArray));
+	if (!TestTrue("Arrays replicated", Int32ArrayHandleIndex != INDEX_NONE && DoubleArrayHandleIndex != INDEX_NONE && FloatArrayHandleIndex != INDEX_NONE && EmptyArrayHandleIndex != INDEX_NONE))
+	{
+		return true;
+	}
+
+	// The int32 array shrinks, the double array grows from empty, and the float and empty arrays are cleared.
+	Schema_ComponentUpdate* ComponentUpdate = Schema_CreateComponentUpdate();
+	Schema_Object* Fields = Schema_GetComponentUpdateFields(ComponentUpdate);
+	Schema_AddInt32(Fields, Int32ArrayHandleIndex + 1, 7);
+	Schema_AddInt32(Fields, Int32ArrayHandleIndex + 1, -8);
+	Schema_AddDouble(Fields, DoubleArrayHandleIndex + 1, 0.5);
+	Schema_AddDouble(Fields, DoubleArrayHandleIndex + 1, 1.5);
+	Schema_AddDouble(Fields, DoubleArrayHandleIndex + 1, -2.5);
+	Schema_AddComponentUpdateClearedField(ComponentUpdate, FloatArrayHandleIndex + 1);
+	Schema_AddComponentUpdateClearedField(ComponentUpdate, EmptyArrayHandleIndex + 1);
+
+	UPropertyPlanTestObject* Object = NewObject<UPropertyPlanTestObject>();
+	Object->Int32Array = { 1, 2, 3, 4, 5 };
+	Object->DoubleArray.Reset();
+	Object->FloatArray = { 1.0f, 2.0f };
+	Object->EmptyArray = { 1, 2, 3 };
+
+	FObjectReferencesMap ObjectReferences;
+	ComponentReader Reader(NetDriver, ObjectReferences);
+
+	// WHEN
+	for (const int32 HandleIndex : { Int32ArrayHandleIndex, DoubleArrayHandleIndex, FloatArrayHandleIndex, EmptyArrayHandleIndex })
+	{
+		const Schema_FieldId FieldId = HandleIndex + 1;
+		ApplyField(Reader, ObjectReferences, Fields, FieldId, RepLayout->Cmds[RepLayout->BaseHandleToCmdIndex[HandleIndex].CmdIndex], Plan->GetReader(FieldId), Object);
+	}
+
+	// THEN
+	TestTrue("Int32 array shrunk to the field", Object->Int32Array == TArray<int32>({ 7, -8 }));
+	TestTrue("Double array grown to the field", Object->DoubleArray == TArray<double>({ 0.5, 1.5, -2.5 }));
+	TestEqual("Cleared float array emptied", Object->FloatArray.Num(), 0);
+	TestEqual("Cleared int32 array emptied", Object->EmptyArray.Num(), 0);
+
+	Schema_DestroyComponentUpdate(ComponentUpdate);
+
+	return true;
+}
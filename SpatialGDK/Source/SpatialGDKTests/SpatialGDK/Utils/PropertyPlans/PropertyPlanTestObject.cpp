@@ -0,0 +1,91 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "PropertyPlanTestObject.h"
+
+#include "Net/UnrealNetwork.h"
+
+void UPropertyPlanTestObject::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UPropertyPlanTestObject, bFirstFlag);
+	DOREPLIFETIME(UPropertyPlanTestObject, bSecondFlag);
+	DOREPLIFETIME(UPropertyPlanTestObject, bPlainBool);
+	DOREPLIFETIME(UPropertyPlanTestObject, Int8Value);
+	DOREPLIFETIME(UPropertyPlanTestObject, Int16Value);
+	DOREPLIFETIME(UPropertyPlanTestObject, Int32Value);
+	DOREPLIFETIME(UPropertyPlanTestObject, Int64Value);
+	DOREPLIFETIME(UPropertyPlanTestObject, ByteValue);
+	DOREPLIFETIME(UPropertyPlanTestObject, UInt16Value);
+	DOREPLIFETIME(UPropertyPlanTestObject, UInt32Value);
+	DOREPLIFETIME(UPropertyPlanTestObject, UInt64Value);
+	DOREPLIFETIME(UPropertyPlanTestObject, FloatValue);
+	DOREPLIFETIME(UPropertyPlanTestObject, DoubleValue);
+	DOREPLIFETIME(UPropertyPlanTestObject, Int8EnumValue);
+	DOREPLIFETIME(UPropertyPlanTestObject, UInt16EnumValue);
+	DOREPLIFETIME(UPropertyPlanTestObject, Int32EnumValue);
+	DOREPLIFETIME(UPropertyPlanTestObject, NameValue);
+	DOREPLIFETIME(UPropertyPlanTestObject, StringValue);
+	DOREPLIFETIME(UPropertyPlanTestObject, TextValue);
+	DOREPLIFETIME(UPropertyPlanTestObject, ObjectValue);
+	DOREPLIFETIME(UPropertyPlanTestObject, StructValue);
+	DOREPLIFETIME(UPropertyPlanTestObject, NetSerializeStructValue);
+	DOREPLIFETIME(UPropertyPlanTestObject, BoolArray);
+	DOREPLIFETIME(UPropertyPlanTestObject, Int8Array);
+	DOREPLIFETIME(UPropertyPlanTestObject, Int32Array);
+	DOREPLIFETIME(UPropertyPlanTestObject, Int64Array);
+	DOREPLIFETIME(UPropertyPlanTestObject, UInt32Array);
+	DOREPLIFETIME(UPropertyPlanTestObject, UInt64Array);
+	DOREPLIFETIME(UPropertyPlanTestObject, FloatArray);
+	DOREPLIFETIME(UPropertyPlanTestObject, DoubleArray);
+	DOREPLIFETIME(UPropertyPlanTestObject, Int8EnumArray);
+	DOREPLIFETIME(UPropertyPlanTestObject, StringArray);
+	DOREPLIFETIME(UPropertyPlanTestObject, StructArray);
+	DOREPLIFETIME(UPropertyPlanTestObject, ObjectArray);
+	DOREPLIFETIME(UPropertyPlanTestObject, EmptyArray);
+}
+
+void UPropertyPlanTestObject::SetTestValues()
+{
+	// Only the second bit of the bitfield byte is set, so reading the byte as a whole would be caught.
+	bFirstFlag = 0;
+	bSecondFlag = 1;
+	bPlainBool = true;
+	Int8Value = -100;
+	Int16Value = -30000;
+	Int32Value = -7;
+	Int64Value = -(int64(1) << 40);
+	ByteValue = 200;
+	UInt16Value = 60000;
+	UInt32Value = 4000000000u;
+	UInt64Value = (uint64(1) << 40) + 5;
+	FloatValue = 1.5f;
+	DoubleValue = 2.25;
+	Int8EnumValue = EPropertyPlanTestInt8Enum::Negative;
+	UInt16EnumValue = EPropertyPlanTestUInt16Enum::Large;
+	Int32EnumValue = EPropertyPlanTestInt32Enum::Negative;
+	NameValue = FName(TEXT("PropertyPlanTestName"));
+	StringValue = TEXT("Property plan test string");
+	TextValue = FText::FromString(TEXT("Property plan test text"));
+	ObjectValue = nullptr;
+	StructValue.IntValue = 3;
+	StructValue.FloatValue = 4.5f;
+	NetSerializeStructValue = FVector_NetQuantize(1.0f, -2.0f, 3.0f);
+	BoolArray = { true, false, true };
+	Int8Array = { -1, 2, -128 };
+	Int32Array = { 1, -2, 3 };
+	Int64Array = { -(int64(1) << 40), 5 };
+	UInt32Array = { 4000000000u, 1 };
+	UInt64Array = { (uint64(1) << 40) + 5, 2 };
+	FloatArray = { 0.5f, -1.5f };
+	DoubleArray = { 0.25, -2.5 };
+	Int8EnumArray = { EPropertyPlanTestInt8Enum::Negative, EPropertyPlanTestInt8Enum::Positive };
+	StringArray = { TEXT("First"), TEXT("Second") };
+	StructArray.SetNum(2);
+	StructArray[0].IntValue = 1;
+	StructArray[0].FloatValue = 2.0f;
+	StructArray[1].IntValue = -3;
+	StructArray[1].FloatValue = 4.0f;
+	ObjectArray = { nullptr, nullptr };
+	EmptyArray.Reset();
+}
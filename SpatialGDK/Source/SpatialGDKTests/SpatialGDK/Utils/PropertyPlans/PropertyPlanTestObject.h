@@ -0,0 +1,162 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+
+#include "PropertyPlanTestObject.generated.h"
+
+UENUM()
+enum class EPropertyPlanTestInt8Enum : int8
+{
+	Negative = -2,
+	Positive = 3
+};
+
+UENUM()
+enum class EPropertyPlanTestUInt16Enum : uint16
+{
+	Small = 1,
+	Large = 0x1234
+};
+
+UENUM()
+enum class EPropertyPlanTestInt32Enum : int32
+{
+	Negative = -100000,
+	Positive = 7
+};
+
+// Serialized with the rep layout of the struct when in an array, flattened into its members otherwise.
+USTRUCT()
+struct FPropertyPlanTestStruct
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 IntValue = 0;
+
+	UPROPERTY()
+	float FloatValue = 0.0f;
+};
+
+// Has a replicated property of every type that property serialization and apply plans pick a writer or reader for.
+UCLASS()
+class UPropertyPlanTestObject : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// Gives every property a value other than its default. Object references are left null, as writing any other
+	// reference needs a package map.
+	void SetTestValues();
+
+	UPROPERTY(Replicated)
+	uint8 bFirstFlag : 1;
+
+	UPROPERTY(Replicated)
+	uint8 bSecondFlag : 1;
+
+	UPROPERTY(Replicated)
+	bool bPlainBool;
+
+	UPROPERTY(Replicated)
+	int8 Int8Value;
+
+	UPROPERTY(Replicated)
+	int16 Int16Value;
+
+	UPROPERTY(Replicated)
+	int32 Int32Value;
+
+	UPROPERTY(Replicated)
+	int64 Int64Value;
+
+	UPROPERTY(Replicated)
+	uint8 ByteValue;
+
+	UPROPERTY(Replicated)
+	uint16 UInt16Value;
+
+	UPROPERTY(Replicated)
+	uint32 UInt32Value;
+
+	UPROPERTY(Replicated)
+	uint64 UInt64Value;
+
+	UPROPERTY(Replicated)
+	float FloatValue;
+
+	UPROPERTY(Replicated)
+	double DoubleValue;
+
+	UPROPERTY(Replicated)
+	EPropertyPlanTestInt8Enum Int8EnumValue;
+
+	UPROPERTY(Replicated)
+	EPropertyPlanTestUInt16Enum UInt16EnumValue;
+
+	UPROPERTY(Replicated)
+	EPropertyPlanTestInt32Enum Int32EnumValue;
+
+	UPROPERTY(Replicated)
+	FName NameValue;
+
+	UPROPERTY(Replicated)
+	FString StringValue;
+
+	UPROPERTY(Replicated)
+	FText TextValue;
+
+	UPROPERTY(Replicated)
+	UObject* ObjectValue;
+
+	UPROPERTY(Replicated)
+	FPropertyPlanTestStruct StructValue;
+
+	UPROPERTY(Replicated)
+	FVector_NetQuantize NetSerializeStructValue;
+
+	UPROPERTY(Replicated)
+	TArray<bool> BoolArray;
+
+	UPROPERTY(Replicated)
+	TArray<int8> Int8Array;
+
+	UPROPERTY(Replicated)
+	TArray<int32> Int32Array;
+
+	UPROPERTY(Replicated)
+	TArray<int64> Int64Array;
+
+	UPROPERTY(Replicated)
+	TArray<uint32> UInt32Array;
+
+	UPROPERTY(Replicated)
+	TArray<uint64> UInt64Array;
+
+	UPROPERTY(Replicated)
+	TArray<float> FloatArray;
+
+	UPROPERTY(Replicated)
+	TArray<double> DoubleArray;
+
+	UPROPERTY(Replicated)
+	TArray<EPropertyPlanTestInt8Enum> Int8EnumArray;
+
+	UPROPERTY(Replicated)
+	TArray<FString> StringArray;
+
+	UPROPERTY(Replicated)
+	TArray<FPropertyPlanTestStruct> StructArray;
+
+	UPROPERTY(Replicated)
+	TArray<UObject*> ObjectArray;
+
+	// Left empty, so it is written as a cleared field.
+	UPROPERTY(Replicated)
+	TArray<int32> EmptyArray;
+};
@@ -0,0 +1,181 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Tests/TestDefinitions.h"
+
+#include "PropertyPlanTestObject.h"
+
+#include "EngineClasses/SpatialNetDriver.h"
+#include "Interop/SpatialClassInfoManager.h"
+#include "Utils/ComponentFactory.h"
+#include "Utils/ComponentReader.h"
+#include "Utils/PropertySerializationPlan.h"
+
+#include "CoreMinimal.h"
+#include "Net/RepLayout.h"
+#include "UObject/UnrealType.h"
+
+#define PROPERTYSERIALIZATIONPLAN_TEST(TestName) \
+	GDK_TEST(Core, PropertySerializationPlan, TestName)
+
+namespace SpatialGDK
+{
+
+// Reaches the private property writing of ComponentFactory.
+struct FComponentFactoryTestAccess
+{
+	static void AddProperty(ComponentFactory& Factory, Schema_Object* Object, Schema_FieldId FieldId, UProperty* Property, const uint8* Data, TArray<Schema_FieldId>* ClearedIds)
+	{
+		Factory.AddProperty(Object, FieldId, Property, Data, ClearedIds);
+	}
+
+	static void AddProperty(ComponentFactory& Factory, Schema_Object* Object, Schema_FieldId FieldId, const FPropertyWriter& Writer, const uint8* Data, TArray<Schema_FieldId>* ClearedIds)
+	{
+		Factory.AddProperty(Object, FieldId, Writer, Data, ClearedIds);
+	}
+};
+
+} // namespace SpatialGDK
+
+using namespace SpatialGDK;
+
+namespace
+{
+	// The result of writing one field into empty component data.
+	struct FWrittenField
+	{
+		TArray<uint8> Bytes;
+		TArray<Schema_FieldId> ClearedIds;
+	};
+
+	FWrittenField WriteField(TFunctionRef<void(Schema_Object*, TArray<Schema_FieldId>*)> Write)
+	{
+		FWrittenField WrittenField;
+
+		Schema_ComponentData* ComponentData = Schema_CreateComponentData();
+		Schema_Object* Fields = Schema_GetComponentDataFields(ComponentData);
+		Write(Fields, &WrittenField.ClearedIds);
+
+		WrittenField.Bytes.SetNumUninitialized(Schema_GetWriteBufferLength(Fields));
+		Schema_SerializeToBuffer(Fields, WrittenField.Bytes.GetData(), WrittenField.Bytes.Num());
+		Schema_DestroyComponentData(ComponentData);
+
+		return WrittenField;
+	}
+
+	FClassInfo CreateTestClassInfo()
+	{
+		FClassInfo Info;
+		Info.Class = UPropertyPlanTestObject::StaticClass();
+		return Info;
+	}
+} // anonymous namespace
+
+PROPERTYSERIALIZATIONPLAN_TEST(GIVEN_a_property_of_every_written_type_WHEN_written_with_its_plan_writer_THEN_the_schema_matches_AddProperty)
+{
+	// GIVEN
+	USpatialNetDriver* NetDriver = NewObject<USpatialNetDriver>();
+	TSharedPtr<FRepLayout> RepLayout = NetDriver->GetObjectClassRepLayout(UPropertyPlanTestObject::StaticClass());
+	FPropertySerializationPlan Plan(NetDriver, CreateTestClassInfo());
+	ComponentFactory Factory(false, NetDriver, nullptr);
+
+	UPropertyPlanTestObject* Object = NewObject<UPropertyPlanTestObject>();
+	Object->SetTestValues();
+
+	// WHEN
+	for (int32 HandleIndex = 0; HandleIndex < RepLayout->BaseHandleToCmdIndex.Num(); ++HandleIndex)
+	{
+		const Schema_FieldId FieldId = HandleIndex + 1;
+		const int32 CmdIndex = RepLayout->BaseHandleToCmdIndex[HandleIndex].CmdIndex;
+		const FRepLayoutCmd& Cmd = RepLayout->Cmds[CmdIndex];
+		const uint8* Data = reinterpret_cast<const uint8*>(Object) + Cmd.Offset;
+
+		const FPropertyWriter& Writer = Plan.GetRepWriter(CmdIndex);
+		const FWrittenField PlanField = WriteField([&](Schema_Object* Fields, TArray<Schema_FieldId>* ClearedIds)
+		{
+			FComponentFactoryTestAccess::AddProperty(Factory, Fields, FieldId, Writer, Data, ClearedIds);
+		});
+		const FWrittenField PropertyField = WriteField([&](Schema_Object* Fields, TArray<Schema_FieldId>* ClearedIds)
+		{
+			FComponentFactoryTestAccess::AddProperty(Factory, Fields, FieldId, Cmd.Property, Data, ClearedIds);
+		});
+
+		// THEN
+		const FString PropertyName = Cmd.Property->GetName();
+		TestTrue(FString::Printf(TEXT("%s has a plan writer"), *PropertyName), Writer.Write != nullptr);
+		TestTrue(FString::Printf(TEXT("%s written"), *PropertyName), PropertyField.Bytes.Num() > 0 || PropertyField.ClearedIds.Num() > 0);
+		TestTrue(FString::Printf(TEXT("%s schema matches AddProperty"), *PropertyName), PlanField.Bytes == PropertyField.Bytes);
+		TestTrue(FString::Printf(TEXT("%s cleared ids match AddProperty"), *PropertyName), PlanField.ClearedIds == PropertyField.ClearedIds);
+	}
+
+	return true;
+}
+
+PROPERTYSERIALIZATIONPLAN_TEST(GIVEN_an_object_written_with_its_plan_WHEN_read_back_by_ComponentReader_THEN_every_property_round_trips)
+{
+	// GIVEN
+	USpatialNetDriver* NetDriver = NewObject<USpatialNetDriver>();
+	TSharedPtr<FRepLayout> RepLayout = NetDriver->GetObjectClassRepLayout(UPropertyPlanTestObject::StaticClass());
+	FPropertySerializationPlan Plan(NetDriver, CreateTestClassInfo());
+	ComponentFactory Factory(false, NetDriver, nullptr);
+
+	UPropertyPlanTestObject* SourceObject = NewObject<UPropertyPlanTestObject>();
+	SourceObject->SetTestValues();
+	UPropertyPlanTestObject* TargetObject = NewObject<UPropertyPlanTestObject>();
+	// Non-empty, so that reading the cleared field has to empty it.
+	TargetObject->EmptyArray = { 1, 2 };
+
+	Schema_ComponentData* ComponentData = Schema_CreateComponentData();
+	Schema_Object* Fields = Schema_GetComponentDataFields(ComponentData);
+	TArray<Schema_FieldId> ClearedIds;
+
+	FObjectReferencesMap ObjectReferences;
+	ComponentReader Reader(NetDriver, ObjectReferences);
+	bool bReferencesChanged = false;
+
+	// WHEN
+	for (int32 HandleIndex = 0; HandleIndex < RepLayout->BaseHandleToCmdIndex.Num(); ++HandleIndex)
+	{
+		const int32 CmdIndex = RepLayout->BaseHandleToCmdIndex[HandleIndex].CmdIndex;
+		const FRepLayoutCmd& Cmd = RepLayout->Cmds[CmdIndex];
+		FComponentFactoryTestAccess::AddProperty(Factory, Fields, HandleIndex + 1, Plan.GetRepWriter(CmdIndex), reinterpret_cast<const uint8*>(SourceObject) + Cmd.Offset, &ClearedIds);
+	}
+
+	for (int32 HandleIndex = 0; HandleIndex < RepLayout->BaseHandleToCmdIndex.Num(); ++HandleIndex)
+	{
+		const FRepLayoutCmd& Cmd = RepLayout->Cmds[RepLayout->BaseHandleToCmdIndex[HandleIndex].CmdIndex];
+		uint8* Data = reinterpret_cast<uint8*>(TargetObject) + Cmd.Offset;
+
+		if (UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Cmd.Property))
+		{
+			Reader.ApplyArray(Fields, HandleIndex + 1, ObjectReferences, ArrayProperty, Data, Cmd.Offset, Cmd.ShadowOffset, Cmd.ParentIndex, bReferencesChanged);
+		}
+		else
+		{
+			Reader.ApplyProperty(Fields, HandleIndex + 1, ObjectReferences, 0, Cmd.Property, Data, Cmd.Offset, Cmd.ShadowOffset, Cmd.ParentIndex, bReferencesChanged);
+		}
+	}
+
+	// THEN
+	for (int32 HandleIndex = 0; HandleIndex < RepLayout->BaseHandleToCmdIndex.Num(); ++HandleIndex)
+	{
+		const FRepLayoutCmd& Cmd = RepLayout->Cmds[RepLayout->BaseHandleToCmdIndex[HandleIndex].CmdIndex];
+		const uint8* SourceData = reinterpret_cast<const uint8*>(SourceObject) + Cmd.Offset;
+		const uint8* TargetData = reinterpret_cast<const uint8*>(TargetObject) + Cmd.Offset;
+
+		TestTrue(FString::Printf(TEXT("%s round trips"), *Cmd.Property->GetName()), Cmd.Property->Identical(SourceData, TargetData));
+	}
+
+	// Spot checks of the values most easily mangled by writing them through the wrong schema type.
+	TestTrue("Only the set bit of the bitfield byte is written", TargetObject->bFirstFlag == 0 && TargetObject->bSecondFlag == 1);
+	TestTrue("Signed small enum", TargetObject->Int8EnumValue == EPropertyPlanTestInt8Enum::Negative);
+	TestEqual("Int8", TargetObject->Int8Value, SourceObject->Int8Value);
+	TestEqual("Int16", TargetObject->Int16Value, SourceObject->Int16Value);
+	TestEqual("Struct array", TargetObject->StructArray.Num(), 2);
+	TestEqual("Object array", TargetObject->ObjectArray.Num(), 2);
+	TestTrue("Empty array written as cleared", ClearedIds.Num() == 1);
+	TestEqual("Cleared array emptied", TargetObject->EmptyArray.Num(), 0);
+
+	Schema_DestroyComponentData(ComponentData);
+
+	return true;
+}